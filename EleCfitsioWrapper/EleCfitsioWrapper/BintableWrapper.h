@@ -21,8 +21,12 @@
 #define _ELECFITSIOWRAPPER_BINTABLEWRAPPER_H
 
 #include "EleCfitsioWrapper/CfitsioUtils.h"
+#include "EleCfitsioWrapper/IoStats.h"
 #include "EleCfitsioWrapper/TypeWrapper.h"
 #include "EleFitsData/Column.h"
+#include "EleFitsData/Conversion.h"
+#include "EleFitsData/Scaling.h"
+#include "EleFitsData/VlaColumn.h"
 
 #include <tuple>
 #include <vector>
@@ -45,6 +49,16 @@ long columnCount(fitsfile* fptr);
  */
 long rowCount(fitsfile* fptr);
 
+/**
+ * @brief Append rows filled with zeros.
+ */
+void appendRows(fitsfile* fptr, long count);
+
+/**
+ * @brief Delete the rows after a given number of rows.
+ */
+void truncateRows(fitsfile* fptr, long rowCount);
+
 /**
  * @brief Check whether a given column exists.
  */
@@ -77,11 +91,40 @@ Fits::ColumnInfo<T> readColumnInfo(fitsfile* fptr, long index);
 template <typename T>
 Fits::VecColumn<T> readColumn(fitsfile* fptr, long index);
 
+/**
+ * @brief Read the scaling (`TSCALn` and `TZEROn`) of a binary table column with given index.
+ * @details
+ * If the keywords are not present, the identity is returned.
+ */
+Fits::Scaling readColumnScaling(fitsfile* fptr, long index);
+
 /**
  * @brief Read the segment of a binary table column with given index.
+ * @details
+ * If the values are scaled in the file, and the scaling boils down to an unsigned offset
+ * or `T` is a floating point type, then the stored values are read as is and scaled natively
+ * instead of relying on CFitsIO element-wise scaling.
+ *
+ * Otherwise, if `T` is not the stored type, then the stored values are read chunk-wise into a scratch buffer
+ * and converted with convertTo(), according to the given overflow policy.
+ * The policy is ignored for string columns.
  */
 template <typename T>
-void readColumnSegment(fitsfile* fptr, const Fits::Segment& rows, long index, Fits::Column<T>& column);
+void readColumnSegment(
+    fitsfile* fptr,
+    const Fits::Segment& rows,
+    long index,
+    Fits::Column<T>& column,
+    Fits::OverflowPolicy policy = Fits::OverflowPolicy::Throw);
+
+/**
+ * @brief Read the segment of a binary table column with given index, without applying the scaling.
+ * @details
+ * The stored values are read as is, e.g. as `std::int16_t` for an `std::uint16_t` column,
+ * and the scaling can be read with readColumnScaling().
+ */
+template <typename T>
+void readRawColumnSegment(fitsfile* fptr, const Fits::Segment& rows, long index, Fits::Column<T>& column);
 
 /**
  * @brief Read a binary table column with given name.
@@ -113,6 +156,35 @@ void writeColumn(fitsfile* fptr, const Fits::Column<T>& column);
 template <typename T>
 void writeColumnSegment(fitsfile* fptr, long firstRow, const Fits::Column<T>& column);
 
+/**
+ * @brief Read the segment of a variable-length array column with given index.
+ * @param rows The 1-based row indices
+ * @param index The 1-based column index
+ * @details
+ * The descriptors of the rows are read in a single call,
+ * and the heap region which spans the values is read in a single access and decoded natively.
+ * If the values are too sparse in the heap or cannot be decoded natively, they are read row-wise by CFitsIO.
+ */
+template <typename T>
+Fits::VlaColumn<T> readVlaColumnSegment(fitsfile* fptr, const Fits::Segment& rows, long index);
+
+/**
+ * @brief Write a variable-length array column from a given row.
+ * @param firstRow The 1-based index of the first row
+ * @param index The 1-based column index
+ * @details
+ * The values of all the rows are appended to the heap as a single array,
+ * and the descriptors of the rows are then set to point to consecutive regions of this array.
+ * The values are converted to the stored type, and the descriptors account for the stored width.
+ * The table is extended if needed.
+ *
+ * When existing rows are overwritten, their previous values are left unused in the heap,
+ * which is therefore compressed (with `fits_compress_heap()`) to reclaim them.
+ * This rewrites the whole heap, such that many small overwrites are better grouped into one call.
+ */
+template <typename T>
+void writeVlaColumnSegment(fitsfile* fptr, long firstRow, long index, const Fits::VlaColumn<T>& column);
+
 /**
  * @brief Write several binary table columns.
  */
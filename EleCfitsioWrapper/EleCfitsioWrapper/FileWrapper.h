@@ -20,6 +20,7 @@
 #ifndef _ELECFITSIOWRAPPER_FILEWRAPPER_H
 #define _ELECFITSIOWRAPPER_FILEWRAPPER_H
 
+#include <cstddef> // size_t
 #include <fitsio.h>
 #include <string>
 
@@ -59,6 +60,42 @@ fitsfile* createAndOpen(const std::string& filename, CreatePolicy policy);
  */
 fitsfile* open(const std::string& filename, OpenPolicy policy);
 
+/**
+ * @brief Create a Fits file in memory and open it.
+ * @param buffer The address of the buffer, which can be null
+ * @param size The address of the buffer capacity
+ * @details
+ * The buffer is grown with `std::realloc()` as needed, such that it must have been allocated with `std::malloc()`.
+ * CFitsIO keeps the addresses of the buffer and capacity variables, which must therefore outlive the file.
+ * They are updated as the file grows, and when the file is closed, the buffer is not freed.
+ */
+fitsfile* createAndOpen(void** buffer, std::size_t* size);
+
+/**
+ * @brief Open a Fits file in memory with optional write permission.
+ * @param buffer The address of the buffer
+ * @param size The address of the buffer capacity
+ * @details
+ * With `OpenPolicy::ReadOnly`, the buffer is not copied, and it is not modified.
+ * With `OpenPolicy::ReadWrite`, the buffer is grown with `std::realloc()` as needed.
+ * @see createAndOpen(void**, std::size_t*)
+ */
+fitsfile* open(void** buffer, std::size_t* size, OpenPolicy policy);
+
+/**
+ * @brief Compute the size of a Fits file in bytes, i.e. the end of its last HDU.
+ * @details
+ * For files in memory, this is generally smaller than the buffer capacity.
+ */
+std::size_t byteCount(fitsfile* fptr);
+
+/**
+ * @brief Write the internal buffers of CFitsIO to the file.
+ * @details
+ * This is useful to make sure the data written so far would survive a crash of the process.
+ */
+void flush(fitsfile* fptr);
+
 /**
  * @brief Close a Fits file.
  */
@@ -80,6 +117,14 @@ std::string name(fitsfile* fptr);
  */
 bool isWritable(fitsfile* fptr);
 
+/**
+ * @brief Check whether a Fits file is in memory, in which case it cannot be opened a second time by name.
+ * @details
+ * This relies on the CFitsIO driver rather than on the file name,
+ * which is not standard for files created from a buffer.
+ */
+bool isInMemory(fitsfile* fptr);
+
 } // namespace FileAccess
 } // namespace Cfitsio
 } // namespace Euclid
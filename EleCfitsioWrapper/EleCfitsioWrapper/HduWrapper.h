@@ -23,6 +23,7 @@
 #include "EleCfitsioWrapper/BintableWrapper.h"
 #include "EleCfitsioWrapper/CfitsioUtils.h"
 #include "EleCfitsioWrapper/ImageWrapper.h"
+#include "EleCfitsioWrapper/IoStats.h"
 #include "EleCfitsioWrapper/TypeWrapper.h"
 #include "EleFitsData/HduCategory.h"
 
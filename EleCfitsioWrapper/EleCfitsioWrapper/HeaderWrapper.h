@@ -23,6 +23,7 @@
 #include "EleCfitsioWrapper/CfitsioUtils.h"
 #include "EleCfitsioWrapper/ErrorWrapper.h"
 #include "EleCfitsioWrapper/HduWrapper.h"
+#include "EleCfitsioWrapper/IoStats.h"
 #include "EleCfitsioWrapper/TypeWrapper.h"
 #include "EleFitsData/KeywordCategory.h"
 #include "EleFitsData/Record.h"
@@ -22,8 +22,11 @@
 
 #include "EleCfitsioWrapper/ErrorWrapper.h"
 #include "EleCfitsioWrapper/FileWrapper.h"
+#include "EleCfitsioWrapper/IoStats.h"
 #include "EleCfitsioWrapper/TypeWrapper.h"
+#include "EleFitsData/Conversion.h"
 #include "EleFitsData/Raster.h"
+#include "EleFitsData/Scaling.h"
 
 #include <fitsio.h>
 #include <string>
@@ -62,9 +65,19 @@ Fits::VecRaster<T, n> readRaster(fitsfile* fptr);
 
 /**
  * @brief Read the whole raster of the current image HDU into a pre-existing raster.
+ * @details
+ * If the values are scaled in the file, and the scaling boils down to an unsigned offset
+ * or `T` is a floating point type, then the stored bytes are read and decoded natively
+ * instead of relying on CFitsIO element-wise scaling.
+ *
+ * Otherwise, if `T` is not the stored type, then the stored values are read chunk-wise into a scratch buffer
+ * and converted with convertTo(), according to the given overflow policy.
  */
 template <typename T, long n = 2>
-void readRasterTo(fitsfile* fptr, Fits::Raster<T, n>& destination);
+void readRasterTo(
+    fitsfile* fptr,
+    Fits::Raster<T, n>& destination,
+    Fits::OverflowPolicy policy = Fits::OverflowPolicy::Throw);
 
 /**
  * @brief Read the whole raster of the current image HDU into a pre-existing subraster.
@@ -72,6 +85,27 @@ void readRasterTo(fitsfile* fptr, Fits::Raster<T, n>& destination);
 template <typename T, long n = 2>
 void readRasterTo(fitsfile* fptr, Fits::Subraster<T, n>& destination);
 
+/**
+ * @brief Read the scaling (`BSCALE` and `BZERO`) of the current image HDU.
+ * @details
+ * If the keywords are not present, the identity is returned.
+ *
+ * The scaling is taken from the HDU structure, which CFitsIO parses once when the HDU is loaded,
+ * such that no keyword is searched at each read.
+ * It is therefore the scaling that CFitsIO applies, including an override by `fits_set_bscale()`.
+ * For tile-compressed images, the keywords are read.
+ */
+Fits::Scaling readScaling(fitsfile* fptr);
+
+/**
+ * @brief Read the whole raster of the current image HDU into a pre-existing raster, without applying the scaling.
+ * @details
+ * The stored values are read as is, e.g. as `std::int16_t` for an `std::uint16_t` image,
+ * and the scaling can be read with readScaling().
+ */
+template <typename T, long n = 2>
+void readRawRasterTo(fitsfile* fptr, Fits::Raster<T, n>& destination);
+
 /**
  * @brief Read a region of the current image HDU.
  */
@@ -89,6 +123,19 @@ Fits::VecRaster<T, m> readRegion(fitsfile* fptr, const Fits::Region<n>& region);
 template <typename T, long m, long n>
 void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Raster<T, m>& destination);
 
+/**
+ * @brief Read every `step`-th pixel of a region of the current image HDU into a pre-existing raster.
+ * @param region The source region
+ * @param step The distance between two read pixels along each axis
+ * @param destination The destination raster, whose shape is the region shape divided by the step, rounded up
+ */
+template <typename T, long m, long n>
+void readDecimatedTo(
+    fitsfile* fptr,
+    const Fits::Region<n>& region,
+    const Fits::Position<n>& step,
+    Fits::Raster<T, m>& destination);
+
 /**
  * @brief Read a region of the current image HDU into a pre-existing subraster.
  * @param region The source region
@@ -0,0 +1,321 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELECFITSIOWRAPPER_IOSTATS_H
+#define _ELECFITSIOWRAPPER_IOSTATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fitsio.h>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace Euclid {
+namespace Cfitsio {
+
+/**
+ * @brief The categories of CFitsIO calls.
+ */
+enum class IoCategory
+{
+  File = 0, ///< File creation, opening, flushing and closing
+  Hdu, ///< HDU navigation, creation and deletion
+  Header, ///< Header reading and writing
+  Image, ///< Image data reading and writing
+  Bintable ///< Binary table data reading and writing
+};
+
+/**
+ * @brief The number of `IoCategory` values.
+ */
+constexpr std::size_t ioCategoryCount = 5;
+
+/**
+ * @brief Get the lower case name of an `IoCategory`.
+ */
+std::string ioCategoryName(IoCategory category);
+
+/**
+ * @brief I/O counters of a file or of an HDU.
+ */
+struct IoCounters {
+
+  /**
+   * @brief The number of CFitsIO calls, per `IoCategory`.
+   */
+  std::array<long, ioCategoryCount> calls {};
+
+  /**
+   * @brief The number of data bytes requested.
+   */
+  long requestedBytes = 0;
+
+  /**
+   * @brief The number of data bytes actually read or written.
+   */
+  long deliveredBytes = 0;
+
+  /**
+   * @brief The number of HDU moves, i.e. of navigation calls which actually changed the current HDU.
+   */
+  long hduMoves = 0;
+
+  /**
+   * @brief The number of header cards read by whole-header scans.
+   */
+  long cardScans = 0;
+
+  /**
+   * @brief The time spent in CFitsIO calls, in microseconds.
+   */
+  double elapsed = 0;
+
+  /**
+   * @brief Get the number of calls of a given category.
+   */
+  long callCount(IoCategory category) const;
+
+  /**
+   * @brief Get the total number of calls.
+   */
+  long callCount() const;
+
+  /**
+   * @brief Add counters.
+   */
+  IoCounters& operator+=(const IoCounters& rhs);
+
+  /**
+   * @brief Write the counters as a JSON object.
+   */
+  void writeJson(std::ostream& out) const;
+};
+
+/**
+ * @brief I/O counters of a file, aggregated for the whole file and per HDU.
+ */
+struct IoFileStats {
+
+  /**
+   * @brief The counters of the whole file.
+   */
+  IoCounters total;
+
+  /**
+   * @brief The counters of each HDU, indexed by 0-based HDU index.
+   */
+  std::map<long, IoCounters> hdus;
+
+  /**
+   * @brief Write the statistics as a JSON object.
+   */
+  void writeJson(std::ostream& out) const;
+};
+
+/**
+ * @brief Opt-in registry of I/O counters, aggregated per file name and per HDU.
+ * @details
+ * When enabled, the functions of the wrapper record their CFitsIO calls by category,
+ * the numbers of bytes requested and delivered, the HDU moves, the header card scans, and the time spent.
+ * When disabled, which is the default, recording costs one relaxed atomic load per call.
+ *
+ * The registry is thread-safe, and files which are opened several times, e.g. by several threads,
+ * are aggregated under the same name.
+ *
+ * Example usage:
+ * \code
+ * IoStats::enable();
+ * // Run some pipeline step
+ * IoStats::writeJson(std::cout);
+ * const auto stats = IoStats::read("file.fits");
+ * const auto moveCount = stats.total.hduMoves;
+ * \endcode
+ * @see IoScope
+ */
+class IoStats {
+
+public:
+  /**
+   * @brief Start recording.
+   */
+  static void enable();
+
+  /**
+   * @brief Stop recording, while keeping the counters.
+   */
+  static void disable();
+
+  /**
+   * @brief Check whether recording is enabled.
+   */
+  static bool isEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Clear the counters.
+   */
+  static void reset();
+
+  /**
+   * @brief Get the counters of a file.
+   * @details
+   * If no call was recorded for the file, the counters are all zero.
+   */
+  static IoFileStats read(const std::string& filename);
+
+  /**
+   * @brief Get the counters of all files, by file name.
+   */
+  static std::map<std::string, IoFileStats> readAll();
+
+  /**
+   * @brief Record a call.
+   * @param filename The file name
+   * @param hduIndex The 0-based HDU index
+   * @param category The call category
+   * @param counters The call counters, whose call counts are ignored
+   */
+  static void record(const std::string& filename, long hduIndex, IoCategory category, const IoCounters& counters);
+
+  /**
+   * @brief Write the counters of all files as JSON.
+   */
+  static void writeJson(std::ostream& out);
+
+  /**
+   * @brief Write the counters of all files as JSON in a file.
+   */
+  static void writeJson(const std::string& filename);
+
+private:
+  /**
+   * @brief The recording flag.
+   */
+  static std::atomic<bool> s_enabled;
+};
+
+/**
+ * @brief RAII helper which records a CFitsIO call in the `IoStats` registry.
+ * @details
+ * The file name and HDU index are read at construction, and the call is recorded at destruction,
+ * with the elapsed time.
+ * Delivered bytes, HDU moves and card scans are recorded only if declared, typically once the call succeeded,
+ * such that a call which throws delivers nothing.
+ * When the registry is disabled, the helper does nothing.
+ *
+ * \code
+ * IoScope scope(fptr, IoCategory::Image, size * sizeof(T));
+ * fits_read_img(fptr, ...);
+ * CfitsioError::mayThrow(status, fptr, "Cannot read image");
+ * scope.deliver(size * sizeof(T));
+ * \endcode
+ */
+class IoScope {
+
+public:
+  /**
+   * @brief Start recording a call on an open file.
+   */
+  IoScope(fitsfile* fptr, IoCategory category, long requestedBytes = 0);
+
+  /**
+   * @brief Start recording a call on a file which is not open yet.
+   * @details
+   * Once the file is open, `relocate()` should be called to use the name given by CFitsIO.
+   */
+  IoScope(const std::string& filename, IoCategory category);
+
+  /**
+   * @brief Non-copyable.
+   */
+  IoScope(const IoScope&) = delete;
+
+  /**
+   * @brief Non-copyable.
+   */
+  IoScope& operator=(const IoScope&) = delete;
+
+  /**
+   * @brief Record the call.
+   */
+  ~IoScope();
+
+  /**
+   * @brief Declare the number of bytes delivered.
+   */
+  void deliver(long byteCount) {
+    m_counters.deliveredBytes += byteCount;
+  }
+
+  /**
+   * @brief Attribute the call to the current file and HDU, e.g. after a file was opened or an HDU was created.
+   */
+  void relocate(fitsfile* fptr);
+
+  /**
+   * @brief Declare that the current HDU was changed by navigation, and attribute the call to the new HDU.
+   */
+  void move(fitsfile* fptr);
+
+  /**
+   * @brief Declare a number of header cards scanned.
+   */
+  void scan(long cardCount) {
+    m_counters.cardScans += cardCount;
+  }
+
+private:
+  /**
+   * @brief Whether the call is recorded.
+   */
+  bool m_enabled;
+
+  /**
+   * @brief The file name.
+   */
+  std::string m_filename;
+
+  /**
+   * @brief The 0-based HDU index.
+   */
+  long m_hduIndex;
+
+  /**
+   * @brief The call category.
+   */
+  IoCategory m_category;
+
+  /**
+   * @brief The counters.
+   */
+  IoCounters m_counters;
+
+  /**
+   * @brief The start time.
+   */
+  std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace Cfitsio
+} // namespace Euclid
+
+#endif
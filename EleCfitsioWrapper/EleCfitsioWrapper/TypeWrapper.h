@@ -54,6 +54,12 @@ struct TypeCode {
    */
   inline static std::string tform(long repeatCount);
 
+  /**
+   * @brief Get the TFORM value to handle variable-length array columns.
+   * @param largeHeap Use 64-bit descriptors (`Q`) instead of 32-bit descriptors (`P`)
+   */
+  inline static std::string vlaTform(bool largeHeap = false);
+
   /**
    * @brief Get the type code for an image.
    */
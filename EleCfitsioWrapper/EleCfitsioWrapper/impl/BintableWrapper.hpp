@@ -25,6 +25,9 @@
   #include "ElementsKernel/Unused.h"
 
   #include <algorithm> // transform
+  #include <cstdlib> // abs
+  #include <type_traits>
+  #include <utility> // index_sequence
 
 namespace Euclid {
 namespace Cfitsio {
@@ -34,22 +37,12 @@ namespace BintableIo {
 namespace Internal {
 
 /**
- * @brief Read metadata and allocate data.
+ * @brief Read metadata and allocate data of each column, without default-constructing the columns first.
  */
-template <typename T>
-void readColumnInfoImpl(fitsfile* fptr, long index, Fits::VecColumn<T>& column, long rowCount);
-
-/**
- * @brief String specialization.
- */
-template <>
-void readColumnInfoImpl<std::string>(fitsfile* fptr, long index, Fits::VecColumn<std::string>& column, long rowCount);
-
-template <typename T>
-void readColumnInfoImpl(fitsfile* fptr, long index, Fits::VecColumn<T>& column, long rowCount) {
-  column = Fits::VecColumn<T>(
-      readColumnInfo<T>(fptr, index),
-      std::vector<std::decay_t<T>>(column.info().repeatCount * rowCount));
+template <typename... Ts, std::size_t... Is>
+std::tuple<Fits::VecColumn<Ts>...>
+readColumnInfos(fitsfile* fptr, const std::vector<long>& indices, long rowCount, std::index_sequence<Is...>) {
+  return std::tuple<Fits::VecColumn<Ts>...> { Fits::VecColumn<Ts>(readColumnInfo<Ts>(fptr, indices[Is]), rowCount)... };
 }
 
 /**
@@ -71,6 +64,8 @@ void readColumnChunkImpl<std::string>(
 
 template <typename T>
 void readColumnChunkImpl(fitsfile* fptr, long index, Fits::VecColumn<T>& column, long firstRow, long rowCount) {
+  const long byteCount = rowCount * column.info().repeatCount * sizeof(T);
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
   int status = 0;
   auto begin = column.data() + (firstRow - 1) * column.info().repeatCount;
   fits_read_col(
@@ -89,6 +84,7 @@ void readColumnChunkImpl(fitsfile* fptr, long index, Fits::VecColumn<T>& column,
       fptr,
       "Cannot read column chunk: " + column.info().name + " (" + std::to_string(index - 1) + "); " + "rows: [" +
           std::to_string(firstRow - 1) + "-" + std::to_string(firstRow - 1 + rowCount - 1) + "-");
+  scope.deliver(byteCount);
 }
 
 /**
@@ -117,6 +113,8 @@ void writeColumnChunkImpl(fitsfile* fptr, long index, const Fits::Column<T>& col
   const auto end = begin + size;
   std::vector<std::decay_t<T>> vec(begin, end);
   /* Write data */
+  const long byteCount = size * sizeof(T);
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
   int status = 0;
   fits_write_col(fptr, TypeCode<T>::forBintable(), static_cast<int>(index), firstRow, 1, size, vec.data(), &status);
   CfitsioError::mayThrow(
@@ -124,6 +122,7 @@ void writeColumnChunkImpl(fitsfile* fptr, long index, const Fits::Column<T>& col
       fptr,
       "Cannot write column chunk: " + column.info().name + " (" + std::to_string(index - 1) + "); " + "rows: [" +
           std::to_string(firstRow - 1) + "-" + std::to_string(firstRow - 1 + rowCount - 1) + "-");
+  scope.deliver(byteCount);
 }
 
 /**
@@ -138,18 +137,6 @@ void writeColumnChunkImpl(fitsfile* fptr, long index, const Fits::Column<T>& col
 template <std::size_t i, typename... Ts>
 struct ColumnLooperImpl {
 
-  /**
-   * @brief Read metadata and allocate data for each column
-   */
-  static void readInfos(
-      fitsfile* fptr,
-      const std::vector<long>& indices,
-      std::tuple<Fits::VecColumn<Ts>...>& columns,
-      long rowCount) {
-    readColumnInfoImpl(fptr, indices[i], std::get<i>(columns), rowCount);
-    ColumnLooperImpl<i - 1, Ts...>::readInfos(fptr, indices, columns, rowCount);
-  }
-
   /**
    * @brief Read a chunk of each column
    */
@@ -191,13 +178,6 @@ struct ColumnLooperImpl {
 template <typename... Ts>
 struct ColumnLooperImpl<std::size_t(-1), Ts...> {
 
-  /** @brief Pass */
-  static void readInfos(
-      ELEMENTS_UNUSED fitsfile* fptr,
-      ELEMENTS_UNUSED const std::vector<long>& indices,
-      ELEMENTS_UNUSED std::tuple<Fits::VecColumn<Ts>...>& columns,
-      ELEMENTS_UNUSED long rowCount) {}
-
   /** @brief Pass */
   static void readChunks(
       ELEMENTS_UNUSED fitsfile* fptr,
@@ -261,11 +241,334 @@ void readColumnSegment<std::string>(
     fitsfile* fptr,
     const Fits::Segment& rows,
     long index,
-    Fits::Column<std::string>& column);
+    Fits::Column<std::string>& column,
+    Fits::OverflowPolicy policy);
+/// @endcond
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Read stored values with scaling disabled.
+ */
+template <typename TRaw>
+void readRawColumnValues(
+    fitsfile* fptr,
+    const Fits::Segment& rows,
+    long index,
+    const Fits::Scaling& scaling,
+    long count,
+    TRaw* data) {
+  int status = 0;
+  fits_set_tscale(fptr, static_cast<int>(index), 1., 0., &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot disable scaling of column: #" + std::to_string(index - 1));
+  fits_read_col(
+      fptr,
+      TypeCode<TRaw>::forBintable(),
+      static_cast<int>(index),
+      rows.front,
+      1,
+      count,
+      nullptr,
+      data,
+      nullptr,
+      &status);
+  int restoreStatus = 0; // Restore even if reading failed
+  fits_set_tscale(fptr, static_cast<int>(index), scaling.scale, scaling.offset, &restoreStatus);
+  CfitsioError::mayThrow(status, fptr, "Cannot read raw column data: #" + std::to_string(index - 1));
+  CfitsioError::mayThrow(restoreStatus, fptr, "Cannot restore scaling of column: #" + std::to_string(index - 1));
+}
+
+/**
+ * @brief Read stored values and scale them natively.
+ * @details
+ * Unsigned offsets are applied in place, other scalings require a scratch buffer.
+ * @return False if the scaling cannot be applied natively, in which case CFitsIO should be used.
+ */
+template <typename TRaw, typename T>
+bool readScaledColumnValues(
+    fitsfile* fptr,
+    const Fits::Segment& rows,
+    long index,
+    const Fits::Scaling& scaling,
+    long count,
+    T* data) {
+  if (scaling.isSignBitFlip<TRaw, T>()) {
+    auto* raw = reinterpret_cast<TRaw*>(data); // Signed and unsigned variants can alias
+    readRawColumnValues(fptr, rows, index, scaling, count, raw);
+    Fits::scaleTo(raw, count, scaling, data);
+    return true;
+  }
+  if (std::is_floating_point<T>::value) {
+    std::vector<TRaw> raw(count);
+    readRawColumnValues(fptr, rows, index, scaling, count, raw.data());
+    Fits::scaleTo(raw.data(), count, scaling, data);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Read and scale a column segment natively, if relevant.
+ * @return False if the column is not scaled or cannot be scaled natively, in which case CFitsIO should be used.
+ */
+template <typename T>
+bool readScaledColumnSegment(
+    fitsfile* fptr,
+    const Fits::Segment& rows,
+    long index,
+    Fits::Column<T>& column,
+    std::true_type) {
+  const auto scaling = readColumnScaling(fptr, index);
+  if (scaling.isIdentity()) {
+    return false;
+  }
+  int status = 0;
+  int typecode = 0;
+  fits_get_coltype(fptr, static_cast<int>(index), &typecode, nullptr, nullptr, &status);
+  if (status != 0) {
+    return false;
+  }
+  const long count = rows.size() * column.info().repeatCount;
+  switch (typecode) {
+    case TBYTE:
+      return readScaledColumnValues<unsigned char>(fptr, rows, index, scaling, count, column.data());
+    case TSHORT:
+      return readScaledColumnValues<std::int16_t>(fptr, rows, index, scaling, count, column.data());
+    case TLONG: // 'J' is 32-bit wide
+    case TINT:
+      return readScaledColumnValues<std::int32_t>(fptr, rows, index, scaling, count, column.data());
+    case TLONGLONG:
+      return readScaledColumnValues<std::int64_t>(fptr, rows, index, scaling, count, column.data());
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Non-arithmetic case (e.g. complex values): leave scaling to CFitsIO.
+ */
+template <typename T>
+bool readScaledColumnSegment(fitsfile*, const Fits::Segment&, long, Fits::Column<T>&, std::false_type) {
+  return false;
+}
+
+/**
+ * @brief The maximum number of bytes read at once when converting a column segment natively.
+ */
+constexpr long conversionChunkByteCount = 1 << 20;
+
+/**
+ * @brief Read stored values of a column segment as `TRaw` values, and convert them to `T` chunk-wise.
+ * @return False if `T` is the stored type, in which case CFitsIO should be used.
+ * @details
+ * The values are read into a per-thread scratch buffer, which is reused across calls.
+ */
+template <typename TRaw, typename T>
+bool convertColumnValues(
+    fitsfile* fptr,
+    const Fits::Segment& rows,
+    long index,
+    long repeatCount,
+    T* data,
+    Fits::OverflowPolicy policy,
+    std::true_type) {
+  if (std::is_same<TRaw, T>::value) {
+    return false;
+  }
+  const long size = rows.size() * repeatCount;
+  const long chunkSize = std::max(1L, conversionChunkByteCount / static_cast<long>(sizeof(TRaw)));
+  auto* buffer = Fits::Internal::scratch<TRaw>(std::min(size, chunkSize));
+  int status = 0;
+  for (long front = 0; front < size; front += chunkSize) {
+    const long count = std::min(chunkSize, size - front);
+    fits_read_col(
+        fptr,
+        TypeCode<TRaw>::forBintable(),
+        static_cast<int>(index),
+        rows.front + front / repeatCount, // 1-based first row index
+        1 + front % repeatCount, // 1-based first element index
+        count,
+        nullptr,
+        buffer,
+        nullptr,
+        &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot read column data: #" + std::to_string(index - 1));
+    Fits::convertTo(buffer, count, data + front, policy);
+  }
+  return true;
+}
+
+/**
+ * @brief Inconvertible case (e.g. complex to real values): leave conversion to CFitsIO.
+ */
+template <typename TRaw, typename T>
+bool convertColumnValues(fitsfile*, const Fits::Segment&, long, long, T*, Fits::OverflowPolicy, std::false_type) {
+  return false;
+}
+
+/**
+ * @brief Read and convert a column segment natively if `T` is not the stored type.
+ * @details
+ * The stored type is given by the equivalent type code,
+ * i.e. scaled columns are handled like their unscaled equivalents.
+ * @return False if no conversion is needed or the types are not convertible, in which case CFitsIO should be used.
+ */
+template <typename T>
+bool readConvertedColumnSegment(
+    fitsfile* fptr,
+    const Fits::Segment& rows,
+    long index,
+    Fits::Column<T>& column,
+    Fits::OverflowPolicy policy,
+    std::true_type) {
+  int status = 0;
+  int typecode = 0;
+  fits_get_eqcoltype(fptr, static_cast<int>(index), &typecode, nullptr, nullptr, &status);
+  if (status != 0) {
+    return false;
+  }
+  if ((typecode == TFLOAT || typecode == TDOUBLE) && not readColumnScaling(fptr, index).isIdentity()) {
+    return false; // Let CFitsIO scale in double precision
+  }
+  const auto repeatCount = column.info().repeatCount;
+  auto* data = column.data();
+  switch (typecode) {
+    case TSBYTE:
+      return convertColumnValues<char>(fptr, rows, index, repeatCount, data, policy, Fits::IsConvertible<char, T>());
+    case TBYTE:
+      return convertColumnValues<unsigned char>(
+          fptr,
+          rows,
+          index,
+          repeatCount,
+          data,
+          policy,
+          Fits::IsConvertible<unsigned char, T>());
+    case TSHORT:
+      return convertColumnValues<std::int16_t>(
+          fptr,
+          rows,
+          index,
+          repeatCount,
+          data,
+          policy,
+          Fits::IsConvertible<std::int16_t, T>());
+    case TUSHORT:
+      return convertColumnValues<std::uint16_t>(
+          fptr,
+          rows,
+          index,
+          repeatCount,
+          data,
+          policy,
+          Fits::IsConvertible<std::uint16_t, T>());
+    case TLONG: // 'J' is 32-bit wide
+    case TINT:
+      return convertColumnValues<std::int32_t>(
+          fptr,
+          rows,
+          index,
+          repeatCount,
+          data,
+          policy,
+          Fits::IsConvertible<std::int32_t, T>());
+    case TULONG:
+    case TUINT:
+      return convertColumnValues<std::uint32_t>(
+          fptr,
+          rows,
+          index,
+          repeatCount,
+          data,
+          policy,
+          Fits::IsConvertible<std::uint32_t, T>());
+    case TLONGLONG:
+      return convertColumnValues<std::int64_t>(
+          fptr,
+          rows,
+          index,
+          repeatCount,
+          data,
+          policy,
+          Fits::IsConvertible<std::int64_t, T>());
+    case TULONGLONG:
+      return convertColumnValues<std::uint64_t>(
+          fptr,
+          rows,
+          index,
+          repeatCount,
+          data,
+          policy,
+          Fits::IsConvertible<std::uint64_t, T>());
+    case TFLOAT:
+      return convertColumnValues<float>(fptr, rows, index, repeatCount, data, policy, Fits::IsConvertible<float, T>());
+    case TDOUBLE:
+      return convertColumnValues<double>(
+          fptr,
+          rows,
+          index,
+          repeatCount,
+          data,
+          policy,
+          Fits::IsConvertible<double, T>());
+    case TCOMPLEX:
+      return convertColumnValues<std::complex<float>>(
+          fptr,
+          rows,
+          index,
+          repeatCount,
+          data,
+          policy,
+          Fits::IsConvertible<std::complex<float>, T>());
+    case TDBLCOMPLEX:
+      return convertColumnValues<std::complex<double>>(
+          fptr,
+          rows,
+          index,
+          repeatCount,
+          data,
+          policy,
+          Fits::IsConvertible<std::complex<double>, T>());
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Non-numeric case (e.g. strings): leave conversion to CFitsIO.
+ */
+template <typename T>
+bool readConvertedColumnSegment(
+    fitsfile*,
+    const Fits::Segment&,
+    long,
+    Fits::Column<T>&,
+    Fits::OverflowPolicy,
+    std::false_type) {
+  return false;
+}
+
+} // namespace Internal
 /// @endcond
 
 template <typename T>
-void readColumnSegment(fitsfile* fptr, const Fits::Segment& rows, long index, Fits::Column<T>& column) {
+void readColumnSegment(
+    fitsfile* fptr,
+    const Fits::Segment& rows,
+    long index,
+    Fits::Column<T>& column,
+    Fits::OverflowPolicy policy) {
+  const long byteCount = rows.size() * column.info().repeatCount * sizeof(T);
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
+  if (Internal::readScaledColumnSegment(fptr, rows, index, column, std::is_arithmetic<T>())) {
+    scope.deliver(byteCount);
+    return;
+  }
+  if (Internal::readConvertedColumnSegment(fptr, rows, index, column, policy, Fits::IsConvertible<T, T>())) {
+    scope.deliver(byteCount);
+    return;
+  }
   int status = 0;
   fits_read_col(
       fptr,
@@ -279,6 +582,16 @@ void readColumnSegment(fitsfile* fptr, const Fits::Segment& rows, long index, Fi
       nullptr,
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot read column data: #" + std::to_string(index - 1));
+  scope.deliver(byteCount);
+}
+
+template <typename T>
+void readRawColumnSegment(fitsfile* fptr, const Fits::Segment& rows, long index, Fits::Column<T>& column) {
+  const long byteCount = rows.size() * column.info().repeatCount * sizeof(T);
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
+  const auto scaling = readColumnScaling(fptr, index);
+  Internal::readRawColumnValues(fptr, rows, index, scaling, rows.size() * column.info().repeatCount, column.data());
+  scope.deliver(byteCount);
 }
 
 template <typename T>
@@ -298,6 +611,8 @@ void writeColumn(fitsfile* fptr, const Fits::Column<T>& column) {
   const auto begin = column.data();
   const auto end = begin + column.elementCount();
   std::vector<std::decay_t<T>> nonconstData(begin, end); // We need a non-const data for CFitsIO
+  const long byteCount = column.elementCount() * sizeof(T);
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
   int status = 0;
   fits_write_col(
       fptr,
@@ -309,6 +624,7 @@ void writeColumn(fitsfile* fptr, const Fits::Column<T>& column) {
       nonconstData.data(),
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot write column data: " + column.info().name);
+  scope.deliver(byteCount);
 }
 
 /**
@@ -329,6 +645,8 @@ void writeColumnSegment(fitsfile* fptr, long firstRow, const Fits::Column<T>& co
   const auto begin = column.data();
   const auto end = begin + column.elementCount();
   std::vector<std::decay_t<T>> nonconstData(begin, end); // We need a non-const data for CFitsIO
+  const long byteCount = column.elementCount() * sizeof(T);
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
   int status = 0;
   fits_write_col(
       fptr,
@@ -340,14 +658,271 @@ void writeColumnSegment(fitsfile* fptr, long firstRow, const Fits::Column<T>& co
       nonconstData.data(),
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot write column data: " + column.info().name);
+  scope.deliver(byteCount);
+}
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief The maximum ratio between the size of the heap region which spans some rows and the size of their values,
+ * for the region to be read in a single access.
+ */
+constexpr long heapSpanRatio = 2;
+
+/**
+ * @brief Get the position of the heap of the current binary table HDU in the file, in bytes.
+ */
+long heapPosition(fitsfile* fptr);
+
+/**
+ * @brief Get the width in bytes of the elements of a variable-length array column, as stored in the heap.
+ * @param index The 1-based column index
+ * @throw CfitsioError if the column type cannot be read
+ * @throw FitsError if the elements are bits
+ */
+long vlaElementWidth(fitsfile* fptr, long index);
+
+/**
+ * @brief Read the heap region which spans given descriptors in a single access.
+ * @param front The heap address of the first byte read
+ * @return False if the region is too sparse, in which case nothing is read.
+ */
+bool readHeapSpan(
+    fitsfile* fptr,
+    const std::vector<LONGLONG>& lengths,
+    const std::vector<LONGLONG>& addresses,
+    long elementSize,
+    std::vector<unsigned char>& bytes,
+    LONGLONG& front);
+
+/**
+ * @brief Read the stored values of some rows of a variable-length array column and decode them natively.
+ * @return False if the values cannot be decoded natively, in which case CFitsIO should be used.
+ */
+template <typename TRaw, typename T>
+bool decodeVlaValues(
+    fitsfile* fptr,
+    const std::vector<LONGLONG>& lengths,
+    const std::vector<LONGLONG>& addresses,
+    const Fits::Scaling& scaling,
+    T* data,
+    std::true_type) {
+  const bool native = (std::is_same<TRaw, T>::value && scaling.isIdentity()) || scaling.isSignBitFlip<TRaw, T>() ||
+      std::is_floating_point<T>::value;
+  std::vector<unsigned char> bytes;
+  LONGLONG front = 0;
+  if (not native || not readHeapSpan(fptr, lengths, addresses, sizeof(TRaw), bytes, front)) {
+    return false;
+  }
+  for (std::size_t i = 0; i < lengths.size(); ++i) {
+    Fits::decodeScaledTo<TRaw>(bytes.data() + addresses[i] - front, lengths[i], scaling, data);
+    data += lengths[i];
+  }
+  return true;
+}
+
+/**
+ * @brief Non-arithmetic case (e.g. complex values): leave decoding to decodeComplexVlaValues() or CFitsIO.
+ */
+template <typename TRaw, typename T>
+bool decodeVlaValues(
+    fitsfile*,
+    const std::vector<LONGLONG>&,
+    const std::vector<LONGLONG>&,
+    const Fits::Scaling&,
+    T*,
+    std::false_type) {
+  return false;
+}
+
+/**
+ * @brief Read the stored values of some rows of a complex variable-length array column and decode them natively.
+ * @details
+ * The real and imaginary parts are decoded as consecutive values.
+ * @return False if the values cannot be decoded natively, in which case CFitsIO should be used.
+ */
+template <typename U>
+bool decodeComplexVlaValues(
+    fitsfile* fptr,
+    const std::vector<LONGLONG>& lengths,
+    const std::vector<LONGLONG>& addresses,
+    const Fits::Scaling& scaling,
+    std::complex<U>* data) {
+  std::vector<unsigned char> bytes;
+  LONGLONG front = 0;
+  if (not scaling.isIdentity() || not readHeapSpan(fptr, lengths, addresses, sizeof(std::complex<U>), bytes, front)) {
+    return false;
+  }
+  for (std::size_t i = 0; i < lengths.size(); ++i) {
+    auto* parts = reinterpret_cast<U*>(data);
+    Fits::decodeScaledTo<U>(bytes.data() + addresses[i] - front, 2 * lengths[i], scaling, parts);
+    data += lengths[i];
+  }
+  return true;
+}
+
+/**
+ * @brief Non-matching complex case: leave decoding to CFitsIO.
+ */
+template <typename U, typename T>
+bool decodeComplexVlaValues(
+    fitsfile*,
+    const std::vector<LONGLONG>&,
+    const std::vector<LONGLONG>&,
+    const Fits::Scaling&,
+    T*) {
+  return false;
+}
+
+/**
+ * @brief Read the values of some rows of a variable-length array column natively, if relevant.
+ * @return False if the values cannot be read natively, in which case CFitsIO should be used.
+ */
+template <typename T>
+bool readVlaValues(
+    fitsfile* fptr,
+    long index,
+    const std::vector<LONGLONG>& lengths,
+    const std::vector<LONGLONG>& addresses,
+    T* data) {
+  int status = 0;
+  int typecode = 0;
+  fits_get_coltype(fptr, static_cast<int>(index), &typecode, nullptr, nullptr, &status);
+  if (status != 0) {
+    return false;
+  }
+  const auto scaling = readColumnScaling(fptr, index);
+  const auto arithmetic = std::is_arithmetic<T>();
+  switch (std::abs(typecode)) { // Negative for variable-length arrays
+    case TBYTE:
+      return decodeVlaValues<unsigned char>(fptr, lengths, addresses, scaling, data, arithmetic);
+    case TSBYTE:
+      return decodeVlaValues<char>(fptr, lengths, addresses, scaling, data, arithmetic);
+    case TSHORT:
+      return decodeVlaValues<std::int16_t>(fptr, lengths, addresses, scaling, data, arithmetic);
+    case TLONG: // 'J' is 32-bit wide
+    case TINT:
+      return decodeVlaValues<std::int32_t>(fptr, lengths, addresses, scaling, data, arithmetic);
+    case TLONGLONG:
+      return decodeVlaValues<std::int64_t>(fptr, lengths, addresses, scaling, data, arithmetic);
+    case TFLOAT:
+      return decodeVlaValues<float>(fptr, lengths, addresses, scaling, data, arithmetic);
+    case TDOUBLE:
+      return decodeVlaValues<double>(fptr, lengths, addresses, scaling, data, arithmetic);
+    case TCOMPLEX:
+      return decodeComplexVlaValues<float>(fptr, lengths, addresses, scaling, data);
+    case TDBLCOMPLEX:
+      return decodeComplexVlaValues<double>(fptr, lengths, addresses, scaling, data);
+    default:
+      return false;
+  }
+}
+
+} // namespace Internal
+/// @endcond
+
+template <typename T>
+Fits::VlaColumn<T> readVlaColumnSegment(fitsfile* fptr, const Fits::Segment& rows, long index) {
+  const auto info = readColumnInfo<T>(fptr, index);
+  const long count = rows.size();
+  std::vector<LONGLONG> lengths(count);
+  std::vector<LONGLONG> addresses(count);
+  int status = 0;
+  if (count > 0) {
+    IoScope scope(fptr, IoCategory::Bintable);
+    fits_read_descriptsll(
+        fptr,
+        static_cast<int>(index),
+        rows.front,
+        count,
+        lengths.data(),
+        addresses.data(),
+        &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot read descriptors of column: #" + std::to_string(index - 1));
+  }
+  std::vector<long> offsets(count + 1, 0);
+  for (long i = 0; i < count; ++i) {
+    offsets[i + 1] = offsets[i] + lengths[i];
+  }
+  std::vector<T> values(offsets.back());
+  if (not values.empty() && not Internal::readVlaValues(fptr, index, lengths, addresses, values.data())) {
+    const long byteCount = values.size() * sizeof(T);
+    IoScope scope(fptr, IoCategory::Bintable, byteCount);
+    for (long i = 0; i < count; ++i) {
+      if (lengths[i] == 0) {
+        continue;
+      }
+      fits_read_col(
+          fptr,
+          TypeCode<T>::forBintable(),
+          static_cast<int>(index),
+          rows.front + i,
+          1,
+          lengths[i],
+          nullptr,
+          values.data() + offsets[i],
+          nullptr,
+          &status);
+    }
+    CfitsioError::mayThrow(status, fptr, "Cannot read column data: #" + std::to_string(index - 1));
+    scope.deliver(byteCount);
+  }
+  return Fits::VlaColumn<T>(info.name, info.unit, std::move(offsets), std::move(values));
+}
+
+template <typename T>
+void writeVlaColumnSegment(fitsfile* fptr, long firstRow, long index, const Fits::VlaColumn<T>& column) {
+  const long count = column.rowCount();
+  const long lastRow = firstRow + count - 1;
+  const long tableRowCount = rowCount(fptr);
+  const long byteCount = column.elementCount() * sizeof(T);
+  const LONGLONG width = Internal::vlaElementWidth(fptr, index); // Values are converted to the stored type
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
+  int status = 0;
+  if (lastRow > tableRowCount) {
+    fits_insert_rows(fptr, tableRowCount, lastRow - tableRowCount, &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot append rows to write column: " + column.name());
+  }
+  LONGLONG front = 0;
+  if (column.elementCount() > 0) {
+    std::vector<T> nonconstData(column.values()); // We need a non-const data for CFitsIO
+    fits_write_col( // Appended to the heap as a single array
+        fptr,
+        TypeCode<T>::forBintable(),
+        static_cast<int>(index),
+        firstRow,
+        1,
+        column.elementCount(),
+        nonconstData.data(),
+        &status);
+    LONGLONG length = 0;
+    fits_read_descriptll(fptr, static_cast<int>(index), firstRow, &length, &front, &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot write column data: " + column.name());
+  }
+  const auto& offsets = column.offsets();
+  for (long i = 0; i < count; ++i) {
+    fits_write_descript(
+        fptr,
+        static_cast<int>(index),
+        firstRow + i,
+        column.size(i),
+        front + offsets[i] * width,
+        &status);
+  }
+  CfitsioError::mayThrow(status, fptr, "Cannot write descriptors of column: " + column.name());
+  if (firstRow <= tableRowCount && count > 0) { // Reclaim the values of the overwritten rows
+    fits_compress_heap(fptr, &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot compress heap after writing column: " + column.name());
+  }
+  scope.deliver(byteCount);
 }
 
 template <typename... Ts>
 std::tuple<Fits::VecColumn<Ts>...> readColumns(fitsfile* fptr, const std::vector<long>& indices) {
   /* Read column metadata */
   const long rows = rowCount(fptr);
-  std::tuple<Fits::VecColumn<Ts>...> columns;
-  Internal::ColumnLooperImpl<sizeof...(Ts) - 1, Ts...>::readInfos(fptr, indices, columns, rows);
+  auto columns = Internal::readColumnInfos<Ts...>(fptr, indices, rows, std::index_sequence_for<Ts...>());
   /* Get the buffer size */
   int status = 0;
   long chunkRows = 0;
@@ -404,8 +979,11 @@ void insertColumn(fitsfile* fptr, long index, const Fits::Column<T>& column) {
   auto name = toCharPtr(column.info().name);
   auto tform = toCharPtr(TypeCode<T>::tform(column.info().repeatCount));
   // FIXME write unit
-  int status = 0;
-  fits_insert_col(fptr, static_cast<int>(index), name.get(), tform.get(), &status);
+  {
+    IoScope scope(fptr, IoCategory::Bintable);
+    int status = 0;
+    fits_insert_col(fptr, static_cast<int>(index), name.get(), tform.get(), &status);
+  }
   writeColumn(fptr, column);
 }
 
@@ -414,8 +992,11 @@ void insertColumns(fitsfile* fptr, long index, const Fits::Column<Ts>&... column
   auto names = CStrArray({ columns.info().name... });
   auto tforms = CStrArray({ TypeCode<Ts>::tform(columns.info().repeatCount)... });
   // FIXME write unit
-  int status = 0;
-  fits_insert_cols(fptr, static_cast<int>(index), sizeof...(Ts), names.data(), tforms.data(), &status);
+  {
+    IoScope scope(fptr, IoCategory::Bintable);
+    int status = 0;
+    fits_insert_cols(fptr, static_cast<int>(index), sizeof...(Ts), names.data(), tforms.data(), &status);
+  }
   writeColumns(fptr, columns...);
 }
 
@@ -30,10 +30,14 @@ namespace HduAccess {
 template <typename T, long n>
 void initImageExtension(fitsfile* fptr, const std::string& name, const Fits::Position<n>& shape) {
   mayThrowReadonlyError(fptr);
-  int status = 0;
-  auto nonconstShape = shape; // const-correctness issue
-  fits_create_img(fptr, TypeCode<T>::bitpix(), n, &nonconstShape[0], &status);
-  CfitsioError::mayThrow(status, fptr, "Cannot create image extension: " + name);
+  {
+    IoScope scope(fptr, IoCategory::Hdu);
+    int status = 0;
+    auto nonconstShape = shape; // const-correctness issue
+    fits_create_img(fptr, TypeCode<T>::bitpix(), n, &nonconstShape[0], &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot create image extension: " + name);
+    scope.relocate(fptr);
+  }
   updateName(fptr, name);
 }
 
@@ -49,9 +53,11 @@ void initBintableExtension(fitsfile* fptr, const std::string& name, const Fits::
   CStrArray colName { infos.name... };
   CStrArray colFormat { TypeCode<Ts>::tform(infos.repeatCount)... };
   CStrArray colUnit { infos.unit... };
+  IoScope scope(fptr, IoCategory::Hdu);
   int status = 0;
   fits_create_tbl(fptr, BINARY_TBL, 0, ncols, colName.data(), colFormat.data(), colUnit.data(), name.c_str(), &status);
   CfitsioError::mayThrow(status, fptr, "Cannot create binary table extension: " + name);
+  scope.relocate(fptr);
 }
 
 template <typename... Ts>
@@ -87,9 +93,13 @@ void assignBintableExtension(fitsfile* fptr, const std::string& name, const Fits
   char* cFormat = &colFormat[0];
   std::string colUnit = column.info().unit;
   char* cUnit = &colUnit[0];
-  int status = 0;
-  fits_create_tbl(fptr, BINARY_TBL, 0, columnCount, &cName, &cFormat, &cUnit, name.c_str(), &status);
-  CfitsioError::mayThrow(status, fptr, "Cannot create binary table extension: " + name);
+  {
+    IoScope scope(fptr, IoCategory::Hdu);
+    int status = 0;
+    fits_create_tbl(fptr, BINARY_TBL, 0, columnCount, &cName, &cFormat, &cUnit, name.c_str(), &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot create binary table extension: " + name);
+    scope.relocate(fptr);
+  }
   BintableIo::writeColumn(fptr, column);
 }
 
@@ -127,6 +127,7 @@ void updateRecordsImpl(fitsfile* fptr, const std::tuple<Fits::Record<Ts>...>& re
 
 template <typename T>
 Fits::Record<T> parseRecord(fitsfile* fptr, const std::string& keyword) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   /* Read value and comment */
   T value;
@@ -172,6 +173,7 @@ Fits::RecordVec<T> parseRecordVec(fitsfile* fptr, const std::vector<std::string>
 
 template <typename T>
 void writeRecord(fitsfile* fptr, const Fits::Record<T>& record) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   T nonconstValue = record.value;
   fits_write_key(
@@ -204,6 +206,7 @@ void writeRecords(fitsfile* fptr, const std::vector<Fits::Record<T>>& records) {
 
 template <typename T>
 void updateRecord(fitsfile* fptr, const Fits::Record<T>& record) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   std::string comment = record.rawComment();
   T value = record.value;
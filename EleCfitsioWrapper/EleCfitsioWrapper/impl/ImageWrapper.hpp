@@ -21,6 +21,9 @@
 
   #include "EleCfitsioWrapper/ImageWrapper.h"
 
+  #include <algorithm> // min, max
+  #include <vector>
+
 namespace Euclid {
 namespace Cfitsio {
 namespace ImageIo {
@@ -65,10 +68,150 @@ Fits::VecRaster<T, n> readRaster(fitsfile* fptr) {
   return raster;
 }
 
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief The maximum number of bytes read at once when decoding a data unit natively.
+ */
+constexpr long decodingChunkByteCount = 1 << 20;
+
+/**
+ * @brief Check whether a scaling from `TRaw` to `T` can be applied natively.
+ * @details
+ * Natively applied scalings are those which cannot overflow, namely unsigned offsets and scalings to floating points.
+ * Other scalings are left to CFitsIO, which checks for overflows element-wise.
+ */
+template <typename TRaw, typename T>
+bool isNativelyScalable(const Fits::Scaling& scaling) {
+  return scaling.isSignBitFlip<TRaw, T>() || std::is_floating_point<T>::value;
+}
+
+/**
+ * @brief Read the stored bytes of the current image HDU and decode them into a contiguous buffer.
+ * @return False if the native path failed, in which case CFitsIO should be used.
+ */
+template <typename TRaw, typename T>
+bool decodeRasterTo(fitsfile* fptr, const Fits::Scaling& scaling, long size, T* data) {
+  if (not isNativelyScalable<TRaw, T>(scaling)) {
+    return false;
+  }
+  int status = 0;
+  LONGLONG headStart = 0;
+  LONGLONG dataStart = 0;
+  LONGLONG dataEnd = 0;
+  fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &status);
+  ffmbyt(fptr, dataStart, REPORT_EOF, &status);
+  const long chunkSize = std::max(1L, decodingChunkByteCount / static_cast<long>(sizeof(TRaw)));
+  std::vector<unsigned char> bytes(std::min(size, chunkSize) * sizeof(TRaw));
+  for (long front = 0; front < size && status == 0; front += chunkSize) {
+    const long count = std::min(chunkSize, size - front);
+    ffgbyt(fptr, count * sizeof(TRaw), bytes.data(), &status); // Reads sequentially from dataStart
+    Fits::decodeScaledTo<TRaw>(bytes.data(), count, scaling, data + front);
+  }
+  return status == 0;
+}
+
+/**
+ * @brief Read and scale the whole raster of the current image HDU natively, if relevant.
+ * @return False if the raster is not scaled or cannot be decoded natively, in which case CFitsIO should be used.
+ */
+template <typename T>
+bool readScaledRasterTo(fitsfile* fptr, long size, T* data) {
+  const auto scaling = readScaling(fptr);
+  if (scaling.isIdentity()) {
+    return false;
+  }
+  int status = 0;
+  int bitpix = 0;
+  const int compressed = fits_is_compressed_image(fptr, &status);
+  fits_get_img_type(fptr, &bitpix, &status);
+  if (status != 0 || compressed) {
+    return false;
+  }
+  switch (bitpix) {
+    case BYTE_IMG:
+      return decodeRasterTo<unsigned char>(fptr, scaling, size, data);
+    case SHORT_IMG:
+      return decodeRasterTo<std::int16_t>(fptr, scaling, size, data);
+    case LONG_IMG:
+      return decodeRasterTo<std::int32_t>(fptr, scaling, size, data);
+    case LONGLONG_IMG:
+      return decodeRasterTo<std::int64_t>(fptr, scaling, size, data);
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Read a contiguous sequence of values of the current image HDU.
+ * @param first The 0-based index of the first value
+ */
+template <typename T>
+void readRasterValuesTo(fitsfile* fptr, long first, long count, T* data) {
+  int status = 0;
+  fits_read_img(fptr, TypeCode<T>::forImage(), first + 1, count, nullptr, data, nullptr, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read raster.");
+}
+
+/**
+ * @brief Read the whole raster of the current image HDU as `TRaw` values, and convert them to `T` chunk-wise.
+ * @details
+ * The values are read into a per-thread scratch buffer, which is reused across calls.
+ */
+template <typename TRaw, typename T>
+void convertRasterChunksTo(fitsfile* fptr, long size, T* data, Fits::OverflowPolicy policy) {
+  const long chunkSize = std::max(1L, decodingChunkByteCount / static_cast<long>(sizeof(TRaw)));
+  auto* buffer = Fits::Internal::scratch<TRaw>(std::min(size, chunkSize));
+  for (long front = 0; front < size; front += chunkSize) {
+    const long count = std::min(chunkSize, size - front);
+    readRasterValuesTo(fptr, front, count, buffer);
+    Fits::convertTo(buffer, count, data + front, policy);
+  }
+}
+
+  #define ELEFITS_CONVERT_RASTER_IF_MATCH(type, name) \
+    if (id == typeid(type)) { \
+      convertRasterChunksTo<type>(fptr, size, data, policy); \
+      return true; \
+    }
+
+/**
+ * @brief Read the whole raster of the current image HDU and convert it natively if `T` is not the stored type.
+ * @return False if no conversion is needed, in which case CFitsIO should be used.
+ */
+template <typename T>
+bool readConvertedRasterTo(fitsfile* fptr, long size, T* data, Fits::OverflowPolicy policy) {
+  const auto& id = readTypeid(fptr);
+  if (id == typeid(T)) {
+    return false;
+  }
+  if ((id == typeid(float) || id == typeid(double)) && not readScaling(fptr).isIdentity()) {
+    return false; // Let CFitsIO scale in double precision
+  }
+  ELEFITS_FOREACH_RASTER_TYPE(ELEFITS_CONVERT_RASTER_IF_MATCH)
+  return false;
+}
+
+  #undef ELEFITS_CONVERT_RASTER_IF_MATCH
+
+} // namespace Internal
+/// @endcond
+
 template <typename T, long n>
-void readRasterTo(fitsfile* fptr, Fits::Raster<T, n>& destination) {
+void readRasterTo(fitsfile* fptr, Fits::Raster<T, n>& destination, Fits::OverflowPolicy policy) {
   int status = 0;
   const auto size = destination.size();
+  const long byteCount = size * sizeof(T);
+  IoScope scope(fptr, IoCategory::Image, byteCount);
+  if (Internal::readScaledRasterTo(fptr, size, destination.data())) {
+    scope.deliver(byteCount);
+    return;
+  }
+  if (Internal::readConvertedRasterTo(fptr, size, destination.data(), policy)) {
+    scope.deliver(byteCount);
+    return;
+  }
   fits_read_img(
       fptr,
       TypeCode<T>::forImage(),
@@ -79,6 +222,23 @@ void readRasterTo(fitsfile* fptr, Fits::Raster<T, n>& destination) {
       nullptr,
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot read raster.");
+  scope.deliver(byteCount);
+}
+
+template <typename T, long n>
+void readRawRasterTo(fitsfile* fptr, Fits::Raster<T, n>& destination) {
+  const long byteCount = destination.size() * sizeof(T);
+  IoScope scope(fptr, IoCategory::Image, byteCount);
+  const auto scaling = readScaling(fptr);
+  int status = 0;
+  fits_set_bscale(fptr, 1., 0., &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot disable scaling.");
+  fits_read_img(fptr, TypeCode<T>::forImage(), 1, destination.size(), nullptr, destination.data(), nullptr, &status);
+  int restoreStatus = 0;
+  fits_set_bscale(fptr, scaling.scale, scaling.offset, &restoreStatus); // Restore even if reading failed
+  CfitsioError::mayThrow(status, fptr, "Cannot read raw raster.");
+  CfitsioError::mayThrow(restoreStatus, fptr, "Cannot restore scaling.");
+  scope.deliver(byteCount);
 }
 
 template <typename T, long n>
@@ -96,11 +256,26 @@ Fits::VecRaster<T, m> readRegion(fitsfile* fptr, const Fits::Region<n>& region)
 
 template <typename T, long m, long n>
 void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Raster<T, m>& raster) {
+  Fits::Position<n> step = region.front; // Same dimension
+  for (auto& s : step) {
+    s = 1;
+  }
+  readDecimatedTo(fptr, region, step, raster);
+}
+
+template <typename T, long m, long n>
+void readDecimatedTo(
+    fitsfile* fptr,
+    const Fits::Region<n>& region,
+    const Fits::Position<n>& step,
+    Fits::Raster<T, m>& raster) {
+  const long byteCount = raster.size() * sizeof(T);
+  IoScope scope(fptr, IoCategory::Image, byteCount);
   int status = 0;
   const std::size_t dim = region.dimension();
   Fits::Position<n> front = region.front; // Copy for const-correctness
   Fits::Position<n> back = region.back; // idem
-  std::vector<long> step(dim, 1);
+  Fits::Position<n> inc = step; // idem
   for (std::size_t i = 0; i < dim; ++i) {
     front[i]++; // CFitsIO is 1-based
     back[i]++; // idem
@@ -110,12 +285,13 @@ void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Raster<T,
       TypeCode<T>::forImage(),
       front.data(),
       back.data(),
-      step.data(),
+      inc.data(),
       nullptr,
       raster.data(),
       nullptr,
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot read image region.");
+  scope.deliver(byteCount);
 }
 
 template <typename T, long m, long n>
@@ -138,7 +314,9 @@ void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Subraster
 
   /* Process each line */
   int status = 0;
+  const long lineByteCount = region.shape()[0] * sizeof(T);
   for (long i = 0; i < srcCount; ++i) {
+    IoScope scope(fptr, IoCategory::Image, lineByteCount);
     fits_read_subset(
         fptr,
         TypeCode<T>::forImage(),
@@ -150,6 +328,7 @@ void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Subraster
         nullptr,
         &status);
     CfitsioError::mayThrow(status, fptr, "Cannot read image region.");
+    scope.deliver(lineByteCount);
     srcScreener.next();
     srcFront = srcScreener.current();
     srcBack = srcScreener.followers()[0];
@@ -160,16 +339,21 @@ void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Subraster
 template <typename T, long n>
 void writeRaster(fitsfile* fptr, const Fits::Raster<T, n>& raster) {
   mayThrowReadonlyError(fptr);
+  const long byteCount = raster.size() * sizeof(T);
+  IoScope scope(fptr, IoCategory::Image, byteCount);
   int status = 0;
   const auto begin = raster.data();
   const auto end = begin + raster.size();
   std::vector<std::decay_t<T>> nonconstData(begin, end); // For const-correctness issue
   fits_write_img(fptr, TypeCode<T>::forImage(), 1, raster.size(), nonconstData.data(), &status);
   CfitsioError::mayThrow(status, fptr, "Cannot write image.");
+  scope.deliver(byteCount);
 }
 
 template <typename T, long m, long n>
 void writeRegion(fitsfile* fptr, const Fits::Raster<T, m>& raster, const Fits::Position<n>& destination) {
+  const long byteCount = raster.size() * sizeof(T);
+  IoScope scope(fptr, IoCategory::Image, byteCount);
   int status = 0;
   auto front = destination + 1;
   const auto shape = raster.shape().extend(destination);
@@ -179,6 +363,7 @@ void writeRegion(fitsfile* fptr, const Fits::Raster<T, m>& raster, const Fits::P
   std::vector<std::decay_t<T>> nonconstData(begin, end); // For const-correctness issue
   fits_write_subset(fptr, TypeCode<T>::forImage(), front.data(), back.data(), nonconstData.data(), &status);
   CfitsioError::mayThrow(status, fptr, "Cannot write image region.");
+  scope.deliver(byteCount);
 }
 
 template <typename T, long m, long n>
@@ -198,7 +383,9 @@ void writeRegion(fitsfile* fptr, const Fits::Subraster<T, m>& subraster, const F
   Fits::Position<n> dstBack;
   Fits::Position<n> srcFront;
   std::vector<std::decay_t<T>> line(dstSize);
+  const long lineByteCount = dstSize * sizeof(T);
   for (auto dstFront : dstRegion) {
+    IoScope scope(fptr, IoCategory::Image, lineByteCount);
     dstBack = dstFront;
     dstBack[0] += dstSize - 1;
     srcFront = dstFront + delta;
@@ -206,6 +393,7 @@ void writeRegion(fitsfile* fptr, const Fits::Subraster<T, m>& subraster, const F
     fits_write_pix(fptr, TypeCode<T>::forImage(), dstFront.data(), dstSize, line.data(), &status);
     // fits_write_subset(fptr, TypeCode<T>::forImage(), dstFront.data(), dstBack.data(), line.data(), &status);
     CfitsioError::mayThrow(status, fptr, "Cannot write image region.");
+    scope.deliver(lineByteCount);
   }
 }
 
@@ -137,6 +137,11 @@ DEF_TABLE_TFORM(std::uint64_t, 'W')
     #undef DEF_TABLE_TFORM
   #endif
 
+template <typename T>
+inline std::string TypeCode<T>::vlaTform(bool largeHeap) {
+  return (largeHeap ? "1Q" : "1P") + tform(1).substr(1);
+}
+
   /*
  * From CFitsIO documentation "Primary Array or Image Extension I/O Routines"
  * https://heasarc.gsfc.nasa.gov/docs/software/fitsio/c/c_user/node40.html
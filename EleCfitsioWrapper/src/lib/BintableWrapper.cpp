@@ -23,6 +23,8 @@
 #include "EleCfitsioWrapper/HeaderWrapper.h"
 
 #include <algorithm>
+#include <cstdlib> // abs
+#include <limits>
 
 namespace Euclid {
 namespace Cfitsio {
@@ -44,6 +46,24 @@ long rowCount(fitsfile* fptr) {
   return nrows;
 }
 
+void appendRows(fitsfile* fptr, long count) {
+  IoScope scope(fptr, IoCategory::Bintable);
+  int status = 0;
+  fits_insert_rows(fptr, rowCount(fptr), count, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot append rows");
+}
+
+void truncateRows(fitsfile* fptr, long rowCount) {
+  const long count = BintableIo::rowCount(fptr) - rowCount;
+  if (count <= 0) {
+    return;
+  }
+  IoScope scope(fptr, IoCategory::Bintable);
+  int status = 0;
+  fits_delete_rows(fptr, rowCount + 1, count, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot delete rows");
+}
+
 bool hasColumn(fitsfile* fptr, const std::string& name) {
   int index = 0;
   int status = 0;
@@ -88,15 +108,106 @@ long columnIndex(fitsfile* fptr, const std::string& name) {
   return index;
 }
 
+Fits::Scaling readColumnScaling(fitsfile* fptr, long index) {
+  auto scaling = Fits::Scaling::identity();
+  int status = 0;
+  fits_get_bcolparms(
+      fptr,
+      index,
+      nullptr, // name
+      nullptr, // unit
+      nullptr, // typechar
+      nullptr, // repeatCount
+      &scaling.scale,
+      &scaling.offset,
+      nullptr, // nulval
+      nullptr, // tdisp
+      &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read column scaling: #" + std::to_string(index - 1));
+  return scaling;
+}
+
 namespace Internal {
 
-template <> // TODO clean
-void readColumnInfoImpl<std::string>(
+long heapPosition(fitsfile* fptr) {
+  int status = 0;
+  LONGLONG headStart = 0;
+  LONGLONG dataStart = 0;
+  LONGLONG dataEnd = 0;
+  fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &status);
+  LONGLONG theap = 0;
+  fits_read_key(fptr, TLONGLONG, "THEAP", &theap, nullptr, &status);
+  if (status == KEY_NO_EXIST) { // The heap follows the table
+    status = 0;
+    LONGLONG rowWidth = 0;
+    fits_read_key(fptr, TLONGLONG, "NAXIS1", &rowWidth, nullptr, &status);
+    theap = rowWidth * rowCount(fptr);
+  }
+  CfitsioError::mayThrow(status, fptr, "Cannot locate the heap");
+  return dataStart + theap;
+}
+
+long vlaElementWidth(fitsfile* fptr, long index) {
+  int status = 0;
+  int typecode = 0;
+  fits_get_coltype(fptr, static_cast<int>(index), &typecode, nullptr, nullptr, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read type of column: #" + std::to_string(index - 1));
+  switch (std::abs(typecode)) { // Negative for variable-length arrays
+    case TLOGICAL:
+    case TBYTE:
+    case TSBYTE:
+    case TSTRING:
+      return 1;
+    case TSHORT:
+      return 2;
+    case TLONG: // 'J' is 32-bit wide
+    case TINT:
+    case TFLOAT:
+      return 4;
+    case TLONGLONG:
+    case TDOUBLE:
+    case TCOMPLEX:
+      return 8;
+    case TDBLCOMPLEX:
+      return 16;
+    default:
+      throw Fits::FitsError("Unsupported variable-length array type for column: #" + std::to_string(index - 1));
+  }
+}
+
+bool readHeapSpan(
     fitsfile* fptr,
-    long index,
-    Fits::VecColumn<std::string>& column,
-    long rowCount) {
-  column = Fits::VecColumn<std::string>(readColumnInfo<std::string>(fptr, index), std::vector<std::string>(rowCount));
+    const std::vector<LONGLONG>& lengths,
+    const std::vector<LONGLONG>& addresses,
+    long elementSize,
+    std::vector<unsigned char>& bytes,
+    LONGLONG& front) {
+  front = std::numeric_limits<LONGLONG>::max();
+  LONGLONG back = 0;
+  LONGLONG size = 0;
+  for (std::size_t i = 0; i < lengths.size(); ++i) {
+    if (lengths[i] > 0) {
+      front = std::min(front, addresses[i]);
+      back = std::max(back, addresses[i] + lengths[i] * elementSize);
+      size += lengths[i] * elementSize;
+    }
+  }
+  if (size == 0) {
+    bytes.clear();
+    front = 0;
+    return true;
+  }
+  if (back - front > heapSpanRatio * size) {
+    return false;
+  }
+  bytes.resize(back - front);
+  IoScope scope(fptr, IoCategory::Bintable, back - front);
+  int status = 0;
+  ffmbyt(fptr, heapPosition(fptr) + front, REPORT_EOF, &status);
+  ffgbyt(fptr, back - front, bytes.data(), &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read heap");
+  scope.deliver(back - front);
+  return true;
 }
 
 template <> // TODO clean
@@ -106,6 +217,7 @@ void readColumnChunkImpl<std::string>(
     Fits::VecColumn<std::string>& column,
     long firstRow,
     long rowCount) {
+  IoScope scope(fptr, IoCategory::Bintable);
   int status = 0;
   long repeatCount = 0;
   fits_get_coltype(
@@ -132,6 +244,7 @@ void readColumnChunkImpl<std::string>(
       nullptr,
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot read column chunk: #" + std::to_string(index - 1));
+  scope.deliver(rowCount * repeatCount);
   auto columnIt = column.data() + firstRow - 1;
   for (auto dataIt = data.begin(); dataIt != data.end(); ++dataIt, ++columnIt) {
     *columnIt = std::string(*dataIt);
@@ -146,6 +259,8 @@ void writeColumnChunkImpl<std::string>(
     const Fits::Column<std::string>& column,
     long firstRow,
     long rowCount) {
+  const long byteCount = rowCount * column.info().repeatCount;
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
   int status = 0;
   auto begin = column.data() + (firstRow - 1);
   long size = rowCount;
@@ -165,6 +280,7 @@ void writeColumnChunkImpl<std::string>(
       fptr,
       "Cannot write column chunk: " + column.info().name + " (" + std::to_string(index - 1) + "); " + "rows: [" +
           std::to_string(firstRow - 1) + "-" + std::to_string(firstRow - 1 + rowCount - 1) + "]");
+  scope.deliver(byteCount);
 }
 
 } // namespace Internal
@@ -174,7 +290,10 @@ void readColumnSegment<std::string>(
     fitsfile* fptr,
     const Fits::Segment& rows,
     long index,
-    Fits::Column<std::string>& column) {
+    Fits::Column<std::string>& column,
+    ELEMENTS_UNUSED Fits::OverflowPolicy policy) {
+  const long byteCount = rows.size() * column.info().repeatCount;
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
   std::vector<char*> data(rows.size());
   std::generate(data.begin(), data.end(), [&]() {
     return (char*)malloc(column.info().repeatCount);
@@ -192,6 +311,7 @@ void readColumnSegment<std::string>(
       nullptr, // anynul
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot read string column #" + std::to_string(index));
+  scope.deliver(byteCount);
   auto columnIt = column.data();
   for (auto dataIt = data.begin(); dataIt != data.end(); ++dataIt, ++columnIt) {
     *columnIt = std::string(*dataIt);
@@ -205,6 +325,8 @@ void writeColumn<std::string>(fitsfile* fptr, const Fits::Column<std::string>& c
   const auto end = begin + column.elementCount();
   CStrArray array(begin, end);
   long index = columnIndex(fptr, column.info().name);
+  const long byteCount = column.elementCount() * column.info().repeatCount;
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
   int status = 0;
   fits_write_col(
       fptr,
@@ -216,6 +338,7 @@ void writeColumn<std::string>(fitsfile* fptr, const Fits::Column<std::string>& c
       array.data(),
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot write column: " + column.info().name);
+  scope.deliver(byteCount);
 }
 
 template <>
@@ -226,6 +349,8 @@ void writeColumnSegment<std::string>(fitsfile* fptr, long firstRow, const Fits::
   CStrArray array(begin, end);
   // CStrArray is the only deviation from the generic case;
   // could we avoid specializing?
+  const long byteCount = column.elementCount() * column.info().repeatCount;
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
   int status = 0;
   fits_write_col(
       fptr,
@@ -237,6 +362,7 @@ void writeColumnSegment<std::string>(fitsfile* fptr, long firstRow, const Fits::
       array.data(),
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot write string column dat: " + column.info().name);
+  scope.deliver(byteCount);
 }
 
 template <>
@@ -247,6 +373,8 @@ void writeColumnSegment<const std::string>(fitsfile* fptr, long firstRow, const
   CStrArray array(begin, end);
   // CStrArray is the only deviation from the generic case;
   // could we avoid specializing?
+  const long byteCount = column.elementCount() * column.info().repeatCount;
+  IoScope scope(fptr, IoCategory::Bintable, byteCount);
   int status = 0;
   fits_write_col(
       fptr,
@@ -258,6 +386,7 @@ void writeColumnSegment<const std::string>(fitsfile* fptr, long firstRow, const
       array.data(),
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot write string column dat: " + column.info().name);
+  scope.deliver(byteCount);
 }
 
 } // namespace BintableIo
@@ -21,6 +21,9 @@
 
 #include "EleCfitsioWrapper/ErrorWrapper.h"
 #include "EleCfitsioWrapper/HduWrapper.h"
+#include "EleCfitsioWrapper/IoStats.h"
+
+#include <cstdlib> // realloc
 
 namespace Euclid {
 namespace Cfitsio {
@@ -32,14 +35,19 @@ fitsfile* createAndOpen(const std::string& filename, CreatePolicy policy) {
     cfitsioName.insert(0, 1, '!'); // CFitsIO convention
   }
   fitsfile* fptr;
-  int status = 0;
-  fits_create_file(&fptr, cfitsioName.c_str(), &status);
-  CfitsioError::mayThrow(status, fptr, "Cannot create file: " + filename);
+  {
+    IoScope scope(filename, IoCategory::File);
+    int status = 0;
+    fits_create_file(&fptr, cfitsioName.c_str(), &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot create file: " + filename);
+    scope.relocate(fptr);
+  }
   HduAccess::initPrimary(fptr);
   return fptr;
 }
 
 fitsfile* open(const std::string& filename, OpenPolicy policy) {
+  IoScope scope(filename, IoCategory::File);
   fitsfile* fptr;
   int status = 0;
   int permission = READONLY;
@@ -48,13 +56,68 @@ fitsfile* open(const std::string& filename, OpenPolicy policy) {
   }
   fits_open_file(&fptr, filename.c_str(), permission, &status);
   CfitsioError::mayThrow(status, fptr, "Cannot open file: " + filename);
+  scope.relocate(fptr);
   return fptr;
 }
 
+fitsfile* createAndOpen(void** buffer, std::size_t* size) {
+  fitsfile* fptr;
+  {
+    IoScope scope("mem://", IoCategory::File);
+    int status = 0;
+    fits_create_memfile(&fptr, buffer, size, 2880, std::realloc, &status); // Grow by at least one block
+    CfitsioError::mayThrow(status, fptr, "Cannot create file in memory");
+    scope.relocate(fptr);
+  }
+  HduAccess::initPrimary(fptr);
+  return fptr;
+}
+
+fitsfile* open(void** buffer, std::size_t* size, OpenPolicy policy) {
+  IoScope scope("mem://", IoCategory::File);
+  fitsfile* fptr;
+  int status = 0;
+  if (policy == OpenPolicy::ReadWrite) {
+    fits_open_memfile(&fptr, "mem://", READWRITE, buffer, size, 2880, std::realloc, &status);
+  } else {
+    fits_open_memfile(&fptr, "mem://", READONLY, buffer, size, 0, nullptr, &status);
+  }
+  CfitsioError::mayThrow(status, fptr, "Cannot open file in memory");
+  scope.relocate(fptr);
+  return fptr;
+}
+
+std::size_t byteCount(fitsfile* fptr) {
+  IoScope scope(fptr, IoCategory::File);
+  int status = 0;
+  int count = 0;
+  int current = 0;
+  int type = 0;
+  LONGLONG headStart = 0;
+  LONGLONG dataStart = 0;
+  LONGLONG dataEnd = 0;
+  fits_flush_buffer(fptr, 0, &status);
+  fits_get_num_hdus(fptr, &count, &status);
+  fits_get_hdu_num(fptr, &current);
+  fits_movabs_hdu(fptr, count, &type, &status);
+  fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &status);
+  fits_movabs_hdu(fptr, current, &type, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot compute file size");
+  return dataEnd;
+}
+
+void flush(fitsfile* fptr) {
+  IoScope scope(fptr, IoCategory::File);
+  int status = 0;
+  fits_flush_buffer(fptr, 0, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot flush file");
+}
+
 void close(fitsfile*& fptr) {
   if (not fptr) {
     return;
   }
+  IoScope scope(fptr, IoCategory::File); // Reads the file name before closing
   int status = 0;
   fits_close_file(fptr, &status);
   CfitsioError::mayThrow(status, fptr, "Cannot close file");
@@ -66,6 +129,7 @@ void closeAndDelete(fitsfile*& fptr) {
     return;
   }
   mayThrowReadonlyError(fptr);
+  IoScope scope(fptr, IoCategory::File);
   int status = 0;
   fits_delete_file(fptr, &status);
   CfitsioError::mayThrow(status, fptr, "Cannot close and delete file");
@@ -87,6 +151,14 @@ bool isWritable(fitsfile* fptr) {
   return filemode == READWRITE;
 }
 
+bool isInMemory(fitsfile* fptr) {
+  int status = 0;
+  char urltype[FLEN_FILENAME];
+  fits_url_type(fptr, urltype, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read file driver");
+  return std::string(urltype).compare(0, 3, "mem") == 0; // "mem://" or "memkeep://"
+}
+
 } // namespace FileAccess
 } // namespace Cfitsio
 } // namespace Euclid
@@ -21,12 +21,14 @@
 
 #include "EleCfitsioWrapper/ErrorWrapper.h"
 #include "EleCfitsioWrapper/HeaderWrapper.h"
+#include "EleCfitsioWrapper/IoStats.h"
 
 namespace Euclid {
 namespace Cfitsio {
 namespace HduAccess {
 
 long count(fitsfile* fptr) {
+  IoScope scope(fptr, IoCategory::Hdu);
   int count = 0;
   int status = 0;
   fits_get_num_hdus(fptr, &count, &status);
@@ -78,10 +80,12 @@ bool gotoIndex(fitsfile* fptr, long index) {
   if (index == currentIndex(fptr)) {
     return false;
   }
+  IoScope scope(fptr, IoCategory::Hdu);
   int type = 0;
   int status = 0;
   fits_movabs_hdu(fptr, static_cast<int>(index), &type, &status); // HDU indices are int
   CfitsioError::mayThrow(status, fptr, "Cannot access HDU: #" + std::to_string(index - 1));
+  scope.move(fptr);
   return true;
 }
 
@@ -98,8 +102,13 @@ bool gotoName(fitsfile* fptr, const std::string& name, long version, Fits::HduCa
   } else if (category != Fits::HduCategory::Any) {
     throw Fits::FitsError("Invalid HduCategory; Only Any, Image and Bintable are supported.");
   }
+  IoScope scope(fptr, IoCategory::Hdu);
+  const auto previous = currentIndex(fptr);
   fits_movnam_hdu(fptr, hdutype, toCharPtr(name).get(), version, &status);
   CfitsioError::mayThrow(status, fptr, "Cannot move to HDU: " + name);
+  if (currentIndex(fptr) != previous) {
+    scope.move(fptr);
+  }
   return true;
 }
 
@@ -107,10 +116,12 @@ bool gotoNext(fitsfile* fptr, long step) {
   if (step == 0) {
     return false;
   }
+  IoScope scope(fptr, IoCategory::Hdu);
   int status = 0;
   int type = 0;
   fits_movrel_hdu(fptr, static_cast<int>(step), &type, &status); // HDU indices are int
   CfitsioError::mayThrow(status, fptr, "Cannot move to next HDU (step " + std::to_string(step) + ")");
+  scope.move(fptr);
   return true;
 }
 
@@ -148,6 +159,7 @@ void createMetadataExtension(fitsfile* fptr, const std::string& name) {
 
 void deleteHdu(fitsfile* fptr, long index) {
   gotoIndex(fptr, index);
+  IoScope scope(fptr, IoCategory::Hdu);
   int status = 0;
   fits_delete_hdu(fptr, nullptr, &status);
   CfitsioError::mayThrow(status, fptr, "Cannot delete HDU: " + std::to_string(index - 1));
@@ -28,6 +28,7 @@ namespace Cfitsio {
 namespace HeaderIo {
 
 std::string readHeader(fitsfile* fptr, bool incNonValued) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   char* header = nullptr;
   int recordCount = 0;
@@ -42,10 +43,12 @@ std::string readHeader(fitsfile* fptr, bool incNonValued) {
   std::string headerString { header };
   fits_free_memory(header, &status);
   CfitsioError::mayThrow(status, fptr, "Cannot read the complete header");
+  scope.scan(recordCount);
   return headerString;
 }
 
 std::vector<std::string> listKeywords(fitsfile* fptr, Fits::KeywordCategory categories) {
+  IoScope scope(fptr, IoCategory::Header);
   int count = 0;
   int status = 0;
   fits_get_hdrspace(fptr, &count, nullptr, &status);
@@ -58,10 +61,12 @@ std::vector<std::string> listKeywords(fitsfile* fptr, Fits::KeywordCategory cate
       keywords.emplace_back(keyword);
     }
   }
+  scope.scan(count);
   return keywords;
 }
 
 std::map<std::string, std::string> listKeywordsValues(fitsfile* fptr, Fits::KeywordCategory categories) {
+  IoScope scope(fptr, IoCategory::Header);
   int count = 0;
   int status = 0;
   fits_get_hdrspace(fptr, &count, nullptr, &status);
@@ -74,10 +79,12 @@ std::map<std::string, std::string> listKeywordsValues(fitsfile* fptr, Fits::Keyw
       records[keyword] = value;
     }
   }
+  scope.scan(count);
   return records;
 }
 
 bool hasKeyword(fitsfile* fptr, const std::string& keyword) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   int length = 0;
   fits_get_key_strlen(fptr, keyword.c_str(), &length, &status);
@@ -90,6 +97,7 @@ bool hasKeyword(fitsfile* fptr, const std::string& keyword) {
 
 template <>
 Fits::Record<bool> parseRecord<bool>(fitsfile* fptr, const std::string& keyword) { // TODO rm duplication
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   /* Read value and comment */
   int nonconstIntValue; // TLOGICAL is for int in CFitsIO
@@ -117,6 +125,7 @@ Fits::Record<bool> parseRecord<bool>(fitsfile* fptr, const std::string& keyword)
 template <>
 Fits::Record<std::string> parseRecord<std::string>(fitsfile* fptr, const std::string& keyword) {
   // TODO rm duplication
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   int length = 0;
   fits_get_key_strlen(fptr, keyword.c_str(), &length, &status);
@@ -165,6 +174,7 @@ Fits::Record<Fits::VariantValue> parseRecord<Fits::VariantValue>(fitsfile* fptr,
 
 template <>
 void writeRecord<bool>(fitsfile* fptr, const Fits::Record<bool>& record) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   int nonconstIntValue = record.value; // TLOGICAL is for int in CFitsIO
   fits_write_key(
@@ -179,6 +189,7 @@ void writeRecord<bool>(fitsfile* fptr, const Fits::Record<bool>& record) {
 
 template <>
 void writeRecord<std::string>(fitsfile* fptr, const Fits::Record<std::string>& record) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   if (record.hasLongStringValue()) { // https://heasarc.gsfc.nasa.gov/docs/software/fitsio/c/c_user/node118.html
     fits_write_key_longwarn(fptr, &status);
@@ -212,6 +223,7 @@ void writeRecord<Fits::VariantValue>(fitsfile* fptr, const Fits::Record<Fits::Va
 
 template <>
 void updateRecord<bool>(fitsfile* fptr, const Fits::Record<bool>& record) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   std::string comment = record.rawComment();
   int nonconstIntValue = record.value; // TLOGICAL is for int in CFitsIO
@@ -228,6 +240,7 @@ void updateRecord<std::string>(fitsfile* fptr, const Fits::Record<std::string>&
     writeRecord(fptr, record);
     // Keyword ordering is changed after deletion, but there is no better (simple) option
   } else {
+    IoScope scope(fptr, IoCategory::Header);
     int status = 0;
     std::string comment = record.rawComment();
     fits_update_key(
@@ -265,6 +278,7 @@ void updateRecord<Fits::VariantValue>(fitsfile* fptr, const Fits::Record<Fits::V
 }
 
 void deleteRecord(fitsfile* fptr, const std::string& keyword) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   fits_delete_key(fptr, keyword.c_str(), &status);
   CfitsioError::mayThrow(status, fptr, "Cannot delete record: " + keyword);
@@ -364,6 +378,7 @@ const std::type_info& complexRecordTypeidImpl(const std::string& value) {
  * @see https://heasarc.gsfc.nasa.gov/docs/software/fitsio/c/c_user/node52.html
  */
 const std::type_info& recordTypeid(fitsfile* fptr, const std::string& keyword) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   char value[FLEN_VALUE];
   auto nonconstKeyword = keyword;
@@ -390,6 +405,7 @@ const std::type_info& recordTypeid(fitsfile* fptr, const std::string& keyword) {
 }
 
 void writeComment(fitsfile* fptr, const std::string& comment) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   std::string nonconstComment = comment;
   fits_write_comment(fptr, &nonconstComment[0], &status);
@@ -397,6 +413,7 @@ void writeComment(fitsfile* fptr, const std::string& comment) {
 }
 
 void writeHistory(fitsfile* fptr, const std::string& history) {
+  IoScope scope(fptr, IoCategory::Header);
   int status = 0;
   std::string nonconstHistory = history;
   fits_write_history(fptr, &nonconstHistory[0], &status);
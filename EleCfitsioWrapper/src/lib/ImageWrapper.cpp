@@ -39,6 +39,39 @@ const std::type_info& readTypeid(fitsfile* fptr) {
   throw Fits::FitsError("Unknown BITPIX: " + std::to_string(bitpix));
 }
 
+/**
+ * @brief Read the scaling from the `BSCALE` and `BZERO` keywords, which costs two header searches.
+ */
+Fits::Scaling readScalingKeywords(fitsfile* fptr) {
+  auto scaling = Fits::Scaling::identity();
+  int status = 0;
+  fits_read_key(fptr, TDOUBLE, "BSCALE", &scaling.scale, nullptr, &status);
+  if (status == KEY_NO_EXIST) {
+    status = 0;
+  }
+  fits_read_key(fptr, TDOUBLE, "BZERO", &scaling.offset, nullptr, &status);
+  if (status == KEY_NO_EXIST) {
+    status = 0;
+  }
+  CfitsioError::mayThrow(status, fptr, "Cannot read image scaling");
+  return scaling;
+}
+
+Fits::Scaling readScaling(fitsfile* fptr) {
+  int status = 0;
+  LONGLONG headStart = 0;
+  LONGLONG dataStart = 0;
+  LONGLONG dataEnd = 0;
+  fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &status); // Loads or reparses the HDU if needed
+  const int compressed = fits_is_compressed_image(fptr, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read image scaling");
+  const auto* image = fptr->Fptr->tableptr; // CFitsIO models images as a single column
+  if (compressed || not image) {
+    return readScalingKeywords(fptr);
+  }
+  return { image->tscale, image->tzero };
+}
+
 template <>
 Fits::Position<-1> readShape<-1>(fitsfile* fptr) {
   int status = 0;
@@ -0,0 +1,228 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleCfitsioWrapper/IoStats.h"
+
+#include <fstream>
+#include <mutex>
+#include <numeric> // accumulate
+
+namespace Euclid {
+namespace Cfitsio {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief The counters of all files, and the mutex which protects them.
+ */
+struct IoRegistry {
+  std::mutex mutex;
+  std::map<std::string, IoFileStats> files;
+};
+
+/**
+ * @brief Get the registry singleton.
+ */
+IoRegistry& ioRegistry() {
+  static IoRegistry registry;
+  return registry;
+}
+
+/**
+ * @brief Write a string as a JSON string.
+ */
+void writeJsonString(std::ostream& out, const std::string& value) {
+  out << '"';
+  for (auto c : value) {
+    if (c == '"' || c == '\\') {
+      out << '\\';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
+} // namespace Internal
+/// @endcond
+
+std::string ioCategoryName(IoCategory category) {
+  static const std::array<std::string, ioCategoryCount> names { "file", "hdu", "header", "image", "bintable" };
+  return names[static_cast<std::size_t>(category)];
+}
+
+long IoCounters::callCount(IoCategory category) const {
+  return calls[static_cast<std::size_t>(category)];
+}
+
+long IoCounters::callCount() const {
+  return std::accumulate(calls.begin(), calls.end(), 0L);
+}
+
+IoCounters& IoCounters::operator+=(const IoCounters& rhs) {
+  for (std::size_t i = 0; i < ioCategoryCount; ++i) {
+    calls[i] += rhs.calls[i];
+  }
+  requestedBytes += rhs.requestedBytes;
+  deliveredBytes += rhs.deliveredBytes;
+  hduMoves += rhs.hduMoves;
+  cardScans += rhs.cardScans;
+  elapsed += rhs.elapsed;
+  return *this;
+}
+
+void IoCounters::writeJson(std::ostream& out) const {
+  out << "{ \"calls\": {";
+  for (std::size_t i = 0; i < ioCategoryCount; ++i) {
+    out << (i == 0 ? " \"" : ", \"") << ioCategoryName(static_cast<IoCategory>(i)) << "\": " << calls[i];
+  }
+  out << " }, \"requested_bytes\": " << requestedBytes << ", \"delivered_bytes\": " << deliveredBytes
+      << ", \"hdu_moves\": " << hduMoves << ", \"card_scans\": " << cardScans << ", \"elapsed_us\": " << elapsed
+      << " }";
+}
+
+void IoFileStats::writeJson(std::ostream& out) const {
+  out << "{\n      \"total\": ";
+  total.writeJson(out);
+  out << ",\n      \"hdus\": [";
+  bool first = true;
+  for (const auto& hdu : hdus) {
+    out << (first ? "\n" : ",\n") << "        { \"index\": " << hdu.first << ", \"counters\": ";
+    hdu.second.writeJson(out);
+    out << " }";
+    first = false;
+  }
+  out << "\n      ]\n    }";
+}
+
+std::atomic<bool> IoStats::s_enabled(false);
+
+void IoStats::enable() {
+  s_enabled = true;
+}
+
+void IoStats::disable() {
+  s_enabled = false;
+}
+
+void IoStats::reset() {
+  auto& registry = Internal::ioRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.files.clear();
+}
+
+IoFileStats IoStats::read(const std::string& filename) {
+  auto& registry = Internal::ioRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const auto it = registry.files.find(filename);
+  if (it == registry.files.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+std::map<std::string, IoFileStats> IoStats::readAll() {
+  auto& registry = Internal::ioRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.files;
+}
+
+void IoStats::record(const std::string& filename, long hduIndex, IoCategory category, const IoCounters& counters) {
+  IoCounters call = counters;
+  call.calls = {};
+  call.calls[static_cast<std::size_t>(category)] = 1;
+  auto& registry = Internal::ioRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto& file = registry.files[filename];
+  file.total += call;
+  file.hdus[hduIndex] += call;
+}
+
+void IoStats::writeJson(std::ostream& out) {
+  const auto files = readAll();
+  out << "{\n  \"files\": [";
+  bool first = true;
+  for (const auto& file : files) {
+    out << (first ? "\n" : ",\n") << "    { \"filename\": ";
+    Internal::writeJsonString(out, file.first);
+    out << ", \"stats\": ";
+    file.second.writeJson(out);
+    out << " }";
+    first = false;
+  }
+  out << "\n  ]\n}\n";
+}
+
+void IoStats::writeJson(const std::string& filename) {
+  std::ofstream out(filename);
+  writeJson(out);
+}
+
+IoScope::IoScope(fitsfile* fptr, IoCategory category, long requestedBytes) :
+    m_enabled(IoStats::isEnabled() && fptr), m_filename(), m_hduIndex(0), m_category(category), m_counters(),
+    m_start() {
+  if (not m_enabled) {
+    return;
+  }
+  relocate(fptr);
+  m_counters.requestedBytes = requestedBytes;
+  m_start = std::chrono::steady_clock::now();
+}
+
+IoScope::IoScope(const std::string& filename, IoCategory category) :
+    m_enabled(IoStats::isEnabled()), m_filename(), m_hduIndex(0), m_category(category), m_counters(), m_start() {
+  if (not m_enabled) {
+    return;
+  }
+  m_filename = filename;
+  m_start = std::chrono::steady_clock::now();
+}
+
+IoScope::~IoScope() {
+  if (not m_enabled) {
+    return;
+  }
+  const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - m_start;
+  m_counters.elapsed = elapsed.count();
+  IoStats::record(m_filename, m_hduIndex, m_category, m_counters);
+}
+
+void IoScope::relocate(fitsfile* fptr) {
+  if (not m_enabled) {
+    return;
+  }
+  int status = 0;
+  char filename[FLEN_FILENAME];
+  fits_file_name(fptr, filename, &status);
+  m_filename = filename;
+  int index = 0;
+  fits_get_hdu_num(fptr, &index);
+  m_hduIndex = index - 1; // 1-based in CFitsIO
+}
+
+void IoScope::move(fitsfile* fptr) {
+  if (not m_enabled) {
+    return;
+  }
+  relocate(fptr);
+  ++m_counters.hduMoves;
+}
+
+} // namespace Cfitsio
+} // namespace Euclid
@@ -23,6 +23,7 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <cstdlib> // free
 
 using namespace Euclid;
 using namespace Cfitsio;
@@ -49,6 +50,23 @@ BOOST_FIXTURE_TEST_CASE(file_operations_test, Fits::Test::MinimalFile) {
   BOOST_TEST(not fptr);
 }
 
+BOOST_AUTO_TEST_CASE(memory_file_operations_test) {
+  void* buffer = nullptr;
+  std::size_t size = 0;
+  auto* fptr = FileAccess::createAndOpen(&buffer, &size);
+  BOOST_TEST(FileAccess::isWritable(fptr));
+  const auto byteCount = FileAccess::byteCount(fptr);
+  BOOST_TEST(byteCount == 2880); // Empty Primary header
+  FileAccess::close(fptr);
+  BOOST_TEST(buffer);
+  BOOST_TEST(size >= byteCount);
+  fptr = FileAccess::open(&buffer, &size, FileAccess::OpenPolicy::ReadOnly);
+  BOOST_TEST(not FileAccess::isWritable(fptr));
+  BOOST_TEST(FileAccess::byteCount(fptr) == byteCount);
+  FileAccess::close(fptr);
+  std::free(buffer);
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
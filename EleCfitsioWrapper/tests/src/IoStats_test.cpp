@@ -0,0 +1,139 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleCfitsioWrapper/CfitsioFixture.h"
+#include "EleCfitsioWrapper/HduWrapper.h"
+#include "EleCfitsioWrapper/HeaderWrapper.h"
+#include "EleCfitsioWrapper/IoStats.h"
+#include "EleFitsData/TestRaster.h"
+
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+
+using namespace Euclid;
+using namespace Cfitsio;
+
+/**
+ * @brief A minimal file, with recording enabled after its creation.
+ */
+struct RecordedFile : Fits::Test::MinimalFile {
+  RecordedFile() : Fits::Test::MinimalFile() {
+    IoStats::reset();
+    IoStats::enable();
+  }
+  ~RecordedFile() {
+    IoStats::disable();
+    IoStats::reset();
+  }
+  IoFileStats stats() const {
+    return IoStats::read(FileAccess::name(fptr));
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(IoStats_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(counters_are_added_test) {
+  IoCounters lhs;
+  lhs.calls[0] = 1;
+  lhs.requestedBytes = 10;
+  lhs.elapsed = 1.5;
+  IoCounters rhs;
+  rhs.calls[0] = 2;
+  rhs.calls[3] = 3;
+  rhs.deliveredBytes = 8;
+  rhs.hduMoves = 4;
+  rhs.cardScans = 5;
+  lhs += rhs;
+  BOOST_TEST(lhs.callCount(IoCategory::File) == 3);
+  BOOST_TEST(lhs.callCount(IoCategory::Image) == 3);
+  BOOST_TEST(lhs.callCount() == 6);
+  BOOST_TEST(lhs.requestedBytes == 10);
+  BOOST_TEST(lhs.deliveredBytes == 8);
+  BOOST_TEST(lhs.hduMoves == 4);
+  BOOST_TEST(lhs.cardScans == 5);
+  BOOST_TEST(lhs.elapsed == 1.5);
+}
+
+BOOST_FIXTURE_TEST_CASE(nothing_is_recorded_when_disabled_test, Fits::Test::MinimalFile) {
+  IoStats::reset();
+  BOOST_TEST(not IoStats::isEnabled());
+  HduAccess::assignImageExtension(this->fptr, "IMAGE", Fits::Test::SmallRaster());
+  HduAccess::gotoPrimary(this->fptr);
+  BOOST_TEST(IoStats::readAll().empty());
+  BOOST_TEST(IoStats::read(this->filename).total.callCount() == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(only_actual_hdu_moves_are_counted_test, RecordedFile) {
+  HduAccess::assignImageExtension(this->fptr, "IMAGE", Fits::Test::SmallRaster());
+  BOOST_TEST(stats().total.hduMoves == 0);
+  HduAccess::gotoIndex(this->fptr, 2); // Already there
+  BOOST_TEST(stats().total.hduMoves == 0);
+  HduAccess::gotoPrimary(this->fptr);
+  BOOST_TEST(stats().total.hduMoves == 1);
+  HduAccess::gotoName(this->fptr, "IMAGE");
+  HduAccess::gotoName(this->fptr, "IMAGE"); // Already there
+  const auto s = stats();
+  BOOST_TEST(s.total.hduMoves == 2);
+  BOOST_TEST(s.hdus.at(0).hduMoves == 1); // Moves are attributed to the destination
+  BOOST_TEST(s.hdus.at(1).hduMoves == 1);
+  BOOST_TEST(s.total.callCount(IoCategory::Hdu) == 4); // Creation, gotoPrimary and both gotoName
+}
+
+BOOST_FIXTURE_TEST_CASE(image_bytes_are_counted_per_hdu_test, RecordedFile) {
+  Fits::Test::SmallRaster input;
+  const long byteCount = input.size() * sizeof(float);
+  HduAccess::assignImageExtension(this->fptr, "IMAGE", input);
+  const auto output = ImageIo::readRaster<float, 2>(this->fptr);
+  BOOST_TEST(output.vector() == input.vector());
+  const auto s = stats();
+  BOOST_TEST(s.total.callCount(IoCategory::Image) == 2);
+  BOOST_TEST(s.total.requestedBytes == 2 * byteCount);
+  BOOST_TEST(s.total.deliveredBytes == 2 * byteCount);
+  BOOST_TEST(s.hdus.at(1).deliveredBytes == 2 * byteCount);
+  BOOST_TEST(s.hdus.count(0) == 0);
+  BOOST_TEST(s.total.elapsed >= 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(header_scans_are_counted_test, RecordedFile) {
+  HeaderIo::writeRecord(this->fptr, Fits::Record<int>("A", 1));
+  HeaderIo::writeRecord(this->fptr, Fits::Record<int>("B", 2));
+  const auto keywords = HeaderIo::listKeywords(this->fptr);
+  const auto s = stats();
+  BOOST_TEST(s.total.cardScans == long(keywords.size()));
+  BOOST_TEST(s.total.callCount(IoCategory::Header) == 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(counters_are_written_as_json_test, RecordedFile) {
+  HduAccess::assignImageExtension(this->fptr, "IMAGE", Fits::Test::SmallRaster());
+  std::ostringstream json;
+  IoStats::writeJson(json);
+  const auto str = json.str();
+  BOOST_TEST(str.find("\"filename\": \"" + FileAccess::name(this->fptr) + "\"") != std::string::npos);
+  BOOST_TEST(str.find("\"index\": 1") != std::string::npos);
+  BOOST_TEST(str.find("\"image\": 1") != std::string::npos);
+  BOOST_TEST(str.find("\"hdu_moves\": 0") != std::string::npos);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
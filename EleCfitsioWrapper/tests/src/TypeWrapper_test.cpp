@@ -70,6 +70,12 @@ ELEFITS_FOREACH_RECORD_TYPE(RECORD_TYPECODE_TEST)
 ELEFITS_FOREACH_COLUMN_TYPE(BINTABLE_TFORM_TEST)
 ELEFITS_FOREACH_RASTER_TYPE(IMAGE_BITPIX_TEST)
 
+BOOST_AUTO_TEST_CASE(vla_tform_test) {
+  BOOST_TEST(TypeCode<float>::vlaTform() == "1PE");
+  BOOST_TEST(TypeCode<double>::vlaTform(true) == "1QD");
+  BOOST_TEST(TypeCode<std::uint16_t>::vlaTform() == "1PU");
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,312 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_ACCESSDIAGNOSTICS_H
+#define _ELEFITS_ACCESSDIAGNOSTICS_H
+
+#include <array>
+#include <chrono>
+#include <fitsio.h>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @brief The access patterns which are detrimental to performance.
+ * @see \ref optim
+ */
+enum class AccessPattern
+{
+  ChainedColumnReads = 0, ///< Single-column reads of the same table one after the other
+  HduPingPong, ///< Moves back to the HDU which was just left
+  RepeatedNameLookups, ///< HDU accesses by a name which was already looked up
+  HeaderAfterData ///< Header writes in an HDU whose data unit was already written
+};
+
+/**
+ * @brief The number of `AccessPattern` values.
+ */
+constexpr std::size_t accessPatternCount = 4;
+
+/**
+ * @brief Get a short description of an `AccessPattern`.
+ */
+std::string accessPatternName(AccessPattern pattern);
+
+/**
+ * @brief Get the EleFits API to be used instead of an `AccessPattern`.
+ */
+std::string accessPatternAdvice(AccessPattern pattern);
+
+/**
+ * @brief The minimum number of occurrences of each `AccessPattern` for it to be reported.
+ */
+struct AccessThresholds {
+
+  /**
+   * @brief The minimum number of chained single-column reads.
+   */
+  long chainedColumnReads = 2;
+
+  /**
+   * @brief The minimum number of moves back to the previous HDU.
+   */
+  long hduPingPongs = 4;
+
+  /**
+   * @brief The minimum number of repeated name lookups.
+   */
+  long repeatedNameLookups = 4;
+
+  /**
+   * @brief The minimum number of header writes after data writes.
+   */
+  long headerAfterData = 1;
+
+  /**
+   * @brief Get the threshold of a given pattern.
+   */
+  long at(AccessPattern pattern) const;
+};
+
+/**
+ * @brief The occurrences of an `AccessPattern`, and the estimated waste.
+ */
+struct AccessDiagnostic {
+
+  /**
+   * @brief The pattern.
+   */
+  AccessPattern pattern = AccessPattern::ChainedColumnReads;
+
+  /**
+   * @brief The number of occurrences.
+   */
+  long count = 0;
+
+  /**
+   * @brief The estimated number of bytes read or moved in vain.
+   */
+  long wastedBytes = 0;
+
+  /**
+   * @brief The time spent in vain, in microseconds.
+   */
+  double wastedTime = 0;
+};
+
+/**
+ * @brief Detector of the access patterns which are detrimental to performance, e.g. in a `MefFile`.
+ * @details
+ * The handlers of a file feed the detector with their operations, from which the following patterns are detected:
+ * - `AccessPattern::ChainedColumnReads`: a single-column read follows a single-column read of another column
+ *   of the same table, which makes CFitsIO traverse the rows once more
+ *   (the estimated waste is the size of the rows traversed);
+ * - `AccessPattern::HduPingPong`: an operation on an HDU follows an operation on another HDU,
+ *   which itself followed an operation on the former HDU
+ *   (the waste is the time spent moving back);
+ * - `AccessPattern::RepeatedNameLookups`: an HDU is accessed by a name which was already looked up
+ *   (the waste is the time spent in the repeated lookups);
+ * - `AccessPattern::HeaderAfterData`: a header record is written in an HDU after its data unit
+ *   (the estimated waste is the size of the data unit, which is moved when the header grows by one block).
+ *
+ * Multi-column reads, like `BintableColumns::readSeq()`, are not taken into account by the detector.
+ * Patterns with fewer occurrences than the thresholds are not reported.
+ *
+ * \code
+ * MefFile f("file.fits", FileMode::Read);
+ * f.enableDiagnostics(); // Report to std::clog at closing
+ * const auto& columns = f.access<BintableHdu>(1).columns();
+ * const auto ra = columns.read<double>("RA");
+ * const auto dec = columns.read<double>("DEC"); // Chained column read, use readSeq()
+ * f.close(); // Print the report
+ * \endcode
+ * @see \ref optim
+ */
+class AccessDiagnostics {
+
+public:
+  /**
+   * @brief The clock used to measure the wasted time.
+   */
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief RAII marker of a multi-column read, during which column reads are not recorded.
+   * @details
+   * A null detector is accepted, in which case nothing is done.
+   */
+  class MultiRead {
+
+  public:
+    /**
+     * @brief Start the multi-column read.
+     */
+    explicit MultiRead(AccessDiagnostics* diagnostics);
+
+    /**
+     * @brief Non-copyable.
+     */
+    MultiRead(const MultiRead&) = delete;
+
+    /**
+     * @brief Non-copyable.
+     */
+    MultiRead& operator=(const MultiRead&) = delete;
+
+    /**
+     * @brief End the multi-column read.
+     */
+    ~MultiRead();
+
+  private:
+    /**
+     * @brief The detector.
+     */
+    AccessDiagnostics* m_diagnostics;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param filename The file name, for the report
+   * @param thresholds The reporting thresholds
+   * @param out The report stream, or `nullptr` to not report at all
+   */
+  AccessDiagnostics(const std::string& filename, const AccessThresholds& thresholds, std::ostream* out);
+
+  /**
+   * @brief Get the counters of a pattern, whatever the thresholds.
+   */
+  const AccessDiagnostic& at(AccessPattern pattern) const;
+
+  /**
+   * @brief Get the patterns which reach the thresholds.
+   */
+  std::vector<AccessDiagnostic> diagnostics() const;
+
+  /**
+   * @brief Write the patterns which reach the thresholds, with the API to be used instead.
+   */
+  void writeReport(std::ostream& out) const;
+
+  /**
+   * @brief Write the report to the report stream if some patterns reach the thresholds, and clear the counters.
+   */
+  void report();
+
+  /**
+   * @brief Clear the counters and the history.
+   */
+  void clear();
+
+  /**
+   * @brief Record an operation on an HDU (0-based), after it was made current.
+   * @param index The HDU index
+   * @param start The time when the HDU was requested
+   */
+  void touchHdu(long index, Clock::time_point start);
+
+  /**
+   * @brief Record a single-column read of a number of rows in the current HDU.
+   */
+  void readColumn(fitsfile* fptr, long columnIndex, long rowCount);
+
+  /**
+   * @brief Record a data unit write in the current HDU.
+   */
+  void writeData(fitsfile* fptr);
+
+  /**
+   * @brief Record a header unit write in the current HDU, before it is performed.
+   */
+  void writeHeader(fitsfile* fptr);
+
+  /**
+   * @brief Record an HDU access by name.
+   * @param name The HDU name
+   * @param start The time when the HDU was requested
+   */
+  void lookupName(const std::string& name, Clock::time_point start);
+
+private:
+  /**
+   * @brief Get the counters of a pattern.
+   */
+  AccessDiagnostic& counters(AccessPattern pattern);
+
+  /**
+   * @brief The file name.
+   */
+  std::string m_filename;
+
+  /**
+   * @brief The reporting thresholds.
+   */
+  AccessThresholds m_thresholds;
+
+  /**
+   * @brief The report stream.
+   */
+  std::ostream* m_out;
+
+  /**
+   * @brief The counters, per pattern.
+   */
+  std::array<AccessDiagnostic, accessPatternCount> m_counters;
+
+  /**
+   * @brief The number of nested multi-column reads in progress.
+   */
+  long m_multiReadDepth;
+
+  /**
+   * @brief The HDU and column indices of the last single-column read, or -1.
+   */
+  std::pair<long, long> m_lastColumn;
+
+  /**
+   * @brief The index of the current HDU, or -1.
+   */
+  long m_currentHdu;
+
+  /**
+   * @brief The index of the HDU before the current one, or -1.
+   */
+  long m_previousHdu;
+
+  /**
+   * @brief The number of lookups per HDU name.
+   */
+  std::map<std::string, long> m_lookups;
+
+  /**
+   * @brief The indices of the HDUs whose data unit was written.
+   */
+  std::set<long> m_dataWritten;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
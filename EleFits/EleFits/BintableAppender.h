@@ -0,0 +1,231 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_BINTABLEAPPENDER_H
+#define _ELEFITS_BINTABLEAPPENDER_H
+
+#include "EleFits/BintableHdu.h"
+
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief The keyword which records the number of committed rows of a table being appended.
+ */
+constexpr const char* committedRowCountKeyword = "NCOMMIT";
+
+} // namespace Internal
+/// @endcond
+
+/**
+ * @ingroup bintable_handlers
+ * @brief Streaming writer which appends rows to a binary table of unknown final length.
+ * @details
+ * Rows are buffered in memory, and written chunk-wise, sequentially, once a chunk is full.
+ * Instead of growing the table by one chunk at each write, which would imply rewriting the header
+ * and possibly shifting the data at each chunk, the table capacity is doubled when needed,
+ * and the table is truncated to the written rows when the appender is closed.
+ * Appending `N` rows therefore costs `O(N)` bytes of I/O.
+ *
+ * Each time a chunk is written, it is flushed to the file,
+ * and the number of committed rows is recorded in the `NCOMMIT` keyword.
+ * If the process crashes before the appender is closed, the table contains extra rows filled with zeros,
+ * and the committed rows can be recovered with `recoverAppendedRows()`.
+ *
+ * Example usage:
+ * \code
+ * const auto& hdu = f.initBintableExt("EVENTS", idInfo, timeInfo);
+ * BintableAppender<std::int64_t, double> appender(hdu, { "ID", "TIME" });
+ * while (running) {
+ *   appender.appendRow(nextId(), now());
+ * }
+ * appender.close();
+ * \endcode
+ * @warning
+ * The header and data unit should not be modified by other means while the appender is open.
+ */
+template <typename... Ts>
+class BintableAppender {
+
+public:
+  /**
+   * @brief Open an appender.
+   * @param hdu The binary table HDU
+   * @param names The names of the columns to be appended, in the order of `Ts...`
+   * @param chunkRowCount The number of rows written at once, or -1 to use `BintableColumns::readBufferRowCount()`
+   * @details
+   * Rows are appended after the existing rows.
+   * Columns which are not listed are filled with zeros.
+   */
+  BintableAppender(const BintableHdu& hdu, const std::vector<std::string>& names, long chunkRowCount = -1);
+
+  /**
+   * @brief Close the appender.
+   */
+  ~BintableAppender();
+
+  /**
+   * @brief Non-copyable.
+   */
+  BintableAppender(const BintableAppender&) = delete;
+
+  /**
+   * @brief Non-copyable.
+   */
+  BintableAppender& operator=(const BintableAppender&) = delete;
+
+  /**
+   * @brief Get the number of rows of the table, including the buffered rows.
+   */
+  long rowCount() const;
+
+  /**
+   * @brief Get the number of rows written to the file.
+   */
+  long committedRowCount() const;
+
+  /**
+   * @brief Append a row of scalar or string columns.
+   * @throw FitsError if some column is a vector column, in which case `appendSeq()` should be used
+   */
+  void appendRow(const Ts&... values);
+
+  /**
+   * @brief Append the rows of some columns.
+   * @details
+   * The columns must have the same number of rows, and the same repeat counts as in the file
+   * (except for string columns).
+   * @throw FitsError if the row counts or repeat counts do not match
+   */
+  void appendSeq(const Column<Ts>&... columns);
+
+  /**
+   * @brief Write the buffered rows.
+   */
+  void flush();
+
+  /**
+   * @brief Write the buffered rows and truncate the table to the written rows.
+   * @details
+   * Nothing can be appended after this call.
+   */
+  void close();
+
+private:
+  /**
+   * @brief Create the buffers.
+   */
+  template <std::size_t... Is>
+  static std::tuple<VecColumn<Ts>...> makeBuffers(
+      const BintableColumns& columns,
+      const std::vector<std::string>& names,
+      long chunkRowCount,
+      std::index_sequence<Is...>);
+
+  /**
+   * @brief Copy the values of a row in the buffers.
+   */
+  template <std::size_t... Is>
+  void bufferRow(std::index_sequence<Is...>, const Ts&... values);
+
+  /**
+   * @brief Copy some rows of some columns in the buffers.
+   */
+  template <std::size_t... Is>
+  void bufferRows(std::index_sequence<Is...>, long front, long count, const Column<Ts>&... columns);
+
+  /**
+   * @brief Check that some columns have a given number of rows and conform to the buffers.
+   */
+  template <std::size_t... Is>
+  void checkColumns(std::index_sequence<Is...>, long rowCount, const Column<Ts>&... columns) const;
+
+  /**
+   * @brief Grow the table geometrically such that it can contain a given number of rows.
+   */
+  void reserve(long rowCount);
+
+  /**
+   * @brief The header of the HDU.
+   */
+  const Header& m_header;
+
+  /**
+   * @brief The data unit of the HDU.
+   */
+  const BintableColumns& m_columns;
+
+  /**
+   * @brief The number of rows per chunk.
+   */
+  long m_chunkRowCount;
+
+  /**
+   * @brief The buffers.
+   */
+  std::tuple<VecColumn<Ts>...> m_buffers;
+
+  /**
+   * @brief The number of buffered rows.
+   */
+  long m_bufferedRowCount;
+
+  /**
+   * @brief The number of written rows.
+   */
+  long m_committedRowCount;
+
+  /**
+   * @brief The number of rows of the table in the file.
+   */
+  long m_capacity;
+
+  /**
+   * @brief Whether the appender is closed.
+   */
+  bool m_closed;
+};
+
+/**
+ * @ingroup bintable_handlers
+ * @brief Truncate a binary table to the rows committed by a `BintableAppender` which was not closed.
+ * @return The number of rows of the table
+ * @details
+ * If the table was not being appended, it is left untouched.
+ */
+long recoverAppendedRows(const BintableHdu& hdu);
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITS_BINTABLEAPPENDER_IMPL
+#include "EleFits/impl/BintableAppender.hpp"
+#undef _ELEFITS_BINTABLEAPPENDER_IMPL
+/// @endcond
+
+#endif
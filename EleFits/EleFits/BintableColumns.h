@@ -20,8 +20,17 @@
 #ifndef _ELEFITS_BINTABLECOLUMNS_H
 #define _ELEFITS_BINTABLECOLUMNS_H
 
+#include "EleFitsData/Allocator.h"
+#include "EleFitsData/BitColumn.h"
 #include "EleFitsData/Column.h"
+#include "EleFitsData/ColumnArena.h"
+#include "EleFitsData/Conversion.h"
+#include "EleFitsData/Scaling.h"
+#include "EleFitsData/VlaColumn.h"
+#include "EleFits/AccessDiagnostics.h"
 #include "EleFits/FileMemSegments.h"
+#include "EleFits/IoExecutor.h"
+#include "EleFits/ZoneMap.h"
 
 #include <fitsio.h>
 #include <functional>
@@ -29,6 +38,12 @@
 namespace Euclid {
 namespace Fits {
 
+// Forward declarations for friendship
+class BintableHdu;
+template <typename... Ts>
+class BintableAppender;
+long recoverAppendedRows(const BintableHdu& hdu);
+
 /**
  * @ingroup bintable_handlers
  * @brief Column-wise reader-writer for the binary table data unit.
@@ -93,11 +108,19 @@ class BintableColumns {
 
 private:
   friend class BintableHdu;
+  template <typename... Ts>
+  friend class BintableAppender;
+  friend long recoverAppendedRows(const BintableHdu& hdu);
 
   /**
    * @brief Constructor.
    */
-  BintableColumns(fitsfile*& fptr, std::function<void(void)> touchFunc, std::function<void(void)> editFunc);
+  BintableColumns(
+      fitsfile*& fptr,
+      std::function<void(void)> touchFunc,
+      std::function<void(void)> editFunc,
+      AccessDiagnostics* const& diagnostics,
+      IoExecutor* const& executor);
 
 public:
   /**
@@ -179,6 +202,61 @@ public:
   template <typename T>
   ColumnInfo<T> readInfo(long index) const;
 
+  /**
+   * @brief Read the scaling from stored to physical values of a column.
+   * @details
+   * This is the identity unless `TSCALn` or `TZEROn` are set,
+   * e.g. when the column values are unsigned integers.
+   */
+  Scaling readScaling(const std::string& name) const;
+
+  /**
+   * @copydoc readScaling
+   */
+  Scaling readScaling(long index) const;
+
+  /**
+   * @brief Get the overflow policy of the conversions on read.
+   */
+  OverflowPolicy overflowPolicy() const;
+
+  /**
+   * @brief Set the overflow policy of the conversions on read.
+   * @details
+   * When the requested value type differs from the stored type, e.g. when reading a `J` column as `double`,
+   * the stored values are converted after reading, and narrowing conversions are checked according to the policy.
+   * The default policy is `OverflowPolicy::Throw`.
+   * 
+   * The policy is a property of the handler rather than of the file:
+   * as handlers are accessed as constant references, the handler is copied to be configured, e.g.:
+   * \code
+   * auto columns = f.access<BintableHdu>(1).columns(); // Copy
+   * columns.setOverflowPolicy(OverflowPolicy::Saturate);
+   * const auto column = columns.read<std::int16_t>("COUNT");
+   * \endcode
+   * The copy reads and writes the same HDU, and other handlers of the HDU are not affected.
+   */
+  void setOverflowPolicy(OverflowPolicy policy);
+
+  /**
+   * @brief Get the zone map which is updated by the write methods, if any.
+   */
+  ZoneMap* zoneMap() const;
+
+  /**
+   * @brief Attach a zone map to be updated by the write methods, or detach it with `nullptr`.
+   * @details
+   * The zone map is not owned by the handler, and must be kept alive while attached.
+   * Like the overflow policy (see `setOverflowPolicy()`), the zone map is a property of the handler,
+   * which is copied to be configured, such that the handlers shared by the HDU never point to it:
+   * \code
+   * auto columns = f.access<BintableHdu>("CATALOG").columns(); // Copy
+   * columns.setZoneMap(&zones);
+   * \endcode
+   * @see ZoneMap
+   */
+  void setZoneMap(ZoneMap* zones);
+
   /**
    * @brief Read the column with given name.
    * @details
@@ -203,18 +281,23 @@ public:
    * columns.readTo("DEC", dec);
    * \endcode
    * 
+   * The allocator of the returned column can be chosen, e.g. to align the data (see Allocator.h):
+   * \code
+   * auto aligned = columns.read<float, AlignedAllocator<float>>("RA");
+   * \endcode
+   *
    * @warning
    * Methods `readTo()` do not allocate memory: the user must ensure that enough space has been allocated previously.
    */
-  template <typename T>
-  VecColumn<T> read(const std::string& name) const;
+  template <typename T, typename TAllocator = std::allocator<std::decay_t<T>>>
+  VecColumn<T, TAllocator> read(const std::string& name) const;
 
   /**
    * @brief Read the column with given index.
    * @copydetails read()
    */
-  template <typename T>
-  VecColumn<T> read(long index) const;
+  template <typename T, typename TAllocator = std::allocator<std::decay_t<T>>>
+  VecColumn<T, TAllocator> read(long index) const;
 
   /**
    * @brief Read a column into an existing `Column`.
@@ -244,6 +327,42 @@ public:
   template <typename T>
   void readTo(long index, Column<T>& column) const;
 
+  /**
+   * @brief Read the column with given name as stored in the file, i.e. without applying the scaling.
+   * @details
+   * For example, an `std::uint16_t` column is read as an `std::int16_t` column,
+   * and the offset of 32768 is returned by readScaling().
+   * When the scaling is applied (e.g. with `read()`), it is done internally,
+   * in a vectorized loop instead of element-wise by CFitsIO.
+   * @see readScaling()
+   * @see scaleTo()
+   */
+  template <typename T>
+  VecColumn<T> readRaw(const std::string& name) const;
+
+  /**
+   * @brief Read the column with given index as stored in the file.
+   * @copydetails readRaw()
+   */
+  template <typename T>
+  VecColumn<T> readRaw(long index) const;
+
+  /**
+   * @brief Read the bit column (TFORM `X`) with given name, without unpacking the bits.
+   * @details
+   * The packed bytes are read as is, like an `unsigned char` column.
+   * To read a bit column together with other columns, e.g. with `readSegmentSeqTo()`,
+   * create a `BitColumn` of the right shape and read it as any other column.
+   * @see BitColumn
+   */
+  BitColumn readBits(const std::string& name) const;
+
+  /**
+   * @brief Read the bit column (TFORM `X`) with given index, without unpacking the bits.
+   * @copydetails readBits()
+   */
+  BitColumn readBits(long index) const;
+
   /// @}
   /**
    * @name Read a single column segment.
@@ -275,15 +394,15 @@ public:
    * \endcode
    * @see read()
    */
-  template <typename T>
-  VecColumn<T> readSegment(const Segment& rows, const std::string& name) const;
+  template <typename T, typename TAllocator = std::allocator<std::decay_t<T>>>
+  VecColumn<T, TAllocator> readSegment(const Segment& rows, const std::string& name) const;
 
   /**
    * @brief Read the segment of a column specified by its index.
    * @copydetails readSegment()
    */
-  template <typename T>
-  VecColumn<T> readSegment(const Segment& rows, long index) const;
+  template <typename T, typename TAllocator = std::allocator<std::decay_t<T>>>
+  VecColumn<T, TAllocator> readSegment(const Segment& rows, long index) const;
 
   /**
    * @brief Read the segment of a column into an existing `Column`.
@@ -306,6 +425,13 @@ public:
   template <typename T>
   void readSegmentTo(FileMemSegments rows, long index, Column<T>& column) const;
 
+  /**
+   * @brief Read the segment of a column specified by its index as stored in the file, into an existing `Column`.
+   * @copydetails readRaw()
+   */
+  template <typename T>
+  void readRawSegmentTo(FileMemSegments rows, long index, Column<T>& column) const;
+
   /// @}
   /**
    * @name Read a sequence of columns.
@@ -331,6 +457,25 @@ public:
   template <typename... Ts>
   std::tuple<VecColumn<Ts>...> readSeq(const Indexed<Ts>&... indices) const;
 
+  /**
+   * @brief Read the columns with given names into an arena.
+   * @param arena The arena, which is reused if large enough, and grown otherwise
+   * @details
+   * Instead of allocating one vector per column, all the columns are carved out of a single aligned buffer,
+   * which is owned by the returned table and can be released for the next read (see `ArenaTable`).
+   * This avoids allocator churn when reading many columns repeatedly.
+   * Only trivially copyable values can be read this way, i.e. not strings.
+   */
+  template <typename... Ts>
+  ArenaTable<Ts...> readSeq(ColumnArena arena, const Named<Ts>&... names) const;
+
+  /**
+   * @brief Read the columns with given indices into an arena.
+   * @copydetails readSeq(ColumnArena, const Named<Ts>&...) const
+   */
+  template <typename... Ts>
+  ArenaTable<Ts...> readSeq(ColumnArena arena, const Indexed<Ts>&... indices) const;
+
   /**
    * @brief Read a sequence of columns into existing `Column`s.
    * @copydetails readSeq()
@@ -395,6 +540,20 @@ public:
   template <typename... Ts>
   std::tuple<VecColumn<Ts>...> readSegmentSeq(const Segment& rows, const Indexed<Ts>&... indices) const;
 
+  /**
+   * @brief Read segments of columns specified by their names into an arena.
+   * @copydetails readSeq(ColumnArena, const Named<Ts>&...) const
+   */
+  template <typename... Ts>
+  ArenaTable<Ts...> readSegmentSeq(ColumnArena arena, const Segment& rows, const Named<Ts>&... names) const;
+
+  /**
+   * @brief Read segments of columns specified by their indices into an arena.
+   * @copydetails readSeq(ColumnArena, const Named<Ts>&...) const
+   */
+  template <typename... Ts>
+  ArenaTable<Ts...> readSegmentSeq(ColumnArena arena, const Segment& rows, const Indexed<Ts>&... indices) const;
+
   /**
    * @brief Read segments of columns into existing `Column`s.
    * @copydetails readSegmentSeq()
@@ -437,6 +596,119 @@ public:
   template <typename... Ts>
   void readSegmentSeqTo(FileMemSegments rows, const std::vector<long>& indices, Column<Ts>&... columns) const;
 
+  /// @}
+  /**
+   * @name Read filtered rows.
+   */
+  /// @{
+
+  /**
+   * @brief Read the rows of given columns for which a predicate holds.
+   * @param where The columns on which the predicate is evaluated
+   * @param predicate The predicate, which takes the values of the `where` columns at a given row
+   * @param names The columns to be read
+   * @details
+   * The table is streamed by chunks of `readBufferRowCount()` rows.
+   * For each chunk, only the `where` columns are read, and the predicate is evaluated row-wise.
+   * Then, the matching rows of the requested columns are appended to the output columns:
+   * if the matches are dense, each column is read by chunk and the matching rows are gathered in memory;
+   * if they are sparse, only the runs of consecutive matching rows are read.
+   * Requested columns which are also `where` columns of the same type are not read again.
+   * Peak memory is therefore proportional to the number of selected rows plus one chunk per column,
+   * instead of the number of rows of the table with `readSeq()` followed by in-memory filtering.
+   * 
+   * The predicate is called with the value of each `where` column at the row,
+   * which is the first element of the row for vector columns.
+   * 
+   * Example usage:
+   * \code
+   * auto columns = du.readFilteredSeq(
+   *     std::make_tuple(Named<float>("G1"), Named<float>("G2")),
+   *     [](float g1, float g2) {
+   *       return g1 > 0.5 && g2 > 0;
+   *     },
+   *     Named<std::int64_t>("ID"),
+   *     Named<float>("G1"));
+   * \endcode
+   */
+  template <typename... TWheres, typename TPredicate, typename... Ts>
+  std::tuple<VecColumn<Ts>...> readFilteredSeq(
+      const std::tuple<Named<TWheres>...>& where,
+      TPredicate&& predicate,
+      const Named<Ts>&... names) const;
+
+  /**
+   * @brief Read the rows of given columns for which a predicate holds, with columns specified by their indices.
+   * @copydetails readFilteredSeq()
+   */
+  template <typename... TWheres, typename TPredicate, typename... Ts>
+  std::tuple<VecColumn<Ts>...> readFilteredSeq(
+      const std::tuple<Indexed<TWheres>...>& where,
+      TPredicate&& predicate,
+      const Indexed<Ts>&... indices) const;
+
+  /**
+   * @brief Read the rows of given columns for which a predicate holds, among candidate row segments.
+   * @param rows The candidate rows, e.g. from `ZoneMap::select()`, where -1 as the back bound means the last row
+   * @copydetails readFilteredSeq()
+   */
+  template <typename... TWheres, typename TPredicate, typename... Ts>
+  std::tuple<VecColumn<Ts>...> readFilteredSeq(
+      const std::vector<Segment>& rows,
+      const std::tuple<Named<TWheres>...>& where,
+      TPredicate&& predicate,
+      const Named<Ts>&... names) const;
+
+  /**
+   * @brief Read the rows of given columns for which a predicate holds, among candidate row segments,
+   * with columns specified by their indices.
+   * @copydetails readFilteredSeq()
+   */
+  template <typename... TWheres, typename TPredicate, typename... Ts>
+  std::tuple<VecColumn<Ts>...> readFilteredSeq(
+      const std::vector<Segment>& rows,
+      const std::tuple<Indexed<TWheres>...>& where,
+      TPredicate&& predicate,
+      const Indexed<Ts>&... indices) const;
+
+  /// @}
+  /**
+   * @name Gather rows.
+   */
+  /// @{
+
+  /**
+   * @brief Read given rows of columns specified by their names.
+   * @param rows The 0-based indices of the rows to be read, in any order, possibly with duplicates
+   * @param maxGap The maximum number of unrequested rows between two requested rows of a same run
+   * @param names The columns to be read
+   * @details
+   * The i-th row of the output columns is the `rows[i]`-th row of the table.
+   * 
+   * Instead of one read per row, the row indices are sorted and coalesced into runs
+   * of rows which are at most `maxGap` rows apart, and of at most `readBufferRowCount()` rows.
+   * Each run is read for all the columns in one pass, and the values are scattered back in the order of `rows`.
+   * The unrequested rows of a run are read and discarded,
+   * which is cheaper than a new read as long as the gap is small compared to the buffer.
+   * 
+   * Example usage:
+   * \code
+   * const std::vector<long> matches { 1000, 12, 13, 15, 999 }; // E.g. from a cross-match
+   * auto columns = du.readGatheredSeq(matches, 8, Named<double>("RA"), Named<double>("DEC"));
+   * \endcode
+   */
+  template <typename... Ts>
+  std::tuple<VecColumn<Ts>...>
+  readGatheredSeq(const std::vector<long>& rows, long maxGap, const Named<Ts>&... names) const;
+
+  /**
+   * @brief Read given rows of columns specified by their indices.
+   * @copydetails readGatheredSeq()
+   */
+  template <typename... Ts>
+  std::tuple<VecColumn<Ts>...>
+  readGatheredSeq(const std::vector<long>& rows, long maxGap, const Indexed<Ts>&... indices) const;
+
   /// @}
   /**
    * @name Write a single column.
@@ -553,8 +825,161 @@ public:
   void writeSegmentSeq(FileMemSegments rows, const Column<Ts>&... columns) const;
 
   /// @}
+  /**
+   * @name Variable-length array columns.
+   */
+  /// @{
+
+  /**
+   * @brief Append or insert a variable-length array column.
+   * @param name The column name
+   * @param unit The column unit
+   * @param index The 0-based column index, which may be >= 0 or -1 to append the column at the end
+   * @param largeHeap Use 64-bit descriptors (TFORM `1Q`) instead of 32-bit descriptors (TFORM `1P`),
+   * which is needed if the heap exceeds 2 GB
+   * @details
+   * Only numeric columns are supported.
+   */
+  template <typename T>
+  void initVla(const std::string& name, const std::string& unit = "", long index = -1, bool largeHeap = false) const;
+
+  /**
+   * @brief Read a variable-length array column specified by its name.
+   */
+  template <typename T>
+  VlaColumn<T> readVla(const std::string& name) const;
+
+  /**
+   * @brief Read a variable-length array column specified by its index.
+   */
+  template <typename T>
+  VlaColumn<T> readVla(long index) const;
+
+  /**
+   * @brief Read a segment of a variable-length array column specified by its name.
+   * @param rows The row segment, where `rows.back = -1` means the last row
+   * @details
+   * The descriptors of the rows are read at once,
+   * and the heap region which spans the values is read in a single access,
+   * instead of one read per row.
+   */
+  template <typename T>
+  VlaColumn<T> readVlaSegment(const Segment& rows, const std::string& name) const;
+
+  /**
+   * @brief Read a segment of a variable-length array column specified by its index.
+   * @copydetails readVlaSegment()
+   */
+  template <typename T>
+  VlaColumn<T> readVlaSegment(const Segment& rows, long index) const;
+
+  /**
+   * @brief Write a variable-length array column.
+   */
+  template <typename T>
+  void writeVla(const VlaColumn<T>& column) const;
+
+  /**
+   * @brief Write a variable-length array column from a given row.
+   * @param firstRow The 0-based index of the first row to be written
+   * @param column The column
+   * @details
+   * The values are appended sequentially to the heap in a single write,
+   * and the descriptors of the rows are set accordingly.
+   * The table is extended if needed.
+   * @warning
+   * Overwritten rows are not released from the heap.
+   */
+  template <typename T>
+  void writeVlaSegment(long firstRow, const VlaColumn<T>& column) const;
+
+  /// @}
+  /**
+   * @name Read and write asynchronously.
+   */
+  /// @{
+
+  /**
+   * @brief Read a column asynchronously.
+   * @details
+   * Asynchronous operations are executed by the I/O thread of the file (see `IoExecutor`),
+   * in the order of submission, such that the calling thread can go on in the meantime:
+   * \code
+   * auto future = columns.readSeqAsync(Named<double>("RA"), Named<double>("DEC"));
+   * ... // Do something else
+   * const auto radec = future.get();
+   * \endcode
+   * Synchronous operations on the file must not be performed while asynchronous operations are pending.
+   * Exceptions are rethrown by `std::future::get()`.
+   * @throw FitsError if the handler is not attached to a file
+   */
+  template <typename T>
+  std::future<VecColumn<T>> readAsync(const std::string& name) const;
+
+  /**
+   * @brief Read a column asynchronously.
+   * @copydetails readAsync(const std::string&)
+   */
+  template <typename T>
+  std::future<VecColumn<T>> readAsync(long index) const;
+
+  /**
+   * @brief Read a column segment asynchronously.
+   * @copydetails readAsync(const std::string&)
+   */
+  template <typename T>
+  std::future<VecColumn<T>> readSegmentAsync(const Segment& rows, const std::string& name) const;
+
+  /**
+   * @brief Read a sequence of columns asynchronously.
+   * @copydetails readAsync(const std::string&)
+   */
+  template <typename... Ts>
+  std::future<std::tuple<VecColumn<Ts>...>> readSeqAsync(const Named<Ts>&... names) const;
+
+  /**
+   * @brief Read a sequence of column segments asynchronously.
+   * @copydetails readAsync(const std::string&)
+   */
+  template <typename... Ts>
+  std::future<std::tuple<VecColumn<Ts>...>> readSegmentSeqAsync(const Segment& rows, const Named<Ts>&... names) const;
+
+  /**
+   * @brief Write a column asynchronously.
+   * @warning
+   * The column must be neither modified nor destroyed before the future is ready.
+   * @see readAsync()
+   */
+  template <typename T>
+  std::future<void> writeAsync(const Column<T>& column) const;
+
+  /**
+   * @brief Write a column segment asynchronously.
+   * @warning
+   * The column must be neither modified nor destroyed before the future is ready.
+   * @see readAsync()
+   */
+  template <typename T>
+  std::future<void> writeSegmentAsync(FileMemSegments rows, const Column<T>& column) const;
+
+  /**
+   * @brief Write a sequence of columns asynchronously.
+   * @warning
+   * The columns must be neither modified nor destroyed before the future is ready.
+   * @see readAsync()
+   */
+  template <typename... Ts>
+  std::future<void> writeSeqAsync(const Column<Ts>&... columns) const;
+
+  /// @}
 
 private:
+  /**
+   * @brief Get the executor of the asynchronous operations.
+   * @throw FitsError if the handler is not attached to a file
+   */
+  IoExecutor& executor() const;
+
   /**
    * @brief The fitsfile.
    */
@@ -569,6 +994,26 @@ private:
    * @brief The function to declare that the header was edited.
    */
   std::function<void(void)> m_edit;
+
+  /**
+   * @brief The overflow policy of the conversions on read.
+   */
+  OverflowPolicy m_overflowPolicy;
+
+  /**
+   * @brief The zone map updated by the write methods, if any.
+   */
+  ZoneMap* m_zoneMap;
+
+  /**
+   * @brief The access pattern detector of the parent HDU, or `nullptr`.
+   */
+  AccessDiagnostics* const& m_diagnostics;
+
+  /**
+   * @brief The executor of the asynchronous operations of the parent HDU, or `nullptr`.
+   */
+  IoExecutor* const& m_executor;
 };
 
 /**
@@ -0,0 +1,161 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_CUTOUTPLAN_H
+#define _ELEFITS_CUTOUTPLAN_H
+
+#include "EleFitsData/Region.h"
+
+#include <functional>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup image_handlers
+ * @brief The parameters of a batch of cutouts.
+ * @see ImageRaster::readCutouts()
+ */
+struct CutoutOptions {
+
+  /**
+   * @brief The maximum number of bytes of a slab, or 0 for no limit.
+   * @details
+   * A stamp larger than the budget is read as a slab of its own.
+   */
+  long memoryBudget = 64 << 20;
+
+  /**
+   * @brief The maximum number of rows between two stamps for them to be read in the same slab.
+   */
+  long maxGap = 16;
+
+  /**
+   * @brief The number of threads, or 0 to use as many threads as hardware ones.
+   */
+  long threadCount = 1;
+};
+
+/**
+ * @ingroup image_handlers
+ * @brief The slabs to be read to extract a batch of stamps from a 2D image.
+ * @details
+ * Reading many small regions one by one is dominated by the per-call overhead of CFITSIO.
+ * Instead, the stamps are clipped to the image, sorted by file offset (i.e. by front row),
+ * and grouped into slabs: a slab is the bounding box of consecutive stamps which are less than
+ * `CutoutOptions::maxGap` rows apart, and such that the box fits into the memory budget.
+ * Each slab is read at once, and the stamps are then copied from the slab.
+ *
+ * When several threads are used, the memory budget is shared among them.
+ *
+ * The plan is built and executed by `ImageRaster::readCutouts()` and `ImageRaster::readCutoutCube()`.
+ */
+class CutoutPlan {
+
+public:
+  /**
+   * @brief A slab and the stamps it contains.
+   */
+  struct Slab {
+
+    /**
+     * @brief The region to be read, which contains all the clipped stamps.
+     */
+    Region<2> region;
+
+    /**
+     * @brief The indices of the stamps, in the input order.
+     */
+    std::vector<long> stamps;
+  };
+
+  /**
+   * @brief Plan the extraction of given stamps.
+   * @param stamps The stamp regions, which may extend outside the image
+   * @param imageShape The image shape
+   * @param elementByteCount The number of bytes per pixel in memory
+   * @param options The slab parameters
+   */
+  CutoutPlan(
+      const std::vector<Region<2>>& stamps,
+      const Position<2>& imageShape,
+      long elementByteCount,
+      const CutoutOptions& options = {});
+
+  /**
+   * @brief Get the number of stamps.
+   */
+  long size() const;
+
+  /**
+   * @brief Get the stamp regions, as input (unclipped).
+   */
+  const std::vector<Region<2>>& stamps() const;
+
+  /**
+   * @brief Get the part of a stamp which lies inside the image.
+   * @details
+   * The region is empty (i.e. its shape has some non-positive component) if the stamp is fully outside the image.
+   */
+  const Region<2>& clipped(long index) const;
+
+  /**
+   * @brief Get the slabs, sorted by front row.
+   * @details
+   * Stamps which are fully outside the image belong to no slab.
+   */
+  const std::vector<Slab>& slabs() const;
+
+  /**
+   * @brief Get the total number of pixels to be read.
+   */
+  long readPixelCount() const;
+
+  /**
+   * @brief Apply a function to each slab, in parallel.
+   * @param func The function, which takes the slab index and the thread index
+   * @param threadCount The number of threads, or 0 to use as many threads as hardware ones
+   * @details
+   * The thread index is between 0 and `threadCount - 1`, where 0 is the calling thread.
+   * The first exception thrown by a thread is rethrown once all threads have finished.
+   */
+  void forEachSlab(const std::function<void(long, long)>& func, long threadCount) const;
+
+private:
+  /**
+   * @brief The input stamps.
+   */
+  std::vector<Region<2>> m_stamps;
+
+  /**
+   * @brief The stamps clipped to the image.
+   */
+  std::vector<Region<2>> m_clipped;
+
+  /**
+   * @brief The slabs.
+   */
+  std::vector<Slab> m_slabs;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
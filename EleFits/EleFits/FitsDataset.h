@@ -0,0 +1,172 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_FITSDATASET_H
+#define _ELEFITS_FITSDATASET_H
+
+#include "EleFits/MefFile.h"
+
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_handlers
+ * @brief Logical concatenation of the binary tables of several files with the same schema.
+ * @details
+ * The dataset is made of one binary table extension per file, at the same index in each file.
+ * At construction, each file is opened once to read the number of rows of the table,
+ * and to check that the columns have the same names and TFORMs as in the first file.
+ *
+ * Columns are read into one contiguous `VecColumn` per column, which covers the rows of all the files,
+ * in the order of the files, and rows are indexed globally.
+ * Files are scanned in parallel, each thread opening one file at a time,
+ * such that the number of open handles is bounded by the number of threads.
+ *
+ * Example usage:
+ * \code
+ * FitsDataset dataset(FitsDataset::listFiles("/data/catalog_*.fits"));
+ * auto columns = dataset.readSeq(Named<std::int64_t>("ID"), Named<float>("FLUX"));
+ * // std::get<1>(columns).rowCount() == dataset.readRowCount()
+ * \endcode
+ * @warning
+ * Parallel reads require that CFITSIO was built thread-safe (which is the default).
+ */
+class FitsDataset {
+
+public:
+  /**
+   * @brief Open a dataset.
+   * @param filenames The files, in the order of the rows
+   * @param hduIndex The 0-based index of the binary table extension in each file
+   * @param threadCount The number of threads, or 0 to use as many threads as hardware ones
+   * @throw FitsError if the schemas differ
+   */
+  explicit FitsDataset(std::vector<std::string> filenames, long hduIndex = 1, long threadCount = 0);
+
+  /**
+   * @brief List the files which match a shell wildcard pattern, in lexicographic order.
+   */
+  static std::vector<std::string> listFiles(const std::string& pattern);
+
+  /**
+   * @brief Get the file names.
+   */
+  const std::vector<std::string>& filenames() const;
+
+  /**
+   * @brief Get the number of files.
+   */
+  long fileCount() const;
+
+  /**
+   * @brief Get the names of the columns.
+   */
+  const std::vector<std::string>& readColumnNames() const;
+
+  /**
+   * @brief Get the total number of rows.
+   */
+  long readRowCount() const;
+
+  /**
+   * @brief Get the number of rows of a file.
+   */
+  long readRowCount(long fileIndex) const;
+
+  /**
+   * @brief Get the index of the file which contains a global row.
+   */
+  long readFileIndex(long row) const;
+
+  /**
+   * @brief Read a sequence of columns over all the files.
+   */
+  template <typename... Ts>
+  std::tuple<VecColumn<Ts>...> readSeq(const Named<Ts>&... names) const;
+
+  /**
+   * @brief Read a sequence of column segments, where rows are indexed globally.
+   * @details
+   * As usual, a segment back of -1 stands for the last row.
+   */
+  template <typename... Ts>
+  std::tuple<VecColumn<Ts>...> readSegmentSeq(const Segment& rows, const Named<Ts>&... names) const;
+
+  /**
+   * @brief Read a sequence of column segments into existing columns, where rows are indexed globally.
+   * @details
+   * The columns are identified by their names, and row `rows.front` is read into row 0.
+   */
+  template <typename... Ts>
+  void readSegmentSeqTo(const Segment& rows, Column<Ts>&... columns) const;
+
+private:
+  /**
+   * @brief Apply a function to the indices of some files, in parallel.
+   * @details
+   * The first exception thrown by a thread is rethrown once all threads have finished.
+   */
+  void forEachFile(const std::vector<long>& fileIndices, const std::function<void(long)>& func) const;
+
+  /**
+   * @brief Resolve a segment back of -1.
+   */
+  Segment resolve(const Segment& rows) const;
+
+  /**
+   * @brief The file names.
+   */
+  std::vector<std::string> m_filenames;
+
+  /**
+   * @brief The HDU index.
+   */
+  long m_hduIndex;
+
+  /**
+   * @brief The number of threads.
+   */
+  long m_threadCount;
+
+  /**
+   * @brief The column names.
+   */
+  std::vector<std::string> m_names;
+
+  /**
+   * @brief The index of the first row of each file, plus the total number of rows.
+   */
+  std::vector<long> m_offsets;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITS_FITSDATASET_IMPL
+#include "EleFits/impl/FitsDataset.hpp"
+#undef _ELEFITS_FITSDATASET_IMPL
+/// @endcond
+
+#endif
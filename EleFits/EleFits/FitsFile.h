@@ -21,9 +21,15 @@
 #define _ELEFITS_FITSFILE_H
 
 #include "EleFitsData/FitsError.h"
+#include "EleFits/AccessDiagnostics.h"
+#include "EleFits/HandlePool.h"
+#include "EleFits/IoExecutor.h"
 
+#include <cstddef> // size_t
 #include <fitsio.h>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace Euclid {
 
@@ -88,6 +94,119 @@ public:
   static void mayThrow(const std::string& prefix, FileMode mode);
 };
 
+/**
+ * @ingroup file_handlers
+ * @brief A buffer which holds a Fits file in memory.
+ * @details
+ * Memory buffers are used to create, edit or read Fits files without any disk access,
+ * through the file handler constructors which take a buffer instead of a file name.
+ * The buffer is owned by the user and must outlive the file handler.
+ * 
+ * Owned buffers are growable: they can be written by the file handlers.
+ * Views, which are created from a constant external buffer, are read-only and are not copied.
+ * 
+ * Example usage:
+ * \code
+ * MemoryBuffer buffer;
+ * {
+ *   MefFile f(buffer, FileMode::Create);
+ *   f.assignImageExt("IMAGE", raster);
+ * } // Closed by the destructor
+ * send(buffer.data(), buffer.size());
+ * \endcode
+ */
+class MemoryBuffer {
+
+  friend class FitsFile;
+  friend class MefFile;
+
+public:
+  /**
+   * @brief Create an empty growable buffer.
+   */
+  MemoryBuffer();
+
+  /**
+   * @brief Create a growable buffer with a copy of given bytes, e.g. to edit an existing file.
+   */
+  explicit MemoryBuffer(const std::vector<unsigned char>& bytes);
+
+  /**
+   * @brief Create a read-only view of an external buffer, without copy.
+   */
+  MemoryBuffer(const void* data, std::size_t size);
+
+  /**
+   * @brief Destructor.
+   * @details
+   * Growable buffers are freed; views are not.
+   */
+  ~MemoryBuffer();
+
+  /**
+   * @brief Non-copyable (the buffer address is shared with CFitsIO).
+   */
+  MemoryBuffer(const MemoryBuffer&) = delete;
+
+  /**
+   * @brief Non-copyable (the buffer address is shared with CFitsIO).
+   */
+  MemoryBuffer& operator=(const MemoryBuffer&) = delete;
+
+  /**
+   * @brief Get the address of the file contents.
+   */
+  const unsigned char* data() const;
+
+  /**
+   * @brief Get the size of the file contents in bytes.
+   * @details
+   * The size is updated when the file handler is closed.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Check whether the buffer can be written by file handlers.
+   */
+  bool isWritable() const;
+
+  /**
+   * @brief Copy the file contents into a vector.
+   */
+  std::vector<unsigned char> vector() const;
+
+private:
+  /**
+   * @brief Ensure the buffer capacity is at least given size, and return the buffer address.
+   */
+  unsigned char* reserve(std::size_t size);
+
+  /**
+   * @brief Free the contents.
+   */
+  void clear();
+
+  /**
+   * @brief The buffer address, which may be updated by CFitsIO.
+   */
+  void* m_data;
+
+  /**
+   * @brief The buffer capacity, which may be updated by CFitsIO.
+   */
+  std::size_t m_capacity;
+
+  /**
+   * @brief The file size.
+   */
+  std::size_t m_size;
+
+  /**
+   * @brief Whether the buffer is owned, and therefore growable.
+   */
+  bool m_owned;
+};
+
 /**
  * @ingroup file_handlers
  * @brief Fits file reader-writer.
@@ -105,6 +224,16 @@ public:
    */
   FitsFile(const std::string& filename, FileMode permission);
 
+  /**
+   * @brief Create a new Fits file handler in memory with given buffer and permission.
+   * @details
+   * With `FileMode::Create`, `FileMode::Overwrite` and `FileMode::Temporary`,
+   * the previous contents of the buffer are discarded.
+   * With `FileMode::Temporary`, the buffer is emptied when the file is closed.
+   * Only `FileMode::Read` is supported for read-only views.
+   */
+  FitsFile(MemoryBuffer& buffer, FileMode permission);
+
   /**
    * @brief Destroy the object and close the file.
    * @details
@@ -114,6 +243,8 @@ public:
 
   /**
    * @brief Get the file name.
+   * @details
+   * For files in memory, the name is "mem://".
    */
   std::string filename() const;
 
@@ -135,6 +266,9 @@ public:
    * @brief Close the file.
    * @details
    * Files opened with `FileMode::Temporary` are deleted after closing by this method.
+   * If access diagnostics are enabled, the report is written before closing.
+   * If concurrent reads are enabled, the handles of the pool are closed, and concurrent reads are disabled.
+   * Pending asynchronous operations are completed first.
    */
   void close();
 
@@ -164,6 +298,12 @@ protected:
    */
   void open(const std::string& filename, FileMode permission);
 
+  /**
+   * @brief Open a Fits file in memory with given buffer and permission.
+   * @copydetails open(const std::string&, FileMode)
+   */
+  void open(MemoryBuffer& buffer, FileMode permission);
+
   /**
    * @brief The CFitsIO file handler.
    */
@@ -183,6 +323,26 @@ protected:
    * @brief An open flag to nullify m_fptr at close.
    */
   bool m_open;
+
+  /**
+   * @brief The memory buffer for files in memory, or `nullptr` for files on disk.
+   */
+  MemoryBuffer* m_memory;
+
+  /**
+   * @brief The access pattern detector, or `nullptr` if diagnostics are disabled.
+   */
+  std::unique_ptr<AccessDiagnostics> m_diagnostics;
+
+  /**
+   * @brief The per-thread handles, or `nullptr` if concurrent reads are disabled.
+   */
+  std::unique_ptr<HandlePool> m_pool;
+
+  /**
+   * @brief The executor of the asynchronous operations.
+   */
+  IoExecutor m_executor;
 };
 
 } // namespace Fits
@@ -0,0 +1,157 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_HANDLEPOOL_H
+#define _ELEFITS_HANDLEPOOL_H
+
+#include <fitsio.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+// Forward declaration for HandlePool::Handle
+class Hdu;
+
+/**
+ * @brief A pool of read-only CFitsIO handles to a file, each bound to at most one thread at a time.
+ * @details
+ * CFitsIO handles hold the current HDU and I/O buffers, and therefore cannot be shared between threads.
+ * Yet, a file can be read concurrently through several handles, as long as each handle is used by a single thread.
+ *
+ * The first call to `local()` from a thread binds a handle to this thread:
+ * a handle which was released by another thread is reused if any, and a new handle is opened otherwise.
+ * The binding lasts until the thread calls `release()`, such that the number of open handles
+ * is bounded by the number of threads which use the pool simultaneously.
+ * Handles are closed when the pool is destroyed.
+ *
+ * Each handle comes with its own HDU handlers, such that the state of an HDU handler
+ * is never shared between threads either.
+ * @see MefFile::enableConcurrentReads()
+ */
+class HandlePool {
+
+public:
+  /**
+   * @brief A CFitsIO handle, with its HDU handlers.
+   */
+  struct Handle {
+
+    /**
+     * @brief The CFitsIO handle.
+     */
+    fitsfile* fptr = nullptr;
+
+    /**
+     * @brief The HDU handlers, lazily created.
+     */
+    std::vector<std::unique_ptr<Hdu>> hdus;
+
+    /**
+     * @brief The buffer address of files in memory, which is owned by the `MemoryBuffer`.
+     */
+    void* data = nullptr;
+
+    /**
+     * @brief The buffer size of files in memory.
+     */
+    std::size_t size = 0;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param open The function which opens a new handle, i.e. sets its `fptr`
+   * @param hduCount The number of HDUs of the file
+   */
+  HandlePool(std::function<void(Handle&)> open, long hduCount);
+
+  /**
+   * @brief Non-copyable.
+   */
+  HandlePool(const HandlePool&) = delete;
+
+  /**
+   * @brief Non-copyable.
+   */
+  HandlePool& operator=(const HandlePool&) = delete;
+
+  /**
+   * @brief Close the handles.
+   */
+  ~HandlePool();
+
+  /**
+   * @brief Get the handle bound to the calling thread, binding one if needed.
+   */
+  Handle& local();
+
+  /**
+   * @brief Give the handle of the calling thread back to the pool, if any.
+   * @details
+   * The handle is kept open for another thread.
+   * The HDU handlers which were obtained through it must not be used anymore by the calling thread.
+   */
+  void release();
+
+  /**
+   * @brief Get the number of open handles.
+   */
+  long size() const;
+
+private:
+  /**
+   * @brief The handle opener.
+   */
+  std::function<void(Handle&)> m_open;
+
+  /**
+   * @brief The number of HDUs.
+   */
+  long m_hduCount;
+
+  /**
+   * @brief The mutex which protects the lists of handles (not the handles).
+   */
+  mutable std::mutex m_mutex;
+
+  /**
+   * @brief The open handles.
+   */
+  std::vector<std::unique_ptr<Handle>> m_handles;
+
+  /**
+   * @brief The handles which are not bound to any thread.
+   */
+  std::vector<Handle*> m_free;
+
+  /**
+   * @brief The handles bound to threads.
+   */
+  std::map<std::thread::id, Handle*> m_bound;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
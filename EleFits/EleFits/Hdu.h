@@ -25,7 +25,9 @@
 #include "EleFitsData/KeywordCategory.h"
 #include "EleFitsData/Record.h"
 #include "EleFitsData/RecordVec.h"
+#include "EleFits/AccessDiagnostics.h"
 #include "EleFits/Header.h"
+#include "EleFits/IoExecutor.h"
 
 #include <fitsio.h>
 #include <memory>
@@ -201,6 +203,13 @@ protected:
    */
   void editThisHdu() const;
 
+  /**
+   * @brief Set the current HDU to this one for writing in the header unit.
+   * @details
+   * Same as `editThisHdu()`, and declare the header write to the access diagnostics, if any.
+   */
+  void editThisHeader() const;
+
   /**
    * @brief The parent file handler.
    * @warning
@@ -239,6 +248,24 @@ protected:
    * @brief Dummy file handler dedicated to dummy constructor.
    */
   fitsfile* m_dummyFptr = nullptr;
+
+  /**
+   * @brief The access pattern detector of the parent file, or `nullptr`.
+   * @details
+   * It is set by `MefFile`, and shared by reference with the data unit handlers.
+   */
+  AccessDiagnostics* m_diagnostics = nullptr;
+
+  /**
+   * @brief The executor of the asynchronous operations of the parent file, or `nullptr`.
+   * @details
+   * It is set by the file handler, and shared by reference with the data unit handlers.
+   */
+  IoExecutor* m_executor = nullptr;
+
+private:
+  friend class MefFile;
+  friend class SifFile;
 };
 
 } // namespace Fits
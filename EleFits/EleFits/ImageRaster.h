@@ -20,8 +20,15 @@
 #ifndef _ELEFITS_IMAGERASTER_H
 #define _ELEFITS_IMAGERASTER_H
 
+#include "EleFitsData/Allocator.h"
+#include "EleFitsData/Binning.h"
+#include "EleFitsData/Conversion.h"
 #include "EleFitsData/Raster.h"
+#include "EleFitsData/Scaling.h"
+#include "EleFits/AccessDiagnostics.h"
+#include "EleFits/CutoutPlan.h"
 #include "EleFits/FileMemRegions.h"
+#include "EleFits/IoExecutor.h"
 
 #include <fitsio.h>
 #include <functional>
@@ -50,7 +57,12 @@ private:
   /**
    * @brief Constructor.
    */
-  ImageRaster(fitsfile*& fptr, std::function<void(void)> touchFunc, std::function<void(void)> editFunc);
+  ImageRaster(
+      fitsfile*& fptr,
+      std::function<void(void)> touchFunc,
+      std::function<void(void)> editFunc,
+      AccessDiagnostics* const& diagnostics,
+      IoExecutor* const& executor);
 
 public:
   /**
@@ -68,6 +80,37 @@ public:
    */
   long readSize() const;
 
+  /**
+   * @brief Read the scaling from stored to physical values.
+   * @details
+   * This is the identity unless `BSCALE` or `BZERO` are set,
+   * e.g. when the image values are unsigned integers.
+   */
+  Scaling readScaling() const;
+
+  /**
+   * @brief Get the overflow policy of the conversions on read.
+   */
+  OverflowPolicy overflowPolicy() const;
+
+  /**
+   * @brief Set the overflow policy of the conversions on read.
+   * @details
+   * When the requested value type differs from the stored type, e.g. when reading a `std::int32_t` image as `float`,
+   * the stored values are converted after reading, and narrowing conversions are checked according to the policy.
+   * The default policy is `OverflowPolicy::Throw`.
+   * 
+   * The policy is a property of the handler rather than of the file:
+   * as handlers are accessed as constant references, the handler is copied to be configured, e.g.:
+   * \code
+   * auto raster = f.access<ImageHdu>(1).raster(); // Copy
+   * raster.setOverflowPolicy(OverflowPolicy::Saturate);
+   * const auto image = raster.read<std::int16_t>();
+   * \endcode
+   * The copy reads and writes the same HDU, and other handlers of the HDU are not affected.
+   */
+  void setOverflowPolicy(OverflowPolicy policy);
+
   /**
    * @brief Read the image shape.
    */
@@ -104,9 +147,18 @@ public:
    * 
    * @warning
    * Filling a `Subraster` is much slower than filling a `Raster`.
+   * 
+   * When the values are scaled in the file (e.g. for unsigned integers),
+   * the scaling is applied internally to the whole data unit, with a single pass over the stored bytes.
+   * Use readRaw() to skip the scaling step.
+   * 
+   * When `T` differs from the stored type, the values are converted according to overflowPolicy().
+   *
+   * The allocator of the returned raster can be chosen, e.g. to align the data or to back it with huge pages
+   * (see Allocator.h).
    */
-  template <typename T, long n = 2>
-  VecRaster<T, n> read() const;
+  template <typename T, long n = 2, typename TAllocator = std::allocator<std::decay_t<T>>>
+  VecRaster<T, n, TAllocator> read() const;
 
   /**
    * @brief Read the whole data unit into an existing `Raster`.
@@ -122,6 +174,25 @@ public:
   template <typename T, long n = 2>
   void readTo(Subraster<T, n>& subraster) const;
 
+  /**
+   * @brief Read the whole data unit as stored in the file, i.e. without applying the scaling.
+   * @details
+   * For example, an `std::uint16_t` image is read as an `std::int16_t` raster,
+   * and the offset of 32768 is returned by readScaling().
+   * This is useful to defer or skip the scaling, or to apply it on the fly in some processing step.
+   * @see readScaling()
+   * @see scaleTo()
+   */
+  template <typename T, long n = 2>
+  VecRaster<T, n> readRaw() const;
+
+  /**
+   * @brief Read the whole data unit as stored in the file into an existing `Raster`.
+   * @copydetails readRaw()
+   */
+  template <typename T, long n = 2>
+  void readRawTo(Raster<T, n>& raster) const;
+
   /// @}
   /**
    * @name Read a region of the data unit.
@@ -167,6 +238,92 @@ public:
   template <typename T, long m, long n>
   void readRegionTo(FileMemRegions<n> regions, Raster<T, m>& raster) const;
 
+  /// @}
+  /**
+   * @name Read a decimated or binned data unit, e.g. for previews.
+   */
+  /// @{
+
+  /**
+   * @brief Read every `step`-th pixel along each axis.
+   * @param step The distance between two read pixels along each axis
+   * @details
+   * The returned raster shape is the data shape divided by the step, rounded up.
+   * Decimation is performed by CFITSIO at read-time, such that the data unit is never held in memory.
+   * For example, to read a 1/8-scale preview:
+   * \code
+   * const auto preview = image.readDecimated<float>({ 8, 8 });
+   * \endcode
+   * @see readBinned()
+   */
+  template <typename T, long n = 2>
+  VecRaster<T, n> readDecimated(const Position<n>& step) const;
+
+  /**
+   * @brief Read every `step`-th pixel along each axis of a region.
+   * @copydetails readDecimated()
+   */
+  template <typename T, long m, long n>
+  VecRaster<T, m> readRegionDecimated(const Region<n>& region, const Position<n>& step) const;
+
+  /**
+   * @brief Read the data unit reduced by blocks.
+   * @param block The block shape
+   * @param mode The reduction
+   * @details
+   * The data unit is read sequentially as slabs of `block[n - 1]` planes,
+   * which are reduced by a `Binner` as soon as they are read,
+   * such that memory is proportional to the output raster and one slab.
+   * Blocks at the upper edges may be incomplete.
+   * \code
+   * const auto preview = image.readBinned<float>({ 8, 8 }, BinningMode::Mean);
+   * \endcode
+   */
+  template <typename T, long n = 2>
+  VecRaster<T, n> readBinned(const Position<n>& block, BinningMode mode = BinningMode::Mean) const;
+
+  /// @}
+  /**
+   * @name Read many small regions of a 2D data unit.
+   */
+  /// @{
+
+  /**
+   * @brief Read a batch of stamps as new `VecRaster`s.
+   * @param regions The in-file stamp regions, which may extend outside the data unit
+   * @param options The slab parameters
+   * @param fill The value of the pixels outside the data unit
+   * @details
+   * Instead of reading each region separately, the stamps are grouped into slabs according to a `CutoutPlan`:
+   * each slab is read at once, and the stamps are copied from it.
+   * Slabs are read in parallel if `CutoutOptions::threadCount` is not 1, each thread opening its own file handle.
+   * Files in memory are read sequentially.
+   * 
+   * The stamps are returned in the input order.
+   * Pixels of the stamps outside the data unit are set to `fill`.
+   * \code
+   * std::vector<Region<2>> regions;
+   * for (const auto& p : detections) {
+   *   regions.push_back(Region<2>::fromShape(p - 16, { 32, 32 }));
+   * }
+   * const auto stamps = image.readCutouts<float>(regions, { 64 << 20, 16, 0 });
+   * \endcode
+   */
+  template <typename T>
+  std::vector<VecRaster<T, 2>>
+  readCutouts(const std::vector<Region<2>>& regions, const CutoutOptions& options = {}, T fill = T()) const;
+
+  /**
+   * @brief Read a batch of stamps of the same shape as the planes of a 3D `VecRaster`.
+   * @copydetails readCutouts()
+   * 
+   * Stamp `i` is plane `i` of the returned cube.
+   * @throw FitsError if the stamps do not all have the same shape
+   */
+  template <typename T>
+  VecRaster<T, 3>
+  readCutoutCube(const std::vector<Region<2>>& regions, const CutoutOptions& options = {}, T fill = T()) const;
+
   /// @}
   /**
    * @name Write the whole data unit.
@@ -212,8 +369,69 @@ public:
   void writeRegion(FileMemRegions<n> regions, const Raster<T, m>& raster) const; // TODO return bool = isContiguous()?
 
   /// @}
+  /**
+   * @name Read and write asynchronously.
+   */
+  /// @{
+
+  /**
+   * @brief Read the whole data unit asynchronously.
+   * @details
+   * Asynchronous operations are executed by the I/O thread of the file (see `IoExecutor`),
+   * in the order of submission, such that the calling thread can go on in the meantime,
+   * e.g. to process the previous data unit:
+   * \code
+   * auto next = f.access<ImageHdu>(1).raster().readAsync<float>();
+   * for (long i = 1; i < f.hduCount(); ++i) {
+   *   auto raster = next.get();
+   *   if (i + 1 < f.hduCount()) {
+   *     next = f.access<ImageHdu>(i + 1).raster().readAsync<float>();
+   *   }
+   *   process(raster); // Overlaps with the next read
+   * }
+   * \endcode
+   * Synchronous operations on the file must not be performed while asynchronous operations are pending.
+   * Exceptions are rethrown by `std::future::get()`.
+   * @throw FitsError if the handler is not attached to a file
+   */
+  template <typename T, long n = 2>
+  std::future<VecRaster<T, n>> readAsync() const;
+
+  /**
+   * @brief Read a region of the data unit asynchronously.
+   * @copydetails readAsync()
+   */
+  template <typename T, long m, long n>
+  std::future<VecRaster<T, m>> readRegionAsync(const Region<n>& region) const;
+
+  /**
+   * @brief Write the whole data unit asynchronously.
+   * @warning
+   * The raster must be neither modified nor destroyed before the future is ready.
+   * @see readAsync()
+   */
+  template <typename T, long n>
+  std::future<void> writeAsync(const Raster<T, n>& raster) const;
+
+  /**
+   * @brief Write a `Raster` at a given position of the data unit asynchronously.
+   * @warning
+   * The raster must be neither modified nor destroyed before the future is ready.
+   * @see readAsync()
+   * @see writeRegion()
+   */
+  template <typename T, long m, long n>
+  std::future<void> writeRegionAsync(FileMemRegions<n> regions, const Raster<T, m>& raster) const;
+
+  /// @}
 
 private:
+  /**
+   * @brief Get the executor of the asynchronous operations.
+   * @throw FitsError if the handler is not attached to a file
+   */
+  IoExecutor& executor() const;
+
   /**
    * @brief Read a region of the data unit into an existing `Raster`.
    * @copydetails readRegion()
@@ -241,6 +459,14 @@ private:
   template <typename T, long n>
   void readRegionTo(Subraster<T, n>& subraster) const;
 
+  /**
+   * @brief Read a batch of stamps into contiguous buffers which are already filled with the outside value.
+   * @param data The destination buffer of each stamp
+   */
+  template <typename T>
+  void readCutoutsTo(const std::vector<Region<2>>& regions, const CutoutOptions& options, const std::vector<T*>& data)
+      const;
+
   /**
    * @brief Write a `Raster` at a given position of the data unit.
    */
@@ -275,6 +501,21 @@ private:
    * @brief The function to declare that the header was edited.
    */
   std::function<void(void)> m_edit;
+
+  /**
+   * @brief The overflow policy of the conversions on read.
+   */
+  OverflowPolicy m_overflowPolicy;
+
+  /**
+   * @brief The access pattern detector of the parent HDU, or `nullptr`.
+   */
+  AccessDiagnostics* const& m_diagnostics;
+
+  /**
+   * @brief The executor of the asynchronous operations of the parent HDU, or `nullptr`.
+   */
+  IoExecutor* const& m_executor;
 };
 
 } // namespace Fits
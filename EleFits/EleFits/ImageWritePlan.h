@@ -0,0 +1,147 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_IMAGEWRITEPLAN_H
+#define _ELEFITS_IMAGEWRITEPLAN_H
+
+#include "EleFitsData/Raster.h"
+
+#include <fitsio.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup image_handlers
+ * @brief A batch of image extensions to be appended to a `MefFile` at once, with data written in parallel.
+ * @details
+ * The data unit sizes are known from the shapes and value types of the rasters,
+ * such that the whole file layout can be planned before writing any data.
+ * The plan is executed by `MefFile::assignImageExts()`, which:
+ * - writes all the headers sequentially;
+ * - preallocates the file up to the end of the last data unit;
+ * - encodes and writes the data units concurrently with positioned writes.
+ * 
+ * The rasters are not copied: they must be kept alive until the plan is executed.
+ * 
+ * Example usage:
+ * \code
+ * ImageWritePlan plan;
+ * for (std::size_t i = 0; i < rasters.size(); ++i) {
+ *   plan.add("CCD" + std::to_string(i), rasters[i]);
+ * }
+ * f.assignImageExts(plan);
+ * \endcode
+ * 
+ * Files in memory (see `MemoryBuffer`) are supported too: the data units are then encoded directly in the buffer.
+ * 
+ * @warning
+ * This is only relevant for uncompressed files, e.g. on a local disk, which can be written by several threads.
+ */
+class ImageWritePlan {
+
+  friend class MefFile;
+
+public:
+  /**
+   * @brief Plan the writing of an image extension with given name and data.
+   */
+  template <typename T, long n>
+  void add(const std::string& name, const Raster<T, n>& raster);
+
+  /**
+   * @brief Get the number of planned image extensions.
+   */
+  long size() const;
+
+  /**
+   * @brief Get the total number of bytes of the planned data units, excluding padding.
+   */
+  long dataByteCount() const;
+
+private:
+  /**
+   * @brief A planned image extension.
+   */
+  struct Entry {
+
+    /**
+     * @brief Write the header.
+     */
+    std::function<void(fitsfile*)> init;
+
+    /**
+     * @brief Encode a contiguous sequence of values as stored in the file, given the first index and the count.
+     */
+    std::function<void(long, long, unsigned char*)> encode;
+
+    /**
+     * @brief The number of values.
+     */
+    long elementCount;
+
+    /**
+     * @brief The number of bytes per stored value.
+     */
+    long elementByteCount;
+  };
+
+  /**
+   * @brief Write the data units into a file which has already been laid out.
+   * @param filename The file name
+   * @param offsets The data unit offsets, in bytes
+   * @param fileSize The expected file size, in bytes
+   * @param threadCount The number of threads, or 0 to use as many threads as hardware ones
+   */
+  void fill(const std::string& filename, const std::vector<long>& offsets, long fileSize, long threadCount) const;
+
+  /**
+   * @brief Write the data units into a file in memory which has already been laid out.
+   * @param data The file contents, with a capacity at least equal to the file size
+   * @param offsets The data unit offsets, in bytes
+   * @param threadCount The number of threads, or 0 to use as many threads as hardware ones
+   */
+  void fill(unsigned char* data, const std::vector<long>& offsets, long threadCount) const;
+
+  /**
+   * @brief Apply a function to the index of each entry, in parallel.
+   * @details
+   * The first exception thrown by a thread is rethrown once all threads have finished.
+   */
+  void forEachEntry(const std::function<void(long)>& func, long threadCount) const;
+
+  /**
+   * @brief The planned image extensions.
+   */
+  std::vector<Entry> m_entries;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITS_IMAGEWRITEPLAN_IMPL
+#include "EleFits/impl/ImageWritePlan.hpp"
+#undef _ELEFITS_IMAGEWRITEPLAN_IMPL
+/// @endcond
+
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_IOEXECUTOR_H
+#define _ELEFITS_IOEXECUTOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @brief A single I/O thread which executes tasks in submission order.
+ * @details
+ * Each file owns an executor, which runs the asynchronous operations of its handlers,
+ * like `ImageRaster::readAsync()` or `BintableColumns::writeAsync()`.
+ * Since there is a single thread per file, operations on a file are executed in the order of submission:
+ * a read submitted after a write reads the written values.
+ * Operations on different files are executed in parallel.
+ *
+ * The thread is started at the first submission, such that files which are not used asynchronously
+ * do not spawn threads.
+ * Exceptions thrown by the tasks are forwarded to the futures.
+ */
+class IoExecutor {
+
+public:
+  /**
+   * @brief Constructor.
+   */
+  IoExecutor();
+
+  /**
+   * @brief Non-copyable.
+   */
+  IoExecutor(const IoExecutor&) = delete;
+
+  /**
+   * @brief Non-copyable.
+   */
+  IoExecutor& operator=(const IoExecutor&) = delete;
+
+  /**
+   * @brief Execute the pending tasks and stop the thread.
+   */
+  ~IoExecutor();
+
+  /**
+   * @brief Submit a task.
+   * @return A future to the value returned by the task
+   */
+  template <typename TFunc>
+  std::future<decltype(std::declval<TFunc>()())> submit(TFunc&& func);
+
+  /**
+   * @brief Wait until all the submitted tasks were executed.
+   */
+  void wait();
+
+  /**
+   * @brief Get the number of tasks which are not completed yet.
+   */
+  long pendingCount() const;
+
+private:
+  /**
+   * @brief Append a task to the queue, and start the thread if needed.
+   */
+  void push(std::function<void()> task);
+
+  /**
+   * @brief The thread loop.
+   */
+  void run();
+
+  /**
+   * @brief The mutex which protects the queue and flags.
+   */
+  mutable std::mutex m_mutex;
+
+  /**
+   * @brief The notifier of new tasks and of stop requests.
+   */
+  std::condition_variable m_wake;
+
+  /**
+   * @brief The notifier of empty queue.
+   */
+  std::condition_variable m_idle;
+
+  /**
+   * @brief The tasks not started yet.
+   */
+  std::deque<std::function<void()>> m_tasks;
+
+  /**
+   * @brief Whether a task is being executed.
+   */
+  bool m_busy;
+
+  /**
+   * @brief Whether the thread was requested to stop.
+   */
+  bool m_stop;
+
+  /**
+   * @brief The I/O thread.
+   */
+  std::thread m_thread;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITS_IOEXECUTOR_IMPL
+#include "EleFits/impl/IoExecutor.hpp"
+#undef _ELEFITS_IOEXECUTOR_IMPL
+/// @endcond
+
+#endif
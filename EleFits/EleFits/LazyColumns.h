@@ -0,0 +1,229 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_LAZYCOLUMNS_H
+#define _ELEFITS_LAZYCOLUMNS_H
+
+#include "EleFits/BintableColumns.h"
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_handlers
+ * @brief Lazy view of the columns of a binary table, which reads columns on first access and caches them.
+ * @details
+ * This is useful for wide tables, of which only some columns are used, in an order which is not known in advance:
+ * reading all the columns with `BintableColumns::readSeq()` would be a waste of memory and time,
+ * while reading the columns one by one with `BintableColumns::read()` would scan the table once per column.
+ *
+ * Columns are accessed through shared handles.
+ * The columns requested in the same call to `getSeq()` which are not cached yet are read together,
+ * chunk-wise, like with `BintableColumns::readSeq()`, such that the table is scanned only once.
+ * The columns are then cached until the total size of the cached values exceeds the memory budget,
+ * in which case the least recently used columns are evicted.
+ * Evicting a column never invalidates the handles which were returned:
+ * the values are freed only when no handle points to them anymore.
+ *
+ * Example usage:
+ * \code
+ * LazyColumns lazy(hdu.columns(), 512 * 1024 * 1024);
+ * auto ra = lazy.get<double>("RA"); // Read
+ * std::shared_ptr<const VecColumn<double>> dec;
+ * std::shared_ptr<const VecColumn<float>> flux;
+ * std::tie(ra, dec, flux) = lazy.getSeq(Named<double>("RA"), Named<double>("DEC"), Named<float>("FLUX"));
+ * // RA is taken from the cache, DEC and FLUX are read together
+ * \endcode
+ * @warning
+ * The cache is not updated when the table is modified, in which case `clear()` should be called.
+ */
+class LazyColumns {
+
+public:
+  /**
+   * @brief Create a lazy view.
+   * @param columns The data unit
+   * @param budget The maximum number of bytes of the cached values
+   */
+  explicit LazyColumns(const BintableColumns& columns, std::size_t budget = std::size_t(1) << 30);
+
+  /**
+   * @brief Get the memory budget, in bytes.
+   */
+  std::size_t budget() const;
+
+  /**
+   * @brief Set the memory budget, in bytes, and evict columns if needed.
+   */
+  void setBudget(std::size_t budget);
+
+  /**
+   * @brief Get the number of bytes of the cached values.
+   */
+  std::size_t byteCount() const;
+
+  /**
+   * @brief Get the number of columns which were read from the file so far.
+   */
+  long readColumnCount() const;
+
+  /**
+   * @brief Check whether a column is cached.
+   */
+  bool isCached(const std::string& name) const;
+
+  /**
+   * @brief Get a column, which is read if not cached.
+   */
+  template <typename T>
+  std::shared_ptr<const VecColumn<T>> get(const std::string& name);
+
+  /**
+   * @brief Get a sequence of columns, where those which are not cached are read together.
+   * @details
+   * The requested columns are never evicted by the call itself, even if they exceed the budget.
+   */
+  template <typename... Ts>
+  std::tuple<std::shared_ptr<const VecColumn<Ts>>...> getSeq(const Named<Ts>&... names);
+
+  /**
+   * @brief Remove a column from the cache.
+   */
+  void evict(const std::string& name);
+
+  /**
+   * @brief Remove all the columns from the cache.
+   */
+  void clear();
+
+private:
+  /**
+   * @brief A cached column.
+   */
+  struct Entry {
+
+    /**
+     * @brief The type-erased column.
+     */
+    std::shared_ptr<const void> column;
+
+    /**
+     * @brief The value type of the column.
+     */
+    std::type_index type;
+
+    /**
+     * @brief The number of bytes of the values.
+     */
+    std::size_t byteCount;
+
+    /**
+     * @brief The position of the column in the LRU list.
+     */
+    std::list<std::string>::iterator position;
+  };
+
+  /**
+   * @brief Get a cached column and mark it as the most recently used one, or a null pointer if not cached.
+   * @details
+   * A column cached with another value type is considered as not cached.
+   */
+  template <typename T>
+  std::shared_ptr<const VecColumn<T>> find(const std::string& name);
+
+  /**
+   * @brief Get a cached column, or allocate it and schedule its reading if not cached.
+   */
+  template <typename T>
+  void prepare(
+      const Named<T>& name,
+      long rowCount,
+      std::shared_ptr<const VecColumn<T>>& handle,
+      std::vector<std::function<void(const Segment&)>>& reads,
+      std::vector<std::function<void()>>& inserts);
+
+  /**
+   * @brief Get a sequence of columns.
+   */
+  template <typename... Ts, std::size_t... Is>
+  std::tuple<std::shared_ptr<const VecColumn<Ts>>...>
+  getSeqImpl(std::index_sequence<Is...>, const Named<Ts>&... names);
+
+  /**
+   * @brief Cache a column as the most recently used one.
+   */
+  void insert(const std::string& name, std::shared_ptr<const void> column, std::type_index type, std::size_t byteCount);
+
+  /**
+   * @brief Evict the least recently used columns until the budget is respected, except for some pinned columns.
+   */
+  void shrink(const std::vector<std::string>& pinned = {});
+
+  /**
+   * @brief The data unit.
+   */
+  const BintableColumns& m_columns;
+
+  /**
+   * @brief The memory budget.
+   */
+  std::size_t m_budget;
+
+  /**
+   * @brief The number of bytes of the cached values.
+   */
+  std::size_t m_byteCount;
+
+  /**
+   * @brief The number of columns read.
+   */
+  long m_readColumnCount;
+
+  /**
+   * @brief The cached columns.
+   */
+  std::map<std::string, Entry> m_entries;
+
+  /**
+   * @brief The names of the cached columns, most recently used first.
+   */
+  std::list<std::string> m_lru;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITS_LAZYCOLUMNS_IMPL
+#include "EleFits/impl/LazyColumns.hpp"
+#undef _ELEFITS_LAZYCOLUMNS_IMPL
+/// @endcond
+
+#endif
@@ -20,11 +20,13 @@
 #ifndef _ELEFITS_MEFFILE_H
 #define _ELEFITS_MEFFILE_H
 
+#include "EleCfitsioWrapper/IoStats.h"
 #include "EleFits/BintableHdu.h"
 #include "EleFits/FitsFile.h"
 #include "EleFits/Hdu.h"
 #include "EleFits/ImageHdu.h"
 
+#include <iostream> // clog
 #include <memory>
 #include <vector>
 
@@ -35,6 +37,9 @@ namespace Fits {
 template <typename THdu>
 class HduSelector;
 
+// Forward declaration for MefFile::assignImageExts()
+class ImageWritePlan;
+
 /**
  * @ingroup file_handlers
  * @brief Multi-Extension Fits file reader-writer.
@@ -51,13 +56,18 @@ public:
   /**
    * @copydoc FitsFile::~FitsFile
    */
-  virtual ~MefFile() = default;
+  virtual ~MefFile();
 
   /**
    * @copydoc FitsFile::FitsFile
    */
   MefFile(const std::string& filename, FileMode permission);
 
+  /**
+   * @copydoc FitsFile::FitsFile(MemoryBuffer&, FileMode)
+   */
+  MefFile(MemoryBuffer& buffer, FileMode permission);
+
   /**
    * @brief Get the number of HDUs.
    * @details
@@ -83,6 +93,86 @@ public:
    */
   std::vector<std::pair<std::string, long>> readHduNamesVersions();
 
+  /**
+   * @brief Get the I/O counters of the file, aggregated for the whole file and per HDU.
+   * @details
+   * Counters are recorded only while `Cfitsio::IoStats` is enabled, e.g.:
+   * \code
+   * Cfitsio::IoStats::enable();
+   * MefFile f(filename, FileMode::Read);
+   * ... // Process the file
+   * const auto stats = f.ioStats();
+   * logger.info() << stats.total.hduMoves << " HDU moves, " << stats.total.cardScans << " cards scanned";
+   * \endcode
+   * @see Cfitsio::IoStats
+   */
+  Cfitsio::IoFileStats ioStats() const;
+
+  /**
+   * @brief Start detecting the access patterns which are detrimental to performance.
+   * @param thresholds The minimum number of occurrences for a pattern to be reported
+   * @param report The stream to which the report is written when the file is closed
+   * @details
+   * The report lists the detected patterns, their number of occurrences, the estimated waste,
+   * and the EleFits API to be used instead, e.g. `BintableColumns::readSeq()` instead of chained column reads.
+   * Calling this method again restarts the detection from scratch.
+   * @see AccessDiagnostics
+   */
+  void enableDiagnostics(const AccessThresholds& thresholds = {}, std::ostream& report = std::clog);
+
+  /**
+   * @brief Get the access pattern detector, or `nullptr` if `enableDiagnostics()` was not called.
+   */
+  const AccessDiagnostics* diagnostics() const;
+
+  /**
+   * @brief Enable reading the file from several threads at once.
+   * @details
+   * Once enabled, the HDU handlers returned by `access()`, `accessFirst()`, `primary()` and the HDU selectors
+   * are bound to a CFitsIO handle which is specific to the calling thread,
+   * and which is taken from a pool of handles to the same file (see `HandlePool`).
+   * Each thread therefore has its own current HDU, and several threads can read different HDUs,
+   * or different columns of the same table, simultaneously:
+   * \code
+   * MefFile f(filename, FileMode::Read);
+   * f.enableConcurrentReads();
+   * std::vector<std::thread> threads;
+   * for (long i = 1; i < f.hduCount(); ++i) {
+   *   threads.emplace_back([&f, i]() {
+   *     const auto raster = f.access<ImageHdu>(i).raster().read<float>();
+   *     ... // Process the raster
+   *     f.releaseThreadHandle();
+   *   });
+   * }
+   * for (auto& t : threads) {
+   *   t.join();
+   * }
+   * \endcode
+   * Handlers must not be passed from one thread to another.
+   * Handlers which were obtained before enabling concurrent reads are still bound to the main handle,
+   * and can be used by a single thread only.
+   * Access diagnostics are not fed by the handlers of the pool.
+   * Concurrent reads are disabled when the file is closed.
+   * @warning
+   * This requires that CFitsIO was built thread-safe (which is the default).
+   * @throw FitsError if the file is not opened with `FileMode::Read`
+   */
+  void enableConcurrentReads();
+
+  /**
+   * @brief Give the CFitsIO handle of the calling thread back to the pool, for reuse by another thread.
+   * @details
+   * This bounds the number of open handles when the file is read by short-lived threads.
+   * The handlers obtained by the calling thread must not be used after the call.
+   * Nothing is done if concurrent reads are disabled.
+   */
+  void releaseThreadHandle();
+
+  /**
+   * @brief Get the number of CFitsIO handles opened for concurrent reads.
+   */
+  long concurrentHandleCount() const;
+
   /**
    * @brief Access the HDU at given 0-based index.
    * @tparam T The type of HDU: ImageHdu, BintableHdu, or Hdu to just handle metadata.
@@ -181,6 +271,19 @@ public:
   template <typename T, long n>
   const ImageHdu& assignImageExt(const std::string& name, const Raster<T, n>& raster);
 
+  /**
+   * @brief Append a batch of ImageHdus, and write their data units in parallel.
+   * @param plan The planned image extensions
+   * @param threadCount The number of threads, or 0 to use as many threads as hardware ones
+   * @details
+   * The headers are written first, then the file is closed and its layout is read,
+   * such that the data units are encoded and written concurrently with positioned writes.
+   * The file is finally reopened, and the new HDUs can be accessed as usual.
+   * This is much faster than calling assignImageExt() in a loop when there are many extensions.
+   * @see ImageWritePlan
+   */
+  void assignImageExts(const ImageWritePlan& plan, long threadCount = 0);
+
   /**
    * @brief Append a BintableHdu with given name and columns info.
    * @details
@@ -232,6 +335,11 @@ protected:
   template <class T = Hdu>
   const T& appendExt(T extension);
 
+  /**
+   * @brief Connect an HDU handler to the executor and to the access pattern detector, if any.
+   */
+  void watch(Hdu& hdu);
+
   /**
    * @brief Vector of `Hdu`s (castable to `ImageHdu` or `BintableHdu`).
    * @warning
@@ -0,0 +1,385 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_MEFFILECACHE_H
+#define _ELEFITS_MEFFILECACHE_H
+
+#include "EleFits/MefFile.h"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup file_handlers
+ * @brief A bounded set of open `MefFile`s, which are closed in least-recently-used order.
+ * @details
+ * Workloads which touch many files repeatedly, like cutouts across thousands of exposures,
+ * cannot keep all the files open (because of file descriptor limits),
+ * and would waste time reopening them for each access.
+ * The cache keeps up to a given number of files open, and closes the least recently used ones when needed.
+ * Files are accessed through a `Lease`, which reopens the file transparently if it was evicted:
+ * \code
+ * MefFileCache cache(128);
+ * for (const auto& d : detections) {
+ *   auto file = cache.acquire(d.filename);
+ *   stamps.push_back(file.access<ImageHdu>("SCI").raster().readRegion<float, 2>(d.region));
+ * }
+ * \endcode
+ *
+ * The cache is safe for concurrent use: a lease gives exclusive access to the file,
+ * such that threads which acquire the same file are serialized, while different files are accessed in parallel.
+ * Leased files are never evicted, such that the number of open files can temporarily exceed the capacity
+ * by the number of concurrent leases.
+ *
+ * The names and versions of the HDUs are read at most once per file, and kept across reopenings,
+ * such that `Lease::access()` by name does not scan the headers again after a reopening.
+ * They are small compared to an open file, such that they are kept for many more files than the capacity,
+ * up to a separate limit with least recently used eviction, see `setMetadataCapacity()`.
+ * Hits, misses and evictions are counted, see `stats()`.
+ *
+ * Besides explicit caches, a process-wide cache is provided by `global()`.
+ */
+class MefFileCache {
+
+private:
+  struct Entry;
+
+public:
+  /**
+   * @brief The usage statistics.
+   */
+  struct Stats {
+
+    /**
+     * @brief The number of acquisitions of a file which was in the cache.
+     */
+    long hits = 0;
+
+    /**
+     * @brief The number of acquisitions which required opening the file.
+     */
+    long misses = 0;
+
+    /**
+     * @brief The number of files closed to respect the capacity.
+     */
+    long evictions = 0;
+  };
+
+  /**
+   * @brief An exclusive access to a file of the cache.
+   * @details
+   * The file is kept open and locked while the lease is alive, and released at destruction.
+   */
+  class Lease {
+
+    friend class MefFileCache;
+
+  public:
+    /**
+     * @brief Move constructor.
+     */
+    Lease(Lease&& other);
+
+    /**
+     * @brief Non-copyable.
+     */
+    Lease(const Lease&) = delete;
+
+    /**
+     * @brief Non-assignable.
+     */
+    Lease& operator=(const Lease&) = delete;
+
+    /**
+     * @brief Release the file.
+     */
+    ~Lease();
+
+    /**
+     * @brief Get the file.
+     */
+    MefFile& file();
+
+    /**
+     * @brief Get the file.
+     */
+    MefFile& operator*();
+
+    /**
+     * @brief Get the file.
+     */
+    MefFile* operator->();
+
+    /**
+     * @brief Read the names and versions of the HDUs, or get them from the cache.
+     * @details
+     * The returned reference is valid as long as the lease is alive.
+     */
+    const std::vector<std::pair<std::string, long>>& readHduNamesVersions();
+
+    /**
+     * @brief Get the index of the first HDU with given name and optional version.
+     * @param name The HDU name
+     * @param version The HDU version, or 0 to ignore the version
+     * @throw FitsError if there is no such HDU
+     */
+    long readHduIndex(const std::string& name, long version = 0);
+
+    /**
+     * @brief Access the first HDU with given name and optional version.
+     * @details
+     * This is equivalent to `MefFile::accessFirst()`, but the index is looked up in the cached names.
+     */
+    template <class T = Hdu>
+    const T& access(const std::string& name, long version = 0);
+
+  private:
+    /**
+     * @brief Constructor.
+     */
+    Lease(MefFileCache& cache, Entry& entry, std::unique_lock<std::mutex> lock);
+
+    /**
+     * @brief The cache.
+     */
+    MefFileCache* m_cache;
+
+    /**
+     * @brief The entry, or `nullptr` if moved.
+     */
+    Entry* m_entry;
+
+    /**
+     * @brief The lock on the entry.
+     */
+    std::unique_lock<std::mutex> m_lock;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param capacity The maximum number of open files, which is exceeded only by leased files
+   * @param permission The opening mode of the files, either `FileMode::Read` or `FileMode::Edit`
+   * @param metadataCapacity The maximum number of files whose HDU names and versions are kept
+   * @throw FitsError if the mode would create or overwrite the files
+   */
+  explicit MefFileCache(long capacity = 64, FileMode permission = FileMode::Read, long metadataCapacity = 65536);
+
+  /**
+   * @brief Non-copyable.
+   */
+  MefFileCache(const MefFileCache&) = delete;
+
+  /**
+   * @brief Non-copyable.
+   */
+  MefFileCache& operator=(const MefFileCache&) = delete;
+
+  /**
+   * @brief Close the files.
+   * @warning
+   * All the leases must have been released.
+   */
+  ~MefFileCache();
+
+  /**
+   * @brief Get the process-wide cache, of capacity 64 and in read mode.
+   */
+  static MefFileCache& global();
+
+  /**
+   * @brief Get an exclusive access to a file, which is opened if needed.
+   * @details
+   * If the file is leased by another thread, wait until it is released.
+   */
+  Lease acquire(const std::string& filename);
+
+  /**
+   * @brief Get the maximum number of open files, which is exceeded only by leased files.
+   */
+  long capacity() const;
+
+  /**
+   * @brief Set the maximum number of open files, and close files which are not leased if needed.
+   */
+  void setCapacity(long capacity);
+
+  /**
+   * @brief Get the maximum number of files whose HDU names and versions are kept.
+   */
+  long metadataCapacity() const;
+
+  /**
+   * @brief Set the maximum number of files whose HDU names and versions are kept, and forget some if needed.
+   * @details
+   * The metadata of the least recently used files are forgotten first, except that of leased files,
+   * such that the limit can temporarily be exceeded by the number of concurrent leases.
+   */
+  void setMetadataCapacity(long capacity);
+
+  /**
+   * @brief Get the number of files whose HDU names and versions are kept.
+   */
+  long metadataCount() const;
+
+  /**
+   * @brief Get the number of open files.
+   */
+  long openCount() const;
+
+  /**
+   * @brief Get the usage statistics.
+   */
+  Stats stats() const;
+
+  /**
+   * @brief Close all the files which are not leased.
+   * @details
+   * HDU names and versions are kept.
+   */
+  void clear();
+
+private:
+  /**
+   * @brief An open file.
+   */
+  struct Entry {
+
+    /**
+     * @brief Constructor.
+     */
+    explicit Entry(const std::string& name);
+
+    /**
+     * @brief The file name.
+     */
+    std::string filename;
+
+    /**
+     * @brief The file, or `nullptr` if not opened yet.
+     */
+    std::unique_ptr<MefFile> file;
+
+    /**
+     * @brief The mutex held by the lease.
+     */
+    std::mutex mutex;
+
+    /**
+     * @brief The number of leases which hold or wait for the entry.
+     */
+    long users;
+  };
+
+  /**
+   * @brief Release an entry.
+   */
+  void release(Entry& entry);
+
+  /**
+   * @brief Remove the least recently used entries which are not leased, until the capacity is respected.
+   * @param evicted The list the removed entries are moved to
+   * @details
+   * The cache mutex must be locked.
+   * The files are closed when the removed entries are destroyed, which should happen after unlocking,
+   * such that other threads are not blocked by the closing.
+   */
+  void evict(std::list<Entry>& evicted);
+
+  /**
+   * @brief Forget the HDU names and versions of the least recently used files which are not leased,
+   * until the metadata capacity is respected.
+   * @details
+   * The cache mutex must be locked.
+   */
+  void evictMetadata();
+
+  /**
+   * @brief Get the names and versions of the HDUs, and read them if needed.
+   * @details
+   * The entry must be locked.
+   */
+  const std::vector<std::pair<std::string, long>>& namesVersions(Entry& entry);
+
+  /**
+   * @brief The capacity.
+   */
+  long m_capacity;
+
+  /**
+   * @brief The opening mode.
+   */
+  FileMode m_permission;
+
+  /**
+   * @brief The mutex which protects the entries, metadata and statistics.
+   */
+  mutable std::mutex m_mutex;
+
+  /**
+   * @brief The entries, from the most recently to the least recently used.
+   */
+  std::list<Entry> m_entries;
+
+  /**
+   * @brief The entries by file name.
+   */
+  std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+
+  /**
+   * @brief The maximum number of files whose HDU names and versions are kept.
+   */
+  long m_metadataCapacity;
+
+  /**
+   * @brief The HDU names and versions of each file, from the most recently to the least recently used.
+   * @details
+   * They are kept after the eviction of the file, and have their own capacity.
+   */
+  std::list<std::pair<std::string, std::vector<std::pair<std::string, long>>>> m_metadata;
+
+  /**
+   * @brief The HDU names and versions by file name.
+   */
+  std::unordered_map<std::string, decltype(m_metadata)::iterator> m_metadataIndex;
+
+  /**
+   * @brief The statistics.
+   */
+  Stats m_stats;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITS_MEFFILECACHE_IMPL
+#include "EleFits/impl/MefFileCache.hpp"
+#undef _ELEFITS_MEFFILECACHE_IMPL
+/// @endcond
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_PARALLELFOR_H
+#define _ELEFITS_PARALLELFOR_H
+
+#include <functional>
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Apply a function to each index of a range, in parallel.
+ * @param count The number of indices, from 0 to `count - 1`
+ * @param threadCount The number of threads, or 0 to use as many threads as hardware ones
+ * @param func The function, which takes the index and the thread index
+ * @details
+ * The indices are distributed dynamically, such that uneven tasks are balanced.
+ * The thread index is between 0 and the actual number of threads minus 1, where 0 is the calling thread.
+ * The first exception thrown by a thread is rethrown once all threads have finished,
+ * and the other threads stop taking new indices.
+ */
+void parallelFor(long count, long threadCount, const std::function<void(long, long)>& func);
+
+} // namespace Internal
+/// @endcond
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
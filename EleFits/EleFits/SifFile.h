@@ -39,13 +39,18 @@ public:
   /**
    * @copydoc FitsFile::~FitsFile
    */
-  virtual ~SifFile() = default;
+  virtual ~SifFile();
 
   /**
    * @copydoc FitsFile::FitsFile
    */
   SifFile(const std::string& filename, FileMode permission);
 
+  /**
+   * @copydoc FitsFile::FitsFile(MemoryBuffer&, FileMode)
+   */
+  SifFile(MemoryBuffer& buffer, FileMode permission);
+
   /**
    * @brief Access the header unit.
    * @warning
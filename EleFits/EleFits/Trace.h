@@ -0,0 +1,359 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_TRACE_H
+#define _ELEFITS_TRACE_H
+
+#include "EleFitsData/DataUtils.h"
+#include "EleFitsData/Region.h"
+
+#include <array>
+#include <atomic>
+#include <fitsio.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Expand to its arguments if `ELEFITS_ENABLE_TRACE` is defined, and to nothing otherwise.
+ * @details
+ * This is used to declare and feed tracing spans, such that they are compiled out by default:
+ * \code
+ * ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::write"));
+ * m_edit();
+ * ELEFITS_TRACE(span.hdu(m_fptr); span.bytes(raster.size() * sizeof(T)));
+ * \endcode
+ * Since part of the instrumented code lives in headers, the macro `ELEFITS_ENABLE_TRACE`
+ * should be defined consistently for EleFits and for the client code
+ * (this is done by the `ELEFITS_ENABLE_TRACE` CMake option).
+ */
+#ifdef ELEFITS_ENABLE_TRACE
+  #define ELEFITS_TRACE(...) __VA_ARGS__
+#else
+  #define ELEFITS_TRACE(...)
+#endif
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @brief A completed operation, as recorded by a `TraceSpan`.
+ */
+struct TraceEvent {
+
+  /**
+   * @brief The maximum length of the detail string, including the null terminator.
+   */
+  static constexpr std::size_t detailCapacity = 48;
+
+  /**
+   * @brief The category, e.g. "image", as a string literal.
+   */
+  const char* category = "";
+
+  /**
+   * @brief The operation name, e.g. "ImageRaster::readTo", as a string literal.
+   */
+  const char* name = "";
+
+  /**
+   * @brief The id of the recording thread, starting at 1.
+   */
+  long thread = 0;
+
+  /**
+   * @brief The 0-based HDU index, or -1 if the operation is not bound to an HDU.
+   */
+  long hdu = -1;
+
+  /**
+   * @brief The number of data bytes moved.
+   */
+  long bytes = 0;
+
+  /**
+   * @brief The start time, in microseconds since the trace origin.
+   */
+  double start = 0;
+
+  /**
+   * @brief The duration, in microseconds.
+   */
+  double duration = 0;
+
+  /**
+   * @brief A short null-terminated description of the rows, region or keyword, possibly truncated.
+   */
+  std::array<char, detailCapacity> detail {};
+};
+
+/**
+ * @brief A single-producer ring buffer of trace events.
+ * @details
+ * The buffer is written by its owning thread only, without locking.
+ * When the buffer is full, the oldest events are overwritten.
+ */
+class TraceBuffer {
+
+public:
+  /**
+   * @brief Constructor.
+   */
+  TraceBuffer(long thread, std::size_t capacity);
+
+  /**
+   * @brief Get the id of the owning thread.
+   */
+  long thread() const;
+
+  /**
+   * @brief Get the maximum number of events.
+   */
+  std::size_t capacity() const;
+
+  /**
+   * @brief Get the number of events which were overwritten since the last `clear()`.
+   */
+  std::size_t dropCount() const;
+
+  /**
+   * @brief Append an event, which is stamped with the thread id.
+   */
+  void push(TraceEvent event);
+
+  /**
+   * @brief Get a copy of the events, from the oldest to the newest.
+   */
+  std::vector<TraceEvent> events() const;
+
+  /**
+   * @brief Discard the events.
+   */
+  void clear();
+
+private:
+  /**
+   * @brief The owning thread id.
+   */
+  long m_thread;
+
+  /**
+   * @brief The events storage.
+   */
+  std::vector<TraceEvent> m_events;
+
+  /**
+   * @brief The total number of events pushed since the last `clear()`.
+   */
+  std::atomic<std::size_t> m_head;
+};
+
+/**
+ * @brief Registry of the per-thread trace buffers, and Chrome trace exporter.
+ * @details
+ * When EleFits is compiled with `ELEFITS_ENABLE_TRACE`, operations on `ImageRaster`, `BintableColumns`, `Header`
+ * and `MefFile` are wrapped in `TraceSpan`s, which record the operation, HDU, rows or region, bytes moved,
+ * thread, and timing.
+ * Recording must additionally be enabled at runtime with `enable()`.
+ * Otherwise, spans are not even compiled, and this class is only useful to user-defined spans.
+ *
+ * Events are exported as Chrome trace JSON, which can be loaded in `chrome://tracing` or in Perfetto,
+ * such that the time spent in EleFits can be compared to that of the client code,
+ * which can declare its own spans.
+ *
+ * Export and reset are meant to be called once the traced threads are idle:
+ * events being recorded concurrently may be missed.
+ *
+ * \code
+ * Tracer::enable();
+ * {
+ *   TraceSpan span("pipeline", "calibrate"); // Client span
+ *   f.primary().raster().read<float>(); // Traced EleFits operation
+ * }
+ * Tracer::writeChromeTrace("/tmp/trace.json");
+ * \endcode
+ */
+class Tracer {
+
+public:
+  /**
+   * @brief Start recording.
+   */
+  static void enable();
+
+  /**
+   * @brief Stop recording, while keeping the recorded events.
+   */
+  static void disable();
+
+  /**
+   * @brief Check whether recording is enabled.
+   */
+  static bool isEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Discard the events, and forget the buffers of terminated threads.
+   */
+  static void reset();
+
+  /**
+   * @brief Set the capacity of the buffers of threads which did not record any event yet.
+   */
+  static void setBufferCapacity(std::size_t capacity);
+
+  /**
+   * @brief Get the number of microseconds since the trace origin.
+   */
+  static double now();
+
+  /**
+   * @brief Record an event in the buffer of the calling thread.
+   */
+  static void record(const TraceEvent& event);
+
+  /**
+   * @brief Get the events of all threads, ordered by start time.
+   */
+  static std::vector<TraceEvent> events();
+
+  /**
+   * @brief Write the events as Chrome trace JSON.
+   */
+  static void writeChromeTrace(std::ostream& out);
+
+  /**
+   * @brief Write the events as Chrome trace JSON in a file.
+   */
+  static void writeChromeTrace(const std::string& filename);
+
+private:
+  /**
+   * @brief The recording flag.
+   */
+  static std::atomic<bool> s_enabled;
+};
+
+/**
+ * @brief RAII helper which records an operation as a `TraceEvent`, from construction to destruction.
+ * @details
+ * Category and name must be string literals (or strings which outlive the trace), because they are not copied.
+ * When the `Tracer` is disabled, the span does nothing.
+ */
+class TraceSpan {
+
+public:
+  /**
+   * @brief Start the span.
+   */
+  TraceSpan(const char* category, const char* name);
+
+  /**
+   * @brief Non-copyable.
+   */
+  TraceSpan(const TraceSpan&) = delete;
+
+  /**
+   * @brief Non-copyable.
+   */
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+  /**
+   * @brief Stop the span and record it.
+   */
+  ~TraceSpan();
+
+  /**
+   * @brief Attribute the span to a given HDU (0-based).
+   */
+  void hdu(long index) {
+    m_event.hdu = index;
+  }
+
+  /**
+   * @brief Attribute the span to the current HDU of a file.
+   */
+  void hdu(fitsfile* fptr);
+
+  /**
+   * @brief Declare a number of bytes moved.
+   */
+  void bytes(long count) {
+    m_event.bytes += count;
+  }
+
+  /**
+   * @brief Describe the span with a rows segment (0-based).
+   */
+  void rows(const Segment& segment);
+
+  /**
+   * @brief Describe the span with an image region (0-based).
+   */
+  template <long n>
+  void region(const Region<n>& region) {
+    if (not m_enabled) {
+      return;
+    }
+    std::string text = "[";
+    for (long i = 0; i < region.dimension(); ++i) {
+      text += (i == 0 ? "" : ", ") + std::to_string(region.front[i]) + ":" + std::to_string(region.back[i]);
+    }
+    detail(text + "]");
+  }
+
+  /**
+   * @brief Describe the span with an image region, given by its front position and the shape of its first axes.
+   * @details
+   * The region is of length 1 along the other axes.
+   */
+  template <long n, long m>
+  void region(const Position<n>& front, const Position<m>& shape) {
+    if (not m_enabled) {
+      return;
+    }
+    auto back = front;
+    for (long i = 0; i < shape.size(); ++i) {
+      back[i] += shape[i] - 1;
+    }
+    region(Region<n> { front, back });
+  }
+
+  /**
+   * @brief Describe the span with some text, truncated to fit `TraceEvent::detailCapacity`.
+   */
+  void detail(const std::string& text);
+
+private:
+  /**
+   * @brief Whether the span is recorded.
+   */
+  bool m_enabled;
+
+  /**
+   * @brief The event being recorded.
+   */
+  TraceEvent m_event;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -0,0 +1,219 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_ZONEMAP_H
+#define _ELEFITS_ZONEMAP_H
+
+#include "EleFitsData/Column.h"
+
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+// Forward declarations for ZoneMap::read() and ZoneMap::write()
+class BintableHdu;
+class MefFile;
+
+/**
+ * @ingroup bintable_handlers
+ * @brief Per-zone summaries of binary table columns, used to skip zones which cannot match a range query.
+ * @details
+ * The rows of the table are split into zones of `zoneRowCount()` rows.
+ * For each tracked column and each zone, the minimum and maximum values and the number of NaNs are stored.
+ * The summaries are built incrementally while writing, without an extra pass on the data,
+ * by attaching the zone map to the `BintableColumns` handler with `BintableColumns::setZoneMap()`.
+ *
+ * The zone map is persisted as a binary table, either as a companion extension of the summarized table,
+ * or in a sidecar file, with `write()` and `read()`.
+ *
+ * Candidate rows of a range query are obtained with `select()`,
+ * and given to `BintableColumns::readFilteredSeq()` to skip the other zones.
+ *
+ * Example usage:
+ * \code
+ * ZoneMap zones({ "DEC", "MJD" });
+ * auto columns = f.initBintableExt("CATALOG", decInfo, mjdInfo).columns(); // Copy to attach the zone map
+ * columns.setZoneMap(&zones);
+ * columns.writeSeq(dec, mjd); // Zones are updated on the fly
+ * zones.write(f, "CATALOG_ZONES");
+ *
+ * // Later
+ * const auto zones = ZoneMap::read(f.access<BintableHdu>("CATALOG_ZONES"));
+ * auto selected = columns.readFilteredSeq(
+ *     zones.select("DEC", 10, 20),
+ *     std::make_tuple(Named<double>("DEC")),
+ *     [](double dec) {
+ *       return dec >= 10 && dec <= 20;
+ *     },
+ *     Named<double>("MJD"));
+ * \endcode
+ *
+ * Summaries are conservative:
+ * when rows are overwritten, the bounds are widened and the number of NaNs becomes unknown;
+ * when rows are skipped by a write, the bounds of the skipped zones are infinite.
+ * Rows which are beyond the tracked rows (e.g. written without the zone map) are always candidates.
+ * @warning
+ * Row insertion and deletion are not tracked.
+ */
+class ZoneMap {
+
+public:
+  /**
+   * @brief The summary of a column over a zone.
+   */
+  struct Zone {
+
+    /** @brief The minimum value, or +infinity if there are no values. */
+    double min;
+
+    /** @brief The maximum value, or -infinity if there are no values. */
+    double max;
+
+    /** @brief The number of NaNs, or -1 if unknown. */
+    long nullCount;
+
+    /** @brief The number of tracked rows. */
+    long rowCount;
+  };
+
+  /**
+   * @brief Create an empty zone map.
+   * @param names The names of the columns to be tracked
+   * @param zoneRowCount The number of rows per zone
+   */
+  explicit ZoneMap(const std::vector<std::string>& names, long zoneRowCount = 10000);
+
+  /**
+   * @brief Read a zone map from a binary table HDU.
+   */
+  static ZoneMap read(const BintableHdu& hdu);
+
+  /**
+   * @brief Write the zone map as a new binary table extension.
+   * @details
+   * The extension can be appended to the file which contains the summarized table, or to a sidecar file.
+   */
+  void write(MefFile& f, const std::string& name) const;
+
+  /**
+   * @brief Get the number of rows per zone.
+   */
+  long zoneRowCount() const;
+
+  /**
+   * @brief Get the names of the tracked columns.
+   */
+  std::vector<std::string> names() const;
+
+  /**
+   * @brief Check whether a column is tracked.
+   */
+  bool has(const std::string& name) const;
+
+  /**
+   * @brief Get the zones of a tracked column.
+   */
+  const std::vector<Zone>& zones(const std::string& name) const;
+
+  /**
+   * @brief Get the number of tracked rows of a column.
+   */
+  long rowCount(const std::string& name) const;
+
+  /**
+   * @brief Update the zones with a column segment, if the column is tracked.
+   * @param firstRow The 0-based index in the table of the first row of the segment
+   * @param column The segment
+   * @details
+   * This is called by the write methods of `BintableColumns` when the zone map is attached.
+   * Only arithmetic columns can be tracked.
+   */
+  template <typename T>
+  void update(long firstRow, const Column<T>& column);
+
+  /**
+   * @brief Get the row segments which may contain values of a column in a given range.
+   * @param name The column name
+   * @param min The included lower bound
+   * @param max The included upper bound
+   * @details
+   * Consecutive candidate zones are merged, and the rows beyond the tracked rows are appended as `{ front, -1 }`.
+   */
+  std::vector<Segment> select(const std::string& name, double min, double max) const;
+
+private:
+  /**
+   * @brief Update the zones of a column with a sequence of rows.
+   */
+  template <typename T>
+  void updateRows(
+      const std::string& name,
+      long firstRow,
+      long rowCount,
+      long rowWidth,
+      const T* values,
+      std::true_type);
+
+  /**
+   * @brief Non-arithmetic columns cannot be tracked.
+   */
+  template <typename T>
+  void updateRows(
+      const std::string& name,
+      long firstRow,
+      long rowCount,
+      long rowWidth,
+      const T* values,
+      std::false_type);
+
+  /**
+   * @brief Mark rows skipped by a write as unknown.
+   */
+  void markSkipped(std::vector<Zone>& zones, long front, long back) const;
+
+  /**
+   * @brief Get the zone of a row, and create it if needed.
+   */
+  Zone& zoneAt(std::vector<Zone>& zones, long row) const;
+
+  /**
+   * @brief The number of rows per zone.
+   */
+  long m_zoneRowCount;
+
+  /**
+   * @brief The zones of each tracked column.
+   */
+  std::map<std::string, std::vector<Zone>> m_zones;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITS_ZONEMAP_IMPL
+#include "EleFits/impl/ZoneMap.hpp"
+#undef _ELEFITS_ZONEMAP_IMPL
+/// @endcond
+
+#endif
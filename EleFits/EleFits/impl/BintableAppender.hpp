@@ -0,0 +1,184 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITS_BINTABLEAPPENDER_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleCfitsioWrapper/BintableWrapper.h"
+  #include "EleCfitsioWrapper/FileWrapper.h"
+  #include "EleFits/BintableAppender.h"
+
+  #include <algorithm> // copy_n, max, min
+  #include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+template <typename... Ts>
+BintableAppender<Ts...>::BintableAppender(
+    const BintableHdu& hdu,
+    const std::vector<std::string>& names,
+    long chunkRowCount) :
+    m_header(hdu.header()),
+    m_columns(hdu.columns()),
+    m_chunkRowCount(chunkRowCount == -1 ? m_columns.readBufferRowCount() : chunkRowCount),
+    m_buffers(makeBuffers(m_columns, names, m_chunkRowCount, std::index_sequence_for<Ts...>())),
+    m_bufferedRowCount(0),
+    m_committedRowCount(m_columns.readRowCount()),
+    m_capacity(m_committedRowCount),
+    m_closed(false) {
+  if (names.size() != sizeof...(Ts)) {
+    throw FitsError("Numbers of column names and types differ");
+  }
+  m_header.write(Internal::committedRowCountKeyword, m_committedRowCount, "", "Number of committed rows");
+}
+
+template <typename... Ts>
+BintableAppender<Ts...>::~BintableAppender() {
+  close();
+}
+
+template <typename... Ts>
+long BintableAppender<Ts...>::rowCount() const {
+  return m_committedRowCount + m_bufferedRowCount;
+}
+
+template <typename... Ts>
+long BintableAppender<Ts...>::committedRowCount() const {
+  return m_committedRowCount;
+}
+
+template <typename... Ts>
+void BintableAppender<Ts...>::appendRow(const Ts&... values) {
+  bufferRow(std::index_sequence_for<Ts...>(), values...);
+  ++m_bufferedRowCount;
+  if (m_bufferedRowCount == m_chunkRowCount) {
+    flush();
+  }
+}
+
+template <typename... Ts>
+void BintableAppender<Ts...>::appendSeq(const Column<Ts>&... columns) {
+  const long count = std::get<0>(std::forward_as_tuple(columns...)).rowCount();
+  checkColumns(std::index_sequence_for<Ts...>(), count, columns...);
+  for (long front = 0; front < count;) {
+    const long chunkCount = std::min(m_chunkRowCount - m_bufferedRowCount, count - front);
+    bufferRows(std::index_sequence_for<Ts...>(), front, chunkCount, columns...);
+    m_bufferedRowCount += chunkCount;
+    front += chunkCount;
+    if (m_bufferedRowCount == m_chunkRowCount) {
+      flush();
+    }
+  }
+}
+
+template <typename... Ts>
+void BintableAppender<Ts...>::flush() {
+  if (m_bufferedRowCount == 0) {
+    return;
+  }
+  reserve(m_committedRowCount + m_bufferedRowCount);
+  m_columns.writeSegmentSeq({ m_committedRowCount, { 0, m_bufferedRowCount - 1 } }, m_buffers);
+  Cfitsio::FileAccess::flush(m_columns.m_fptr); // Data is written before it is committed
+  m_committedRowCount += m_bufferedRowCount;
+  m_bufferedRowCount = 0;
+  m_header.write(Internal::committedRowCountKeyword, m_committedRowCount, "", "Number of committed rows");
+}
+
+template <typename... Ts>
+void BintableAppender<Ts...>::close() {
+  if (m_closed) {
+    return;
+  }
+  flush();
+  m_columns.m_edit();
+  Cfitsio::BintableIo::truncateRows(m_columns.m_fptr, m_committedRowCount);
+  m_header.remove(Internal::committedRowCountKeyword);
+  m_closed = true;
+}
+
+template <typename... Ts>
+template <std::size_t... Is>
+std::tuple<VecColumn<Ts>...> BintableAppender<Ts...>::makeBuffers(
+    const BintableColumns& columns,
+    const std::vector<std::string>& names,
+    long chunkRowCount,
+    std::index_sequence<Is...>) {
+  return std::tuple<VecColumn<Ts>...> { VecColumn<Ts>(columns.readInfo<Ts>(names.at(Is)), chunkRowCount)... };
+}
+
+template <typename... Ts>
+template <std::size_t... Is>
+void BintableAppender<Ts...>::bufferRow(std::index_sequence<Is...>, const Ts&... values) {
+  for (long width : { 1L, Internal::rowWidth(std::get<Is>(m_buffers).info())... }) {
+    if (width != 1) {
+      throw FitsError("Cannot append a single value to a vector column; use appendSeq()");
+    }
+  }
+  using mockUnpack = int[];
+  (void)mockUnpack { 0, (std::get<Is>(m_buffers)(m_bufferedRowCount) = values, 0)... };
+}
+
+template <typename... Ts>
+template <std::size_t... Is>
+void BintableAppender<Ts...>::bufferRows(
+    std::index_sequence<Is...>,
+    long front,
+    long count,
+    const Column<Ts>&... columns) {
+  using mockUnpack = int[];
+  (void)mockUnpack { 0,
+                     (std::copy_n(
+                          columns.data() + front * Internal::rowWidth(columns.info()),
+                          count * Internal::rowWidth(columns.info()),
+                          std::get<Is>(m_buffers).data() +
+                              m_bufferedRowCount * Internal::rowWidth(std::get<Is>(m_buffers).info())),
+                      0)... };
+}
+
+template <typename... Ts>
+template <std::size_t... Is>
+void BintableAppender<Ts...>::checkColumns(std::index_sequence<Is...>, long rowCount, const Column<Ts>&... columns)
+    const {
+  for (long count : { rowCount, columns.rowCount()... }) {
+    if (count != rowCount) {
+      throw FitsError("Cannot append columns with different row counts");
+    }
+  }
+  const std::vector<long> widths { Internal::rowWidth(columns.info())... };
+  const std::vector<long> expected { Internal::rowWidth(std::get<Is>(m_buffers).info())... };
+  if (widths != expected) {
+    throw FitsError("Cannot append columns whose repeat counts differ from those in the file");
+  }
+}
+
+template <typename... Ts>
+void BintableAppender<Ts...>::reserve(long rowCount) {
+  if (rowCount <= m_capacity) {
+    return;
+  }
+  const long capacity = std::max(rowCount, 2 * m_capacity);
+  m_columns.m_edit();
+  Cfitsio::BintableIo::appendRows(m_columns.m_fptr, capacity - m_capacity);
+  m_capacity = capacity;
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
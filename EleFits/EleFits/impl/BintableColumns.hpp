@@ -22,6 +22,10 @@
   #include "EleCfitsioWrapper/BintableWrapper.h"
   #include "EleCfitsioWrapper/HeaderWrapper.h" // TODO rm when implementation of init(Seq) is in BintableWrapper
   #include "EleFits/BintableColumns.h"
+  #include "EleFits/Trace.h"
+
+  #include <algorithm> // copy, copy_n, is_sorted, max, min, stable_sort
+  #include <numeric> // iota
 
 namespace Euclid {
 namespace Fits {
@@ -49,14 +53,14 @@ ColumnInfo<T> BintableColumns::readInfo(long index) const {
 
 // read
 
-template <typename T>
-VecColumn<T> BintableColumns::read(const std::string& name) const {
-  return read<T>(readIndex(name));
+template <typename T, typename TAllocator>
+VecColumn<T, TAllocator> BintableColumns::read(const std::string& name) const {
+  return read<T, TAllocator>(readIndex(name));
 }
 
-template <typename T>
-VecColumn<T> BintableColumns::read(long index) const {
-  return readSegment<T>({ 0, readRowCount() - 1 }, index);
+template <typename T, typename TAllocator>
+VecColumn<T, TAllocator> BintableColumns::read(long index) const {
+  return readSegment<T, TAllocator>({ 0, readRowCount() - 1 }, index);
 }
 
 // readTo
@@ -76,16 +80,30 @@ void BintableColumns::readTo(long index, Column<T>& column) const {
   readSegmentTo<T>({ 0, readRowCount() - 1 }, column);
 }
 
-// readSegment
+// readRaw
 
 template <typename T>
-VecColumn<T> BintableColumns::readSegment(const Segment& rows, const std::string& name) const {
-  return readSegment<T>(rows, readIndex(name));
+VecColumn<T> BintableColumns::readRaw(const std::string& name) const {
+  return readRaw<T>(readIndex(name));
 }
 
 template <typename T>
-VecColumn<T> BintableColumns::readSegment(const Segment& rows, long index) const {
-  VecColumn<T> column(readInfo<T>(index), rows.size());
+VecColumn<T> BintableColumns::readRaw(long index) const {
+  VecColumn<T> column(readInfo<T>(index), readRowCount());
+  readRawSegmentTo<T>(Segment::whole(), index, column);
+  return column;
+}
+
+// readSegment
+
+template <typename T, typename TAllocator>
+VecColumn<T, TAllocator> BintableColumns::readSegment(const Segment& rows, const std::string& name) const {
+  return readSegment<T, TAllocator>(rows, readIndex(name));
+}
+
+template <typename T, typename TAllocator>
+VecColumn<T, TAllocator> BintableColumns::readSegment(const Segment& rows, long index) const {
+  VecColumn<T, TAllocator> column(readInfo<T>(index), rows.size());
   readSegmentTo<T>(rows, index, column);
   return column;
 }
@@ -104,13 +122,38 @@ void BintableColumns::readSegmentTo(FileMemSegments rows, const std::string& nam
 
 template <typename T>
 void BintableColumns::readSegmentTo(FileMemSegments rows, long index, Column<T>& column) const {
+  ELEFITS_TRACE(TraceSpan span("bintable", "BintableColumns::readSegmentTo"));
   m_touch();
   rows.resolve(readRowCount() - 1, column.rowCount() - 1);
   auto slice = column.slice(rows.memory()); // TODO do we need a temporary variable?
+  ELEFITS_TRACE(span.hdu(m_fptr); span.rows(rows.file()); span.bytes(slice.elementCount() * sizeof(T)));
+  if (m_diagnostics) {
+    m_diagnostics->readColumn(m_fptr, index, rows.file().size());
+  }
   Cfitsio::BintableIo::readColumnSegment<T>(
       m_fptr,
       Segment { rows.file().front + 1, rows.file().back + 1 }, // TODO operator+
       index + 1,
+      slice,
+      m_overflowPolicy);
+}
+
+// readRawSegmentTo
+
+template <typename T>
+void BintableColumns::readRawSegmentTo(FileMemSegments rows, long index, Column<T>& column) const {
+  ELEFITS_TRACE(TraceSpan span("bintable", "BintableColumns::readRawSegmentTo"));
+  m_touch();
+  rows.resolve(readRowCount() - 1, column.rowCount() - 1);
+  auto slice = column.slice(rows.memory());
+  ELEFITS_TRACE(span.hdu(m_fptr); span.rows(rows.file()); span.bytes(slice.elementCount() * sizeof(T)));
+  if (m_diagnostics) {
+    m_diagnostics->readColumn(m_fptr, index, rows.file().size());
+  }
+  Cfitsio::BintableIo::readRawColumnSegment<T>(
+      m_fptr,
+      Segment { rows.file().front + 1, rows.file().back + 1 },
+      index + 1,
       slice);
 }
 
@@ -130,6 +173,19 @@ std::tuple<VecColumn<Ts>...> BintableColumns::readSeq(const Indexed<Ts>&... indi
   return res;
 }
 
+template <typename... Ts>
+ArenaTable<Ts...> BintableColumns::readSeq(ColumnArena arena, const Named<Ts>&... names) const {
+  return readSeq(std::move(arena), Indexed<Ts>(readIndex(names.name))...);
+}
+
+template <typename... Ts>
+ArenaTable<Ts...> BintableColumns::readSeq(ColumnArena arena, const Indexed<Ts>&... indices) const {
+  m_touch();
+  ArenaTable<Ts...> table(std::move(arena), readRowCount(), readInfo<Ts>(indices)...);
+  readSeqTo({ indices... }, table.columns());
+  return table;
+}
+
 // readSeqTo
 
 template <typename TSeq>
@@ -187,6 +243,24 @@ std::tuple<VecColumn<Ts>...> BintableColumns::readSegmentSeq(const Segment& rows
   return columns;
 }
 
+template <typename... Ts>
+ArenaTable<Ts...>
+BintableColumns::readSegmentSeq(ColumnArena arena, const Segment& rows, const Named<Ts>&... names) const {
+  return readSegmentSeq(std::move(arena), rows, Indexed<Ts>(readIndex(names))...);
+}
+
+template <typename... Ts>
+ArenaTable<Ts...>
+BintableColumns::readSegmentSeq(ColumnArena arena, const Segment& rows, const Indexed<Ts>&... indices) const {
+  auto resolvedRows = rows;
+  if (rows.back == -1) {
+    resolvedRows.back = readRowCount() - 1;
+  }
+  ArenaTable<Ts...> table(std::move(arena), resolvedRows.size(), readInfo<Ts>(indices)...);
+  readSegmentSeqTo(resolvedRows, { indices.index... }, table.columns());
+  return table;
+}
+
 // readSegmentSeqTo
 
 template <typename TSeq>
@@ -223,9 +297,12 @@ void BintableColumns::readSegmentSeqTo(
 
 template <typename TSeq>
 void BintableColumns::readSegmentSeqTo(FileMemSegments rows, const std::vector<long>& indices, TSeq&& columns) const {
+  ELEFITS_TRACE(TraceSpan span("bintable", "BintableColumns::readSegmentSeqTo"));
+  AccessDiagnostics::MultiRead multiRead(m_diagnostics);
   const auto bufferSize = readBufferRowCount();
   const long rowCount = columnsRowCount(std::forward<TSeq>(columns));
   rows.resolve(readRowCount() - 1, rowCount - 1);
+  ELEFITS_TRACE(span.hdu(m_fptr); span.rows(rows.file()));
   const long lastMemRow = rows.memory().back;
   for (Segment file = Segment::fromSize(rows.file().front, bufferSize), // TODO use a FileMemSegments
        mem = Segment::fromSize(rows.memory().front, bufferSize);
@@ -248,6 +325,303 @@ void BintableColumns::readSegmentSeqTo(FileMemSegments rows, const std::vector<l
   readSegmentSeqTo(rows, indices, std::forward_as_tuple(columns...)); // FIXME move rows?
 }
 
+// readFilteredSeq
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Get the number of elements per row of a column (1 for string columns).
+ */
+template <typename T>
+long rowWidth(const ColumnInfo<T>& info) {
+  return std::is_same<T, std::string>::value ? 1 : info.repeatCount;
+}
+
+/**
+ * @brief A column which grows as rows are selected by a filtered read.
+ */
+template <typename T>
+struct FilteredColumn {
+
+  /**
+   * @brief Constructor.
+   */
+  FilteredColumn(ColumnInfo<T> columnInfo, long columnIndex) :
+      info(std::move(columnInfo)), index(columnIndex), rowWidth(Internal::rowWidth(info)), chunk(info, 0),
+      source(nullptr), values() {}
+
+  /** @brief The column info. */
+  ColumnInfo<T> info;
+
+  /** @brief The column index. */
+  long index;
+
+  /** @brief The number of elements per row. */
+  long rowWidth;
+
+  /** @brief The values of the current chunk, allocated at the first dense chunk. */
+  VecColumn<T> chunk;
+
+  /** @brief The chunk of the same predicate column, if any, from which the values are gathered. */
+  const VecColumn<T>* source;
+
+  /** @brief The values of the selected rows. */
+  std::vector<T> values;
+};
+
+/**
+ * @brief Gather the values of a selected column from a predicate column of the same type and index.
+ */
+template <typename T>
+void bindFilteredSource(FilteredColumn<T>& column, const VecColumn<T>& where, long whereIndex) {
+  if (not column.source && column.index == whereIndex) {
+    column.source = &where;
+  }
+}
+
+/**
+ * @brief Do nothing, because the types differ.
+ */
+template <typename T, typename TWhere>
+void bindFilteredSource(FilteredColumn<T>&, const VecColumn<TWhere>&, long) {}
+
+/**
+ * @brief The minimum ratio of matching rows for which a whole chunk is read rather than runs of matching rows.
+ */
+constexpr long denseFilterRatio = 8;
+
+} // namespace Internal
+/// @endcond
+
+template <typename... TWheres, typename TPredicate, typename... Ts>
+std::tuple<VecColumn<Ts>...> BintableColumns::readFilteredSeq(
+    const std::tuple<Named<TWheres>...>& where,
+    TPredicate&& predicate,
+    const Named<Ts>&... names) const {
+  return readFilteredSeq({ Segment::whole() }, where, std::forward<TPredicate>(predicate), names...);
+}
+
+template <typename... TWheres, typename TPredicate, typename... Ts>
+std::tuple<VecColumn<Ts>...> BintableColumns::readFilteredSeq(
+    const std::tuple<Indexed<TWheres>...>& where,
+    TPredicate&& predicate,
+    const Indexed<Ts>&... indices) const {
+  return readFilteredSeq({ Segment::whole() }, where, std::forward<TPredicate>(predicate), indices...);
+}
+
+template <typename... TWheres, typename TPredicate, typename... Ts>
+std::tuple<VecColumn<Ts>...> BintableColumns::readFilteredSeq(
+    const std::vector<Segment>& rows,
+    const std::tuple<Named<TWheres>...>& where,
+    TPredicate&& predicate,
+    const Named<Ts>&... names) const {
+  const auto whereIndices = seqTransform<std::tuple<Indexed<TWheres>...>>(where, [&](const auto& w) {
+    return Indexed<typename std::decay_t<decltype(w)>::Value>(readIndex(w.name));
+  });
+  return readFilteredSeq(
+      rows,
+      whereIndices,
+      std::forward<TPredicate>(predicate),
+      Indexed<Ts>(readIndex(names.name))...);
+}
+
+template <typename... TWheres, typename TPredicate, typename... Ts>
+std::tuple<VecColumn<Ts>...> BintableColumns::readFilteredSeq(
+    const std::vector<Segment>& rows,
+    const std::tuple<Indexed<TWheres>...>& where,
+    TPredicate&& predicate,
+    const Indexed<Ts>&... indices) const {
+  ELEFITS_TRACE(TraceSpan span("bintable", "BintableColumns::readFilteredSeq"));
+  AccessDiagnostics::MultiRead multiRead(m_diagnostics);
+  m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr));
+  const auto rowCount = readRowCount();
+  const auto chunkSize = std::min(readBufferRowCount(), rowCount);
+  const auto whereIndices = seqTransform<std::vector<long>>(where, [](const auto& w) {
+    return w.index;
+  });
+  auto chunk = seqTransform<std::tuple<VecColumn<TWheres>...>>(where, [&](const auto& w) {
+    using T = typename std::decay_t<decltype(w)>::Value;
+    return VecColumn<T>(readInfo<T>(w.index), chunkSize);
+  });
+  std::tuple<Internal::FilteredColumn<Ts>...> selected {
+      Internal::FilteredColumn<Ts>(readInfo<Ts>(indices.index), indices.index)... };
+
+  /* Reuse the chunks of the predicate columns */
+  seqForeach(selected, [&](auto& c) {
+    long i = 0;
+    seqForeach(chunk, [&](const auto& w) {
+      Internal::bindFilteredSource(c, w, whereIndices[i]);
+      ++i;
+    });
+  });
+  std::vector<long> matches;
+  matches.reserve(chunkSize);
+  std::vector<Segment> runs;
+  for (const auto& segment : rows) {
+    const auto last = segment.back == -1 ? rowCount - 1 : std::min(segment.back, rowCount - 1);
+    for (long front = segment.front; front <= last; front += chunkSize) {
+
+      /* Evaluate the predicate on the chunk */
+      const auto size = std::min(chunkSize, last - front + 1);
+      readSegmentSeqTo(FileMemSegments(front, Segment::fromSize(0, size)), whereIndices, chunk);
+      matches.clear();
+      tupleApply(chunk, [&](const auto&... columns) {
+        for (long row = 0; row < size; ++row) {
+          if (predicate(columns(row)...)) {
+            matches.push_back(front + row);
+          }
+        }
+      });
+      if (matches.empty()) {
+        continue;
+      }
+
+      /* Group the matching rows by runs of consecutive rows */
+      runs.clear();
+      for (auto it = matches.begin(); it != matches.end();) {
+        auto end = it + 1;
+        while (end != matches.end() && *end == *(end - 1) + 1) {
+          ++end;
+        }
+        runs.push_back({ *it, *(end - 1) });
+        it = end;
+      }
+      const bool dense = runs.size() > 1 && long(matches.size()) * Internal::denseFilterRatio >= size;
+
+      seqForeach(selected, [&](auto& c) {
+        using T = typename std::decay_t<decltype(c.info)>::Value;
+        auto offset = c.values.size();
+        c.values.resize(offset + matches.size() * c.rowWidth);
+        const VecColumn<T>* source = c.source;
+        if (not source && dense) {
+
+          /* Read the whole chunk once */
+          if (c.chunk.rowCount() == 0) {
+            c.chunk = VecColumn<T>(c.info, chunkSize);
+          }
+          PtrColumn<T> view(c.info, size * c.rowWidth, c.chunk.data());
+          readSegmentTo(front, c.index, view);
+          source = &c.chunk;
+        }
+        if (source) {
+
+          /* Gather the matching rows from the chunk in memory */
+          const auto* data = source->data();
+          for (auto row : matches) {
+            const auto* begin = data + (row - front) * c.rowWidth;
+            std::copy(begin, begin + c.rowWidth, &c.values[offset]);
+            offset += c.rowWidth;
+          }
+          return;
+        }
+
+        /* Read the matching rows by runs, which is cheaper when they are sparse */
+        for (const auto& run : runs) {
+          PtrColumn<T> view(c.info, run.size() * c.rowWidth, &c.values[offset]);
+          readSegmentTo(run.front, c.index, view);
+          offset += run.size() * c.rowWidth;
+        }
+      });
+    }
+  }
+  return seqTransform<std::tuple<VecColumn<Ts>...>>(selected, [](auto& c) {
+    using T = typename std::decay_t<decltype(c.info)>::Value;
+    return VecColumn<T>(std::move(c.info), std::move(c.values));
+  });
+}
+
+// readGatheredSeq
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief A column read by runs in a buffer, and scattered in the output column.
+ */
+template <typename T>
+struct GatheredColumn {
+
+  /**
+   * @brief Constructor.
+   */
+  GatheredColumn(const ColumnInfo<T>& info, long columnIndex, long rowCount, long bufferRowCount) :
+      index(columnIndex), rowWidth(Internal::rowWidth(info)), buffer(info, bufferRowCount), output(info, rowCount) {}
+
+  /** @brief The column index. */
+  long index;
+
+  /** @brief The number of elements per row. */
+  long rowWidth;
+
+  /** @brief The buffer of the current run. */
+  VecColumn<T> buffer;
+
+  /** @brief The output column. */
+  VecColumn<T> output;
+};
+
+} // namespace Internal
+/// @endcond
+
+template <typename... Ts>
+std::tuple<VecColumn<Ts>...>
+BintableColumns::readGatheredSeq(const std::vector<long>& rows, long maxGap, const Named<Ts>&... names) const {
+  return readGatheredSeq(rows, maxGap, Indexed<Ts>(readIndex(names.name))...);
+}
+
+template <typename... Ts>
+std::tuple<VecColumn<Ts>...>
+BintableColumns::readGatheredSeq(const std::vector<long>& rows, long maxGap, const Indexed<Ts>&... indices) const {
+  ELEFITS_TRACE(TraceSpan span("bintable", "BintableColumns::readGatheredSeq"));
+  AccessDiagnostics::MultiRead multiRead(m_diagnostics);
+  m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.detail(std::to_string(rows.size()) + " rows"));
+  const long count = rows.size();
+  const auto bufferSize = std::max(readBufferRowCount(), 1L);
+  std::tuple<Internal::GatheredColumn<Ts>...> columns {
+      Internal::GatheredColumn<Ts>(readInfo<Ts>(indices.index), indices.index, count, bufferSize)... };
+
+  /* Sort the rows, and keep track of the output positions */
+  std::vector<long> order(count);
+  std::iota(order.begin(), order.end(), 0);
+  if (not std::is_sorted(rows.begin(), rows.end())) {
+    std::stable_sort(order.begin(), order.end(), [&](long lhs, long rhs) {
+      return rows[lhs] < rows[rhs];
+    });
+  }
+  if (count > 0) {
+    const std::pair<long, long> bounds { 0, readRowCount() - 1 };
+    OutOfBoundsError::mayThrow("Cannot gather row", rows[order.front()], bounds);
+    OutOfBoundsError::mayThrow("Cannot gather row", rows[order.back()], bounds);
+  }
+
+  /* Read the runs and scatter them */
+  for (long begin = 0; begin < count;) {
+    const auto front = rows[order[begin]];
+    auto end = begin + 1;
+    while (end < count) {
+      const auto row = rows[order[end]];
+      if (row - rows[order[end - 1]] - 1 > maxGap || row - front >= bufferSize) {
+        break;
+      }
+      ++end;
+    }
+    const Segment run { front, rows[order[end - 1]] };
+    seqForeach(columns, [&](auto& c) {
+      readSegmentTo(FileMemSegments(run.front, Segment::fromSize(0, run.size())), c.index, c.buffer);
+      for (auto i = begin; i < end; ++i) {
+        std::copy_n(&c.buffer(rows[order[i]] - run.front), c.rowWidth, &c.output(order[i]));
+      }
+    });
+    begin = end;
+  }
+  return seqTransform<std::tuple<VecColumn<Ts>...>>(columns, [](auto& c) {
+    return std::move(c.output);
+  });
+}
+
 // write
 
 template <typename T>
@@ -275,13 +649,87 @@ void BintableColumns::init(const ColumnInfo<T>& info, long index) const {
   // TODO to Cfitsio
 }
 
+// initVla
+
+template <typename T>
+void BintableColumns::initVla(const std::string& name, const std::string& unit, long index, bool largeHeap) const {
+  m_edit();
+  auto cname = Cfitsio::toCharPtr(name);
+  auto tform = Cfitsio::toCharPtr(Cfitsio::TypeCode<T>::vlaTform(largeHeap));
+  int status = 0;
+  int cfitsioIndex = index == -1 ? Cfitsio::BintableIo::columnCount(m_fptr) + 1 : index + 1;
+  fits_insert_col(m_fptr, cfitsioIndex, cname.get(), tform.get(), &status);
+  Cfitsio::CfitsioError::mayThrow(status, m_fptr, "Cannot init new column: #" + std::to_string(index));
+  if (unit != "") {
+    const Record<std::string> record { "TUNIT" + std::to_string(cfitsioIndex), unit, "", "physical unit of field" };
+    Cfitsio::HeaderIo::updateRecord(m_fptr, record);
+  }
+}
+
+// readVla
+
+template <typename T>
+VlaColumn<T> BintableColumns::readVla(const std::string& name) const {
+  return readVla<T>(readIndex(name));
+}
+
+template <typename T>
+VlaColumn<T> BintableColumns::readVla(long index) const {
+  return readVlaSegment<T>({ 0, -1 }, index);
+}
+
+// readVlaSegment
+
+template <typename T>
+VlaColumn<T> BintableColumns::readVlaSegment(const Segment& rows, const std::string& name) const {
+  return readVlaSegment<T>(rows, readIndex(name));
+}
+
+template <typename T>
+VlaColumn<T> BintableColumns::readVlaSegment(const Segment& rows, long index) const {
+  ELEFITS_TRACE(TraceSpan span("bintable", "BintableColumns::readVlaSegment"));
+  m_touch();
+  const long back = rows.back == -1 ? readRowCount() - 1 : rows.back;
+  ELEFITS_TRACE(span.hdu(m_fptr); span.rows({ rows.front, back }));
+  return Cfitsio::BintableIo::readVlaColumnSegment<T>(m_fptr, { rows.front + 1, back + 1 }, index + 1);
+}
+
+// writeVla
+
+template <typename T>
+void BintableColumns::writeVla(const VlaColumn<T>& column) const {
+  writeVlaSegment(0, column);
+}
+
+// writeVlaSegment
+
+template <typename T>
+void BintableColumns::writeVlaSegment(long firstRow, const VlaColumn<T>& column) const {
+  ELEFITS_TRACE(TraceSpan span("bintable", "BintableColumns::writeVlaSegment"));
+  m_edit();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.rows(Segment::fromSize(firstRow, column.rowCount())));
+  if (m_diagnostics) {
+    m_diagnostics->writeData(m_fptr);
+  }
+  Cfitsio::BintableIo::writeVlaColumnSegment(m_fptr, firstRow + 1, readIndex(column.name()) + 1, column);
+}
+
 // writeSegment
 
 template <typename T>
 void BintableColumns::writeSegment(FileMemSegments rows, const Column<T>& column) const {
+  ELEFITS_TRACE(TraceSpan span("bintable", "BintableColumns::writeSegment"));
   m_edit();
   rows.resolve(readRowCount() - 1, column.rowCount() - 1);
-  Cfitsio::BintableIo::writeColumnSegment(m_fptr, rows.file().front + 1, column.slice(rows.memory()));
+  const auto slice = column.slice(rows.memory());
+  ELEFITS_TRACE(span.hdu(m_fptr); span.rows(rows.file()); span.bytes(slice.elementCount() * sizeof(T)));
+  if (m_diagnostics) {
+    m_diagnostics->writeData(m_fptr);
+  }
+  Cfitsio::BintableIo::writeColumnSegment(m_fptr, rows.file().front + 1, slice);
+  if (m_zoneMap) {
+    m_zoneMap->update(rows.file().front, slice);
+  }
 }
 
 // writeSeq
@@ -332,8 +780,10 @@ void BintableColumns::initSeq(long index, const ColumnInfo<Ts>&... infos) const
 
 template <typename TSeq>
 void BintableColumns::writeSegmentSeq(FileMemSegments rows, TSeq&& columns) const {
+  ELEFITS_TRACE(TraceSpan span("bintable", "BintableColumns::writeSegmentSeq"));
   const auto rowCount = columnsRowCount(std::forward<TSeq>(columns));
   rows.resolve(readRowCount() - 1, rowCount - 1);
+  ELEFITS_TRACE(span.hdu(m_fptr); span.rows(rows.file()));
   const long lastMemRow = rows.memory().back;
   const auto bufferSize = readBufferRowCount();
   for (auto mem = Segment::fromSize(rows.memory().front, bufferSize), // TODO use a FileMemSegments
@@ -354,6 +804,67 @@ void BintableColumns::writeSegmentSeq(FileMemSegments rows, const Column<Ts>&...
   writeSegmentSeq(rows, std::forward_as_tuple(columns...));
 }
 
+// readAsync
+
+template <typename T>
+std::future<VecColumn<T>> BintableColumns::readAsync(const std::string& name) const {
+  return executor().submit([this, name]() {
+    return read<T>(name);
+  });
+}
+
+template <typename T>
+std::future<VecColumn<T>> BintableColumns::readAsync(long index) const {
+  return executor().submit([this, index]() {
+    return read<T>(index);
+  });
+}
+
+template <typename T>
+std::future<VecColumn<T>> BintableColumns::readSegmentAsync(const Segment& rows, const std::string& name) const {
+  return executor().submit([this, rows, name]() {
+    return readSegment<T>(rows, name);
+  });
+}
+
+template <typename... Ts>
+std::future<std::tuple<VecColumn<Ts>...>> BintableColumns::readSeqAsync(const Named<Ts>&... names) const {
+  return executor().submit([this, names...]() {
+    return readSeq(names...);
+  });
+}
+
+template <typename... Ts>
+std::future<std::tuple<VecColumn<Ts>...>>
+BintableColumns::readSegmentSeqAsync(const Segment& rows, const Named<Ts>&... names) const {
+  return executor().submit([this, rows, names...]() {
+    return readSegmentSeq(rows, names...);
+  });
+}
+
+// writeAsync
+
+template <typename T>
+std::future<void> BintableColumns::writeAsync(const Column<T>& column) const {
+  return executor().submit([this, &column]() {
+    write(column);
+  });
+}
+
+template <typename T>
+std::future<void> BintableColumns::writeSegmentAsync(FileMemSegments rows, const Column<T>& column) const {
+  return executor().submit([this, rows, &column]() {
+    writeSegment(rows, column);
+  });
+}
+
+template <typename... Ts>
+std::future<void> BintableColumns::writeSeqAsync(const Column<Ts>&... columns) const {
+  return executor().submit([this, &columns...]() {
+    writeSeq(columns...);
+  });
+}
+
 template <typename TSeq>
 long columnsRowCount(TSeq&& columns) {
   long rows = -1;
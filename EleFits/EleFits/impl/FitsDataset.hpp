@@ -0,0 +1,73 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITS_FITSDATASET_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFits/FitsDataset.h"
+
+  #include <algorithm> // max, min
+
+namespace Euclid {
+namespace Fits {
+
+template <typename... Ts>
+std::tuple<VecColumn<Ts>...> FitsDataset::readSeq(const Named<Ts>&... names) const {
+  return readSegmentSeq({ 0, -1 }, names...);
+}
+
+template <typename... Ts>
+std::tuple<VecColumn<Ts>...> FitsDataset::readSegmentSeq(const Segment& rows, const Named<Ts>&... names) const {
+  const auto resolvedRows = resolve(rows);
+  MefFile f(m_filenames[0], FileMode::Read);
+  const auto& du = f.access<BintableHdu>(m_hduIndex).columns();
+  std::tuple<VecColumn<Ts>...> columns { VecColumn<Ts>(du.readInfo<Ts>(names.name), resolvedRows.size())... };
+  f.close();
+  tupleApply(columns, [&](auto&... cs) {
+    readSegmentSeqTo(resolvedRows, cs...);
+  });
+  return columns;
+}
+
+template <typename... Ts>
+void FitsDataset::readSegmentSeqTo(const Segment& rows, Column<Ts>&... columns) const {
+  const auto resolvedRows = resolve(rows);
+  if (resolvedRows.size() <= 0) {
+    return;
+  }
+  std::vector<long> fileIndices;
+  for (long i = readFileIndex(resolvedRows.front); i < fileCount() && m_offsets[i] <= resolvedRows.back; ++i) {
+    if (m_offsets[i + 1] > m_offsets[i]) { // Skip empty tables
+      fileIndices.push_back(i);
+    }
+  }
+  forEachFile(fileIndices, [&](long i) {
+    const long front = std::max(resolvedRows.front, m_offsets[i]);
+    const long back = std::min(resolvedRows.back, m_offsets[i + 1] - 1);
+    MefFile f(m_filenames[i], FileMode::Read);
+    const auto& du = f.access<BintableHdu>(m_hduIndex).columns();
+    du.readSegmentSeqTo(
+        { Segment { front - m_offsets[i], back - m_offsets[i] }, front - resolvedRows.front },
+        std::forward_as_tuple(columns...));
+  });
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
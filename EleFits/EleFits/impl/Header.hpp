@@ -21,13 +21,16 @@
 
   #include "EleCfitsioWrapper/HeaderWrapper.h"
   #include "EleFits/Header.h"
+  #include "EleFits/Trace.h"
 
 namespace Euclid {
 namespace Fits {
 
 template <typename T>
 Record<T> Header::parse(const std::string& keyword) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::parse"));
   m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.detail(keyword));
   return Cfitsio::HeaderIo::parseRecord<T>(m_fptr, keyword);
 }
 
@@ -50,7 +53,9 @@ Record<T> Header::parseOr(
 
 template <typename T>
 RecordVec<T> Header::parseSeq(const std::vector<std::string>& keywords) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::parseSeq"));
   m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.detail(std::to_string(keywords.size()) + " keywords"));
   RecordVec<T> res(keywords.size());
   std::transform(keywords.begin(), keywords.end(), res.vector.begin(), [&](const std::string& k) {
     return Cfitsio::HeaderIo::parseRecord<T>(m_fptr, k);
@@ -78,7 +83,9 @@ std::tuple<Record<Ts>...> Header::parseSeqOr(const Record<Ts>&... fallbacks) con
 
 template <typename TReturn, typename... Ts>
 TReturn Header::parseStruct(const Named<Ts>&... keywords) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::parseStruct"));
   m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.detail(std::to_string(sizeof...(Ts)) + " keywords"));
   return { Cfitsio::HeaderIo::parseRecord<Ts>(m_fptr, keywords.name)... };
 }
 
@@ -143,7 +150,9 @@ struct RecordWriterImpl<RecordMode::CreateOrUpdate> {
 
 template <RecordMode Mode, typename T>
 void Header::write(const Record<T>& record) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::write"));
   m_edit();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.detail(record.keyword));
   Internal::RecordWriterImpl<Mode>::write(m_fptr, *this, record);
 }
 
@@ -187,7 +196,9 @@ void Header::writeSeq(const Record<Ts>&... records) const {
 
 template <RecordMode Mode, typename TSeq>
 void Header::writeSeq(TSeq&& records) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::writeSeq"));
   m_edit();
+  ELEFITS_TRACE(span.hdu(m_fptr));
   auto func = [&](const auto& r) {
     Internal::RecordWriterImpl<Mode>::write(m_fptr, *this, r);
   };
@@ -201,7 +212,9 @@ void Header::writeSeqIn(const std::vector<std::string>& keywords, const Record<T
 
 template <RecordMode Mode, typename TSeq>
 void Header::writeSeqIn(const std::vector<std::string>& keywords, TSeq&& records) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::writeSeqIn"));
   m_edit();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.detail(std::to_string(keywords.size()) + " keywords"));
   auto func = [&](const auto& r) {
     if (std::find(keywords.begin(), keywords.end(), r.keyword) != keywords.end()) {
       Internal::RecordWriterImpl<Mode>::write(m_fptr, *this, r);
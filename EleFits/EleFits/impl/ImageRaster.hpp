@@ -19,8 +19,15 @@
 
 #if defined(_ELEFITS_IMAGERASTER_IMPL) || defined(CHECK_QUALITY)
 
+  #include "EleCfitsioWrapper/FileWrapper.h"
+  #include "EleCfitsioWrapper/HduWrapper.h"
   #include "EleCfitsioWrapper/ImageWrapper.h"
+  #include "EleFitsData/FitsError.h"
   #include "EleFits/ImageRaster.h"
+  #include "EleFits/Trace.h"
+
+  #include <algorithm> // copy, fill, min, max
+  #include <thread>
 
 namespace Euclid {
 namespace Fits {
@@ -43,39 +50,61 @@ void ImageRaster::reinit(const Position<n>& shape) const {
   Cfitsio::ImageIo::updateTypeShape<T, n>(m_fptr, shape);
 }
 
-template <typename T, long n>
-VecRaster<T, n> ImageRaster::read() const {
-  VecRaster<T, n> raster(readShape<n>());
+template <typename T, long n, typename TAllocator>
+VecRaster<T, n, TAllocator> ImageRaster::read() const {
+  VecRaster<T, n, TAllocator> raster(readShape<n>());
   readTo<T, n>(raster);
   return raster;
 }
 
 template <typename T, long n>
 void ImageRaster::readTo(Raster<T, n>& raster) const {
+  ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::readTo"));
   m_touch();
-  Cfitsio::ImageIo::readRasterTo<T, n>(m_fptr, raster);
+  ELEFITS_TRACE(span.hdu(m_fptr); span.bytes(raster.size() * sizeof(T)));
+  Cfitsio::ImageIo::readRasterTo<T, n>(m_fptr, raster, m_overflowPolicy);
 }
 
 template <typename T, long n>
 void ImageRaster::readTo(Subraster<T, n>& subraster) const {
+  ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::readTo"));
   m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.bytes(subraster.size() * sizeof(T)); span.region(subraster.region()));
   Cfitsio::ImageIo::readRasterTo<T, n>(m_fptr, subraster);
 }
 
+template <typename T, long n>
+VecRaster<T, n> ImageRaster::readRaw() const {
+  VecRaster<T, n> raster(readShape<n>());
+  readRawTo<T, n>(raster);
+  return raster;
+}
+
+template <typename T, long n>
+void ImageRaster::readRawTo(Raster<T, n>& raster) const {
+  ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::readRawTo"));
+  m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.bytes(raster.size() * sizeof(T)));
+  Cfitsio::ImageIo::readRawRasterTo<T, n>(m_fptr, raster);
+}
+
 template <typename T, long m, long n>
 VecRaster<T, m> ImageRaster::readRegion(const Region<n>& region) const {
   VecRaster<T, m> raster(region.shape().template slice<m>());
-  readRegionTo(region.front, raster);
+  readRegionTo(FileMemRegions<n>(region.front), raster);
   return raster;
 }
 
 template <typename T, long m, long n>
 void ImageRaster::readRegionTo(FileMemRegions<n> regions, Raster<T, m>& raster) const {
-  const auto& memRegion = regions.inMemory();
+  regions.resolve(readShape<n>() - 1, raster.shape() - 1);
+  const auto& memRegion = regions.memory();
   if (raster.isContiguous(memRegion)) {
-    readRegionToSlice(regions.inFile().front, raster.slice(memRegion));
+    auto slice = raster.template slice<m>(memRegion);
+    readRegionToSlice(regions.file().front, slice);
   } else {
-    readRegionToSubraster(regions.inFile().front, raster.subraster(memRegion));
+    auto subraster = raster.subraster(memRegion);
+    readRegionToSubraster(regions.file().front, subraster);
   }
 }
 
@@ -86,7 +115,10 @@ void ImageRaster::readRegionTo(Subraster<T, n>& subraster) const {
 
 template <typename T, long m, long n>
 void ImageRaster::readRegionToSlice(const Position<n>& frontPosition, Raster<T, m>& raster) const {
+  ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::readRegionTo"));
   m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.bytes(raster.size() * sizeof(T)));
+  ELEFITS_TRACE(span.region(frontPosition, raster.shape()));
   Cfitsio::ImageIo::readRegionTo(
       m_fptr,
       Region<n>::fromShape(frontPosition, raster.shape()), // FIXME use frontPosition in ImageIo
@@ -95,7 +127,10 @@ void ImageRaster::readRegionToSlice(const Position<n>& frontPosition, Raster<T,
 
 template <typename T, long m, long n>
 void ImageRaster::readRegionToSubraster(const Position<n>& frontPosition, Subraster<T, m>& subraster) const {
+  ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::readRegionTo"));
   m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.bytes(subraster.size() * sizeof(T)));
+  ELEFITS_TRACE(span.region(frontPosition, subraster.shape()));
   Cfitsio::ImageIo::readRegionTo(
       m_fptr,
       Region<n>::fromShape(frontPosition, subraster.shape()), // FIXME use frontPosition in ImageIo
@@ -105,7 +140,12 @@ void ImageRaster::readRegionToSubraster(const Position<n>& frontPosition, Subras
 
 template <typename T, long n>
 void ImageRaster::write(const Raster<T, n>& raster) const {
+  ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::write"));
   m_edit();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.bytes(raster.size() * sizeof(T)));
+  if (m_diagnostics) {
+    m_diagnostics->writeData(m_fptr);
+  }
   Cfitsio::ImageIo::writeRaster<T, n>(m_fptr, raster);
 }
 
@@ -126,12 +166,24 @@ void ImageRaster::writeRegion(const Subraster<T, n>& subraster) const {
 
 template <typename T, long m, long n>
 void ImageRaster::writeSlice(const Position<n>& frontPosition, const Raster<T, m>& raster) const {
+  ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::writeRegion"));
+  ELEFITS_TRACE(span.hdu(m_fptr); span.bytes(raster.size() * sizeof(T)));
+  ELEFITS_TRACE(span.region(frontPosition, raster.shape()));
+  if (m_diagnostics) {
+    m_diagnostics->writeData(m_fptr);
+  }
   Cfitsio::ImageIo::writeRegion(m_fptr, raster, frontPosition);
 }
 
 template <typename T, long m, long n>
 void ImageRaster::writeSubraster(const Position<n>& frontPosition, const Subraster<T, m>& subraster) const {
+  ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::writeRegion"));
   m_edit();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.bytes(subraster.size() * sizeof(T)));
+  ELEFITS_TRACE(span.region(frontPosition, subraster.shape()));
+  if (m_diagnostics) {
+    m_diagnostics->writeData(m_fptr);
+  }
   int status = 0;
   auto locus = Region<m>::fromShape(Position<m>::zero(), subraster.shape());
   locus.back[0] = locus.front[0];
@@ -148,6 +200,187 @@ void ImageRaster::writeSubraster(const Position<n>& frontPosition, const Subrast
   }
 }
 
+template <typename T, long n>
+VecRaster<T, n> ImageRaster::readDecimated(const Position<n>& step) const {
+  return readRegionDecimated<T, n>(Region<n>::whole(), step);
+}
+
+template <typename T, long m, long n>
+VecRaster<T, m> ImageRaster::readRegionDecimated(const Region<n>& region, const Position<n>& step) const {
+  ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::readRegionDecimated"));
+  m_touch();
+  const auto shape = Cfitsio::ImageIo::readShape<n>(m_fptr);
+  Region<n> resolved = region;
+  auto decimatedShape = shape;
+  for (long i = 0; i < long(resolved.dimension()); ++i) {
+    if (step[i] <= 0) {
+      throw FitsError("Decimation step must be positive");
+    }
+    if (resolved.back[i] == -1) {
+      resolved.back[i] = shape[i] - 1;
+    }
+    decimatedShape[i] = (resolved.back[i] - resolved.front[i] + step[i]) / step[i];
+  }
+  VecRaster<T, m> raster(decimatedShape.template slice<m>());
+  ELEFITS_TRACE(span.hdu(m_fptr); span.bytes(raster.size() * sizeof(T)); span.region(resolved));
+  Cfitsio::ImageIo::readDecimatedTo(m_fptr, resolved, step, raster);
+  return raster;
+}
+
+template <typename T, long n>
+VecRaster<T, n> ImageRaster::readBinned(const Position<n>& block, BinningMode mode) const {
+  ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::readBinned"));
+  m_touch();
+  Binner<T, n> binner(Cfitsio::ImageIo::readShape<n>(m_fptr), block, mode);
+  ELEFITS_TRACE(span.hdu(m_fptr); span.bytes(shapeSize(Cfitsio::ImageIo::readShape<n>(m_fptr)) * sizeof(T)));
+  std::vector<T> buffer;
+  for (long i = 0; i < binner.slabCount(); ++i) {
+    const auto region = binner.slab(i);
+    buffer.resize(region.size());
+    PtrRaster<T, n> slab(region.shape(), buffer.data());
+    Cfitsio::ImageIo::readRegionTo(m_fptr, region, slab);
+    binner.reduce(i, buffer.data());
+  }
+  return std::move(binner.raster());
+}
+
+template <typename T>
+std::vector<VecRaster<T, 2>>
+ImageRaster::readCutouts(const std::vector<Region<2>>& regions, const CutoutOptions& options, T fill) const {
+  std::vector<VecRaster<T, 2>> stamps;
+  stamps.reserve(regions.size());
+  std::vector<T*> data;
+  data.reserve(regions.size());
+  for (const auto& r : regions) {
+    stamps.emplace_back(r.shape());
+    auto& stamp = stamps.back();
+    std::fill(stamp.data(), stamp.data() + stamp.size(), fill);
+    data.push_back(stamp.data());
+  }
+  readCutoutsTo(regions, options, data);
+  return stamps;
+}
+
+template <typename T>
+VecRaster<T, 3>
+ImageRaster::readCutoutCube(const std::vector<Region<2>>& regions, const CutoutOptions& options, T fill) const {
+  const auto shape = regions.empty() ? Position<2>::zero() : regions.front().shape();
+  for (const auto& r : regions) {
+    if (r.shape() != shape) {
+      throw FitsError("Cannot read stamps of different shapes as a cube");
+    }
+  }
+  VecRaster<T, 3> cube({ shape[0], shape[1], long(regions.size()) });
+  std::fill(cube.data(), cube.data() + cube.size(), fill);
+  std::vector<T*> data(regions.size());
+  const long stampSize = shapeSize(shape);
+  for (std::size_t i = 0; i < regions.size(); ++i) {
+    data[i] = cube.data() + i * stampSize;
+  }
+  readCutoutsTo(regions, options, data);
+  return cube;
+}
+
+template <typename T>
+void ImageRaster::readCutoutsTo(
+    const std::vector<Region<2>>& regions,
+    const CutoutOptions& options,
+    const std::vector<T*>& data) const {
+  ELEFITS_TRACE(TraceSpan span("image", "ImageRaster::readCutouts"));
+  m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.detail(std::to_string(regions.size()) + " stamps"));
+  const CutoutPlan plan(regions, Cfitsio::ImageIo::readShape<2>(m_fptr), sizeof(T), options);
+  const auto& slabs = plan.slabs();
+
+  /* Resolve the number of threads */
+  const auto filename = Cfitsio::FileAccess::name(m_fptr);
+  long threadCount = options.threadCount;
+  if (threadCount <= 0) {
+    threadCount = std::thread::hardware_concurrency();
+  }
+  if (Cfitsio::FileAccess::isInMemory(m_fptr)) {
+    threadCount = 1; // No second handle to a file in memory
+  }
+  threadCount = std::max(1L, std::min(threadCount, long(slabs.size())));
+  if (threadCount > 1 && Cfitsio::FileAccess::isWritable(m_fptr)) {
+    Cfitsio::FileAccess::flush(m_fptr); // Such that the other handles read up-to-date values
+  }
+
+  /* Open one handle per additional thread, lazily */
+  const long hduIndex = Cfitsio::HduAccess::currentIndex(m_fptr);
+  std::vector<fitsfile*> handles(threadCount, nullptr);
+  handles[0] = m_fptr;
+  const auto closeHandles = [&]() {
+    for (long t = 1; t < threadCount; ++t) {
+      if (handles[t]) {
+        Cfitsio::FileAccess::close(handles[t]);
+      }
+    }
+  };
+
+  /* Read each slab and copy the stamp rows */
+  try {
+    plan.forEachSlab(
+        [&](long s, long t) {
+          auto& fptr = handles[t];
+          if (not fptr) {
+            fptr = Cfitsio::FileAccess::open(filename, Cfitsio::FileAccess::OpenPolicy::ReadOnly);
+            Cfitsio::HduAccess::gotoIndex(fptr, hduIndex);
+          }
+          const auto& slab = slabs[s];
+          VecRaster<T, 2> buffer(slab.region.shape());
+          Cfitsio::ImageIo::readRegionTo(fptr, slab.region, buffer);
+          const long slabWidth = buffer.shape()[0];
+          for (auto i : slab.stamps) {
+            const auto& stamp = regions[i];
+            const auto& clipped = plan.clipped(i);
+            const long stampWidth = stamp.shape()[0];
+            const long width = clipped.shape()[0];
+            for (long y = clipped.front[1]; y <= clipped.back[1]; ++y) {
+              const T* in =
+                  buffer.data() + (y - slab.region.front[1]) * slabWidth + (clipped.front[0] - slab.region.front[0]);
+              T* out = data[i] + (y - stamp.front[1]) * stampWidth + (clipped.front[0] - stamp.front[0]);
+              std::copy(in, in + width, out);
+            }
+          }
+        },
+        threadCount);
+  } catch (...) {
+    closeHandles();
+    throw;
+  }
+  closeHandles();
+  ELEFITS_TRACE(span.bytes(plan.readPixelCount() * sizeof(T)));
+}
+
+template <typename T, long n>
+std::future<VecRaster<T, n>> ImageRaster::readAsync() const {
+  return executor().submit([this]() {
+    return read<T, n>();
+  });
+}
+
+template <typename T, long m, long n>
+std::future<VecRaster<T, m>> ImageRaster::readRegionAsync(const Region<n>& region) const {
+  return executor().submit([this, region]() {
+    return readRegion<T, m>(region);
+  });
+}
+
+template <typename T, long n>
+std::future<void> ImageRaster::writeAsync(const Raster<T, n>& raster) const {
+  return executor().submit([this, &raster]() {
+    write(raster);
+  });
+}
+
+template <typename T, long m, long n>
+std::future<void> ImageRaster::writeRegionAsync(FileMemRegions<n> regions, const Raster<T, m>& raster) const {
+  return executor().submit([this, regions, &raster]() {
+    writeRegion(regions, raster);
+  });
+}
+
 } // namespace Fits
 } // namespace Euclid
 
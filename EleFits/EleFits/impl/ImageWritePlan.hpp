@@ -0,0 +1,47 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITS_IMAGEWRITEPLAN_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleCfitsioWrapper/HduWrapper.h"
+  #include "EleFits/ImageWritePlan.h"
+  #include "EleFitsData/Scaling.h"
+
+namespace Euclid {
+namespace Fits {
+
+template <typename T, long n>
+void ImageWritePlan::add(const std::string& name, const Raster<T, n>& raster) {
+  const auto shape = raster.shape();
+  const auto* data = raster.data();
+  m_entries.push_back(
+      { [=](fitsfile* fptr) {
+         Cfitsio::HduAccess::initImageExtension<std::decay_t<T>, n>(fptr, name, shape);
+       },
+        [=](long first, long count, unsigned char* out) {
+          encodeScaledTo(data + first, count, out);
+        },
+        raster.size(),
+        static_cast<long>(sizeof(T)) });
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITS_LAZYCOLUMNS_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFits/LazyColumns.h"
+
+  #include <algorithm> // min
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Get the number of bytes of the values of a column.
+ */
+template <typename T>
+std::size_t columnByteCount(const VecColumn<T>& column) {
+  return column.elementCount() * sizeof(T);
+}
+
+/**
+ * @brief Get the number of bytes of the values of a string column, including the characters.
+ */
+template <>
+inline std::size_t columnByteCount(const VecColumn<std::string>& column) {
+  std::size_t count = column.elementCount() * sizeof(std::string);
+  for (const auto& value : column.vector()) {
+    count += value.capacity();
+  }
+  return count;
+}
+
+} // namespace Internal
+/// @endcond
+
+template <typename T>
+std::shared_ptr<const VecColumn<T>> LazyColumns::get(const std::string& name) {
+  return std::get<0>(getSeq(Named<T>(name)));
+}
+
+template <typename... Ts>
+std::tuple<std::shared_ptr<const VecColumn<Ts>>...> LazyColumns::getSeq(const Named<Ts>&... names) {
+  return getSeqImpl(std::index_sequence_for<Ts...>(), names...);
+}
+
+template <typename T>
+std::shared_ptr<const VecColumn<T>> LazyColumns::find(const std::string& name) {
+  const auto it = m_entries.find(name);
+  if (it == m_entries.end() || it->second.type != std::type_index(typeid(T))) {
+    return nullptr;
+  }
+  m_lru.splice(m_lru.begin(), m_lru, it->second.position);
+  return std::static_pointer_cast<const VecColumn<T>>(it->second.column);
+}
+
+template <typename T>
+void LazyColumns::prepare(
+    const Named<T>& name,
+    long rowCount,
+    std::shared_ptr<const VecColumn<T>>& handle,
+    std::vector<std::function<void(const Segment&)>>& reads,
+    std::vector<std::function<void()>>& inserts) {
+  handle = find<T>(name.name);
+  if (handle) {
+    return;
+  }
+  const long index = m_columns.readIndex(name.name);
+  auto column = std::make_shared<VecColumn<T>>(m_columns.readInfo<T>(index), rowCount);
+  handle = column;
+  const auto& columns = m_columns;
+  reads.push_back([&columns, index, column](const Segment& rows) {
+    columns.readSegmentTo<T>({ rows, rows.front }, index, *column);
+  });
+  inserts.push_back([this, name, column]() {
+    insert(name.name, column, typeid(T), Internal::columnByteCount(*column));
+  });
+}
+
+template <typename... Ts, std::size_t... Is>
+std::tuple<std::shared_ptr<const VecColumn<Ts>>...>
+LazyColumns::getSeqImpl(std::index_sequence<Is...>, const Named<Ts>&... names) {
+  std::tuple<std::shared_ptr<const VecColumn<Ts>>...> handles;
+  std::vector<std::function<void(const Segment&)>> reads;
+  std::vector<std::function<void()>> inserts;
+  const long rowCount = m_columns.readRowCount();
+  using mockUnpack = int[];
+  (void)mockUnpack { 0, (prepare(names, rowCount, std::get<Is>(handles), reads, inserts), 0)... };
+  if (reads.empty()) {
+    return handles;
+  }
+
+  /* Read the missing columns chunk-wise */
+  const long bufferSize = m_columns.readBufferRowCount();
+  for (long front = 0; front < rowCount; front += bufferSize) {
+    const Segment rows { front, std::min(front + bufferSize, rowCount) - 1 };
+    for (const auto& read : reads) {
+      read(rows);
+    }
+  }
+  m_readColumnCount += reads.size();
+
+  /* Cache them */
+  for (const auto& insertColumn : inserts) {
+    insertColumn();
+  }
+  shrink({ names.name... });
+  return handles;
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -20,22 +20,29 @@
 #if defined(_ELEFITS_MEFFILE_IMPL) || defined(CHECK_QUALITY)
 
   #include "EleFits/MefFile.h"
+  #include "EleFits/Trace.h"
 
 namespace Euclid {
 namespace Fits {
 
 template <class T>
 const T& MefFile::access(long index) {
-  Cfitsio::HduAccess::gotoIndex(m_fptr, index + 1); // CFitsIO index is 1-based
-  const auto hduType = Cfitsio::HduAccess::currentType(m_fptr);
-  auto& ptr = m_hdus[index];
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::access"); span.hdu(index));
+  auto* handle = m_pool ? &m_pool->local() : nullptr;
+  auto& fptr = handle ? handle->fptr : m_fptr;
+  Cfitsio::HduAccess::gotoIndex(fptr, index + 1); // CFitsIO index is 1-based
+  const auto hduType = Cfitsio::HduAccess::currentType(fptr);
+  auto& ptr = handle ? handle->hdus[index] : m_hdus[index];
   if (ptr == nullptr) {
     if (hduType == HduCategory::Image) {
-      ptr.reset(new ImageHdu(Hdu::Token {}, m_fptr, index));
+      ptr.reset(new ImageHdu(Hdu::Token {}, fptr, index));
     } else if (hduType == HduCategory::Bintable) {
-      ptr.reset(new BintableHdu(Hdu::Token {}, m_fptr, index));
+      ptr.reset(new BintableHdu(Hdu::Token {}, fptr, index));
     } else {
-      ptr.reset(new Hdu(Hdu::Token {}, m_fptr, index));
+      ptr.reset(new Hdu(Hdu::Token {}, fptr, index));
+    }
+    if (not handle) { // Diagnostics are not thread-safe
+      watch(*ptr);
     }
   }
   return ptr->as<T>();
@@ -43,12 +50,23 @@ const T& MefFile::access(long index) {
 
 template <class T>
 const T& MefFile::accessFirst(const std::string& name, long version) {
-  Cfitsio::HduAccess::gotoName(m_fptr, name, version, HduCategory::forClass<T>());
-  return access<T>(Cfitsio::HduAccess::currentIndex(m_fptr) - 1); // -1 because CFitsIO index is 1-based
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::accessFirst"); span.detail(name));
+  const bool diagnosed = m_diagnostics && not m_pool;
+  const auto start = diagnosed ? AccessDiagnostics::Clock::now() : AccessDiagnostics::Clock::time_point();
+  auto& fptr = m_pool ? m_pool->local().fptr : m_fptr;
+  Cfitsio::HduAccess::gotoName(fptr, name, version, HduCategory::forClass<T>());
+  ELEFITS_TRACE(span.hdu(fptr));
+  if (diagnosed) {
+    m_diagnostics->lookupName(name, start);
+  }
+  return access<T>(Cfitsio::HduAccess::currentIndex(fptr) - 1); // -1 because CFitsIO index is 1-based
 }
 
 template <class T>
 const T& MefFile::access(const std::string& name, long version) {
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::access"); span.detail(name));
+  const bool diagnosed = m_diagnostics && not m_pool;
+  const auto start = diagnosed ? AccessDiagnostics::Clock::now() : AccessDiagnostics::Clock::time_point();
   const auto category = HduCategory::forClass<T>();
   const Hdu* hduPtr = nullptr;
   for (long i = 0; i < hduCount(); ++i) {
@@ -67,6 +85,10 @@ const T& MefFile::access(const std::string& name, long version) {
   if (not hduPtr) {
     throw FitsError("No HDU match."); // TODO specific exception?
   }
+  ELEFITS_TRACE(span.hdu(hduPtr->index()));
+  if (diagnosed) {
+    m_diagnostics->lookupName(name, start);
+  }
   return hduPtr->as<T>();
 }
 
@@ -82,41 +104,61 @@ HduSelector<THdu> MefFile::select(const HduFilter& filter) {
 
 template <typename T, long n>
 const ImageHdu& MefFile::initImageExt(const std::string& name, const Position<n>& shape) {
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::initImageExt"); span.hdu(hduCount()); span.detail(name));
   Cfitsio::HduAccess::initImageExtension<T, n>(m_fptr, name, shape);
   const auto size = m_hdus.size();
   m_hdus.push_back(std::make_unique<ImageHdu>(Hdu::Token {}, m_fptr, size, HduCategory::Created));
+  watch(*m_hdus[size]);
   return m_hdus[size]->as<ImageHdu>();
 }
 
 template <typename T, long n>
 const ImageHdu& MefFile::assignImageExt(const std::string& name, const Raster<T, n>& raster) {
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::assignImageExt"); span.hdu(hduCount()); span.detail(name));
+  ELEFITS_TRACE(span.bytes(raster.size() * sizeof(T)));
   Cfitsio::HduAccess::assignImageExtension(m_fptr, name, raster);
+  if (m_diagnostics) {
+    m_diagnostics->writeData(m_fptr);
+  }
   const auto size = m_hdus.size();
   m_hdus.push_back(std::make_unique<ImageHdu>(Hdu::Token {}, m_fptr, size, HduCategory::Created));
+  watch(*m_hdus[size]);
   return m_hdus[size]->as<ImageHdu>();
 }
 
 template <typename... Ts>
 const BintableHdu& MefFile::initBintableExt(const std::string& name, const ColumnInfo<Ts>&... header) {
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::initBintableExt"); span.hdu(hduCount()); span.detail(name));
   Cfitsio::HduAccess::initBintableExtension(m_fptr, name, header...);
   const auto size = m_hdus.size();
   m_hdus.push_back(std::make_unique<BintableHdu>(Hdu::Token {}, m_fptr, size, HduCategory::Created));
+  watch(*m_hdus[size]);
   return m_hdus[size]->as<BintableHdu>();
 }
 
 template <typename... Ts>
 const BintableHdu& MefFile::assignBintableExt(const std::string& name, const Column<Ts>&... columns) {
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::assignBintableExt"); span.hdu(hduCount()); span.detail(name));
   Cfitsio::HduAccess::assignBintableExtension(m_fptr, name, columns...);
+  if (m_diagnostics) {
+    m_diagnostics->writeData(m_fptr);
+  }
   const auto size = m_hdus.size();
   m_hdus.push_back(std::make_unique<BintableHdu>(Hdu::Token {}, m_fptr, size, HduCategory::Created));
+  watch(*m_hdus[size]);
   return m_hdus[size]->as<BintableHdu>();
 }
 
 template <typename Tuple, std::size_t count>
 const BintableHdu& MefFile::assignBintableExt(const std::string& name, const Tuple& columns) {
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::assignBintableExt"); span.hdu(hduCount()); span.detail(name));
   Cfitsio::HduAccess::assignBintableExtension<Tuple, count>(m_fptr, name, columns);
+  if (m_diagnostics) {
+    m_diagnostics->writeData(m_fptr);
+  }
   const auto size = m_hdus.size();
   m_hdus.push_back(std::make_unique<BintableHdu>(Hdu::Token {}, m_fptr, size, HduCategory::Created));
+  watch(*m_hdus[size]);
   return m_hdus[size]->as<BintableHdu>();
 }
 
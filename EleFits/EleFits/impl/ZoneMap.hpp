@@ -0,0 +1,96 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITS_ZONEMAP_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFits/ZoneMap.h"
+
+  #include <algorithm> // min, max
+
+namespace Euclid {
+namespace Fits {
+
+template <typename T>
+void ZoneMap::update(long firstRow, const Column<T>& column) {
+  const auto& name = column.info().name;
+  if (not has(name)) {
+    return;
+  }
+  using Value = std::decay_t<T>;
+  updateRows<Value>(
+      name,
+      firstRow,
+      column.rowCount(),
+      column.info().repeatCount,
+      column.data(),
+      std::is_arithmetic<Value>());
+}
+
+template <typename T>
+void ZoneMap::updateRows(
+    const std::string& name,
+    long firstRow,
+    long rowCount,
+    long rowWidth,
+    const T* values,
+    std::true_type) {
+  auto& zones = m_zones.at(name);
+  const auto extent = this->rowCount(name);
+  if (firstRow > extent) {
+    markSkipped(zones, extent, firstRow - 1);
+  }
+  const auto lastRow = firstRow + rowCount - 1;
+  for (long row = firstRow; row <= lastRow;) {
+    auto& zone = zoneAt(zones, row);
+    const auto zoneFront = row / m_zoneRowCount * m_zoneRowCount;
+    const auto back = std::min(lastRow, zoneFront + m_zoneRowCount - 1);
+    auto min = zone.min;
+    auto max = zone.max;
+    long nullCount = 0;
+    const auto* end = values + (back - firstRow + 1) * rowWidth;
+    for (const auto* it = values + (row - firstRow) * rowWidth; it != end; ++it) {
+      const auto value = static_cast<double>(*it);
+      if (value != value) { // NaN
+        ++nullCount;
+        continue;
+      }
+      min = std::min(min, value);
+      max = std::max(max, value);
+    }
+    zone.min = min;
+    zone.max = max;
+    if (row < extent) { // Overwritten values are unknown
+      zone.nullCount = -1;
+    } else if (zone.nullCount >= 0) {
+      zone.nullCount += nullCount;
+    }
+    zone.rowCount = std::max(zone.rowCount, back - zoneFront + 1);
+    row = back + 1;
+  }
+}
+
+template <typename T>
+void ZoneMap::updateRows(const std::string& name, long, long, long, const T*, std::false_type) {
+  throw FitsError("Cannot track non-arithmetic column in zone map: " + name);
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
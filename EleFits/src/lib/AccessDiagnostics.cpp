@@ -0,0 +1,213 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/AccessDiagnostics.h"
+
+#include "EleCfitsioWrapper/BintableWrapper.h"
+#include "EleCfitsioWrapper/HduWrapper.h"
+#include "EleCfitsioWrapper/HeaderWrapper.h"
+
+namespace Euclid {
+namespace Fits {
+
+std::string accessPatternName(AccessPattern pattern) {
+  switch (pattern) {
+    case AccessPattern::ChainedColumnReads:
+      return "Chained single-column reads";
+    case AccessPattern::HduPingPong:
+      return "HDU ping-pong";
+    case AccessPattern::RepeatedNameLookups:
+      return "Repeated HDU accesses by name";
+    case AccessPattern::HeaderAfterData:
+      return "Header writes after data writes";
+  }
+  return "";
+}
+
+std::string accessPatternAdvice(AccessPattern pattern) {
+  switch (pattern) {
+    case AccessPattern::ChainedColumnReads:
+      return "Read the columns at once with BintableColumns::readSeq() or readSegmentSeq(), "
+             "or with a LazyColumns view if the columns are not known in advance";
+    case AccessPattern::HduPingPong:
+      return "Exploit each HDU at once before moving to another one, "
+             "e.g. read all the records with Header::parseSeq() and all the columns with BintableColumns::readSeq()";
+    case AccessPattern::RepeatedNameLookups:
+      return "Keep the handler returned by MefFile::access() and pass it to functions instead of the HDU name";
+    case AccessPattern::HeaderAfterData:
+      return "Create the HDU with MefFile::initImageExt() or initBintableExt(), "
+             "write the records with Header::writeSeq(), and only then write the data unit";
+  }
+  return "";
+}
+
+long AccessThresholds::at(AccessPattern pattern) const {
+  switch (pattern) {
+    case AccessPattern::ChainedColumnReads:
+      return chainedColumnReads;
+    case AccessPattern::HduPingPong:
+      return hduPingPongs;
+    case AccessPattern::RepeatedNameLookups:
+      return repeatedNameLookups;
+    case AccessPattern::HeaderAfterData:
+      return headerAfterData;
+  }
+  return 0;
+}
+
+AccessDiagnostics::MultiRead::MultiRead(AccessDiagnostics* diagnostics) : m_diagnostics(diagnostics) {
+  if (m_diagnostics) {
+    ++m_diagnostics->m_multiReadDepth;
+    m_diagnostics->m_lastColumn = { -1, -1 };
+  }
+}
+
+AccessDiagnostics::MultiRead::~MultiRead() {
+  if (m_diagnostics) {
+    --m_diagnostics->m_multiReadDepth;
+  }
+}
+
+AccessDiagnostics::AccessDiagnostics(
+    const std::string& filename,
+    const AccessThresholds& thresholds,
+    std::ostream* out) :
+    m_filename(filename),
+    m_thresholds(thresholds), m_out(out), m_counters(), m_multiReadDepth(0), m_lastColumn(-1, -1), m_currentHdu(-1),
+    m_previousHdu(-1), m_lookups(), m_dataWritten() {
+  clear();
+}
+
+const AccessDiagnostic& AccessDiagnostics::at(AccessPattern pattern) const {
+  return m_counters[static_cast<std::size_t>(pattern)];
+}
+
+std::vector<AccessDiagnostic> AccessDiagnostics::diagnostics() const {
+  std::vector<AccessDiagnostic> out;
+  for (const auto& c : m_counters) {
+    if (c.count > 0 && c.count >= m_thresholds.at(c.pattern)) {
+      out.push_back(c);
+    }
+  }
+  return out;
+}
+
+void AccessDiagnostics::writeReport(std::ostream& out) const {
+  const auto patterns = diagnostics();
+  if (patterns.empty()) {
+    return;
+  }
+  out << "EleFits access diagnostics for " << m_filename << ":\n";
+  for (const auto& p : patterns) {
+    out << "- " << accessPatternName(p.pattern) << ": " << p.count << " occurrence(s)";
+    if (p.wastedBytes > 0) {
+      out << ", ~" << p.wastedBytes << " bytes wasted";
+    }
+    if (p.wastedTime > 0) {
+      out << ", ~" << p.wastedTime << " us wasted";
+    }
+    out << "\n  " << accessPatternAdvice(p.pattern) << "\n";
+  }
+}
+
+void AccessDiagnostics::report() {
+  if (m_out) {
+    writeReport(*m_out);
+  }
+  clear();
+}
+
+void AccessDiagnostics::clear() {
+  for (std::size_t i = 0; i < accessPatternCount; ++i) {
+    m_counters[i] = AccessDiagnostic();
+    m_counters[i].pattern = static_cast<AccessPattern>(i);
+  }
+  m_lastColumn = { -1, -1 };
+  m_currentHdu = -1;
+  m_previousHdu = -1;
+  m_lookups.clear();
+  m_dataWritten.clear();
+}
+
+void AccessDiagnostics::touchHdu(long index, Clock::time_point start) {
+  if (index == m_currentHdu) {
+    return;
+  }
+  if (index == m_previousHdu) {
+    auto& c = counters(AccessPattern::HduPingPong);
+    ++c.count;
+    c.wastedTime += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+  }
+  m_previousHdu = m_currentHdu;
+  m_currentHdu = index;
+}
+
+void AccessDiagnostics::readColumn(fitsfile* fptr, long columnIndex, long rowCount) {
+  if (m_multiReadDepth > 0) {
+    return;
+  }
+  const long hdu = Cfitsio::HduAccess::currentIndex(fptr) - 1;
+  if (hdu == m_lastColumn.first && columnIndex != m_lastColumn.second) {
+    auto& c = counters(AccessPattern::ChainedColumnReads);
+    ++c.count;
+    c.wastedBytes += rowCount * Cfitsio::HeaderIo::parseRecord<long>(fptr, "NAXIS1").value;
+  }
+  m_lastColumn = { hdu, columnIndex };
+}
+
+void AccessDiagnostics::writeData(fitsfile* fptr) {
+  m_dataWritten.insert(Cfitsio::HduAccess::currentIndex(fptr) - 1);
+}
+
+void AccessDiagnostics::writeHeader(fitsfile* fptr) {
+  if (m_dataWritten.count(Cfitsio::HduAccess::currentIndex(fptr) - 1) == 0) {
+    return;
+  }
+  auto& c = counters(AccessPattern::HeaderAfterData);
+  ++c.count;
+  int status = 0;
+  int existCount = 0;
+  int moreCount = 0;
+  fits_get_hdrspace(fptr, &existCount, &moreCount, &status);
+  if (status == 0 && moreCount == 0) { // The header will grow by one block
+    LONGLONG headStart = 0;
+    LONGLONG dataStart = 0;
+    LONGLONG dataEnd = 0;
+    fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &status);
+    if (status == 0) {
+      c.wastedBytes += dataEnd - dataStart;
+    }
+  }
+}
+
+void AccessDiagnostics::lookupName(const std::string& name, Clock::time_point start) {
+  if (++m_lookups[name] == 1) {
+    return;
+  }
+  auto& c = counters(AccessPattern::RepeatedNameLookups);
+  ++c.count;
+  c.wastedTime += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+AccessDiagnostic& AccessDiagnostics::counters(AccessPattern pattern) {
+  return m_counters[static_cast<std::size_t>(pattern)];
+}
+
+} // namespace Fits
+} // namespace Euclid
@@ -0,0 +1,39 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/BintableAppender.h"
+
+namespace Euclid {
+namespace Fits {
+
+long recoverAppendedRows(const BintableHdu& hdu) {
+  const auto& header = hdu.header();
+  if (not header.has(Internal::committedRowCountKeyword)) {
+    return hdu.readRowCount();
+  }
+  const auto rowCount = header.parse<long>(Internal::committedRowCountKeyword).value;
+  const auto& columns = hdu.columns();
+  columns.m_edit();
+  Cfitsio::BintableIo::truncateRows(columns.m_fptr, rowCount);
+  header.remove(Internal::committedRowCountKeyword);
+  return rowCount;
+}
+
+} // namespace Fits
+} // namespace Euclid
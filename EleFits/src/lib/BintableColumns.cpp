@@ -25,9 +25,12 @@ namespace Fits {
 BintableColumns::BintableColumns(
     fitsfile*& fptr,
     std::function<void(void)> touchFunc,
-    std::function<void(void)> editFunc) :
+    std::function<void(void)> editFunc,
+    AccessDiagnostics* const& diagnostics,
+    IoExecutor* const& executor) :
     m_fptr(fptr),
-    m_touch(touchFunc), m_edit(editFunc) {}
+    m_touch(touchFunc), m_edit(editFunc), m_overflowPolicy(OverflowPolicy::Throw), m_zoneMap(nullptr),
+    m_diagnostics(diagnostics), m_executor(executor) {}
 
 long BintableColumns::readColumnCount() const {
   m_touch();
@@ -89,6 +92,41 @@ void BintableColumns::rename(long index, const std::string& newName) const {
   Cfitsio::BintableIo::updateColumnName(m_fptr, index + 1, newName);
 }
 
+Scaling BintableColumns::readScaling(const std::string& name) const {
+  return readScaling(readIndex(name));
+}
+
+Scaling BintableColumns::readScaling(long index) const {
+  m_touch();
+  return Cfitsio::BintableIo::readColumnScaling(m_fptr, index + 1);
+}
+
+BitColumn BintableColumns::readBits(const std::string& name) const {
+  return readBits(readIndex(name));
+}
+
+BitColumn BintableColumns::readBits(long index) const {
+  BitColumn column(readInfo<bool>(index), readRowCount());
+  readSegmentTo<unsigned char>(Segment::whole(), index, column);
+  return column;
+}
+
+OverflowPolicy BintableColumns::overflowPolicy() const {
+  return m_overflowPolicy;
+}
+
+void BintableColumns::setOverflowPolicy(OverflowPolicy policy) {
+  m_overflowPolicy = policy;
+}
+
+ZoneMap* BintableColumns::zoneMap() const {
+  return m_zoneMap;
+}
+
+void BintableColumns::setZoneMap(ZoneMap* zones) {
+  m_zoneMap = zones;
+}
+
 void BintableColumns::remove(const std::string& name) const {
   remove(readIndex(name));
 }
@@ -113,5 +151,12 @@ void BintableColumns::removeSeq(const std::vector<long>& indices) const {
   }
 }
 
+IoExecutor& BintableColumns::executor() const {
+  if (not m_executor) {
+    throw FitsError("Cannot perform asynchronous operations: binary table data unit is not attached to a file");
+  }
+  return *m_executor;
+}
+
 } // namespace Fits
 } // namespace Euclid
\ No newline at end of file
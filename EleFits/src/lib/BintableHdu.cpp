@@ -30,7 +30,9 @@ BintableHdu::BintableHdu(Token token, fitsfile*& fptr, long index, HduCategory s
                                                                 },
                                                                 [&]() {
                                                                   editThisHdu();
-                                                                }) {}
+                                                                },
+                                                                m_diagnostics,
+                                                                m_executor) {}
 
 BintableHdu::BintableHdu() :
     Hdu(), m_columns(
@@ -40,7 +42,9 @@ BintableHdu::BintableHdu() :
                },
                [&]() {
                  editThisHdu();
-               }) {}
+               },
+               m_diagnostics,
+               m_executor) {}
 
 const BintableColumns& BintableHdu::columns() const {
   return m_columns;
@@ -0,0 +1,111 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/CutoutPlan.h"
+
+#include "EleFits/ParallelFor.h"
+
+#include <algorithm> // max, min, stable_sort
+#include <thread>
+
+namespace Euclid {
+namespace Fits {
+
+CutoutPlan::CutoutPlan(
+    const std::vector<Region<2>>& stamps,
+    const Position<2>& imageShape,
+    long elementByteCount,
+    const CutoutOptions& options) :
+    m_stamps(stamps),
+    m_clipped(stamps.size()), m_slabs() {
+
+  /* Clip */
+  std::vector<long> order;
+  for (std::size_t i = 0; i < stamps.size(); ++i) {
+    auto& c = m_clipped[i];
+    for (long d = 0; d < 2; ++d) {
+      c.front[d] = std::max(stamps[i].front[d], 0L);
+      c.back[d] = std::min(stamps[i].back[d], imageShape[d] - 1);
+    }
+    if (c.front[0] <= c.back[0] && c.front[1] <= c.back[1]) {
+      order.push_back(i);
+    }
+  }
+
+  /* Sort by file offset */
+  std::stable_sort(order.begin(), order.end(), [&](long lhs, long rhs) {
+    return m_clipped[lhs].front[1] < m_clipped[rhs].front[1];
+  });
+
+  /* Group */
+  long budget = options.memoryBudget / elementByteCount;
+  if (options.threadCount != 1 && budget > 0) {
+    const long threadCount =
+        options.threadCount > 0 ? options.threadCount : std::max(1L, long(std::thread::hardware_concurrency()));
+    budget /= threadCount;
+  }
+  for (auto i : order) {
+    const auto& c = m_clipped[i];
+    if (not m_slabs.empty()) {
+      auto& slab = m_slabs.back();
+      Region<2> merged = slab.region;
+      merged.front[0] = std::min(merged.front[0], c.front[0]);
+      merged.back[0] = std::max(merged.back[0], c.back[0]);
+      merged.back[1] = std::max(merged.back[1], c.back[1]);
+      const bool near = c.front[1] <= slab.region.back[1] + options.maxGap + 1;
+      if (near && (budget <= 0 || merged.size() <= budget)) {
+        slab.region = merged;
+        slab.stamps.push_back(i);
+        continue;
+      }
+    }
+    m_slabs.push_back({c, {i}});
+  }
+}
+
+long CutoutPlan::size() const {
+  return m_stamps.size();
+}
+
+const std::vector<Region<2>>& CutoutPlan::stamps() const {
+  return m_stamps;
+}
+
+const Region<2>& CutoutPlan::clipped(long index) const {
+  return m_clipped[index];
+}
+
+const std::vector<CutoutPlan::Slab>& CutoutPlan::slabs() const {
+  return m_slabs;
+}
+
+long CutoutPlan::readPixelCount() const {
+  long count = 0;
+  for (const auto& s : m_slabs) {
+    count += s.region.size();
+  }
+  return count;
+}
+
+void CutoutPlan::forEachSlab(const std::function<void(long, long)>& func, long threadCount) const {
+  Internal::parallelFor(m_slabs.size(), threadCount, func);
+}
+
+} // namespace Fits
+} // namespace Euclid
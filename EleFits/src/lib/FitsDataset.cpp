@@ -0,0 +1,142 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/FitsDataset.h"
+
+#include "EleFits/ParallelFor.h"
+
+#include <algorithm> // max, upper_bound
+#include <glob.h>
+#include <thread>
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief The schema of a binary table, i.e. the names and TFORMs of the columns.
+ */
+std::vector<std::string> readSchema(const BintableHdu& hdu) {
+  const auto names = hdu.columns().readAllNames();
+  std::vector<std::string> schema;
+  schema.reserve(names.size() * 2);
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    schema.push_back(names[i]);
+    schema.push_back(hdu.header().parse<std::string>("TFORM" + std::to_string(i + 1)).value);
+  }
+  return schema;
+}
+
+} // namespace Internal
+/// @endcond
+
+FitsDataset::FitsDataset(std::vector<std::string> filenames, long hduIndex, long threadCount) :
+    m_filenames(std::move(filenames)), m_hduIndex(hduIndex), m_threadCount(threadCount), m_names(),
+    m_offsets(m_filenames.size() + 1, 0) {
+  if (m_filenames.empty()) {
+    throw FitsError("Cannot create an empty dataset");
+  }
+  if (m_threadCount <= 0) {
+    m_threadCount = std::thread::hardware_concurrency();
+  }
+
+  /* Read the reference schema */
+  std::vector<std::string> schema;
+  {
+    MefFile f(m_filenames[0], FileMode::Read);
+    const auto& hdu = f.access<BintableHdu>(m_hduIndex);
+    schema = Internal::readSchema(hdu);
+    m_names = hdu.columns().readAllNames();
+  }
+
+  /* Read the row counts and check the schemas */
+  std::vector<long> fileIndices(fileCount());
+  for (long i = 0; i < fileCount(); ++i) {
+    fileIndices[i] = i;
+  }
+  forEachFile(fileIndices, [&](long i) {
+    MefFile f(m_filenames[i], FileMode::Read);
+    const auto& hdu = f.access<BintableHdu>(m_hduIndex);
+    if (i > 0 && Internal::readSchema(hdu) != schema) {
+      throw FitsError("Schema of " + m_filenames[i] + " differs from that of " + m_filenames[0]);
+    }
+    m_offsets[i + 1] = hdu.readRowCount();
+  });
+  for (long i = 0; i < fileCount(); ++i) {
+    m_offsets[i + 1] += m_offsets[i];
+  }
+}
+
+std::vector<std::string> FitsDataset::listFiles(const std::string& pattern) {
+  glob_t matches;
+  const int status = glob(pattern.c_str(), 0, nullptr, &matches);
+  std::vector<std::string> filenames;
+  if (status == 0) {
+    filenames.assign(matches.gl_pathv, matches.gl_pathv + matches.gl_pathc); // Sorted by glob
+  }
+  globfree(&matches);
+  if (status != 0 && status != GLOB_NOMATCH) {
+    throw FitsError("Cannot list files: " + pattern);
+  }
+  return filenames;
+}
+
+const std::vector<std::string>& FitsDataset::filenames() const {
+  return m_filenames;
+}
+
+long FitsDataset::fileCount() const {
+  return m_filenames.size();
+}
+
+const std::vector<std::string>& FitsDataset::readColumnNames() const {
+  return m_names;
+}
+
+long FitsDataset::readRowCount() const {
+  return m_offsets.back();
+}
+
+long FitsDataset::readRowCount(long fileIndex) const {
+  return m_offsets[fileIndex + 1] - m_offsets[fileIndex];
+}
+
+long FitsDataset::readFileIndex(long row) const {
+  OutOfBoundsError::mayThrow("Row index", row, { 0, readRowCount() - 1 });
+  return std::upper_bound(m_offsets.begin(), m_offsets.end(), row) - m_offsets.begin() - 1;
+}
+
+void FitsDataset::forEachFile(const std::vector<long>& fileIndices, const std::function<void(long)>& func) const {
+  Internal::parallelFor(fileIndices.size(), std::max(1L, m_threadCount), [&](long i, long) {
+    func(fileIndices[i]);
+  });
+}
+
+Segment FitsDataset::resolve(const Segment& rows) const {
+  auto resolved = rows;
+  if (resolved.back == -1) {
+    resolved.back = readRowCount() - 1;
+  }
+  return resolved;
+}
+
+} // namespace Fits
+} // namespace Euclid
@@ -20,9 +20,13 @@
 #include "EleFits/FitsFile.h"
 
 #include "EleCfitsioWrapper/FileWrapper.h"
+#include "EleFits/Trace.h"
 #include "EleFitsData/FitsError.h"
 #include "ElementsKernel/Project.h"
 
+#include <algorithm> // copy, fill
+#include <cstdlib> // malloc, realloc, free
+
 namespace Euclid {
 namespace Fits {
 
@@ -38,11 +42,73 @@ void ReadOnlyError::mayThrow(const std::string& prefix, FileMode mode) {
   }
 }
 
+MemoryBuffer::MemoryBuffer() : m_data(nullptr), m_capacity(0), m_size(0), m_owned(true) {}
+
+MemoryBuffer::MemoryBuffer(const std::vector<unsigned char>& bytes) : MemoryBuffer() {
+  std::copy(bytes.begin(), bytes.end(), reserve(bytes.size()));
+  m_size = bytes.size();
+}
+
+MemoryBuffer::MemoryBuffer(const void* data, std::size_t size) :
+    m_data(const_cast<void*>(data)), m_capacity(size), m_size(size), m_owned(false) {}
+
+MemoryBuffer::~MemoryBuffer() {
+  clear();
+}
+
+const unsigned char* MemoryBuffer::data() const {
+  return static_cast<const unsigned char*>(m_data);
+}
+
+std::size_t MemoryBuffer::size() const {
+  return m_size;
+}
+
+bool MemoryBuffer::isWritable() const {
+  return m_owned;
+}
+
+std::vector<unsigned char> MemoryBuffer::vector() const {
+  return std::vector<unsigned char>(data(), data() + m_size);
+}
+
+unsigned char* MemoryBuffer::reserve(std::size_t size) {
+  if (not m_owned) {
+    throw FitsError("Cannot write a read-only memory buffer.");
+  }
+  if (m_capacity < size) {
+    auto* data = std::realloc(m_data, size); // As CFitsIO does
+    if (not data) {
+      throw FitsError("Cannot allocate memory buffer of " + std::to_string(size) + " bytes.");
+    }
+    std::fill(static_cast<unsigned char*>(data) + m_capacity, static_cast<unsigned char*>(data) + size, 0);
+    m_data = data;
+    m_capacity = size;
+  }
+  return static_cast<unsigned char*>(m_data);
+}
+
+void MemoryBuffer::clear() {
+  if (m_owned) {
+    std::free(m_data);
+  }
+  m_data = nullptr;
+  m_capacity = 0;
+  m_size = 0;
+}
+
 FitsFile::FitsFile(const std::string& filename, FileMode permission) :
-    m_fptr(nullptr), m_filename(filename), m_permission(permission), m_open(false) {
+    m_fptr(nullptr), m_filename(filename), m_permission(permission), m_open(false), m_memory(nullptr),
+    m_diagnostics(), m_pool(), m_executor() {
   open(filename, permission);
 }
 
+FitsFile::FitsFile(MemoryBuffer& buffer, FileMode permission) :
+    m_fptr(nullptr), m_filename("mem://"), m_permission(permission), m_open(false), m_memory(nullptr),
+    m_diagnostics(), m_pool(), m_executor() {
+  open(buffer, permission);
+}
+
 FitsFile::~FitsFile() {
   close();
 }
@@ -56,6 +122,19 @@ bool FitsFile::isOpen() const {
 }
 
 void FitsFile::reopen() {
+  if (m_memory && not m_open) {
+    switch (m_permission) {
+      case FileMode::Temporary:
+        throw FitsError("Cannot reopen closed temporary file.");
+        break;
+      case FileMode::Read:
+        open(*m_memory, FileMode::Read);
+        break;
+      default:
+        open(*m_memory, FileMode::Edit);
+        break;
+    }
+  }
   if (not m_open) {
     switch (m_permission) {
       case FileMode::Create:
@@ -73,6 +152,7 @@ void FitsFile::reopen() {
 }
 
 void FitsFile::open(const std::string& filename, FileMode permission) {
+  ELEFITS_TRACE(TraceSpan span("file", "FitsFile::open"); span.detail(filename));
   if (m_open) {
     throw FitsError("Cannot open file '" + filename + "' because '" + m_filename + "' is still open.");
   }
@@ -95,12 +175,58 @@ void FitsFile::open(const std::string& filename, FileMode permission) {
   m_filename = filename;
   m_permission = permission;
   m_open = true; // If this line is reached, no error was raised
+  m_memory = nullptr;
+}
+
+void FitsFile::open(MemoryBuffer& buffer, FileMode permission) {
+  ELEFITS_TRACE(TraceSpan span("file", "FitsFile::open"); span.detail("mem://"));
+  if (m_open) {
+    throw FitsError("Cannot open file in memory because '" + m_filename + "' is still open.");
+  }
+  if (permission != FileMode::Read && not buffer.isWritable()) {
+    throw ReadOnlyError("Cannot open read-only memory buffer");
+  }
+  switch (permission) {
+    case FileMode::Read:
+      buffer.m_capacity = buffer.m_size; // Hide the unused capacity from CFitsIO
+      m_fptr = Cfitsio::FileAccess::open(&buffer.m_data, &buffer.m_capacity, Cfitsio::FileAccess::OpenPolicy::ReadOnly);
+      break;
+    case FileMode::Edit:
+      buffer.m_capacity = buffer.m_size;
+      m_fptr =
+          Cfitsio::FileAccess::open(&buffer.m_data, &buffer.m_capacity, Cfitsio::FileAccess::OpenPolicy::ReadWrite);
+      break;
+    default: // Create, Overwrite, Temporary
+      buffer.m_size = 0;
+      m_fptr = Cfitsio::FileAccess::createAndOpen(&buffer.m_data, &buffer.m_capacity);
+  }
+  m_filename = "mem://";
+  m_permission = permission;
+  m_open = true; // If this line is reached, no error was raised
+  m_memory = &buffer;
 }
 
 void FitsFile::close() {
   if (not m_open) {
     return;
   }
+  m_executor.wait();
+  ELEFITS_TRACE(TraceSpan span("file", "FitsFile::close"); span.detail(m_filename));
+  if (m_diagnostics) {
+    m_diagnostics->report();
+  }
+  m_pool.reset();
+  if (m_memory) {
+    if (m_permission != FileMode::Read) {
+      m_memory->m_size = Cfitsio::FileAccess::byteCount(m_fptr);
+    }
+    Cfitsio::FileAccess::close(m_fptr);
+    m_open = false;
+    if (m_permission == FileMode::Temporary) {
+      m_memory->clear();
+    }
+    return;
+  }
   switch (m_permission) {
     case FileMode::Temporary:
       closeAndDelete();
@@ -115,6 +241,19 @@ void FitsFile::closeAndDelete() {
   if (not m_open) {
     return; // TODO should we delete if not open?
   }
+  m_executor.wait();
+  ELEFITS_TRACE(TraceSpan span("file", "FitsFile::closeAndDelete"); span.detail(m_filename));
+  if (m_diagnostics) {
+    m_diagnostics->report();
+  }
+  m_pool.reset();
+  if (m_memory) {
+    ReadOnlyError::mayThrow("Cannot delete file in memory", m_permission);
+    Cfitsio::FileAccess::close(m_fptr);
+    m_open = false;
+    m_memory->clear();
+    return;
+  }
   Cfitsio::FileAccess::closeAndDelete(m_fptr);
   m_open = false;
 }
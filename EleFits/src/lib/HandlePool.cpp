@@ -0,0 +1,80 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/HandlePool.h"
+
+#include "EleCfitsioWrapper/FileWrapper.h"
+#include "EleFits/Hdu.h"
+
+namespace Euclid {
+namespace Fits {
+
+HandlePool::HandlePool(std::function<void(Handle&)> open, long hduCount) :
+    m_open(std::move(open)), m_hduCount(hduCount), m_mutex(), m_handles(), m_free(), m_bound() {}
+
+HandlePool::~HandlePool() {
+  for (auto& h : m_handles) {
+    h->hdus.clear(); // Before the handle they refer to is closed
+    try {
+      Cfitsio::FileAccess::close(h->fptr);
+    } catch (...) {
+      // Read-only handles have nothing to flush
+    }
+  }
+}
+
+HandlePool::Handle& HandlePool::local() {
+  const auto id = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto it = m_bound.find(id);
+  if (it != m_bound.end()) {
+    return *it->second;
+  }
+  Handle* handle = nullptr;
+  if (m_free.empty()) {
+    auto created = std::make_unique<Handle>();
+    created->hdus.resize(m_hduCount);
+    m_open(*created);
+    handle = created.get();
+    m_handles.push_back(std::move(created));
+  } else {
+    handle = m_free.back();
+    m_free.pop_back();
+  }
+  m_bound[id] = handle;
+  return *handle;
+}
+
+void HandlePool::release() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto it = m_bound.find(std::this_thread::get_id());
+  if (it == m_bound.end()) {
+    return;
+  }
+  m_free.push_back(it->second);
+  m_bound.erase(it);
+}
+
+long HandlePool::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_handles.size();
+}
+
+} // namespace Fits
+} // namespace Euclid
@@ -32,7 +32,7 @@ Hdu::Hdu(Token, fitsfile*& fptr, long index, HduCategory type, HduCategory statu
                                                                  touchThisHdu();
                                                                },
                                                                [&]() {
-                                                                 editThisHdu();
+                                                                 editThisHeader();
                                                                }),
     m_status(status) {}
 
@@ -75,12 +75,12 @@ long Hdu::readVersion() const {
 }
 
 void Hdu::updateName(const std::string& name) const {
-  editThisHdu();
+  editThisHeader();
   Cfitsio::HduAccess::updateName(m_fptr, name);
 }
 
 void Hdu::updateVersion(long version) const {
-  editThisHdu();
+  editThisHeader();
   Cfitsio::HduAccess::updateVersion(m_fptr, version);
 }
 
@@ -103,7 +103,13 @@ void Hdu::updateChecksums() const {
 }
 
 void Hdu::touchThisHdu() const {
-  Cfitsio::HduAccess::gotoIndex(m_fptr, m_cfitsioIndex);
+  if (m_diagnostics) {
+    const auto start = AccessDiagnostics::Clock::now();
+    Cfitsio::HduAccess::gotoIndex(m_fptr, m_cfitsioIndex);
+    m_diagnostics->touchHdu(index(), start);
+  } else {
+    Cfitsio::HduAccess::gotoIndex(m_fptr, m_cfitsioIndex);
+  }
   if (m_status == HduCategory::Untouched) {
     m_status = HduCategory::Touched;
   }
@@ -114,5 +120,12 @@ void Hdu::editThisHdu() const {
   m_status &= HduCategory::Edited;
 }
 
+void Hdu::editThisHeader() const {
+  editThisHdu();
+  if (m_diagnostics) {
+    m_diagnostics->writeHeader(m_fptr);
+  }
+}
+
 } // namespace Fits
 } // namespace Euclid
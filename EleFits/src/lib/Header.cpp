@@ -19,6 +19,7 @@
 
 #include "EleCfitsioWrapper/HeaderWrapper.h"
 #include "EleFits/Hdu.h"
+#include "EleFits/Trace.h"
 
 #include <algorithm> // find
 
@@ -29,28 +30,38 @@ Header::Header(fitsfile*& fptr, std::function<void(void)> touchFunction, std::fu
     m_fptr(fptr), m_touch(touchFunction), m_edit(editFunction) {}
 
 bool Header::has(const std::string& keyword) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::has"));
   m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.detail(keyword));
   return Cfitsio::HeaderIo::hasKeyword(m_fptr, keyword);
 }
 
 void Header::remove(const std::string& keyword) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::remove"));
   m_edit();
+  ELEFITS_TRACE(span.hdu(m_fptr); span.detail(keyword));
   KeywordNotFoundError::mayThrow(keyword, *this);
   Cfitsio::HeaderIo::deleteRecord(m_fptr, keyword);
 }
 
 std::vector<std::string> Header::readKeywords(KeywordCategory categories) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::readKeywords"));
   m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr));
   return Cfitsio::HeaderIo::listKeywords(m_fptr, categories);
 }
 
 std::map<std::string, std::string> Header::readKeywordsValues(KeywordCategory categories) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::readKeywordsValues"));
   m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr));
   return Cfitsio::HeaderIo::listKeywordsValues(m_fptr, categories);
 }
 
 std::string Header::readAll(KeywordCategory categories) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::readAll"));
   m_touch();
+  ELEFITS_TRACE(span.hdu(m_fptr));
   const bool incNonValues = categories == KeywordCategory::All;
   return Cfitsio::HeaderIo::readHeader(m_fptr, incNonValues);
 }
@@ -97,12 +108,16 @@ void Header::write<RecordMode::UpdateExisting, const char*>(
 }
 
 void Header::writeComment(const std::string& comment) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::writeComment"));
   m_edit();
+  ELEFITS_TRACE(span.hdu(m_fptr));
   return Cfitsio::HeaderIo::writeComment(m_fptr, comment);
 }
 
 void Header::writeHistory(const std::string& history) const {
+  ELEFITS_TRACE(TraceSpan span("header", "Header::writeHistory"));
   m_edit();
+  ELEFITS_TRACE(span.hdu(m_fptr));
   return Cfitsio::HeaderIo::writeHistory(m_fptr, history);
 }
 
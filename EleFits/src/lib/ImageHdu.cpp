@@ -33,7 +33,9 @@ ImageHdu::ImageHdu(Token token, fitsfile*& fptr, long index, HduCategory status)
                                                              },
                                                              [&]() {
                                                                editThisHdu();
-                                                             }) {}
+                                                             },
+                                                             m_diagnostics,
+                                                             m_executor) {}
 
 ImageHdu::ImageHdu() :
     Hdu(), m_raster(
@@ -43,7 +45,9 @@ ImageHdu::ImageHdu() :
                },
                [&]() {
                  editThisHdu();
-               }) {}
+               },
+               m_diagnostics,
+               m_executor) {}
 
 const ImageRaster& ImageHdu::raster() const {
   return m_raster;
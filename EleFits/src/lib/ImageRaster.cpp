@@ -22,17 +22,44 @@
 namespace Euclid {
 namespace Fits {
 
-ImageRaster::ImageRaster(fitsfile*& fptr, std::function<void(void)> touchFunc, std::function<void(void)> editFunc) :
-    m_fptr(fptr), m_touch(touchFunc), m_edit(editFunc) {}
+ImageRaster::ImageRaster(
+    fitsfile*& fptr,
+    std::function<void(void)> touchFunc,
+    std::function<void(void)> editFunc,
+    AccessDiagnostics* const& diagnostics,
+    IoExecutor* const& executor) :
+    m_fptr(fptr),
+    m_touch(touchFunc), m_edit(editFunc), m_overflowPolicy(OverflowPolicy::Throw), m_diagnostics(diagnostics),
+    m_executor(executor) {}
 
 const std::type_info& ImageRaster::readTypeid() const {
   m_touch();
   return Cfitsio::ImageIo::readTypeid(m_fptr);
 }
 
+Scaling ImageRaster::readScaling() const {
+  m_touch();
+  return Cfitsio::ImageIo::readScaling(m_fptr);
+}
+
+OverflowPolicy ImageRaster::overflowPolicy() const {
+  return m_overflowPolicy;
+}
+
+void ImageRaster::setOverflowPolicy(OverflowPolicy policy) {
+  m_overflowPolicy = policy;
+}
+
 long ImageRaster::readSize() const {
   return shapeSize(readShape());
 }
 
+IoExecutor& ImageRaster::executor() const {
+  if (not m_executor) {
+    throw FitsError("Cannot perform asynchronous operations: image data unit is not attached to a file");
+  }
+  return *m_executor;
+}
+
 } // namespace Fits
 } // namespace Euclid
\ No newline at end of file
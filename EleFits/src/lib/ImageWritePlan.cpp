@@ -0,0 +1,131 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/ImageWritePlan.h"
+
+#include "EleFits/ParallelFor.h"
+#include "EleFitsData/Conversion.h" // scratch
+#include "EleFitsData/FitsError.h"
+
+#include <algorithm> // min, max
+#include <cerrno>
+#include <cstring> // strerror
+#include <fcntl.h> // open, posix_fallocate
+#include <unistd.h> // pwrite, close
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief The maximum number of bytes encoded at once by each thread.
+ */
+constexpr long encodingChunkByteCount = 1 << 20;
+
+/**
+ * @brief Write a buffer at given offset, retrying on partial writes and interruptions.
+ */
+void writeAt(int fd, const unsigned char* buffer, long size, long offset, const std::string& filename) {
+  while (size > 0) {
+    const auto written = pwrite(fd, buffer, size, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw FitsError("Cannot write data unit into file: " + filename + " (" + std::strerror(errno) + ")");
+    }
+    buffer += written;
+    size -= written;
+    offset += written;
+  }
+}
+
+} // namespace Internal
+/// @endcond
+
+long ImageWritePlan::size() const {
+  return m_entries.size();
+}
+
+long ImageWritePlan::dataByteCount() const {
+  long count = 0;
+  for (const auto& e : m_entries) {
+    count += e.elementCount * e.elementByteCount;
+  }
+  return count;
+}
+
+void ImageWritePlan::fill(
+    const std::string& filename,
+    const std::vector<long>& offsets,
+    long fileSize,
+    long threadCount) const {
+
+  /* Open and preallocate */
+  const int fd = open(filename.c_str(), O_WRONLY);
+  if (fd < 0) {
+    throw FitsError("Cannot open file for parallel writing: " + filename + " (" + std::strerror(errno) + ")");
+  }
+  posix_fallocate(fd, 0, fileSize); // Best effort: file systems without support are just not preallocated
+
+  /* Encode and write chunk-wise */
+  try {
+    forEachEntry(
+        [&](long i) {
+          const auto& e = m_entries[i];
+          const long chunkSize = Internal::encodingChunkByteCount / e.elementByteCount;
+          auto* buffer = Internal::scratch<unsigned char>(Internal::encodingChunkByteCount);
+          for (long front = 0; front < e.elementCount; front += chunkSize) {
+            const long count = std::min(chunkSize, e.elementCount - front);
+            e.encode(front, count, buffer);
+            const long offset = offsets[i] + front * e.elementByteCount;
+            Internal::writeAt(fd, buffer, count * e.elementByteCount, offset, filename);
+          }
+        },
+        threadCount);
+  } catch (...) {
+    close(fd);
+    throw;
+  }
+
+  /* Close */
+  if (close(fd) != 0) {
+    throw FitsError("Cannot close file after parallel writing: " + filename + " (" + std::strerror(errno) + ")");
+  }
+}
+
+void ImageWritePlan::fill(unsigned char* data, const std::vector<long>& offsets, long threadCount) const {
+  forEachEntry(
+      [&](long i) {
+        const auto& e = m_entries[i];
+        e.encode(0, e.elementCount, data + offsets[i]);
+      },
+      threadCount);
+}
+
+void ImageWritePlan::forEachEntry(const std::function<void(long)>& func, long threadCount) const {
+  Internal::parallelFor(size(), threadCount, [&](long i, long) {
+    func(i);
+  });
+}
+
+} // namespace Fits
+} // namespace Euclid
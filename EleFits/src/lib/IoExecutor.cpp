@@ -0,0 +1,84 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/IoExecutor.h"
+
+namespace Euclid {
+namespace Fits {
+
+IoExecutor::IoExecutor() : m_mutex(), m_wake(), m_idle(), m_tasks(), m_busy(false), m_stop(false), m_thread() {}
+
+IoExecutor::~IoExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_one();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+void IoExecutor::wait() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_idle.wait(lock, [&]() {
+    return m_tasks.empty() && not m_busy;
+  });
+}
+
+long IoExecutor::pendingCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_tasks.size() + (m_busy ? 1 : 0);
+}
+
+void IoExecutor::push(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+    if (not m_thread.joinable()) {
+      m_thread = std::thread(&IoExecutor::run, this);
+    }
+  }
+  m_wake.notify_one();
+}
+
+void IoExecutor::run() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_wake.wait(lock, [&]() {
+      return m_stop || not m_tasks.empty();
+    });
+    if (m_tasks.empty()) { // Stop requested and nothing left to do
+      return;
+    }
+    auto task = std::move(m_tasks.front());
+    m_tasks.pop_front();
+    m_busy = true;
+    lock.unlock();
+    task(); // Exceptions are caught by the packaged task
+    lock.lock();
+    m_busy = false;
+    if (m_tasks.empty()) {
+      m_idle.notify_all();
+    }
+  }
+}
+
+} // namespace Fits
+} // namespace Euclid
@@ -0,0 +1,92 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/LazyColumns.h"
+
+#include <algorithm> // find
+
+namespace Euclid {
+namespace Fits {
+
+LazyColumns::LazyColumns(const BintableColumns& columns, std::size_t budget) :
+    m_columns(columns), m_budget(budget), m_byteCount(0), m_readColumnCount(0), m_entries(), m_lru() {}
+
+std::size_t LazyColumns::budget() const {
+  return m_budget;
+}
+
+void LazyColumns::setBudget(std::size_t budget) {
+  m_budget = budget;
+  shrink();
+}
+
+std::size_t LazyColumns::byteCount() const {
+  return m_byteCount;
+}
+
+long LazyColumns::readColumnCount() const {
+  return m_readColumnCount;
+}
+
+bool LazyColumns::isCached(const std::string& name) const {
+  return m_entries.find(name) != m_entries.end();
+}
+
+void LazyColumns::evict(const std::string& name) {
+  const auto it = m_entries.find(name);
+  if (it == m_entries.end()) {
+    return;
+  }
+  m_byteCount -= it->second.byteCount;
+  m_lru.erase(it->second.position);
+  m_entries.erase(it);
+}
+
+void LazyColumns::clear() {
+  m_entries.clear();
+  m_lru.clear();
+  m_byteCount = 0;
+}
+
+void LazyColumns::insert(
+    const std::string& name,
+    std::shared_ptr<const void> column,
+    std::type_index type,
+    std::size_t byteCount) {
+  evict(name); // Possibly cached with another type
+  m_lru.push_front(name);
+  m_entries.emplace(name, Entry { std::move(column), type, byteCount, m_lru.begin() });
+  m_byteCount += byteCount;
+}
+
+void LazyColumns::shrink(const std::vector<std::string>& pinned) {
+  auto it = m_lru.end();
+  while (m_byteCount > m_budget && it != m_lru.begin()) {
+    --it;
+    if (std::find(pinned.begin(), pinned.end(), *it) != pinned.end()) {
+      continue;
+    }
+    const auto name = *it;
+    ++it; // Keep a valid iterator
+    evict(name);
+  }
+}
+
+} // namespace Fits
+} // namespace Euclid
@@ -19,7 +19,10 @@
 
 #include "EleFits/MefFile.h"
 
+#include "EleCfitsioWrapper/FileWrapper.h"
 #include "EleCfitsioWrapper/HduWrapper.h"
+#include "EleFits/ImageWritePlan.h"
+#include "EleFits/Trace.h"
 
 namespace Euclid {
 namespace Fits {
@@ -28,11 +31,19 @@ MefFile::MefFile(const std::string& filename, FileMode permission) :
     FitsFile(filename, permission), m_hdus(std::max(1L, Cfitsio::HduAccess::count(m_fptr))) {
 } // 1 for create, count() for open
 
+MefFile::MefFile(MemoryBuffer& buffer, FileMode permission) :
+    FitsFile(buffer, permission), m_hdus(std::max(1L, Cfitsio::HduAccess::count(m_fptr))) {}
+
+MefFile::~MefFile() {
+  m_executor.wait(); // Before the HDU handlers are destroyed
+}
+
 long MefFile::hduCount() const {
   return m_hdus.size();
 }
 
 std::vector<std::string> MefFile::readHduNames() {
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::readHduNames"));
   const long count = hduCount();
   std::vector<std::string> names(count);
   for (long i = 0; i < count; ++i) {
@@ -42,6 +53,7 @@ std::vector<std::string> MefFile::readHduNames() {
 }
 
 std::vector<std::pair<std::string, long>> MefFile::readHduNamesVersions() {
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::readHduNamesVersions"));
   const long count = hduCount();
   std::vector<std::pair<std::string, long>> namesVersions(count);
   for (long i = 0; i < count; ++i) {
@@ -53,6 +65,53 @@ std::vector<std::pair<std::string, long>> MefFile::readHduNamesVersions() {
   return namesVersions;
 }
 
+Cfitsio::IoFileStats MefFile::ioStats() const {
+  return Cfitsio::IoStats::read(m_fptr ? Cfitsio::FileAccess::name(m_fptr) : m_filename);
+}
+
+void MefFile::enableDiagnostics(const AccessThresholds& thresholds, std::ostream& report) {
+  m_diagnostics = std::make_unique<AccessDiagnostics>(m_filename, thresholds, &report);
+  for (auto& hdu : m_hdus) {
+    if (hdu) {
+      watch(*hdu);
+    }
+  }
+}
+
+const AccessDiagnostics* MefFile::diagnostics() const {
+  return m_diagnostics.get();
+}
+
+void MefFile::enableConcurrentReads() {
+  if (m_permission != FileMode::Read) {
+    throw FitsError("Cannot enable concurrent reads of a file which is not opened in read mode: " + m_filename);
+  }
+  if (m_pool) {
+    return;
+  }
+  const auto open = [&](HandlePool::Handle& handle) {
+    if (m_memory) {
+      handle.data = m_memory->m_data;
+      handle.size = m_memory->m_size;
+      handle.fptr =
+          Cfitsio::FileAccess::open(&handle.data, &handle.size, Cfitsio::FileAccess::OpenPolicy::ReadOnly);
+    } else {
+      handle.fptr = Cfitsio::FileAccess::open(m_filename, Cfitsio::FileAccess::OpenPolicy::ReadOnly);
+    }
+  };
+  m_pool = std::make_unique<HandlePool>(open, hduCount());
+}
+
+void MefFile::releaseThreadHandle() {
+  if (m_pool) {
+    m_pool->release();
+  }
+}
+
+long MefFile::concurrentHandleCount() const {
+  return m_pool ? m_pool->size() : 0;
+}
+
 const Hdu& MefFile::operator[](long index) {
   return access<Hdu>(index);
 }
@@ -62,12 +121,73 @@ const ImageHdu& MefFile::primary() {
 }
 
 const Hdu& MefFile::initRecordExt(const std::string& name) {
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::initRecordExt"); span.hdu(hduCount()); span.detail(name));
   Cfitsio::HduAccess::createMetadataExtension(m_fptr, name);
   const auto size = m_hdus.size();
   m_hdus.push_back(std::make_unique<Hdu>(Hdu::Token {}, m_fptr, size, HduCategory::Image, HduCategory::Created));
+  watch(*m_hdus[size]);
   return *m_hdus[size].get();
 }
 
+void MefFile::assignImageExts(const ImageWritePlan& plan, long threadCount) {
+  if (plan.size() == 0) {
+    return;
+  }
+  ELEFITS_TRACE(TraceSpan span("hdu", "MefFile::assignImageExts"); span.hdu(hduCount()));
+  ELEFITS_TRACE(span.detail(std::to_string(plan.size()) + " HDUs, " + std::to_string(threadCount) + " threads"));
+
+  /* Write headers */
+  const long first = m_hdus.size();
+  for (const auto& e : plan.m_entries) {
+    e.init(m_fptr);
+    m_hdus.push_back(std::make_unique<ImageHdu>(Hdu::Token {}, m_fptr, m_hdus.size(), HduCategory::Created));
+    watch(*m_hdus.back());
+  }
+
+  /* Read layout */
+  std::vector<long> offsets(plan.size());
+  LONGLONG headStart = 0;
+  LONGLONG dataStart = 0;
+  LONGLONG dataEnd = 0;
+  for (long i = 0; i < plan.size(); ++i) {
+    Cfitsio::HduAccess::gotoIndex(m_fptr, first + i + 1); // 1-based
+    int status = 0;
+    fits_get_hduaddrll(m_fptr, &headStart, &dataStart, &dataEnd, &status);
+    Cfitsio::CfitsioError::mayThrow(status, m_fptr, "Cannot read HDU layout: #" + std::to_string(first + i));
+    offsets[i] = dataStart;
+  }
+
+  /* Release the file (which flushes the headers) */
+  if (m_memory) {
+    m_memory->m_size = dataEnd;
+  }
+  Cfitsio::FileAccess::close(m_fptr);
+
+  /* Fill the data units and reopen, even if filling failed */
+  const auto reopenForEdit = [&]() {
+    if (m_memory) {
+      m_memory->m_capacity = m_memory->m_size; // Hide the unused capacity from CFitsIO
+      m_fptr = Cfitsio::FileAccess::open(
+          &m_memory->m_data,
+          &m_memory->m_capacity,
+          Cfitsio::FileAccess::OpenPolicy::ReadWrite);
+    } else {
+      m_fptr = Cfitsio::FileAccess::open(m_filename, Cfitsio::FileAccess::OpenPolicy::ReadWrite);
+    }
+  };
+  try {
+    if (m_memory) {
+      plan.fill(m_memory->reserve(dataEnd), offsets, threadCount);
+    } else {
+      plan.fill(m_filename, offsets, dataEnd, threadCount);
+    }
+  } catch (...) {
+    reopenForEdit();
+    throw;
+  }
+  reopenForEdit();
+}
+
 const long MefFile::primaryIndex;
 
 #ifndef COMPILE_ASSIGN_IMAGE_EXT
@@ -79,5 +199,10 @@ ELEFITS_FOREACH_RASTER_TYPE(COMPILE_ASSIGN_IMAGE_EXT)
   #undef COMPILE_ASSIGN_IMAGE_EXT
 #endif
 
+void MefFile::watch(Hdu& hdu) {
+  hdu.m_diagnostics = m_diagnostics.get();
+  hdu.m_executor = &m_executor;
+}
+
 } // namespace Fits
 } // namespace Euclid
@@ -0,0 +1,231 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/MefFileCache.h"
+
+#include <iterator> // next
+
+namespace Euclid {
+namespace Fits {
+
+MefFileCache::Entry::Entry(const std::string& name) : filename(name), file(), mutex(), users(0) {}
+
+MefFileCache::Lease::Lease(MefFileCache& cache, Entry& entry, std::unique_lock<std::mutex> lock) :
+    m_cache(&cache), m_entry(&entry), m_lock(std::move(lock)) {}
+
+MefFileCache::Lease::Lease(Lease&& other) :
+    m_cache(other.m_cache), m_entry(other.m_entry), m_lock(std::move(other.m_lock)) {
+  other.m_entry = nullptr;
+}
+
+MefFileCache::Lease::~Lease() {
+  if (m_entry) {
+    m_lock.unlock();
+    m_cache->release(*m_entry);
+  }
+}
+
+MefFile& MefFileCache::Lease::file() {
+  return *m_entry->file;
+}
+
+MefFile& MefFileCache::Lease::operator*() {
+  return file();
+}
+
+MefFile* MefFileCache::Lease::operator->() {
+  return &file();
+}
+
+const std::vector<std::pair<std::string, long>>& MefFileCache::Lease::readHduNamesVersions() {
+  return m_cache->namesVersions(*m_entry);
+}
+
+long MefFileCache::Lease::readHduIndex(const std::string& name, long version) {
+  const auto& namesVersions = readHduNamesVersions();
+  for (std::size_t i = 0; i < namesVersions.size(); ++i) {
+    if (namesVersions[i].first == name && (version == 0 || namesVersions[i].second == version)) {
+      return i;
+    }
+  }
+  throw FitsError("No HDU with name " + name + " in file: " + m_entry->filename);
+}
+
+MefFileCache::MefFileCache(long capacity, FileMode permission, long metadataCapacity) :
+    m_capacity(capacity), m_permission(permission), m_mutex(), m_entries(), m_index(),
+    m_metadataCapacity(metadataCapacity), m_metadata(), m_metadataIndex(), m_stats() {
+  if (permission != FileMode::Read && permission != FileMode::Edit) {
+    throw FitsError("File cache only supports read and edit modes");
+  }
+}
+
+MefFileCache::~MefFileCache() {
+  for (auto& e : m_entries) {
+    if (e.file) {
+      e.file->close();
+    }
+  }
+}
+
+MefFileCache& MefFileCache::global() {
+  static MefFileCache cache;
+  return cache;
+}
+
+MefFileCache::Lease MefFileCache::acquire(const std::string& filename) {
+
+  /* Find or insert the entry */
+  std::list<Entry> evicted;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto it = m_index.find(filename);
+  if (it != m_index.end()) {
+    ++m_stats.hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+  } else {
+    ++m_stats.misses;
+    m_entries.emplace_front(filename);
+    it = m_index.emplace(filename, m_entries.begin()).first;
+  }
+  auto& entry = *it->second;
+  ++entry.users;
+  evict(evicted);
+  lock.unlock();
+  evicted.clear(); // Close the evicted files outside the cache lock
+
+  /* Lock the entry and open the file if needed */
+  std::unique_lock<std::mutex> entryLock(entry.mutex);
+  if (not entry.file) {
+    try {
+      entry.file = std::make_unique<MefFile>(filename, m_permission);
+    } catch (...) {
+      entryLock.unlock();
+      release(entry);
+      throw;
+    }
+  }
+  return Lease(*this, entry, std::move(entryLock));
+}
+
+long MefFileCache::capacity() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_capacity;
+}
+
+void MefFileCache::setCapacity(long capacity) {
+  std::list<Entry> evicted; // Destroyed after the lock is released
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_capacity = capacity;
+  evict(evicted);
+}
+
+long MefFileCache::metadataCapacity() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_metadataCapacity;
+}
+
+void MefFileCache::setMetadataCapacity(long capacity) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_metadataCapacity = capacity;
+  evictMetadata();
+}
+
+long MefFileCache::metadataCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_metadata.size();
+}
+
+long MefFileCache::openCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+MefFileCache::Stats MefFileCache::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+void MefFileCache::clear() {
+  std::list<Entry> evicted; // Destroyed after the lock is released
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto capacity = m_capacity;
+  m_capacity = 0;
+  evict(evicted);
+  m_capacity = capacity;
+}
+
+void MefFileCache::release(Entry& entry) {
+  std::list<Entry> evicted; // Destroyed after the lock is released
+  std::lock_guard<std::mutex> lock(m_mutex);
+  --entry.users;
+  if (entry.users == 0 && not entry.file) { // Opening failed
+    const auto it = m_index.find(entry.filename);
+    m_entries.erase(it->second);
+    m_index.erase(it);
+    return;
+  }
+  evict(evicted);
+}
+
+void MefFileCache::evict(std::list<Entry>& evicted) {
+  auto it = m_entries.end();
+  while (long(m_entries.size()) > m_capacity && it != m_entries.begin()) {
+    --it;
+    if (it->users > 0) {
+      continue;
+    }
+    ++m_stats.evictions;
+    m_index.erase(it->filename);
+    const auto next = std::next(it);
+    evicted.splice(evicted.end(), m_entries, it); // The file is closed when the entry is destroyed
+    it = next;
+  }
+}
+
+void MefFileCache::evictMetadata() {
+  auto it = m_metadata.end();
+  while (long(m_metadata.size()) > m_metadataCapacity && it != m_metadata.begin()) {
+    --it;
+    const auto entry = m_index.find(it->first);
+    if (entry != m_index.end() && entry->second->users > 0) { // Referenced by a lease
+      continue;
+    }
+    m_metadataIndex.erase(it->first);
+    it = m_metadata.erase(it);
+  }
+}
+
+const std::vector<std::pair<std::string, long>>& MefFileCache::namesVersions(Entry& entry) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_metadataIndex.find(entry.filename);
+    if (it != m_metadataIndex.end()) {
+      m_metadata.splice(m_metadata.begin(), m_metadata, it->second);
+      return it->second->second;
+    }
+  }
+  auto namesVersions = entry.file->readHduNamesVersions(); // Outside the cache lock
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_metadata.emplace_front(entry.filename, std::move(namesVersions));
+  m_metadataIndex.emplace(entry.filename, m_metadata.begin());
+  evictMetadata();
+  return m_metadata.front().second;
+}
+
+} // namespace Fits
+} // namespace Euclid
@@ -0,0 +1,66 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/ParallelFor.h"
+
+#include <algorithm> // max, min
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+namespace Internal {
+
+void parallelFor(long count, long threadCount, const std::function<void(long, long)>& func) {
+  if (threadCount <= 0) {
+    threadCount = std::thread::hardware_concurrency();
+  }
+  threadCount = std::max(1L, std::min(threadCount, count));
+  std::atomic<long> next(0);
+  std::vector<std::exception_ptr> errors(threadCount);
+  const auto work = [&](long t) {
+    try {
+      for (long i = next++; i < count; i = next++) {
+        func(i, t);
+      }
+    } catch (...) {
+      errors[t] = std::current_exception();
+      next = count; // Stop the other threads early
+    }
+  };
+  std::vector<std::thread> threads;
+  for (long t = 1; t < threadCount; ++t) {
+    threads.emplace_back(work, t);
+  }
+  work(0);
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (const auto& e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+} // namespace Internal
+} // namespace Fits
+} // namespace Euclid
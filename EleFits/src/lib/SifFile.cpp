@@ -25,7 +25,21 @@ namespace Euclid {
 namespace Fits {
 
 SifFile::SifFile(const std::string& filename, FileMode permission) :
-    FitsFile(filename, permission), m_hdu(ImageHdu::Token {}, m_fptr, 0), m_header(m_hdu.header()), m_raster(m_hdu.raster()) {}
+    FitsFile(filename, permission), m_hdu(ImageHdu::Token {}, m_fptr, 0), m_header(m_hdu.header()), m_raster(m_hdu.raster()) {
+  m_hdu.m_executor = &m_executor;
+}
+
+SifFile::SifFile(MemoryBuffer& buffer, FileMode permission) :
+    FitsFile(buffer, permission),
+    m_hdu(ImageHdu::Token {}, m_fptr, 0),
+    m_header(m_hdu.header()),
+    m_raster(m_hdu.raster()) {
+  m_hdu.m_executor = &m_executor;
+}
+
+SifFile::~SifFile() {
+  m_executor.wait(); // Before the HDU handler is destroyed
+}
 
 const Header& SifFile::header() const {
   return m_header;
@@ -0,0 +1,257 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/Trace.h"
+
+#include <algorithm> // min, remove_if, sort
+#include <chrono>
+#include <cstring> // strncpy
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief The buffers of all threads, and the mutex which protects the list (not the buffers).
+ */
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<TraceBuffer>> buffers;
+  std::size_t capacity = 16384;
+  long threadCount = 0;
+};
+
+/**
+ * @brief Get the registry singleton.
+ */
+TraceRegistry& traceRegistry() {
+  static TraceRegistry registry;
+  return registry;
+}
+
+/**
+ * @brief Get the buffer of the calling thread, which is registered at first call.
+ */
+TraceBuffer& localTraceBuffer() {
+  thread_local std::shared_ptr<TraceBuffer> buffer;
+  if (not buffer) {
+    auto& registry = traceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    ++registry.threadCount;
+    buffer = std::make_shared<TraceBuffer>(registry.threadCount, registry.capacity);
+    registry.buffers.push_back(buffer);
+  }
+  return *buffer;
+}
+
+/**
+ * @brief Write a string as a JSON string.
+ */
+void writeTraceString(std::ostream& out, const char* value) {
+  out << '"';
+  for (; *value; ++value) {
+    if (*value == '"' || *value == '\\') {
+      out << '\\';
+    }
+    out << *value;
+  }
+  out << '"';
+}
+
+} // namespace Internal
+/// @endcond
+
+TraceBuffer::TraceBuffer(long thread, std::size_t capacity) :
+    m_thread(thread), m_events(std::max<std::size_t>(capacity, 1)), m_head(0) {}
+
+long TraceBuffer::thread() const {
+  return m_thread;
+}
+
+std::size_t TraceBuffer::capacity() const {
+  return m_events.size();
+}
+
+std::size_t TraceBuffer::dropCount() const {
+  const auto head = m_head.load(std::memory_order_acquire);
+  return head > capacity() ? head - capacity() : 0;
+}
+
+void TraceBuffer::push(TraceEvent event) {
+  event.thread = m_thread;
+  const auto head = m_head.load(std::memory_order_relaxed);
+  m_events[head % capacity()] = event;
+  m_head.store(head + 1, std::memory_order_release);
+}
+
+std::vector<TraceEvent> TraceBuffer::events() const {
+  const auto head = m_head.load(std::memory_order_acquire);
+  const auto count = std::min(head, capacity());
+  std::vector<TraceEvent> out;
+  out.reserve(count);
+  for (auto i = head - count; i < head; ++i) {
+    out.push_back(m_events[i % capacity()]);
+  }
+  return out;
+}
+
+void TraceBuffer::clear() {
+  m_head.store(0, std::memory_order_release);
+}
+
+std::atomic<bool> Tracer::s_enabled(false);
+
+void Tracer::enable() {
+  now(); // Set the origin
+  s_enabled = true;
+}
+
+void Tracer::disable() {
+  s_enabled = false;
+}
+
+void Tracer::reset() {
+  auto& registry = Internal::traceRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto& buffers = registry.buffers;
+  buffers.erase(
+      std::remove_if(
+          buffers.begin(),
+          buffers.end(),
+          [](const std::shared_ptr<TraceBuffer>& b) {
+            return b.use_count() == 1; // Owned by the registry only: the thread is terminated
+          }),
+      buffers.end());
+  for (auto& b : buffers) {
+    b->clear();
+  }
+}
+
+void Tracer::setBufferCapacity(std::size_t capacity) {
+  auto& registry = Internal::traceRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.capacity = capacity;
+}
+
+double Tracer::now() {
+  static const auto origin = std::chrono::steady_clock::now();
+  const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - origin;
+  return elapsed.count();
+}
+
+void Tracer::record(const TraceEvent& event) {
+  Internal::localTraceBuffer().push(event);
+}
+
+std::vector<TraceEvent> Tracer::events() {
+  auto& registry = Internal::traceRegistry();
+  std::vector<TraceEvent> out;
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& b : registry.buffers) {
+      const auto events = b->events();
+      out.insert(out.end(), events.begin(), events.end());
+    }
+  }
+  std::sort(out.begin(), out.end(), [](const TraceEvent& lhs, const TraceEvent& rhs) {
+    return lhs.start < rhs.start;
+  });
+  return out;
+}
+
+void Tracer::writeChromeTrace(std::ostream& out) {
+  const auto all = events();
+  std::vector<long> threads;
+  for (const auto& e : all) {
+    if (std::find(threads.begin(), threads.end(), e.thread) == threads.end()) {
+      threads.push_back(e.thread);
+    }
+  }
+  out << "{\n  \"displayTimeUnit\": \"ms\",\n  \"traceEvents\": [";
+  out << "\n    { \"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": { \"name\": \"EleFits\" } }";
+  for (auto t : threads) {
+    out << ",\n    { \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << t
+        << ", \"args\": { \"name\": \"Thread " << t << "\" } }";
+  }
+  for (const auto& e : all) {
+    out << ",\n    { \"name\": ";
+    Internal::writeTraceString(out, e.name);
+    out << ", \"cat\": ";
+    Internal::writeTraceString(out, e.category);
+    out << ", \"ph\": \"X\", \"ts\": " << e.start << ", \"dur\": " << e.duration << ", \"pid\": 1, \"tid\": " << e.thread
+        << ", \"args\": { \"hdu\": " << e.hdu << ", \"bytes\": " << e.bytes << ", \"detail\": ";
+    Internal::writeTraceString(out, e.detail.data());
+    out << " } }";
+  }
+  out << "\n  ]\n}\n";
+}
+
+void Tracer::writeChromeTrace(const std::string& filename) {
+  std::ofstream out(filename);
+  writeChromeTrace(out);
+}
+
+TraceSpan::TraceSpan(const char* category, const char* name) : m_enabled(Tracer::isEnabled()), m_event() {
+  if (not m_enabled) {
+    return;
+  }
+  m_event.category = category;
+  m_event.name = name;
+  m_event.start = Tracer::now();
+}
+
+TraceSpan::~TraceSpan() {
+  if (not m_enabled) {
+    return;
+  }
+  m_event.duration = Tracer::now() - m_event.start;
+  Tracer::record(m_event);
+}
+
+void TraceSpan::hdu(fitsfile* fptr) {
+  if (not m_enabled || not fptr) {
+    return;
+  }
+  int index = 0;
+  fits_get_hdu_num(fptr, &index);
+  m_event.hdu = index - 1; // 1-based in CFitsIO
+}
+
+void TraceSpan::rows(const Segment& segment) {
+  if (not m_enabled) {
+    return;
+  }
+  detail("rows " + std::to_string(segment.front) + ":" + std::to_string(segment.back));
+}
+
+void TraceSpan::detail(const std::string& text) {
+  if (not m_enabled) {
+    return;
+  }
+  std::strncpy(m_event.detail.data(), text.c_str(), TraceEvent::detailCapacity - 1);
+  m_event.detail[TraceEvent::detailCapacity - 1] = '\0';
+}
+
+} // namespace Fits
+} // namespace Euclid
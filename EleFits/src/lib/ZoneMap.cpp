@@ -0,0 +1,179 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/ZoneMap.h"
+
+#include "EleFits/BintableHdu.h"
+#include "EleFits/MefFile.h"
+
+#include <algorithm> // max, min
+#include <limits>
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief A zone without values.
+ */
+ZoneMap::Zone emptyZone() {
+  return { std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), 0, 0 };
+}
+
+} // namespace Internal
+/// @endcond
+
+ZoneMap::ZoneMap(const std::vector<std::string>& names, long zoneRowCount) : m_zoneRowCount(zoneRowCount), m_zones() {
+  if (zoneRowCount <= 0) {
+    throw FitsError("Number of rows per zone must be strictly positive");
+  }
+  for (const auto& n : names) {
+    m_zones[n] = { Internal::emptyZone() };
+  }
+}
+
+ZoneMap ZoneMap::read(const BintableHdu& hdu) {
+  const auto zoneRowCount = hdu.header().parse<long>("ZONEROWS").value;
+  const auto columns = hdu.columns().readSeq(
+      Named<std::string>("NAME"),
+      Named<std::int64_t>("FRONT"),
+      Named<std::int64_t>("ROWS"),
+      Named<double>("MIN"),
+      Named<double>("MAX"),
+      Named<std::int64_t>("NULLS"));
+  const auto& names = std::get<0>(columns);
+  ZoneMap map({}, zoneRowCount);
+  for (long i = 0; i < names.rowCount(); ++i) {
+    auto& zones = map.m_zones[names(i)];
+    auto& zone = map.zoneAt(zones, std::get<1>(columns)(i));
+    zone = { std::get<3>(columns)(i), std::get<4>(columns)(i), std::get<5>(columns)(i), std::get<2>(columns)(i) };
+  }
+  return map;
+}
+
+void ZoneMap::write(MefFile& f, const std::string& name) const {
+  std::vector<std::string> names;
+  std::vector<std::int64_t> fronts;
+  std::vector<std::int64_t> rowCounts;
+  std::vector<double> mins;
+  std::vector<double> maxs;
+  std::vector<std::int64_t> nullCounts;
+  long nameLength = 1;
+  for (const auto& c : m_zones) {
+    nameLength = std::max<long>(nameLength, c.first.length());
+    for (std::size_t i = 0; i < c.second.size(); ++i) {
+      const auto& zone = c.second[i];
+      names.push_back(c.first);
+      fronts.push_back(i * m_zoneRowCount);
+      rowCounts.push_back(zone.rowCount);
+      mins.push_back(zone.min);
+      maxs.push_back(zone.max);
+      nullCounts.push_back(zone.nullCount);
+    }
+  }
+  const auto& ext = f.assignBintableExt(
+      name,
+      VecColumn<std::string>({ "NAME", "", nameLength }, std::move(names)),
+      VecColumn<std::int64_t>({ "FRONT", "", 1 }, std::move(fronts)),
+      VecColumn<std::int64_t>({ "ROWS", "", 1 }, std::move(rowCounts)),
+      VecColumn<double>({ "MIN", "", 1 }, std::move(mins)),
+      VecColumn<double>({ "MAX", "", 1 }, std::move(maxs)),
+      VecColumn<std::int64_t>({ "NULLS", "", 1 }, std::move(nullCounts)));
+  ext.header().write("ZONEROWS", m_zoneRowCount, "", "Number of rows per zone");
+}
+
+long ZoneMap::zoneRowCount() const {
+  return m_zoneRowCount;
+}
+
+std::vector<std::string> ZoneMap::names() const {
+  std::vector<std::string> res;
+  for (const auto& c : m_zones) {
+    res.push_back(c.first);
+  }
+  return res;
+}
+
+bool ZoneMap::has(const std::string& name) const {
+  return m_zones.find(name) != m_zones.end();
+}
+
+const std::vector<ZoneMap::Zone>& ZoneMap::zones(const std::string& name) const {
+  const auto it = m_zones.find(name);
+  if (it == m_zones.end()) {
+    throw FitsError("Column is not tracked in zone map: " + name);
+  }
+  return it->second;
+}
+
+long ZoneMap::rowCount(const std::string& name) const {
+  const auto& z = zones(name);
+  return (z.size() - 1) * m_zoneRowCount + z.back().rowCount;
+}
+
+std::vector<Segment> ZoneMap::select(const std::string& name, double min, double max) const {
+  const auto& z = zones(name);
+  std::vector<Segment> res;
+  for (std::size_t i = 0; i < z.size(); ++i) {
+    const auto& zone = z[i];
+    if (zone.rowCount == 0 || zone.max < min || zone.min > max) {
+      continue;
+    }
+    const long front = i * m_zoneRowCount;
+    const long back = front + zone.rowCount - 1;
+    if (not res.empty() && res.back().back + 1 == front) {
+      res.back().back = back;
+    } else {
+      res.push_back({ front, back });
+    }
+  }
+  const auto extent = rowCount(name);
+  if (not res.empty() && res.back().back + 1 == extent) {
+    res.back().back = -1;
+  } else {
+    res.push_back({ extent, -1 });
+  }
+  return res;
+}
+
+void ZoneMap::markSkipped(std::vector<Zone>& zones, long front, long back) const {
+  for (long row = front; row <= back;) {
+    auto& zone = zoneAt(zones, row);
+    const auto zoneFront = row / m_zoneRowCount * m_zoneRowCount;
+    const auto zoneBack = std::min(back, zoneFront + m_zoneRowCount - 1);
+    zone.min = -std::numeric_limits<double>::infinity();
+    zone.max = std::numeric_limits<double>::infinity();
+    zone.nullCount = -1;
+    zone.rowCount = std::max(zone.rowCount, zoneBack - zoneFront + 1);
+    row = zoneBack + 1;
+  }
+}
+
+ZoneMap::Zone& ZoneMap::zoneAt(std::vector<Zone>& zones, long row) const {
+  const std::size_t index = row / m_zoneRowCount;
+  if (index >= zones.size()) {
+    zones.resize(index + 1, Internal::emptyZone());
+  }
+  return zones[index];
+}
+
+} // namespace Fits
+} // namespace Euclid
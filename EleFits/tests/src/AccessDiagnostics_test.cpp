@@ -0,0 +1,155 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/AccessDiagnostics.h"
+#include "EleFits/FitsFileFixture.h"
+#include "EleFitsData/TestColumn.h"
+#include "EleFitsData/TestRaster.h"
+
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <string>
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief Write a table with two float columns A and B.
+ */
+const BintableHdu& assignTable(MefFile& f, long rowCount) {
+  Test::RandomScalarColumn<float> a(rowCount);
+  a.rename("A");
+  Test::RandomScalarColumn<float> b(rowCount);
+  b.rename("B");
+  return f.assignBintableExt("TABLE", a, b);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(AccessDiagnostics_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(diagnostics_are_disabled_by_default_test) {
+  Test::TemporaryMefFile f;
+  BOOST_TEST(f.diagnostics() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(chained_column_reads_are_detected_test) {
+  std::ostringstream report;
+  Test::TemporaryMefFile f;
+  const long rowCount = 10;
+  const auto& columns = assignTable(f, rowCount).columns();
+  f.enableDiagnostics({}, report);
+  const auto& counters = f.diagnostics()->at(AccessPattern::ChainedColumnReads);
+
+  columns.readSeq(Named<float>("A"), Named<float>("B"));
+  BOOST_TEST(counters.count == 0);
+
+  columns.read<float>("A");
+  columns.read<float>("B");
+  BOOST_TEST(counters.count == 1);
+  BOOST_TEST(f.diagnostics()->diagnostics().empty()); // Below threshold
+
+  columns.read<float>("A");
+  BOOST_TEST(counters.count == 2);
+  BOOST_TEST(counters.wastedBytes == 2 * rowCount * long(2 * sizeof(float)));
+  const auto diagnostics = f.diagnostics()->diagnostics();
+  BOOST_TEST(diagnostics.size() == 1);
+  BOOST_TEST((diagnostics[0].pattern == AccessPattern::ChainedColumnReads));
+}
+
+BOOST_AUTO_TEST_CASE(hdu_ping_pong_is_detected_test) {
+  std::ostringstream report;
+  Test::TemporaryMefFile f;
+  Test::SmallRaster raster;
+  const auto& first = f.assignImageExt("FIRST", raster);
+  const auto& second = f.assignImageExt("SECOND", raster);
+  f.enableDiagnostics({}, report);
+  for (int i = 0; i < 3; ++i) {
+    first.raster().read<float, 2>();
+    second.raster().read<float, 2>();
+  }
+  const auto& counters = f.diagnostics()->at(AccessPattern::HduPingPong);
+  BOOST_TEST(counters.count == 4);
+  BOOST_TEST(counters.wastedTime >= 0);
+}
+
+BOOST_AUTO_TEST_CASE(repeated_name_lookups_are_detected_test) {
+  std::ostringstream report;
+  Test::TemporaryMefFile f;
+  Test::SmallRaster raster;
+  f.assignImageExt("IMAGE", raster);
+  f.enableDiagnostics({}, report);
+  for (int i = 0; i < 5; ++i) {
+    f.access<ImageHdu>("IMAGE");
+  }
+  f.accessFirst<ImageHdu>("IMAGE");
+  BOOST_TEST(f.diagnostics()->at(AccessPattern::RepeatedNameLookups).count == 5);
+}
+
+BOOST_AUTO_TEST_CASE(header_writes_after_data_writes_are_detected_test) {
+  std::ostringstream report;
+  Test::TemporaryMefFile f;
+  f.enableDiagnostics({}, report);
+  const auto& counters = f.diagnostics()->at(AccessPattern::HeaderAfterData);
+  Test::SmallRaster raster;
+
+  const auto& init = f.initImageExt<float>("INIT", raster.shape());
+  init.header().write("BEFORE", 1);
+  init.raster().write(raster);
+  BOOST_TEST(counters.count == 0);
+  init.header().write("AFTER", 1);
+  BOOST_TEST(counters.count == 1);
+
+  const auto& assigned = f.assignImageExt("ASSIGNED", raster);
+  assigned.header().write("AFTER", 1);
+  BOOST_TEST(counters.count == 2);
+}
+
+BOOST_AUTO_TEST_CASE(report_is_written_at_closing_test) {
+  std::ostringstream report;
+  Test::TemporaryMefFile f;
+  const auto& columns = assignTable(f, 3).columns();
+  AccessThresholds thresholds;
+  thresholds.chainedColumnReads = 1;
+  f.enableDiagnostics(thresholds, report);
+  columns.read<float>("A");
+  columns.read<float>("B");
+  BOOST_TEST(report.str().empty());
+  f.close();
+  const auto str = report.str();
+  BOOST_TEST(str.find(f.filename()) != std::string::npos);
+  BOOST_TEST(str.find(accessPatternName(AccessPattern::ChainedColumnReads)) != std::string::npos);
+  BOOST_TEST(str.find("readSeq()") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(nothing_is_reported_below_thresholds_test) {
+  std::ostringstream report;
+  Test::TemporaryMefFile f;
+  const auto& columns = assignTable(f, 3).columns();
+  f.enableDiagnostics({}, report);
+  columns.read<float>("A");
+  columns.read<float>("B");
+  f.close();
+  BOOST_TEST(report.str().empty());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/BintableAppender.h"
+#include "EleFits/FitsFileFixture.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(BintableAppender_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(rows_are_appended_chunk_wise_test, Test::TemporaryMefFile) {
+  const ColumnInfo<std::int32_t> idInfo { "ID", "", 1 };
+  const ColumnInfo<float> valueInfo { "VALUE", "", 1 };
+  const auto& hdu = initBintableExt("TABLE", idInfo, valueInfo);
+  const auto& columns = hdu.columns();
+  const long chunkRowCount = 10;
+  BintableAppender<std::int32_t, float> appender(hdu, { "ID", "VALUE" }, chunkRowCount);
+  BOOST_TEST(hdu.header().has("NCOMMIT"));
+  for (std::int32_t i = 0; i < 15; ++i) {
+    appender.appendRow(i, i * 2.F);
+  }
+  BOOST_TEST(appender.rowCount() == 15);
+  BOOST_TEST(appender.committedRowCount() == chunkRowCount);
+  BOOST_TEST(hdu.header().parse<long>("NCOMMIT").value == chunkRowCount);
+  VecColumn<std::int32_t> ids(idInfo, 30);
+  VecColumn<float> values(valueInfo, 30);
+  for (long i = 0; i < 30; ++i) {
+    ids(i) = 15 + i;
+    values(i) = (15 + i) * 2.F;
+  }
+  appender.appendSeq(ids, values);
+  BOOST_TEST(appender.rowCount() == 45);
+  BOOST_TEST(appender.committedRowCount() == 40);
+  BOOST_TEST(columns.readRowCount() >= 40); // Capacity
+  appender.close();
+  BOOST_TEST(not hdu.header().has("NCOMMIT"));
+  BOOST_TEST(columns.readRowCount() == 45);
+  const auto res = columns.readSeq(Named<std::int32_t>("ID"), Named<float>("VALUE"));
+  for (long i = 0; i < 45; ++i) {
+    BOOST_TEST(std::get<0>(res)(i) == i);
+    BOOST_TEST(std::get<1>(res)(i) == i * 2.F);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(vector_rows_are_appended_across_chunks_test, Test::TemporaryMefFile) {
+  const ColumnInfo<std::int32_t> idInfo { "ID", "", 1 };
+  const ColumnInfo<float> vectorInfo { "VECTOR", "", 3 };
+  const auto& hdu = initBintableExt("TABLE", idInfo, vectorInfo);
+  BintableAppender<std::int32_t, float> appender(hdu, { "ID", "VECTOR" }, 10);
+  BOOST_CHECK_THROW(appender.appendRow(0, 0.F), FitsError);
+  VecColumn<std::int32_t> ids(idInfo, 25);
+  VecColumn<float> vectors(vectorInfo, 25);
+  for (long i = 0; i < 25; ++i) {
+    ids(i) = i;
+    for (long j = 0; j < 3; ++j) {
+      vectors(i, j) = i * 3 + j;
+    }
+  }
+  appender.appendSeq(ids, vectors);
+  BOOST_TEST(appender.committedRowCount() == 20); // Buffer reused for the second chunk
+  const VecColumn<float> narrow({ "VECTOR", "", 2 }, 25);
+  BOOST_CHECK_THROW(appender.appendSeq(ids, narrow), FitsError);
+  const VecColumn<float> wide({ "VECTOR", "", 4 }, 25);
+  BOOST_CHECK_THROW(appender.appendSeq(ids, wide), FitsError);
+  const VecColumn<float> shorter({ "VECTOR", "", 3 }, 5);
+  BOOST_CHECK_THROW(appender.appendSeq(ids, shorter), FitsError);
+  appender.close();
+  BOOST_TEST(hdu.readRowCount() == 25);
+  const auto res = hdu.columns().read<float>("VECTOR");
+  BOOST_TEST(res.vector() == vectors.vector());
+}
+
+BOOST_FIXTURE_TEST_CASE(committed_rows_are_recovered_test, Test::TemporaryMefFile) {
+  VecColumn<std::int32_t> ids({ "ID", "", 1 }, 10);
+  const auto& hdu = assignBintableExt("TABLE", ids);
+  BOOST_TEST(recoverAppendedRows(hdu) == 10);
+  hdu.header().write("NCOMMIT", 6L);
+  BOOST_TEST(recoverAppendedRows(hdu) == 6);
+  BOOST_TEST(hdu.readRowCount() == 6);
+  BOOST_TEST(not hdu.header().has("NCOMMIT"));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -19,7 +19,9 @@
 
 #include "EleFits/BintableColumns.h"
 #include "EleFits/FitsFileFixture.h"
+#include "EleFitsData/BitColumn.h"
 #include "EleFitsData/TestColumn.h"
+#include "EleFitsData/VlaColumn.h"
 
 #include <boost/test/unit_test.hpp>
 
@@ -54,6 +56,17 @@ using namespace Euclid::Fits;
 //
 // removeSeq (const std::vector< long > &indices)
 //   removeSeq (const std::vector< std::string > &names) => TEST
+//
+// readFilteredSeq (where indices, predicate, indices...) -> loop on readSegmentSeqTo and readSegmentTo (chunks or runs)
+//   readFilteredSeq (where names, predicate, names...) => TEST
+//
+// readGatheredSeq (rows, gap, indices...) -> loop on readSegmentTo
+//   readGatheredSeq (rows, gap, names...) => TEST
+//
+// readSeq (arena, indices...) -> readSeqTo (indices, columns)
+//   readSeq (arena, names...) => TEST
+// readSegmentSeq (arena, rows, indices...) => TEST
+//   readSegmentSeq (arena, rows, names...)
 
 //-----------------------------------------------------------------------------
 
@@ -78,6 +91,242 @@ BOOST_FIXTURE_TEST_CASE(append_rows_test, Test::TemporaryMefFile) {
   BOOST_TEST(columns.readRowCount() == initSize * 2);
 }
 
+BOOST_FIXTURE_TEST_CASE(uint16_column_is_read_scaled_and_raw_test, Test::TemporaryMefFile) {
+  const Test::RandomVectorColumn<std::uint16_t> input(2, 100);
+  const auto& du = assignBintableExt("UINT16", input).columns();
+  BOOST_TEST((du.readScaling(0) == Scaling::forType<std::uint16_t>()));
+  const auto scaled = du.read<std::uint16_t>(0);
+  BOOST_TEST(scaled.vector() == input.vector());
+  const auto converted = du.read<double>(0);
+  const auto raw = du.readRaw<std::int16_t>(input.info().name);
+  for (long i = 0; i < input.elementCount(); ++i) {
+    BOOST_TEST(converted.data()[i] == static_cast<double>(input.data()[i]));
+    BOOST_TEST(raw.data()[i] == static_cast<std::int16_t>(input.data()[i] ^ 0x8000));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(int32_column_is_converted_with_overflow_policy_test, Test::TemporaryMefFile) {
+  const VecColumn<std::int32_t> input({ "INT32", "", 1 }, { -100000, -1, 0, 1, 100000 });
+  const auto& hdu = assignBintableExt("INT32", input);
+  auto du = hdu.columns(); // Copy to set the policy
+  BOOST_TEST((du.overflowPolicy() == OverflowPolicy::Throw));
+  const auto widened = du.read<double>(0);
+  for (long i = 0; i < input.elementCount(); ++i) {
+    BOOST_TEST(widened.data()[i] == static_cast<double>(input.data()[i]));
+  }
+  BOOST_CHECK_THROW(du.read<std::int16_t>(0), OverflowError);
+  du.setOverflowPolicy(OverflowPolicy::Saturate);
+  const auto narrowed = du.read<std::int16_t>(0);
+  const std::vector<std::int16_t> expected { -32768, -1, 0, 1, 32767 };
+  BOOST_TEST(narrowed.vector() == expected);
+  BOOST_TEST((hdu.columns().overflowPolicy() == OverflowPolicy::Throw)); // Not affected
+}
+
+BOOST_FIXTURE_TEST_CASE(filtered_rows_are_read_test, Test::TemporaryMefFile) {
+  const long rowCount = 10000;
+  VecColumn<std::int64_t> ids({ "ID", "", 1 }, rowCount);
+  VecColumn<float> g1s({ "G1", "", 1 }, rowCount);
+  VecColumn<double> vectors({ "VECTOR", "m", 2 }, rowCount);
+  for (long i = 0; i < rowCount; ++i) {
+    ids(i) = i;
+    g1s(i) = (i % 100) / 100.f;
+    vectors(i, 0) = i;
+    vectors(i, 1) = -i;
+  }
+  const auto& du = assignBintableExt("TABLE", ids, g1s, vectors).columns();
+  BOOST_TEST(du.readBufferRowCount() < rowCount); // Several chunks
+  const auto res = du.readFilteredSeq(
+      std::make_tuple(Named<float>("G1"), Named<std::int64_t>("ID")),
+      [](float g1, std::int64_t id) {
+        return g1 > 0.5 && id % 3 == 0;
+      },
+      Named<std::int64_t>("ID"),
+      Named<double>("VECTOR"));
+  const auto& selectedIds = std::get<0>(res);
+  const auto& selectedVectors = std::get<1>(res);
+  BOOST_TEST((selectedVectors.info() == vectors.info()));
+  std::vector<std::int64_t> expected;
+  for (long i = 0; i < rowCount; ++i) {
+    if (g1s(i) > 0.5 && i % 3 == 0) {
+      expected.push_back(i);
+    }
+  }
+  BOOST_TEST(selectedIds.vector() == expected);
+  BOOST_TEST(selectedVectors.rowCount() == static_cast<long>(expected.size()));
+  for (long i = 0; i < selectedVectors.rowCount(); ++i) {
+    BOOST_TEST(selectedVectors(i, 0) == expected[i]);
+    BOOST_TEST(selectedVectors(i, 1) == -expected[i]);
+  }
+  const auto sparse = du.readFilteredSeq( // Read by runs
+      std::make_tuple(Named<std::int64_t>("ID")),
+      [](std::int64_t id) {
+        return id % 1000 == 0 || id % 1000 == 1;
+      },
+      Named<double>("VECTOR"),
+      Named<std::int64_t>("ID"));
+  const auto& sparseVectors = std::get<0>(sparse);
+  const auto& sparseIds = std::get<1>(sparse);
+  BOOST_TEST(sparseIds.rowCount() == 2 * rowCount / 1000);
+  for (long i = 0; i < sparseIds.rowCount(); ++i) {
+    BOOST_TEST(sparseIds(i) == (i / 2) * 1000 + i % 2);
+    BOOST_TEST(sparseVectors(i, 0) == sparseIds(i));
+    BOOST_TEST(sparseVectors(i, 1) == -sparseIds(i));
+  }
+  const auto none = du.readFilteredSeq(
+      std::make_tuple(Indexed<float>(1)),
+      [](float g1) {
+        return g1 > 1;
+      },
+      Indexed<std::int64_t>(0));
+  BOOST_TEST(std::get<0>(none).rowCount() == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(gathered_rows_are_read_in_order_test, Test::TemporaryMefFile) {
+  const long rowCount = 10000;
+  VecColumn<std::int32_t> ids({ "ID", "", 1 }, rowCount);
+  VecColumn<std::string> names({ "NAME", "", 8 }, rowCount);
+  VecColumn<float> vectors({ "VECTOR", "", 3 }, rowCount);
+  for (long i = 0; i < rowCount; ++i) {
+    ids(i) = i;
+    names(i) = std::to_string(i);
+    for (long j = 0; j < 3; ++j) {
+      vectors(i, j) = i * 3 + j;
+    }
+  }
+  const auto& du = assignBintableExt("TABLE", ids, names, vectors).columns();
+  const std::vector<long> rows { 9999, 12, 13, 15, 0, 5000, 13, 9000 }; // Unsorted, with duplicates
+  for (long gap : { 0L, 1L, 100L, rowCount }) {
+    const auto res =
+        du.readGatheredSeq(rows, gap, Named<std::int32_t>("ID"), Named<std::string>("NAME"), Named<float>("VECTOR"));
+    const auto& gatheredIds = std::get<0>(res);
+    const auto& gatheredNames = std::get<1>(res);
+    const auto& gatheredVectors = std::get<2>(res);
+    BOOST_TEST(gatheredIds.rowCount() == static_cast<long>(rows.size()));
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+      BOOST_TEST(gatheredIds(i) == rows[i]);
+      BOOST_TEST(gatheredNames(i) == std::to_string(rows[i]));
+      BOOST_TEST(gatheredVectors(i, 2) == rows[i] * 3 + 2);
+    }
+  }
+  BOOST_CHECK_THROW(du.readGatheredSeq({ 0, rowCount }, 0, Indexed<std::int32_t>(0)), OutOfBoundsError);
+  const auto empty = du.readGatheredSeq({}, 0, Indexed<std::int32_t>(0));
+  BOOST_TEST(std::get<0>(empty).rowCount() == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(columns_are_read_into_reused_arena_test, Test::TemporaryMefFile) {
+  const long rowCount = 1000;
+  VecColumn<std::int32_t> ids({ "ID", "", 1 }, rowCount);
+  VecColumn<double> vectors({ "VECTOR", "m", 2 }, rowCount);
+  for (long i = 0; i < rowCount; ++i) {
+    ids(i) = i;
+    vectors(i, 0) = i;
+    vectors(i, 1) = -i;
+  }
+  const auto& du = assignBintableExt("TABLE", ids, vectors).columns();
+  auto table = du.readSeq(ColumnArena(), Named<std::int32_t>("ID"), Named<double>("VECTOR"));
+  BOOST_TEST(table.rowCount() == rowCount);
+  BOOST_TEST((std::get<1>(table.columns()).info() == vectors.info()));
+  for (long i = 0; i < rowCount; ++i) {
+    BOOST_TEST(std::get<0>(table.columns())(i) == i);
+    BOOST_TEST(std::get<1>(table.columns())(i, 1) == -i);
+  }
+  auto arena = table.release();
+  const auto capacity = arena.capacity();
+  const Segment rows { 10, 19 };
+  auto segment = du.readSegmentSeq(std::move(arena), rows, Indexed<double>(1), Indexed<std::int32_t>(0));
+  BOOST_TEST(segment.rowCount() == 10);
+  BOOST_TEST(std::get<0>(segment.columns())(0, 0) == 10);
+  BOOST_TEST(std::get<1>(segment.columns())(9) == 19);
+  arena = segment.release();
+  BOOST_TEST(arena.capacity() == capacity); // No reallocation
+}
+
+BOOST_FIXTURE_TEST_CASE(bit_column_is_written_and_read_back_packed_test, Test::TemporaryMefFile) {
+  const long rowCount = 1000;
+  VecColumn<std::int32_t> ids({ "ID", "", 1 }, rowCount);
+  BitColumn flags({ "FLAGS", "", 12 }, rowCount);
+  for (long i = 0; i < rowCount; ++i) {
+    ids(i) = i;
+    flags.setBit(i, i % 12, true);
+  }
+  const auto& du = initBintableExt("TABLE", ids.info(), flags.bitInfo()).columns();
+  du.writeSeq(ids, flags);
+  const auto res = du.readBits("FLAGS");
+  BOOST_TEST(res.bitCount() == 12);
+  BOOST_TEST(res.rowCount() == rowCount);
+  BOOST_TEST(res.vector() == flags.vector());
+  BitColumn segment({ "FLAGS", "", 12 }, 10);
+  VecColumn<std::int32_t> segmentIds({ "ID", "", 1 }, 10);
+  du.readSegmentSeqTo(Segment { 100, 109 }, segmentIds, segment);
+  for (long i = 0; i < 10; ++i) {
+    BOOST_TEST(segment.bit(i, (100 + i) % 12));
+    BOOST_TEST(not segment.bit(i, (101 + i) % 12));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(vla_column_is_written_and_read_back_test, Test::TemporaryMefFile) {
+  const long rowCount = 100;
+  VlaColumn<float> spectra("SPECTRUM", "Jy");
+  for (long i = 0; i < rowCount; ++i) {
+    std::vector<float> row(i % 7); // Including empty rows
+    for (std::size_t j = 0; j < row.size(); ++j) {
+      row[j] = i + j * 0.5F;
+    }
+    spectra.append(row);
+  }
+  const auto& du = initBintableExt<std::int32_t>("TABLE", { "ID", "", 1 }).columns();
+  du.initVla<float>(spectra.name(), spectra.unit());
+  du.writeVla(spectra);
+  BOOST_TEST(du.readRowCount() == rowCount);
+  const auto res = du.readVla<float>("SPECTRUM");
+  BOOST_TEST(res.unit() == "Jy");
+  BOOST_TEST(res.offsets() == spectra.offsets());
+  BOOST_TEST(res.values() == spectra.values());
+  const auto segment = du.readVlaSegment<float>({ 10, 20 }, 1);
+  BOOST_TEST(segment.rowCount() == 11);
+  for (long i = 0; i < segment.rowCount(); ++i) {
+    BOOST_TEST(segment.size(i) == spectra.size(10 + i));
+    for (long j = 0; j < segment.size(i); ++j) {
+      BOOST_TEST(segment.data(i)[j] == spectra.data(10 + i)[j]);
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(vla_rows_are_overwritten_and_appended_test, Test::TemporaryMefFile) {
+  const auto& du = initBintableExt("TABLE").columns();
+  du.initVla<std::int16_t>("DATA", "", -1, true);
+  du.writeVla(VlaColumn<std::int16_t>("DATA", "", { 0, 1, 3, 6 }, { 0, 1, 2, 3, 4, 5 }));
+  du.writeVlaSegment(2, VlaColumn<std::int16_t>("DATA", "", { 0, 1, 1 }, { 6 }));
+  const auto res = du.readVla<std::int16_t>(0);
+  const std::vector<long> offsets { 0, 1, 3, 4, 4 };
+  const std::vector<std::int16_t> values { 0, 1, 2, 6 };
+  BOOST_TEST(res.offsets() == offsets);
+  BOOST_TEST(res.values() == values);
+}
+
+BOOST_FIXTURE_TEST_CASE(vla_values_are_converted_to_the_stored_type_test, Test::TemporaryMefFile) {
+  const auto& du = initBintableExt("TABLE").columns();
+  du.initVla<std::int32_t>("DATA"); // 'PJ', i.e. 4-byte wide in the heap
+  const VlaColumn<std::int64_t> column("DATA", "", { 0, 2, 3, 6 }, { 0, 1, 2, 3, 4, 5 });
+  du.writeVla(column);
+  const auto res = du.readVla<std::int64_t>(0);
+  BOOST_TEST(res.offsets() == column.offsets());
+  BOOST_TEST(res.values() == column.values());
+}
+
+BOOST_FIXTURE_TEST_CASE(vla_heap_does_not_grow_when_rows_are_overwritten_test, Test::TemporaryMefFile) {
+  const auto& hdu = initBintableExt("TABLE");
+  const auto& du = hdu.columns();
+  du.initVla<double>("DATA");
+  const VlaColumn<double> column("DATA", "", { 0, 10, 20, 30 }, std::vector<double>(30, 1.));
+  du.writeVla(column);
+  du.writeVlaSegment(0, column);
+  const auto heapSize = hdu.header().parse<long>("PCOUNT").value;
+  BOOST_TEST(heapSize == 30 * sizeof(double));
+  du.writeVlaSegment(0, column);
+  BOOST_TEST(hdu.header().parse<long>("PCOUNT").value == heapSize);
+}
+
 template <typename T>
 void checkTupleWriteRead(const BintableColumns& du) {
 
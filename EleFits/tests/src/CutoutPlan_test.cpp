@@ -0,0 +1,165 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/CutoutPlan.h"
+#include "EleFits/FitsFileFixture.h"
+#include "EleFitsData/TestRaster.h"
+
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief Check that each stamp equals the region read separately, and is filled with -1 outside the image.
+ */
+void checkStamps(
+    const VecRaster<float, 2>& raster,
+    const std::vector<Region<2>>& regions,
+    const std::vector<VecRaster<float, 2>>& stamps) {
+  BOOST_TEST(stamps.size() == regions.size());
+  for (std::size_t i = 0; i < regions.size(); ++i) {
+    BOOST_TEST(stamps[i].shape() == regions[i].shape());
+    for (const auto& p : regions[i]) {
+      const auto inside = p[0] >= 0 && p[1] >= 0 && p[0] < raster.shape()[0] && p[1] < raster.shape()[1];
+      const auto expected = inside ? raster[p] : -1.F;
+      BOOST_TEST(stamps[i][p - regions[i].front] == expected);
+    }
+  }
+}
+
+/**
+ * @brief Create stamps, including overlapping ones and ones which cross the image edges.
+ */
+std::vector<Region<2>> createStamps() {
+  return {
+      Region<2>::fromShape({ 10, 50 }, { 8, 8 }),
+      Region<2>::fromShape({ 2, 2 }, { 8, 8 }),
+      Region<2>::fromShape({ 5, 4 }, { 8, 8 }), // Overlaps the previous one
+      Region<2>::fromShape({ -3, 20 }, { 8, 8 }), // Crosses the left edge
+      Region<2>::fromShape({ 60, 60 }, { 8, 8 }), // Crosses the top-right corner
+      Region<2>::fromShape({ 100, 100 }, { 8, 8 }), // Outside
+      Region<2>::fromShape({ 30, 21 }, { 8, 8 })};
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(CutoutPlan_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(stamps_are_clipped_test) {
+  const auto stamps = createStamps();
+  const CutoutPlan plan(stamps, { 64, 64 }, sizeof(float));
+  BOOST_TEST(plan.size() == stamps.size());
+  const Position<2> front { 0, 20 };
+  const Position<2> back { 4, 27 };
+  BOOST_TEST(plan.clipped(3).front == front);
+  BOOST_TEST(plan.clipped(3).back == back);
+  BOOST_TEST(plan.clipped(4).back[0] == 63);
+  BOOST_TEST(plan.clipped(5).shape()[0] <= 0);
+}
+
+BOOST_AUTO_TEST_CASE(nearby_stamps_are_grouped_test) {
+  const auto stamps = createStamps();
+  CutoutOptions options;
+  options.maxGap = 2;
+  const CutoutPlan plan(stamps, { 64, 64 }, sizeof(float), options);
+  const auto& slabs = plan.slabs();
+  BOOST_TEST_REQUIRE(slabs.size() == 3);
+  const std::vector<long> first { 1, 2 };
+  const std::vector<long> second { 3, 6 };
+  const std::vector<long> third { 0, 4 };
+  BOOST_TEST(slabs[0].stamps == first);
+  BOOST_TEST(slabs[1].stamps == second);
+  BOOST_TEST(slabs[2].stamps == third);
+  const Position<2> front { 0, 20 };
+  const Position<2> back { 37, 28 };
+  BOOST_TEST(slabs[1].region.front == front);
+  BOOST_TEST(slabs[1].region.back == back);
+}
+
+BOOST_AUTO_TEST_CASE(memory_budget_is_respected_test) {
+  std::vector<Region<2>> stamps;
+  for (long i = 0; i < 10; ++i) {
+    stamps.push_back(Region<2>::fromShape({ 0, i * 4 }, { 4, 4 }));
+  }
+  CutoutOptions options;
+  options.memoryBudget = 4 * 8 * sizeof(float); // Two stamps per slab
+  const CutoutPlan plan(stamps, { 64, 64 }, sizeof(float), options);
+  BOOST_TEST(plan.slabs().size() == 5);
+  BOOST_TEST(plan.readPixelCount() == 4 * 40);
+  options.memoryBudget = 0;
+  BOOST_TEST(CutoutPlan(stamps, { 64, 64 }, sizeof(float), options).slabs().size() == 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(stamps_are_read_from_slabs_test, Test::TemporaryMefFile) {
+  Test::RandomRaster<float, 2> raster({ 64, 64 });
+  const auto& ext = assignImageExt("IMAGE", raster);
+  const auto regions = createStamps();
+  checkStamps(raster, regions, ext.raster().readCutouts<float>(regions, {}, -1.F));
+}
+
+BOOST_FIXTURE_TEST_CASE(stamps_are_read_in_parallel_test, Test::NewMefFile) {
+  Test::RandomRaster<float, 2> raster({ 64, 64 });
+  assignImageExt("IMAGE", raster);
+  close();
+  open(filename(), FileMode::Read);
+  CutoutOptions options;
+  options.maxGap = 0;
+  options.threadCount = 4;
+  const auto regions = createStamps();
+  checkStamps(raster, regions, access<ImageHdu>(1).raster().readCutouts<float>(regions, options, -1.F));
+  close();
+  remove(filename().c_str());
+}
+
+BOOST_AUTO_TEST_CASE(stamps_are_read_in_parallel_from_memory_test) {
+  Test::RandomRaster<float, 2> raster({ 64, 64 });
+  MemoryBuffer buffer;
+  {
+    MefFile f(buffer, FileMode::Create);
+    f.assignImageExt("IMAGE", raster);
+  }
+  MefFile f(buffer, FileMode::Read);
+  CutoutOptions options;
+  options.maxGap = 0;
+  options.threadCount = 4; // Falls back to a single thread
+  const auto regions = createStamps();
+  checkStamps(raster, regions, f.access<ImageHdu>(1).raster().readCutouts<float>(regions, options, -1.F));
+}
+
+BOOST_FIXTURE_TEST_CASE(stamps_are_read_as_a_cube_test, Test::TemporaryMefFile) {
+  Test::RandomRaster<float, 2> raster({ 64, 64 });
+  const auto& ext = assignImageExt("IMAGE", raster);
+  const auto regions = createStamps();
+  const auto cube = ext.raster().readCutoutCube<float>(regions, {}, -1.F);
+  const auto stamps = ext.raster().readCutouts<float>(regions, {}, -1.F);
+  BOOST_TEST(cube.shape()[2] == static_cast<long>(regions.size()));
+  for (std::size_t i = 0; i < regions.size(); ++i) {
+    const Position<3> front { 3, 5, static_cast<long>(i) };
+    BOOST_TEST(cube[front] == (stamps[i][{ 3, 5 }]));
+  }
+  std::vector<Region<2>> mixed { Region<2>::fromShape({ 0, 0 }, { 2, 2 }), Region<2>::fromShape({ 0, 0 }, { 3, 3 }) };
+  BOOST_CHECK_THROW(ext.raster().readCutoutCube<float>(mixed), FitsError);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
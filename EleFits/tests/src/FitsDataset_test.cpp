@@ -0,0 +1,103 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/FitsDataset.h"
+#include "EleFits/FitsFileFixture.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Files of `ID` and `VALUE` columns, where IDs are global row indices.
+ */
+struct DatasetFixture {
+
+  DatasetFixture() : filenames() {
+    long id = 0;
+    for (long rowCount : { 10, 0, 25, 7 }) {
+      Test::NewMefFile f;
+      VecColumn<std::int64_t> ids({ "ID", "", 1 }, rowCount);
+      VecColumn<float> values({ "VALUE", "", 2 }, rowCount);
+      for (long i = 0; i < rowCount; ++i, ++id) {
+        ids(i) = id;
+        values(i, 1) = id * .5F;
+      }
+      f.assignBintableExt("TABLE", ids, values);
+      filenames.push_back(f.filename());
+      f.close();
+    }
+  }
+
+  ~DatasetFixture() {
+    for (const auto& f : filenames) {
+      boost::filesystem::remove(f);
+    }
+  }
+
+  std::vector<std::string> filenames;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FitsDataset_test, DatasetFixture)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(files_are_concatenated_test) {
+  FitsDataset dataset(filenames, 1, 2);
+  BOOST_TEST(dataset.fileCount() == 4);
+  BOOST_TEST(dataset.readRowCount() == 42);
+  BOOST_TEST(dataset.readRowCount(1) == 0);
+  BOOST_TEST(dataset.readFileIndex(9) == 0);
+  BOOST_TEST(dataset.readFileIndex(10) == 2);
+  BOOST_TEST(dataset.readFileIndex(41) == 3);
+  BOOST_CHECK_THROW(dataset.readFileIndex(42), OutOfBoundsError);
+  BOOST_TEST(dataset.readColumnNames().size() == 2);
+  const auto columns = dataset.readSeq(Named<std::int64_t>("ID"), Named<float>("VALUE"));
+  BOOST_TEST(std::get<0>(columns).rowCount() == 42);
+  for (long i = 0; i < 42; ++i) {
+    BOOST_TEST(std::get<0>(columns)(i) == i);
+    BOOST_TEST(std::get<1>(columns)(i, 1) == i * .5F);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(segment_across_files_is_read_test) {
+  FitsDataset dataset(filenames, 1, 3);
+  const auto columns = dataset.readSegmentSeq({ 5, 39 }, Named<std::int64_t>("ID"));
+  const auto& ids = std::get<0>(columns);
+  BOOST_TEST(ids.rowCount() == 35);
+  for (long i = 0; i < ids.rowCount(); ++i) {
+    BOOST_TEST(ids(i) == i + 5);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(incompatible_schema_is_detected_test) {
+  Test::NewMefFile f;
+  VecColumn<std::int32_t> ids({ "ID", "", 1 }, 3);
+  f.assignBintableExt("TABLE", ids);
+  filenames.push_back(f.filename());
+  f.close();
+  BOOST_CHECK_THROW(FitsDataset(filenames, 1, 2), FitsError);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -61,6 +61,30 @@ BOOST_AUTO_TEST_CASE(empty_file_test) {
   BOOST_TEST(not boost::filesystem::exists(filename));
 }
 
+BOOST_AUTO_TEST_CASE(memory_file_test) {
+  MemoryBuffer buffer;
+  BOOST_TEST(buffer.isWritable());
+  {
+    FitsFile newFile(buffer, FileMode::Create);
+    BOOST_TEST(newFile.filename() == "mem://");
+  }
+  BOOST_TEST(buffer.size() == 2880); // Empty Primary header
+  const auto bytes = buffer.vector();
+  MemoryBuffer view(bytes.data(), bytes.size());
+  BOOST_TEST(not view.isWritable());
+  BOOST_TEST(view.data() == bytes.data());
+  BOOST_CHECK_THROW(FitsFile(view, FileMode::Edit), ReadOnlyError);
+  FitsFile readonlyFile(view, FileMode::Read);
+  BOOST_CHECK_THROW(readonlyFile.closeAndDelete(), ReadOnlyError);
+  readonlyFile.close();
+  readonlyFile.reopen();
+  BOOST_TEST(readonlyFile.isOpen());
+  {
+    FitsFile tempFile(buffer, FileMode::Temporary);
+  }
+  BOOST_TEST(buffer.size() == 0);
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/FitsFileFixture.h"
+#include "EleFits/HandlePool.h"
+#include "EleFitsData/TestColumn.h"
+#include "EleFitsData/TestRaster.h"
+
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief The number of image extensions and of reading threads.
+ */
+constexpr long concurrency = 4;
+
+/**
+ * @brief Write image extensions with different values, and a binary table with two columns.
+ */
+template <typename TFile>
+void writeHdus(TFile& f, std::vector<VecRaster<float, 2>>& rasters, std::vector<VecColumn<float>>& columns) {
+  for (long i = 0; i < concurrency; ++i) {
+    Test::RandomRaster<float, 2> raster({ 16, 8 });
+    f.assignImageExt("IMAGE_" + std::to_string(i), raster);
+    rasters.push_back(raster);
+  }
+  Test::RandomScalarColumn<float> a(100);
+  a.rename("A");
+  Test::RandomScalarColumn<float> b(100);
+  b.rename("B");
+  f.assignBintableExt("TABLE", a, b);
+  columns.push_back(a);
+  columns.push_back(b);
+}
+
+/**
+ * @brief Read the image extensions concurrently, and check the values.
+ */
+void readImagesConcurrently(MefFile& f, const std::vector<VecRaster<float, 2>>& rasters) {
+  std::vector<std::vector<float>> outputs(concurrency);
+  std::vector<std::thread> threads;
+  for (long i = 0; i < concurrency; ++i) {
+    threads.emplace_back([&, i]() {
+      for (int repeat = 0; repeat < 10; ++repeat) { // Make threads interleave
+        outputs[i] = f.access<ImageHdu>(i + 1).raster().read<float, 2>().vector();
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (long i = 0; i < concurrency; ++i) {
+    BOOST_TEST(outputs[i] == rasters[i].vector());
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(HandlePool_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(concurrent_reads_require_read_mode_test) {
+  Test::TemporaryMefFile f;
+  BOOST_CHECK_THROW(f.enableConcurrentReads(), FitsError);
+  BOOST_TEST(f.concurrentHandleCount() == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(hdus_are_read_concurrently_test, Test::NewMefFile) {
+  std::vector<VecRaster<float, 2>> rasters;
+  std::vector<VecColumn<float>> columns;
+  writeHdus(*this, rasters, columns);
+  close();
+  open(filename(), FileMode::Read);
+  enableConcurrentReads();
+
+  readImagesConcurrently(*this, rasters);
+  BOOST_TEST(concurrentHandleCount() == concurrency);
+
+  std::vector<float> a;
+  std::vector<float> b;
+  std::thread readA([&]() {
+    a = access<BintableHdu>("TABLE").readColumn<float>("A").vector();
+  });
+  std::thread readB([&]() {
+    b = accessFirst<BintableHdu>("TABLE").readColumn<float>("B").vector();
+  });
+  readA.join();
+  readB.join();
+  BOOST_TEST(a == columns[0].vector());
+  BOOST_TEST(b == columns[1].vector());
+
+  close();
+  BOOST_TEST(concurrentHandleCount() == 0);
+  remove(filename().c_str());
+}
+
+BOOST_AUTO_TEST_CASE(memory_file_is_read_concurrently_test) {
+  std::vector<VecRaster<float, 2>> rasters;
+  std::vector<VecColumn<float>> columns;
+  MemoryBuffer buffer;
+  {
+    MefFile f(buffer, FileMode::Create);
+    writeHdus(f, rasters, columns);
+  }
+  MefFile f(buffer, FileMode::Read);
+  f.enableConcurrentReads();
+  readImagesConcurrently(f, rasters);
+}
+
+BOOST_AUTO_TEST_CASE(released_handles_are_reused_test) {
+  std::vector<VecRaster<float, 2>> rasters;
+  std::vector<VecColumn<float>> columns;
+  MemoryBuffer buffer;
+  {
+    MefFile f(buffer, FileMode::Create);
+    writeHdus(f, rasters, columns);
+  }
+  MefFile f(buffer, FileMode::Read);
+  f.enableConcurrentReads();
+  for (long i = 0; i < concurrency; ++i) {
+    std::thread worker([&]() {
+      f.access<ImageHdu>(i + 1).raster().read<float, 2>();
+      f.releaseThreadHandle();
+    });
+    worker.join();
+  }
+  BOOST_TEST(f.concurrentHandleCount() == 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
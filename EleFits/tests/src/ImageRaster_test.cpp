@@ -22,6 +22,8 @@
 #include "EleFits/ImageRaster.h"
 
 #include <boost/test/unit_test.hpp>
+#include <cstdint> // uintptr_t
+#include <cstdio> // remove
 
 using namespace Euclid::Fits;
 
@@ -182,6 +184,99 @@ BOOST_FIXTURE_TEST_CASE(const_data_raster_is_read_back_test, Test::TemporarySifF
   BOOST_TEST(vec == cData);
 }
 
+BOOST_FIXTURE_TEST_CASE(uint16_raster_is_read_scaled_and_raw_test, Test::TemporarySifFile) {
+  const Test::RandomRaster<std::uint16_t, 2> input({ 7, 2 });
+  writeRaster(input);
+  const auto& du = raster();
+  BOOST_TEST((du.readScaling() == Scaling::forType<std::uint16_t>()));
+  const auto scaled = du.read<std::uint16_t>();
+  BOOST_TEST(scaled.vector() == input.vector());
+  const auto converted = du.read<float>();
+  const auto raw = du.readRaw<std::int16_t>();
+  for (long i = 0; i < input.size(); ++i) {
+    BOOST_TEST(converted.data()[i] == static_cast<float>(input.data()[i]));
+    BOOST_TEST(raw.data()[i] == static_cast<std::int16_t>(input.data()[i] ^ 0x8000));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(scaling_keywords_are_applied_after_reopening_test, Test::NewMefFile) {
+  const VecRaster<std::int16_t, 1> input({ 3 }, { -1, 0, 1 });
+  const auto& ext = assignImageExt("SCALED", input);
+  ext.header().write("BSCALE", 2.);
+  ext.header().write("BZERO", 10.);
+  close();
+  open(filename(), FileMode::Read);
+  const auto& du = access<ImageHdu>(1).raster();
+  const Scaling expectedScaling { 2., 10. };
+  BOOST_TEST((du.readScaling() == expectedScaling));
+  const auto scaled = du.read<float, 1>();
+  const std::vector<float> expected { 8., 10., 12. };
+  BOOST_TEST(scaled.vector() == expected);
+  close();
+  std::remove(filename().c_str());
+}
+
+BOOST_FIXTURE_TEST_CASE(int32_raster_is_converted_with_overflow_policy_test, Test::TemporarySifFile) {
+  const VecRaster<std::int32_t, 1> input({ 5 }, { -100000, -1, 0, 1, 100000 });
+  writeRaster(input);
+  auto du = raster(); // Copy to set the policy
+  BOOST_TEST((du.overflowPolicy() == OverflowPolicy::Throw));
+  const auto widened = du.read<double, 1>();
+  for (long i = 0; i < input.size(); ++i) {
+    BOOST_TEST(widened.data()[i] == static_cast<double>(input.data()[i]));
+  }
+  BOOST_CHECK_THROW((du.read<std::int16_t, 1>()), OverflowError);
+  du.setOverflowPolicy(OverflowPolicy::Saturate);
+  const auto narrowed = du.read<std::int16_t, 1>();
+  const std::vector<std::int16_t> expected { -32768, -1, 0, 1, 32767 };
+  BOOST_TEST(narrowed.vector() == expected);
+  BOOST_TEST((raster().overflowPolicy() == OverflowPolicy::Throw)); // Not affected
+}
+
+BOOST_FIXTURE_TEST_CASE(raster_is_read_decimated_test, Test::TemporarySifFile) {
+  const Test::RandomRaster<float, 3> input({ 13, 7, 4 });
+  writeRaster(input);
+  const Position<3> step { 4, 3, 2 };
+  const auto decimated = raster().readDecimated<float, 3>(step);
+  const Position<3> shape { 4, 3, 2 };
+  BOOST_TEST(decimated.shape() == shape);
+  for (const auto& p : Region<3>::fromShape(Position<3>::zero(), shape)) {
+    const Position<3> q { p[0] * step[0], p[1] * step[1], p[2] * step[2] };
+    BOOST_TEST(decimated[p] == input[q]);
+  }
+  const auto region = raster().readRegionDecimated<float, 2>(Region<3>::fromShape({ 1, 1, 3 }, { 12, 6, 1 }), step);
+  const Position<2> sliceShape { 3, 2 };
+  BOOST_TEST(region.shape() == sliceShape);
+  const Position<2> last { 2, 1 };
+  const Position<3> lastInput { 9, 4, 3 };
+  BOOST_TEST(region[last] == input[lastInput]);
+}
+
+BOOST_FIXTURE_TEST_CASE(raster_is_read_binned_test, Test::TemporarySifFile) {
+  const Test::RandomRaster<float, 2> input({ 30, 21 });
+  writeRaster(input);
+  const Position<2> block { 8, 4 };
+  for (auto mode : { BinningMode::Sum, BinningMode::Mean, BinningMode::Min, BinningMode::Max, BinningMode::Median }) {
+    Binner<float> expected(input.shape(), block, mode);
+    for (long i = 0; i < expected.slabCount(); ++i) {
+      expected.reduce(i, input.data() + input.index(expected.slab(i).front));
+    }
+    const auto binned = raster().readBinned<float>(block, mode);
+    BOOST_TEST(binned.vector() == expected.raster().vector());
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(raster_is_read_with_aligned_allocator_test, Test::TemporarySifFile) {
+  const Test::RandomRaster<float, 2> input({ 17, 9 });
+  writeRaster(input);
+  const auto output = raster().read<float, 2, AlignedAllocator<float>>();
+  BOOST_TEST(reinterpret_cast<std::uintptr_t>(output.data()) % cacheLineSize == 0);
+  BOOST_TEST(output.shape() == input.shape());
+  for (long i = 0; i < input.size(); ++i) {
+    BOOST_TEST(output.data()[i] == input.data()[i]);
+  }
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,92 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/TestRaster.h"
+#include "EleFits/FitsFileFixture.h"
+#include "EleFits/ImageWritePlan.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ImageWritePlan_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(plan_size_test) {
+  const Test::RandomRaster<float, 2> floatRaster({ 3, 2 });
+  const Test::RandomRaster<std::int16_t, 3> intRaster({ 4, 3, 2 });
+  ImageWritePlan plan;
+  BOOST_TEST(plan.size() == 0);
+  plan.add("FLOAT", floatRaster);
+  plan.add("INT", intRaster);
+  BOOST_TEST(plan.size() == 2);
+  BOOST_TEST(plan.dataByteCount() == 6 * 4 + 24 * 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(images_are_written_in_parallel_and_read_back_test, Test::TemporaryMefFile) {
+  constexpr long count = 7;
+  std::vector<Test::RandomRaster<float, 2>> floatRasters;
+  std::vector<Test::RandomRaster<std::uint16_t, 2>> uintRasters;
+  for (long i = 0; i < count; ++i) {
+    floatRasters.emplace_back(Position<2> { 100 + i, 50 });
+    uintRasters.emplace_back(Position<2> { 30, 20 + i });
+  }
+  ImageWritePlan plan;
+  for (long i = 0; i < count; ++i) {
+    plan.add("FLOAT" + std::to_string(i), floatRasters[i]);
+    plan.add("UINT" + std::to_string(i), uintRasters[i]);
+  }
+  assignImageExts(plan, 3);
+  BOOST_TEST(hduCount() == 1 + 2 * count);
+  const Test::SmallRaster last;
+  assignImageExt("LAST", last); // File is still consistent
+  for (long i = 0; i < count; ++i) {
+    const auto& floatExt = access<ImageHdu>(1 + 2 * i);
+    BOOST_TEST(floatExt.readName() == "FLOAT" + std::to_string(i));
+    BOOST_TEST(floatExt.readRaster<float>().vector() == floatRasters[i].vector());
+    const auto& uintExt = access<ImageHdu>(2 + 2 * i);
+    BOOST_TEST(uintExt.readName() == "UINT" + std::to_string(i));
+    BOOST_TEST(uintExt.readRaster<std::uint16_t>().vector() == uintRasters[i].vector());
+  }
+  BOOST_TEST(access<ImageHdu>("LAST").readRaster<float>().vector() == last.vector());
+}
+
+BOOST_AUTO_TEST_CASE(images_are_written_in_parallel_in_memory_test) {
+  const Test::RandomRaster<std::int32_t, 3> first({ 10, 20, 3 });
+  const Test::RandomRaster<double, 1> second({ 1000 });
+  ImageWritePlan plan;
+  plan.add("FIRST", first);
+  plan.add("SECOND", second);
+  MemoryBuffer buffer;
+  {
+    MefFile f(buffer, FileMode::Create);
+    f.assignImageExts(plan, 2);
+  }
+  MefFile f(buffer, FileMode::Read);
+  BOOST_TEST(f.hduCount() == 3);
+  BOOST_TEST((f.access<ImageHdu>("FIRST").readRaster<std::int32_t, 3>().vector() == first.vector()));
+  BOOST_TEST((f.access<ImageHdu>("SECOND").readRaster<double, 1>().vector() == second.vector()));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,118 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/FitsFileFixture.h"
+#include "EleFits/IoExecutor.h"
+#include "EleFitsData/TestColumn.h"
+#include "EleFitsData/TestRaster.h"
+
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <vector>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(IoExecutor_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(tasks_are_executed_in_order_test) {
+  IoExecutor executor;
+  std::vector<int> order;
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 10; ++i) {
+    futures.push_back(executor.submit([&order, i]() {
+      order.push_back(i);
+      return i * i;
+    }));
+  }
+  for (int i = 0; i < 10; ++i) {
+    BOOST_TEST(futures[i].get() == i * i);
+  }
+  executor.wait();
+  BOOST_TEST(executor.pendingCount() == 0);
+  const std::vector<int> expected { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  BOOST_TEST(order == expected);
+}
+
+BOOST_AUTO_TEST_CASE(exceptions_are_forwarded_to_futures_test) {
+  IoExecutor executor;
+  auto failure = executor.submit([]() {
+    throw std::runtime_error("failure");
+  });
+  auto success = executor.submit([]() {
+    return 1;
+  });
+  BOOST_CHECK_THROW(failure.get(), std::runtime_error);
+  BOOST_TEST(success.get() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(pending_tasks_are_executed_at_destruction_test) {
+  int count = 0;
+  {
+    IoExecutor executor;
+    for (int i = 0; i < 10; ++i) {
+      executor.submit([&count]() {
+        ++count;
+      });
+    }
+  }
+  BOOST_TEST(count == 10);
+}
+
+BOOST_FIXTURE_TEST_CASE(raster_is_written_and_read_asynchronously_test, Test::TemporaryMefFile) {
+  Test::RandomRaster<float, 3> raster({ 4, 5, 6 });
+  const auto& ext = initImageExt<float>("IMAGE", raster.shape());
+  auto written = ext.raster().writeAsync(raster);
+  auto read = ext.raster().readAsync<float, 3>(); // Ordered after the write
+  auto region = ext.raster().readRegionAsync<float, 3>(Region<3>::fromShape({ 1, 1, 1 }, { 2, 2, 2 }));
+  written.get();
+  BOOST_TEST(read.get().vector() == raster.vector());
+  const Position<3> front { 1, 1, 1 };
+  BOOST_TEST(region.get()[Position<3>::zero()] == raster[front]);
+}
+
+BOOST_FIXTURE_TEST_CASE(columns_are_written_and_read_asynchronously_test, Test::TemporaryMefFile) {
+  Test::RandomScalarColumn<float> a(10);
+  a.rename("A");
+  Test::RandomScalarColumn<double> b(10);
+  b.rename("B");
+  const auto& columns = initBintableExt("TABLE", a.info(), b.info()).columns();
+  auto written = columns.writeSeqAsync(a, b);
+  auto readA = columns.readAsync<float>("A");
+  auto readSeq = columns.readSeqAsync(Named<float>("A"), Named<double>("B"));
+  auto readSegment = columns.readSegmentAsync<double>({ 2, 4 }, "B");
+  written.get();
+  BOOST_TEST(readA.get().vector() == a.vector());
+  BOOST_TEST(std::get<1>(readSeq.get()).vector() == b.vector());
+  const auto segment = readSegment.get();
+  BOOST_TEST(segment.rowCount() == 3);
+  BOOST_TEST(segment(0) == b(2));
+}
+
+BOOST_AUTO_TEST_CASE(detached_handler_throws_test) {
+  const ImageHdu dummy;
+  BOOST_CHECK_THROW(dummy.raster().readAsync<float>(), FitsError);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
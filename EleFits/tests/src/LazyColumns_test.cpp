@@ -0,0 +1,90 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/FitsFileFixture.h"
+#include "EleFits/LazyColumns.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(LazyColumns_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(columns_are_read_once_and_cached_test, Test::TemporaryMefFile) {
+  const long rowCount = 100;
+  VecColumn<std::int32_t> ids({ "ID", "", 1 }, rowCount);
+  VecColumn<float> fluxes({ "FLUX", "", 3 }, rowCount);
+  VecColumn<double> times({ "TIME", "", 1 }, rowCount);
+  for (long i = 0; i < rowCount; ++i) {
+    ids(i) = i;
+    fluxes(i, 2) = i * 2.F;
+    times(i) = i * .5;
+  }
+  const auto& hdu = assignBintableExt("TABLE", ids, fluxes, times);
+  LazyColumns lazy(hdu.columns());
+  BOOST_TEST(lazy.byteCount() == 0);
+  const auto id = lazy.get<std::int32_t>("ID");
+  BOOST_TEST(lazy.readColumnCount() == 1);
+  BOOST_TEST(lazy.isCached("ID"));
+  BOOST_TEST(not lazy.isCached("FLUX"));
+  const auto seq = lazy.getSeq(Named<std::int32_t>("ID"), Named<float>("FLUX"), Named<double>("TIME"));
+  BOOST_TEST(lazy.readColumnCount() == 3); // ID is not read again
+  BOOST_TEST(std::get<0>(seq) == id);
+  BOOST_TEST(lazy.byteCount() == rowCount * (sizeof(std::int32_t) + 3 * sizeof(float) + sizeof(double)));
+  for (long i = 0; i < rowCount; ++i) {
+    BOOST_TEST((*id)(i) == i);
+    BOOST_TEST((*std::get<1>(seq))(i, 2) == i * 2.F);
+    BOOST_TEST((*std::get<2>(seq))(i) == i * .5);
+  }
+  lazy.get<double>("TIME");
+  BOOST_TEST(lazy.readColumnCount() == 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(least_recently_used_columns_are_evicted_test, Test::TemporaryMefFile) {
+  const long rowCount = 10;
+  VecColumn<std::int64_t> a({ "A", "", 1 }, rowCount);
+  VecColumn<std::int64_t> b({ "B", "", 1 }, rowCount);
+  VecColumn<std::int64_t> c({ "C", "", 1 }, rowCount);
+  const auto& hdu = assignBintableExt("TABLE", a, b, c);
+  const std::size_t columnByteCount = rowCount * sizeof(std::int64_t);
+  LazyColumns lazy(hdu.columns(), 2 * columnByteCount);
+  lazy.get<std::int64_t>("A");
+  const auto handle = lazy.get<std::int64_t>("B");
+  lazy.get<std::int64_t>("A"); // B is now the least recently used
+  lazy.get<std::int64_t>("C");
+  BOOST_TEST(lazy.isCached("A"));
+  BOOST_TEST(not lazy.isCached("B"));
+  BOOST_TEST(lazy.isCached("C"));
+  BOOST_TEST(lazy.byteCount() == 2 * columnByteCount);
+  BOOST_TEST(handle->rowCount() == rowCount); // Still valid
+  lazy.setBudget(columnByteCount);
+  BOOST_TEST(not lazy.isCached("A"));
+  BOOST_TEST(lazy.isCached("C"));
+  lazy.clear();
+  BOOST_TEST(lazy.byteCount() == 0);
+  BOOST_TEST(not lazy.isCached("C"));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
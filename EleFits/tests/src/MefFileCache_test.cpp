@@ -0,0 +1,186 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleCfitsioWrapper/IoStats.h"
+#include "EleFits/FitsFileFixture.h"
+#include "EleFits/MefFileCache.h"
+#include "EleFitsData/TestRaster.h"
+
+#include <algorithm> // fill
+#include <boost/test/unit_test.hpp>
+#include <cstdio> // remove
+#include <thread>
+#include <vector>
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief A set of files with an image extension named "SCI" and filled with the file index.
+ */
+struct CachedFiles {
+
+  /**
+   * @brief Create the files.
+   */
+  CachedFiles(long count = 4) : filenames() {
+    for (long i = 0; i < count; ++i) {
+      filenames.push_back(Test::temporaryFilename());
+      MefFile f(filenames.back(), FileMode::Create);
+      VecRaster<float, 2> raster({ 4, 3 });
+      std::fill(raster.data(), raster.data() + raster.size(), float(i));
+      f.assignImageExt("SCI", raster);
+    }
+  }
+
+  /**
+   * @brief Remove the files.
+   */
+  ~CachedFiles() {
+    for (const auto& f : filenames) {
+      std::remove(f.c_str());
+    }
+  }
+
+  /**
+   * @brief The file names.
+   */
+  std::vector<std::string> filenames;
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_SUITE(MefFileCache_test, CachedFiles)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(creating_modes_are_rejected_test) {
+  BOOST_CHECK_THROW(MefFileCache(2, FileMode::Create), FitsError);
+  BOOST_CHECK_THROW(MefFileCache(2, FileMode::Overwrite), FitsError);
+}
+
+BOOST_AUTO_TEST_CASE(least_recently_used_files_are_evicted_test) {
+  MefFileCache cache(2);
+  cache.acquire(filenames[0]); // miss
+  cache.acquire(filenames[1]); // miss
+  cache.acquire(filenames[0]); // hit
+  cache.acquire(filenames[2]); // miss, evicts 1
+  BOOST_TEST(cache.openCount() == 2);
+  cache.acquire(filenames[0]); // hit
+  cache.acquire(filenames[1]); // miss, evicts 2
+  const auto stats = cache.stats();
+  BOOST_TEST(stats.hits == 2);
+  BOOST_TEST(stats.misses == 4);
+  BOOST_TEST(stats.evictions == 2);
+  cache.clear();
+  BOOST_TEST(cache.openCount() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(evicted_files_are_reopened_transparently_test) {
+  MefFileCache cache(1);
+  for (int repeat = 0; repeat < 3; ++repeat) {
+    for (std::size_t i = 0; i < filenames.size(); ++i) {
+      auto lease = cache.acquire(filenames[i]);
+      BOOST_TEST(lease.readHduIndex("SCI") == 1);
+      const auto raster = lease.access<ImageHdu>("SCI").raster().read<float, 2>();
+      const Position<2> front { 0, 0 };
+      BOOST_TEST(raster[front] == float(i));
+      BOOST_TEST(lease->hduCount() == 2);
+    }
+  }
+  BOOST_TEST(cache.stats().misses == 3 * static_cast<long>(filenames.size()));
+  BOOST_CHECK_THROW(cache.acquire(filenames[0]).readHduIndex("MISSING"), FitsError);
+}
+
+BOOST_AUTO_TEST_CASE(hdu_names_are_not_read_again_after_reopening_test) {
+  using Euclid::Cfitsio::IoStats;
+  MefFileCache cache(1);
+  IoStats::reset();
+  IoStats::enable();
+  const auto callCount = [&]() {
+    return IoStats::read(filenames[0]).total.callCount();
+  };
+  long before = callCount();
+  BOOST_TEST(cache.acquire(filenames[0]).readHduIndex("SCI") == 1);
+  BOOST_TEST(callCount() > before);
+  cache.acquire(filenames[1]); // Evicts filenames[0]
+  BOOST_TEST(cache.stats().evictions == 1);
+  BOOST_TEST(cache.metadataCount() == 1); // Not read through a lease for filenames[1]
+  auto lease = cache.acquire(filenames[0]); // Reopens
+  before = callCount();
+  BOOST_TEST(lease.readHduIndex("SCI") == 1);
+  BOOST_TEST(callCount() == before); // No header scan
+  IoStats::disable();
+  IoStats::reset();
+}
+
+BOOST_AUTO_TEST_CASE(metadata_capacity_is_respected_test) {
+  MefFileCache cache(1, FileMode::Read, 2);
+  for (const auto& f : filenames) {
+    cache.acquire(f).readHduIndex("SCI");
+  }
+  BOOST_TEST(cache.metadataCount() == 2);
+  cache.setMetadataCapacity(0);
+  BOOST_TEST(cache.metadataCount() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(leased_files_are_not_evicted_test) {
+  MefFileCache cache(1);
+  auto first = cache.acquire(filenames[0]);
+  auto second = cache.acquire(filenames[1]);
+  BOOST_TEST(cache.openCount() == 2);
+  BOOST_TEST(first->hduCount() == 2);
+  BOOST_TEST(second->hduCount() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(missing_files_are_not_cached_test) {
+  MefFileCache cache(2);
+  BOOST_CHECK_THROW(cache.acquire("/missing/file.fits"), FitsError);
+  BOOST_TEST(cache.openCount() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(files_are_acquired_concurrently_test) {
+  MefFileCache cache(2);
+  std::vector<long> errors(4, 0);
+  std::vector<std::thread> threads;
+  for (long t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int repeat = 0; repeat < 20; ++repeat) {
+        const long i = (t + repeat) % filenames.size();
+        auto lease = cache.acquire(filenames[i]);
+        const auto raster = lease.access<ImageHdu>("SCI").raster().read<float, 2>();
+        if (raster[{ 3, 2 }] != float(i)) {
+          ++errors[t];
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto e : errors) {
+    BOOST_TEST(e == 0);
+  }
+  const auto stats = cache.stats();
+  BOOST_TEST(stats.hits + stats.misses == 80);
+  BOOST_TEST(cache.openCount() <= 2);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -97,6 +97,26 @@ BOOST_FIXTURE_TEST_CASE(access_single_named_hdu, Test::TemporaryMefFile) {
   BOOST_CHECK_THROW(this->access<>(extname), FitsError);
 }
 
+BOOST_AUTO_TEST_CASE(memory_file_is_edited_test) {
+  Test::SmallRaster raster;
+  MemoryBuffer buffer;
+  {
+    MefFile f(buffer, FileMode::Create);
+    f.assignImageExt("IMG1", raster);
+  }
+  const auto size = buffer.size();
+  {
+    MefFile f(buffer, FileMode::Edit);
+    BOOST_TEST(f.hduCount() == 2);
+    f.assignImageExt("IMG2", raster);
+  }
+  BOOST_TEST(buffer.size() > size);
+  MefFile f(buffer, FileMode::Read);
+  const std::vector<std::string> names { "", "IMG1", "IMG2" };
+  BOOST_TEST(f.readHduNames() == names);
+  BOOST_TEST(f.access<ImageHdu>(2).readRaster<float>().vector() == raster.vector());
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,74 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/ParallelFor.h"
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <vector>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ParallelFor_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(each_index_is_visited_once_test) {
+  const long count = 100;
+  std::vector<std::atomic<long>> visits(count);
+  std::atomic<long> maxThread(0);
+  Internal::parallelFor(count, 4, [&](long i, long t) {
+    ++visits[i];
+    long m = maxThread;
+    while (t > m && not maxThread.compare_exchange_weak(m, t)) {
+    }
+  });
+  for (const auto& v : visits) {
+    BOOST_TEST(v == 1);
+  }
+  BOOST_TEST(maxThread < 4);
+}
+
+BOOST_AUTO_TEST_CASE(empty_range_is_not_visited_test) {
+  long visitCount = 0;
+  Internal::parallelFor(0, 0, [&](long, long) {
+    ++visitCount;
+  });
+  BOOST_TEST(visitCount == 0);
+}
+
+BOOST_AUTO_TEST_CASE(exceptions_are_rethrown_test) {
+  BOOST_CHECK_THROW(
+      Internal::parallelFor(
+          100,
+          4,
+          [](long i, long) {
+            if (i == 10) {
+              throw std::runtime_error("failure");
+            }
+          }),
+      std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -71,6 +71,21 @@ BOOST_FIXTURE_TEST_CASE(checksum_test, Test::TemporarySifFile) {
   BOOST_CHECK_THROW(this->verifyChecksums(), ChecksumError);
 }
 
+BOOST_AUTO_TEST_CASE(memory_file_is_written_and_read_back_test) {
+  Test::SmallRaster input;
+  const Record<int> record { "INT", 1 };
+  MemoryBuffer buffer;
+  {
+    SifFile f(buffer, FileMode::Create);
+    f.writeAll({ record }, input);
+  }
+  const auto bytes = buffer.vector(); // E.g. sent over the network
+  MemoryBuffer view(bytes.data(), bytes.size());
+  SifFile f(view, FileMode::Read);
+  BOOST_TEST((f.header().parse<int>(record.keyword) == record));
+  BOOST_TEST(f.raster().read<float>().vector() == input.vector());
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,150 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/FitsFileFixture.h"
+#include "EleFits/Trace.h"
+#include "EleFitsData/TestRaster.h"
+
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief A temporary MEF file, with tracing enabled after its creation.
+ */
+struct TracedMefFile : Test::TemporaryMefFile {
+  TracedMefFile() : Test::TemporaryMefFile() {
+    Tracer::reset();
+    Tracer::enable();
+  }
+  ~TracedMefFile() {
+    Tracer::disable();
+    Tracer::reset();
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Trace_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(buffer_keeps_the_newest_events_test) {
+  TraceBuffer buffer(3, 4);
+  for (long i = 0; i < 6; ++i) {
+    TraceEvent event;
+    event.bytes = i;
+    buffer.push(event);
+  }
+  const auto events = buffer.events();
+  BOOST_TEST(events.size() == 4);
+  BOOST_TEST(buffer.dropCount() == 2);
+  for (long i = 0; i < 4; ++i) {
+    BOOST_TEST(events[i].bytes == i + 2);
+    BOOST_TEST(events[i].thread == 3);
+  }
+  buffer.clear();
+  BOOST_TEST(buffer.events().empty());
+}
+
+BOOST_AUTO_TEST_CASE(nothing_is_recorded_when_disabled_test) {
+  Tracer::reset();
+  BOOST_TEST(not Tracer::isEnabled());
+  {
+    TraceSpan span("test", "disabled");
+    span.bytes(1);
+  }
+  BOOST_TEST(Tracer::events().empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(span_attributes_are_recorded_test, TracedMefFile) {
+  {
+    TraceSpan span("test", "span");
+    span.hdu(2);
+    span.bytes(10);
+    span.bytes(5);
+    span.region(Region<2> { { 1, 2 }, { 3, 4 } });
+  }
+  {
+    TraceSpan span("test", "truncated");
+    span.detail(std::string(2 * TraceEvent::detailCapacity, 'x'));
+  }
+  const auto events = Tracer::events();
+  BOOST_TEST(events.size() == 2);
+  const auto& e = events[0];
+  BOOST_TEST(std::string(e.category) == "test");
+  BOOST_TEST(std::string(e.name) == "span");
+  BOOST_TEST(e.hdu == 2);
+  BOOST_TEST(e.bytes == 15);
+  BOOST_TEST(std::string(e.detail.data()) == "[1:3, 2:4]");
+  BOOST_TEST(e.duration >= 0);
+  BOOST_TEST(events[1].start >= e.start);
+  BOOST_TEST(std::string(events[1].detail.data()).length() == TraceEvent::detailCapacity - 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(threads_record_in_their_own_buffers_test, TracedMefFile) {
+  auto work = []() {
+    TraceSpan span("test", "thread");
+  };
+  std::thread first(work);
+  std::thread second(work);
+  first.join();
+  second.join();
+  const auto events = Tracer::events();
+  BOOST_TEST(events.size() == 2);
+  BOOST_TEST(events[0].thread != events[1].thread);
+}
+
+BOOST_FIXTURE_TEST_CASE(operations_are_traced_if_compiled_in_test, TracedMefFile) {
+  Test::SmallRaster raster;
+  const auto& ext = assignImageExt("IMAGE", raster);
+  Tracer::reset();
+  ext.raster().read<float, 2>();
+  const auto events = Tracer::events();
+#ifdef ELEFITS_ENABLE_TRACE
+  BOOST_TEST(events.size() == 1);
+  BOOST_TEST(std::string(events[0].name) == "ImageRaster::readTo");
+  BOOST_TEST(events[0].hdu == 1);
+  BOOST_TEST(events[0].bytes == long(raster.size() * sizeof(float)));
+#else
+  BOOST_TEST(events.empty());
+#endif
+}
+
+BOOST_FIXTURE_TEST_CASE(events_are_written_as_chrome_trace_test, TracedMefFile) {
+  {
+    TraceSpan span("test", "quoted\"name");
+    span.hdu(1);
+    span.bytes(42);
+  }
+  std::ostringstream json;
+  Tracer::writeChromeTrace(json);
+  const auto str = json.str();
+  BOOST_TEST(str.find("\"traceEvents\": [") != std::string::npos);
+  BOOST_TEST(str.find("\"name\": \"quoted\\\"name\", \"cat\": \"test\", \"ph\": \"X\"") != std::string::npos);
+  BOOST_TEST(str.find("\"args\": { \"hdu\": 1, \"bytes\": 42, \"detail\": \"\" }") != std::string::npos);
+  BOOST_TEST(str.find("\"thread_name\"") != std::string::npos);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/BintableHdu.h"
+#include "EleFits/FitsFileFixture.h"
+#include "EleFits/ZoneMap.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath> // nan
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ZoneMap_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(zones_are_updated_incrementally_test) {
+  ZoneMap zones({ "DEC" }, 10);
+  BOOST_TEST(zones.has("DEC"));
+  BOOST_TEST(not zones.has("RA"));
+  BOOST_TEST(zones.rowCount("DEC") == 0);
+  VecColumn<double> first({ "DEC", "deg", 1 }, 15);
+  for (long i = 0; i < first.rowCount(); ++i) {
+    first(i) = i;
+  }
+  first(3) = std::nan("");
+  zones.update(0, first);
+  BOOST_TEST(zones.rowCount("DEC") == 15);
+  BOOST_TEST(zones.zones("DEC").size() == 2);
+  const auto& zone0 = zones.zones("DEC")[0];
+  BOOST_TEST(zone0.min == 0.);
+  BOOST_TEST(zone0.max == 9.);
+  BOOST_TEST(zone0.nullCount == 1);
+  BOOST_TEST(zone0.rowCount == 10);
+  VecColumn<double> second({ "DEC", "deg", 1 }, 10);
+  for (long i = 0; i < second.rowCount(); ++i) {
+    second(i) = 100 + i;
+  }
+  zones.update(15, second); // Appended
+  const auto& zone1 = zones.zones("DEC")[1];
+  BOOST_TEST(zone1.min == 10.);
+  BOOST_TEST(zone1.max == 104.);
+  BOOST_TEST(zone1.nullCount == 0);
+  BOOST_TEST(zones.rowCount("DEC") == 25);
+  VecColumn<float> ignored({ "RA", "deg", 1 }, 10);
+  zones.update(0, ignored);
+  BOOST_TEST(not zones.has("RA"));
+}
+
+BOOST_AUTO_TEST_CASE(zones_are_conservative_test) {
+  ZoneMap zones({ "MJD" }, 10);
+  VecColumn<std::int32_t> column({ "MJD", "d", 1 }, 10);
+  zones.update(0, column);
+  zones.update(25, column); // Rows 10 to 24 are skipped
+  const auto& skipped = zones.zones("MJD")[1];
+  BOOST_TEST(skipped.min == -std::numeric_limits<double>::infinity());
+  BOOST_TEST(skipped.max == std::numeric_limits<double>::infinity());
+  BOOST_TEST(skipped.nullCount == -1);
+  zones.update(0, column); // Overwritten
+  BOOST_TEST(zones.zones("MJD")[0].nullCount == -1);
+  BOOST_CHECK_THROW(ZoneMap({ "NAME" }).update(0, VecColumn<std::string>({ "NAME", "", 8 }, 1)), FitsError);
+}
+
+BOOST_AUTO_TEST_CASE(zones_are_selected_test) {
+  ZoneMap zones({ "DEC" }, 10);
+  VecColumn<float> column({ "DEC", "deg", 1 }, 45);
+  for (long i = 0; i < column.rowCount(); ++i) {
+    column(i) = i;
+  }
+  zones.update(0, column);
+  const auto candidates = zones.select("DEC", 12, 25);
+  BOOST_TEST(candidates.size() == 2);
+  BOOST_TEST(candidates[0].front == 10);
+  BOOST_TEST(candidates[0].back == 29);
+  BOOST_TEST(candidates[1].front == 45); // Untracked rows
+  BOOST_TEST(candidates[1].back == -1);
+  const auto tail = zones.select("DEC", 42, 100);
+  BOOST_TEST(tail.size() == 1);
+  BOOST_TEST(tail[0].front == 40);
+  BOOST_TEST(tail[0].back == -1);
+}
+
+BOOST_FIXTURE_TEST_CASE(zones_are_written_and_used_test, Test::TemporaryMefFile) {
+  const long rowCount = 10000;
+  VecColumn<double> decs({ "DEC", "deg", 1 }, rowCount);
+  VecColumn<std::int64_t> ids({ "ID", "", 1 }, rowCount);
+  for (long i = 0; i < rowCount; ++i) {
+    decs(i) = -90. + 180. * i / rowCount; // Sorted
+    ids(i) = i;
+  }
+  ZoneMap zones({ "DEC" }, 1000);
+  const auto& hdu = initBintableExt("CATALOG", decs.info(), ids.info());
+  auto columns = hdu.columns(); // Copy to attach the zone map
+  columns.setZoneMap(&zones);
+  BOOST_TEST(hdu.columns().zoneMap() == nullptr); // Not shared
+  columns.writeSeq(decs, ids);
+  columns.setZoneMap(nullptr);
+  BOOST_TEST(zones.rowCount("DEC") == rowCount);
+  zones.write(*this, "CATALOG_ZONES");
+
+  const auto read = ZoneMap::read(access<BintableHdu>("CATALOG_ZONES"));
+  BOOST_TEST(read.zoneRowCount() == zones.zoneRowCount());
+  BOOST_TEST(read.rowCount("DEC") == rowCount);
+  const auto candidates = read.select("DEC", 0, 10);
+  BOOST_TEST(candidates.size() == 2);
+  BOOST_TEST(candidates[0].size() == 1000);
+  const auto selected = access<BintableHdu>("CATALOG").columns().readFilteredSeq(
+      candidates,
+      std::make_tuple(Named<double>("DEC")),
+      [](double dec) {
+        return dec >= 0 && dec <= 10;
+      },
+      Named<std::int64_t>("ID"));
+  const auto& selectedIds = std::get<0>(selected);
+  BOOST_TEST(selectedIds.rowCount() > 0);
+  for (long i = 0; i < selectedIds.rowCount(); ++i) {
+    const auto dec = decs(selectedIds(i));
+    BOOST_TEST(dec >= 0);
+    BOOST_TEST(dec <= 10);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
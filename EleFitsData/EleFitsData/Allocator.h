@@ -0,0 +1,335 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSDATA_ALLOCATOR_H
+#define _ELEFITSDATA_ALLOCATOR_H
+
+#include <cstddef> // size_t
+#include <new> // bad_alloc
+#include <utility> // forward
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Allocate a buffer aligned to a power of two, or return `nullptr`.
+ */
+void* allocateAligned(std::size_t size, std::size_t alignment);
+
+/**
+ * @brief Free a buffer allocated with `allocateAligned()`.
+ */
+void deallocateAligned(void* ptr);
+
+/**
+ * @brief Allocate a buffer which can be backed by huge pages, or return `nullptr`.
+ * @details
+ * Buffers of at least one huge page are aligned to the huge page size, and advised as huge pages where supported.
+ */
+void* allocateHugePages(std::size_t size);
+
+/**
+ * @brief Free a buffer allocated with `allocateHugePages()`.
+ */
+void deallocateHugePages(void* ptr, std::size_t size);
+
+/**
+ * @brief Map a buffer of zero pages which are not backed by physical memory until written, or return `nullptr`.
+ */
+void* allocateUntouched(std::size_t size);
+
+/**
+ * @brief Unmap a buffer allocated with `allocateUntouched()`.
+ */
+void deallocateUntouched(void* ptr, std::size_t size);
+
+} // namespace Internal
+/// @endcond
+
+/**
+ * @ingroup data_classes
+ * @brief The cache line size, in bytes, which is the default alignment of `AlignedAllocator`.
+ */
+constexpr std::size_t cacheLineSize = 64;
+
+/**
+ * @ingroup data_classes
+ * @brief The huge page size, in bytes, which is used by `HugePageAllocator`.
+ */
+constexpr std::size_t hugePageSize = std::size_t(2) << 20;
+
+/**
+ * @ingroup data_classes
+ * @brief An allocator which aligns the buffers.
+ * @tparam T The value type
+ * @tparam Alignment The alignment in bytes, which must be a power of two
+ * @details
+ * Aligning the buffers to cache lines (the default) or to SIMD register widths
+ * prevents loops from straddling lines at the boundaries, e.g. when processing a raster in parallel.
+ * The allocator can be used with owning data containers:
+ * \code
+ * VecRaster<float, 2, AlignedAllocator<float>> raster({ 2048, 2048 });
+ * const auto image = ext.raster().read<float, 2, AlignedAllocator<float>>();
+ * \endcode
+ */
+template <typename T, std::size_t Alignment = cacheLineSize>
+class AlignedAllocator {
+
+  static_assert(Alignment && !(Alignment & (Alignment - 1)), "Alignment must be a power of two");
+
+public:
+  /**
+   * @brief The value type.
+   */
+  using value_type = T;
+
+  /**
+   * @brief The allocator type for another value type.
+   */
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  /**
+   * @brief Default constructor.
+   */
+  AlignedAllocator() = default;
+
+  /**
+   * @brief Copy constructor from another value type.
+   */
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+  /**
+   * @brief Allocate a buffer of `count` values.
+   * @throw std::bad_alloc if the allocation failed
+   */
+  T* allocate(std::size_t count) {
+    auto* ptr = Internal::allocateAligned(count * sizeof(T), Alignment < alignof(T) ? alignof(T) : Alignment);
+    if (not ptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(ptr);
+  }
+
+  /**
+   * @brief Free a buffer.
+   */
+  void deallocate(T* ptr, std::size_t) {
+    Internal::deallocateAligned(ptr);
+  }
+};
+
+/**
+ * @ingroup data_classes
+ * @brief An allocator which backs large buffers with huge pages.
+ * @tparam T The value type
+ * @details
+ * Buffers of at least `hugePageSize` bytes are aligned to the huge page size,
+ * and transparent huge pages are requested with `madvise()` where the system supports them.
+ * This reduces page faults at first touch by a factor 512, and TLB misses on scattered accesses,
+ * e.g. for random pixel access to large rasters.
+ * Smaller buffers are aligned to cache lines.
+ * If huge pages are not available, the allocator falls back to regular pages.
+ */
+template <typename T>
+class HugePageAllocator {
+
+public:
+  /**
+   * @brief The value type.
+   */
+  using value_type = T;
+
+  /**
+   * @brief The allocator type for another value type.
+   */
+  template <typename U>
+  struct rebind {
+    using other = HugePageAllocator<U>;
+  };
+
+  /**
+   * @brief Default constructor.
+   */
+  HugePageAllocator() = default;
+
+  /**
+   * @brief Copy constructor from another value type.
+   */
+  template <typename U>
+  HugePageAllocator(const HugePageAllocator<U>&) {}
+
+  /**
+   * @brief Allocate a buffer of `count` values.
+   * @throw std::bad_alloc if the allocation failed
+   */
+  T* allocate(std::size_t count) {
+    auto* ptr = Internal::allocateHugePages(count * sizeof(T));
+    if (not ptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(ptr);
+  }
+
+  /**
+   * @brief Free a buffer.
+   */
+  void deallocate(T* ptr, std::size_t count) {
+    Internal::deallocateHugePages(ptr, count * sizeof(T));
+  }
+};
+
+/**
+ * @ingroup data_classes
+ * @brief An allocator which leaves the pages untouched until they are first written.
+ * @tparam T The value type
+ * @details
+ * Buffers are mapped directly from the system, which provides zero pages lazily,
+ * and values are default-initialized instead of value-initialized,
+ * such that allocating a container does not write to the memory.
+ * On NUMA systems, each page is then placed on the node of the thread which writes it first,
+ * e.g. the thread which reads the corresponding part of a raster in a parallel loop,
+ * which is the thread most likely to process it later.
+ *
+ * Values of a new container are zero,
+ * except when a container is resized within its capacity, in which case new values are indeterminate.
+ * Mapping has a system call cost, such that the allocator is meant for large buffers.
+ */
+template <typename T>
+class FirstTouchAllocator {
+
+public:
+  /**
+   * @brief The value type.
+   */
+  using value_type = T;
+
+  /**
+   * @brief The allocator type for another value type.
+   */
+  template <typename U>
+  struct rebind {
+    using other = FirstTouchAllocator<U>;
+  };
+
+  /**
+   * @brief Default constructor.
+   */
+  FirstTouchAllocator() = default;
+
+  /**
+   * @brief Copy constructor from another value type.
+   */
+  template <typename U>
+  FirstTouchAllocator(const FirstTouchAllocator<U>&) {}
+
+  /**
+   * @brief Allocate a buffer of `count` values.
+   * @throw std::bad_alloc if the allocation failed
+   */
+  T* allocate(std::size_t count) {
+    auto* ptr = Internal::allocateUntouched(count * sizeof(T));
+    if (not ptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(ptr);
+  }
+
+  /**
+   * @brief Free a buffer.
+   */
+  void deallocate(T* ptr, std::size_t count) {
+    Internal::deallocateUntouched(ptr, count * sizeof(T));
+  }
+
+  /**
+   * @brief Default-initialize a value, which does not touch the memory of trivial types.
+   */
+  template <typename U>
+  void construct(U* ptr) {
+    ::new (static_cast<void*>(ptr)) U;
+  }
+
+  /**
+   * @brief Construct a value from arguments.
+   */
+  template <typename U, typename... TArgs>
+  void construct(U* ptr, TArgs&&... args) {
+    ::new (static_cast<void*>(ptr)) U(std::forward<TArgs>(args)...);
+  }
+};
+
+/**
+ * @brief Check whether two aligned allocators are interchangeable, which is always true.
+ */
+template <typename T, typename U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) {
+  return true;
+}
+
+/**
+ * @brief Check whether two aligned allocators are not interchangeable, which is always false.
+ */
+template <typename T, typename U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) {
+  return false;
+}
+
+/**
+ * @brief Check whether two huge page allocators are interchangeable, which is always true.
+ */
+template <typename T, typename U>
+bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&) {
+  return true;
+}
+
+/**
+ * @brief Check whether two huge page allocators are not interchangeable, which is always false.
+ */
+template <typename T, typename U>
+bool operator!=(const HugePageAllocator<T>&, const HugePageAllocator<U>&) {
+  return false;
+}
+
+/**
+ * @brief Check whether two first-touch allocators are interchangeable, which is always true.
+ */
+template <typename T, typename U>
+bool operator==(const FirstTouchAllocator<T>&, const FirstTouchAllocator<U>&) {
+  return true;
+}
+
+/**
+ * @brief Check whether two first-touch allocators are not interchangeable, which is always false.
+ */
+template <typename T, typename U>
+bool operator!=(const FirstTouchAllocator<T>&, const FirstTouchAllocator<U>&) {
+  return false;
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
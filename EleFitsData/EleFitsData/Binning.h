@@ -0,0 +1,192 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSDATA_BINNING_H
+#define _ELEFITSDATA_BINNING_H
+
+#include "EleFitsData/Raster.h"
+#include "EleFitsData/Region.h"
+
+#include <type_traits>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup image_data_classes
+ * @brief The reduction of the pixels of a block into a binned pixel.
+ */
+enum class BinningMode {
+  Sum, ///< Sum of the values
+  Mean, ///< Mean of the values
+  Min, ///< Minimum value
+  Max, ///< Maximum value
+  Median ///< Median value, i.e. the lower median if the number of values is even
+};
+
+/**
+ * @ingroup image_data_classes
+ * @brief Streaming block-reduction of a raster, slab by slab.
+ * @tparam T The value type
+ * @tparam n The dimension, which must be at least 2
+ * @details
+ * The input raster is divided into blocks of given shape,
+ * and each block is reduced into one pixel of the output raster.
+ * Blocks at the upper edges may be incomplete, in which case they are reduced from the available pixels.
+ *
+ * The input is not required to be held in memory at once:
+ * it is consumed as slabs of `block[n - 1]` planes along the last axis,
+ * each of which produces one plane of the output raster.
+ * This way, memory is proportional to one input slab and to the output raster,
+ * and slabs are contiguous in the input, e.g. in a Fits data unit.
+ *
+ * Sums and means are accumulated in double precision, and converted to `T` with saturation,
+ * e.g. the sum of a block of `unsigned char` 255's is 255 (see `OverflowPolicy::Saturate`).
+ * For integer `T`, means are rounded to the nearest integer, halfway cases away from zero.
+ * \code
+ * Binner<float> binner(shape, { 8, 8 }, BinningMode::Mean);
+ * for (long i = 0; i < binner.slabCount(); ++i) {
+ *   const auto slab = readRegion(binner.slab(i));
+ *   binner.reduce(i, slab.data());
+ * }
+ * const auto& preview = binner.raster();
+ * \endcode
+ * @see Scaling.h about vectorization
+ */
+template <typename T, long n = 2>
+class Binner {
+
+  static_assert(n >= 2, "Binning requires a fixed dimension of at least 2");
+
+public:
+  /**
+   * @brief The accumulator type for sums and means.
+   */
+  using Accumulator = double;
+
+  /**
+   * @brief Constructor.
+   * @param shape The input shape
+   * @param block The block shape
+   * @param mode The reduction
+   * @throw FitsError if the block shape is not positive
+   */
+  Binner(const Position<n>& shape, const Position<n>& block, BinningMode mode);
+
+  /**
+   * @brief Get the number of input slabs.
+   */
+  long slabCount() const;
+
+  /**
+   * @brief Get the region of an input slab.
+   */
+  Region<n> slab(long index) const;
+
+  /**
+   * @brief Reduce an input slab into the corresponding plane of the output raster.
+   * @param index The slab index
+   * @param data The contiguous values of the slab
+   * @details
+   * Slabs can be reduced in any order.
+   */
+  void reduce(long index, const T* data);
+
+  /**
+   * @brief Get the output raster.
+   * @details
+   * Its shape is the input shape divided by the block shape, rounded up.
+   */
+  const VecRaster<T, n>& raster() const;
+
+  /**
+   * @copydoc raster() const
+   */
+  VecRaster<T, n>& raster();
+
+private:
+  /**
+   * @brief Compute the output shape.
+   * @throw FitsError if the block shape is not positive
+   */
+  static Position<n> binnedShape(const Position<n>& shape, const Position<n>& block);
+
+  /**
+   * @brief Reduce an input line into an output line.
+   */
+  void reduceLine(const T* in, long out);
+
+  /**
+   * @brief Write the reduced values of the current slab into an output plane.
+   */
+  void finalize(long index);
+
+  /**
+   * @brief The input shape.
+   */
+  Position<n> m_shape;
+
+  /**
+   * @brief The block shape.
+   */
+  Position<n> m_block;
+
+  /**
+   * @brief The reduction.
+   */
+  BinningMode m_mode;
+
+  /**
+   * @brief The output raster.
+   */
+  VecRaster<T, n> m_raster;
+
+  /**
+   * @brief The number of pixels of an output plane.
+   */
+  long m_planeSize;
+
+  /**
+   * @brief The sums of the current slab, for `Sum` and `Mean` modes.
+   */
+  std::vector<Accumulator> m_sums;
+
+  /**
+   * @brief The extrema of the current slab, for `Min` and `Max` modes,
+   * or the values of each block, for `Median` mode.
+   */
+  std::vector<T> m_values;
+
+  /**
+   * @brief The number of values accumulated in each output pixel of the current slab.
+   */
+  std::vector<long> m_counts;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITSDATA_BINNING_IMPL
+#include "EleFitsData/impl/Binning.hpp"
+#undef _ELEFITSDATA_BINNING_IMPL
+/// @endcond
+
+#endif
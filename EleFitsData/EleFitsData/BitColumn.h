@@ -0,0 +1,151 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSDATA_BITCOLUMN_H
+#define _ELEFITSDATA_BITCOLUMN_H
+
+#include "EleFitsData/Column.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_data_classes
+ * @brief Pack boolean values into bytes, most significant bit first.
+ * @param values The values to be packed, where non-zero values are set bits
+ * @param count The number of values
+ * @param bytes The `(count + 7) / 8` output bytes, where the trailing bits are cleared
+ * @details
+ * Values are packed 8 at a time.
+ * @see Scaling.h about vectorization
+ */
+template <typename T>
+void packBits(const T* values, long count, unsigned char* bytes);
+
+/**
+ * @ingroup bintable_data_classes
+ * @brief Unpack bytes into boolean values, most significant bit first.
+ * @param bytes The `(count + 7) / 8` bytes to be unpacked
+ * @param count The number of values
+ * @param values The output values, which are 0 or 1
+ */
+template <typename T>
+void unpackBits(const unsigned char* bytes, long count, T* values);
+
+/**
+ * @ingroup bintable_data_classes
+ * @brief Bit column, i.e. column with an `X` TFORM, stored packed.
+ * @details
+ * Each row contains `bitCount()` bits, which are stored as `(bitCount() + 7) / 8` bytes, like in the file.
+ * The column is a `VecColumn<unsigned char>` of those bytes,
+ * such that it is read and written by the usual methods of `BintableColumns`, e.g. in a sequence of columns,
+ * without the 8x overhead of one byte per flag.
+ * The bits can be accessed individually, or unpacked to `bool` or `unsigned char` values at once.
+ *
+ * Example usage:
+ * \code
+ * BitColumn flags({ "FLAGS", "", 12 }, rowCount);
+ * flags.setBit(0, 11, true);
+ * du.init(flags.bitInfo());
+ * du.writeSeq(ids, flags);
+ *
+ * auto res = du.readBits("FLAGS");
+ * std::vector<unsigned char> unpacked = res.unpack(); // rowCount * 12 values
+ * \endcode
+ * @warning
+ * The column must be initialized in the file with `bitInfo()`, which yields an `X` TFORM,
+ * and not with `info()`, which describes the bytes.
+ * For the same reason, `reshape()` should not be used.
+ */
+class BitColumn : public VecColumn<unsigned char> {
+
+public:
+  /**
+   * @brief Create a column with cleared bits.
+   * @param info The column metadata, where the repeat count is the number of bits per row
+   * @param rowCount The number of rows
+   */
+  BitColumn(const ColumnInfo<bool>& info, long rowCount);
+
+  /**
+   * @brief Create a column from unpacked values.
+   * @param info The column metadata, where the repeat count is the number of bits per row
+   * @param rowCount The number of rows
+   * @param values The `rowCount * info.repeatCount` values, where non-zero values are set bits
+   */
+  template <typename T>
+  BitColumn(const ColumnInfo<bool>& info, long rowCount, const T* values);
+
+  /**
+   * @brief Get the metadata of the bits, e.g. to initialize the column in a file.
+   */
+  ColumnInfo<bool> bitInfo() const;
+
+  /**
+   * @brief Get the number of bits per row.
+   */
+  long bitCount() const;
+
+  /**
+   * @brief Get the value of a bit.
+   */
+  bool bit(long row, long index) const;
+
+  /**
+   * @brief Set the value of a bit.
+   */
+  void setBit(long row, long index, bool value);
+
+  /**
+   * @brief Unpack the bits into `rowCount() * bitCount()` values.
+   */
+  template <typename T>
+  void unpackTo(T* values) const;
+
+  /**
+   * @brief Unpack the bits into `rowCount() * bitCount()` bytes.
+   */
+  std::vector<unsigned char> unpack() const;
+
+  /**
+   * @brief Pack `rowCount() * bitCount()` values.
+   */
+  template <typename T>
+  void packFrom(const T* values);
+
+private:
+  /**
+   * @brief The number of bits per row.
+   */
+  long m_bitCount;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITSDATA_BITCOLUMN_IMPL
+#include "EleFitsData/impl/BitColumn.hpp"
+#undef _ELEFITSDATA_BITCOLUMN_IMPL
+/// @endcond
+
+#endif
@@ -24,6 +24,7 @@
 
 #include <complex>
 #include <cstdint>
+#include <memory> // allocator
 #include <string>
 #include <vector>
 
@@ -381,12 +382,18 @@ private:
  * @brief Column which stores internally the data.
  * @details
  * Use it (via move semantics) if you don't need your data after the write operation.
+ * @tparam TAllocator The allocator of the data vector, e.g. an `AlignedAllocator` (see Allocator.h)
  * @see \ref data_classes
  */
-template <typename T>
+template <typename T, typename TAllocator = std::allocator<std::decay_t<T>>>
 class VecColumn : public Column<T> {
 
 public:
+  /**
+   * @brief The container type.
+   */
+  using Container = std::vector<std::decay_t<T>, TAllocator>;
+
   /**
    * @brief Destructor.
    */
@@ -425,7 +432,7 @@ public:
    * VecColumn column(info, std::move(vec));
    * \endcode
    */
-  VecColumn(ColumnInfo<std::decay_t<T>> info, std::vector<T> vec);
+  VecColumn(ColumnInfo<std::decay_t<T>> info, Container vec);
 
   /**
    * @brief Create a VecColumn with given metadata.
@@ -435,7 +442,7 @@ public:
   /**
    * @brief Const reference to the vector data.
    */
-  const std::vector<T>& vector() const;
+  const Container& vector() const;
 
   /**
    * @brief Move the vector outside the column.
@@ -453,7 +460,7 @@ public:
    * @warning
    * The column data is not usable anymore after this call.
    */
-  std::vector<std::decay_t<T>>& moveTo(std::vector<std::decay_t<T>>& destination);
+  Container& moveTo(Container& destination);
 
 private:
   /**
@@ -469,7 +476,7 @@ private:
   /**
    * @brief The data vector.
    */
-  std::vector<std::decay_t<T>> m_vec;
+  Container m_vec;
 
 };
 
@@ -0,0 +1,239 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSDATA_COLUMNARENA_H
+#define _ELEFITSDATA_COLUMNARENA_H
+
+#include "EleFitsData/Allocator.h"
+#include "EleFitsData/Column.h"
+
+#include <cstddef> // size_t
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_data_classes
+ * @brief A single cache-line-aligned buffer from which the data of several columns is carved.
+ * @details
+ * Reading many columns as `VecColumn`s performs one allocation per column, and as many deallocations,
+ * which fragments the heap when done repeatedly, e.g. in a loop over the chunks of a large table.
+ * An arena makes a single allocation for all the columns, each of which starts on a cache line,
+ * and keeps it across uses: the buffer only grows when a larger set of columns is carved.
+ *
+ * Columns are carved as `PtrColumn` views, which are valid until the arena is cleared, grows or is destroyed.
+ * Only trivially copyable values (e.g. numbers, but not strings) can be stored in an arena.
+ * @see ArenaTable
+ */
+class ColumnArena {
+
+public:
+  /**
+   * @brief The alignment of each column, in bytes.
+   */
+  static constexpr std::size_t alignment = cacheLineSize;
+
+  /**
+   * @brief Create an empty arena.
+   */
+  ColumnArena() = default;
+
+  /**
+   * @brief Create an empty arena with given capacity in bytes.
+   */
+  explicit ColumnArena(std::size_t capacity);
+
+  /**
+   * @brief Move constructor.
+   * @details
+   * Views of the moved arena are kept valid.
+   */
+  ColumnArena(ColumnArena&&) = default;
+
+  /**
+   * @brief Move assignment.
+   */
+  ColumnArena& operator=(ColumnArena&&) = default;
+
+  /**
+   * @brief Non-copyable, because the views would point to the source arena.
+   */
+  ColumnArena(const ColumnArena&) = delete;
+
+  /**
+   * @brief Non-copyable.
+   */
+  ColumnArena& operator=(const ColumnArena&) = delete;
+
+  /**
+   * @brief Get the number of bytes required by a column, including the alignment padding.
+   */
+  template <typename T>
+  static std::size_t footprint(const ColumnInfo<T>& info, long rowCount);
+
+  /**
+   * @brief Get the number of bytes in use.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Get the number of bytes allocated.
+   */
+  std::size_t capacity() const;
+
+  /**
+   * @brief Ensure that the capacity is at least a given number of bytes.
+   * @details
+   * If the buffer grows, the views are invalidated.
+   */
+  void reserve(std::size_t capacity);
+
+  /**
+   * @brief Mark the whole buffer as unused, without deallocating it.
+   * @details
+   * The views are invalidated.
+   */
+  void clear();
+
+  /**
+   * @brief Carve a column out of the unused part of the buffer.
+   * @details
+   * The values are left as is, i.e. they are indeterminate.
+   * @throw FitsError if the remaining capacity is insufficient
+   */
+  template <typename T>
+  PtrColumn<T> carve(const ColumnInfo<T>& info, long rowCount);
+
+private:
+  /**
+   * @brief The buffer.
+   */
+  std::vector<unsigned char, AlignedAllocator<unsigned char, alignment>> m_buffer;
+
+  /**
+   * @brief The number of bytes in use.
+   */
+  std::size_t m_size = 0;
+};
+
+/**
+ * @ingroup bintable_data_classes
+ * @brief A set of columns which owns a `ColumnArena` and exposes its columns as `PtrColumn` views.
+ * @details
+ * The table is returned by the multi-column read methods which accept an arena, e.g. `BintableColumns::readSeq()`.
+ * The arena can be released to be reused for the next read, such that there is no allocation in steady state:
+ * \code
+ * ColumnArena arena;
+ * for (const auto& rows : chunks) {
+ *   auto table = columns.readSegmentSeq(std::move(arena), rows, Named<float>("RA"), Named<float>("DEC"));
+ *   const auto& ra = std::get<0>(table.columns());
+ *   ...
+ *   arena = table.release();
+ * }
+ * \endcode
+ */
+template <typename... Ts>
+class ArenaTable {
+
+public:
+  /**
+   * @brief Carve columns out of an arena.
+   * @param arena The arena, which is cleared and grown if needed
+   * @param rowCount The number of rows of each column
+   * @param infos The column infos
+   */
+  ArenaTable(ColumnArena arena, long rowCount, const ColumnInfo<Ts>&... infos);
+
+  /**
+   * @brief Move constructor.
+   */
+  ArenaTable(ArenaTable&&) = default;
+
+  /**
+   * @brief Move assignment.
+   */
+  ArenaTable& operator=(ArenaTable&&) = default;
+
+  /**
+   * @brief Non-copyable.
+   */
+  ArenaTable(const ArenaTable&) = delete;
+
+  /**
+   * @brief Non-copyable.
+   */
+  ArenaTable& operator=(const ArenaTable&) = delete;
+
+  /**
+   * @brief Get the number of rows.
+   */
+  long rowCount() const;
+
+  /**
+   * @brief Get the columns.
+   */
+  const std::tuple<PtrColumn<Ts>...>& columns() const;
+
+  /**
+   * @copydoc columns() const
+   */
+  std::tuple<PtrColumn<Ts>...>& columns();
+
+  /**
+   * @brief Get the arena back, e.g. for the next read.
+   * @warning
+   * The columns are not usable anymore after this call.
+   */
+  ColumnArena release();
+
+private:
+  /**
+   * @brief Clear the arena and reserve the memory for all the columns.
+   */
+  static ColumnArena prepare(ColumnArena arena, long rowCount, const ColumnInfo<Ts>&... infos);
+
+  /**
+   * @brief The arena.
+   */
+  ColumnArena m_arena;
+
+  /**
+   * @brief The number of rows.
+   */
+  long m_rowCount;
+
+  /**
+   * @brief The views.
+   */
+  std::tuple<PtrColumn<Ts>...> m_columns;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITSDATA_COLUMNARENA_IMPL
+#include "EleFitsData/impl/ColumnArena.hpp"
+#undef _ELEFITSDATA_COLUMNARENA_IMPL
+/// @endcond
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSDATA_CONVERSION_H
+#define _ELEFITSDATA_CONVERSION_H
+
+#include "EleFitsData/FitsError.h"
+
+#include <complex>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup data_classes
+ * @brief The behavior of narrowing conversions when a value does not fit in the destination type.
+ */
+enum class OverflowPolicy
+{
+  Throw, ///< Saturate the values and throw an `OverflowError` (default, as CFitsIO)
+  Saturate, ///< Silently saturate the values, i.e. clamp them to the bounds of the destination type
+  Unchecked ///< Cast the values without checking, except from floating point to integer, which saturates
+};
+
+/**
+ * @ingroup exceptions
+ * @brief Exception thrown when values do not fit in the destination type of a conversion.
+ */
+class OverflowError : public FitsError {
+public:
+  /**
+   * @brief Constructor.
+   * @param count The number of overflowing values
+   */
+  explicit OverflowError(long count);
+
+  /**
+   * @brief The number of overflowing values.
+   */
+  long count;
+};
+
+/**
+ * @ingroup data_classes
+ * @brief Check whether values of type `TFrom` can be converted to type `TTo` with convertTo().
+ * @details
+ * Conversions are supported between arithmetic types and between complex types.
+ */
+template <typename TFrom, typename TTo>
+struct IsConvertible;
+
+/**
+ * @ingroup data_classes
+ * @brief Convert a contiguous sequence of values.
+ * @param in The input values
+ * @param count The number of values
+ * @param out The converted values
+ * @param policy The overflow policy for narrowing conversions
+ * @details
+ * Widening conversions are plain casts.
+ * Narrowing conversions check the range of the input values according to the overflow policy.
+ * Floating point values are truncated toward zero when converted to integers, like in CFitsIO.
+ * Conversions from floating point to integers always saturate, even with `OverflowPolicy::Unchecked`,
+ * because casting an out-of-range value or a NaN would be undefined behavior.
+ * @see Scaling.h about vectorization
+ */
+template <typename TFrom, typename TTo>
+void convertTo(const TFrom* in, long count, TTo* out, OverflowPolicy policy = OverflowPolicy::Throw);
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Get a per-thread scratch buffer of at least given size.
+ * @details
+ * The buffer is reused by subsequent calls in the same thread, such that
+ * temporary buffers of the read-and-convert services are allocated once.
+ * Its content is invalidated by the next call.
+ */
+template <typename T>
+T* scratch(long size);
+
+} // namespace Internal
+/// @endcond
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITSDATA_CONVERSION_IMPL
+#include "EleFitsData/impl/Conversion.hpp"
+#undef _ELEFITSDATA_CONVERSION_IMPL
+/// @endcond
+
+#endif
@@ -37,6 +37,11 @@ namespace Fits {
 template <typename T>
 struct Named {
 
+  /**
+   * @brief The value type.
+   */
+  using Value = T;
+
   /**
    * @brief Constructor.
    */
@@ -60,6 +65,11 @@ struct Named {
 template <typename T>
 struct Indexed {
 
+  /**
+   * @brief The value type.
+   */
+  using Value = T;
+
   /**
    * @brief Constructor.
    */
@@ -25,6 +25,7 @@
 
 #include <complex>
 #include <cstdint>
+#include <memory> // allocator
 #include <string>
 #include <vector>
 
@@ -424,11 +425,17 @@ private:
 /**
  * @ingroup image_data_classes
  * @copydoc Raster
+ * @tparam TAllocator The allocator of the data vector, e.g. an `AlignedAllocator` (see Allocator.h)
  */
-template <typename T, long n = 2>
+template <typename T, long n = 2, typename TAllocator = std::allocator<std::decay_t<T>>>
 class VecRaster : public Raster<T, n> {
 
 public:
+  /**
+   * @brief The container type.
+   */
+  using Container = std::vector<std::decay_t<T>, TAllocator>;
+
   /**
    * @brief Destructor.
    */
@@ -462,7 +469,7 @@ public:
    * VecRaster column(shape, std::move(data));
    * \endcode
    */
-  VecRaster(Position<n> shape, std::vector<std::decay_t<T>> vec);
+  VecRaster(Position<n> shape, Container vec);
 
   /**
    * @brief Create a VecRaster with given shape and empty data.
@@ -477,7 +484,7 @@ public:
   /**
    * @brief Const reference to the vector.
    */
-  const std::vector<std::decay_t<T>>& vector() const;
+  const Container& vector() const;
 
   /**
    * @brief Move the vector outside the raster.
@@ -495,7 +502,7 @@ public:
    * @warning
    * The raster data is not usable anymore after this call.
    */
-  std::vector<std::decay_t<T>>& moveTo(std::vector<std::decay_t<T>>& destination);
+  Container& moveTo(Container& destination);
 
 private:
   /**
@@ -506,7 +513,7 @@ private:
   /**
    * @brief The data vector.
    */
-  std::vector<std::decay_t<T>> m_vec;
+  Container m_vec;
 };
 
 /**
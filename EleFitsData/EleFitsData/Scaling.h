@@ -0,0 +1,160 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSDATA_SCALING_H
+#define _ELEFITSDATA_SCALING_H
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup data_classes
+ * @brief The affine transform between stored and physical values.
+ * @details
+ * In Fits files, the physical value of a pixel or column element is computed from the stored value as:
+ * \code
+ * physical = offset + scale * stored
+ * \endcode
+ * where `offset` and `scale` are the values of the `BZERO` and `BSCALE` keywords for images,
+ * or of the `TZEROn` and `TSCALn` keywords for binary table columns.
+ *
+ * This is also how unsigned integers are stored, since they are not supported natively by the Fits format:
+ * for example, an `std::uint16_t` value is stored as an `std::int16_t` with an offset of 32768,
+ * which boils down to flipping the sign bit.
+ * @see scaleTo()
+ * @see decodeScaledTo()
+ * @see encodeScaledTo()
+ */
+struct Scaling {
+
+  /**
+   * @brief Create the identity transform (no scaling).
+   */
+  static Scaling identity() {
+    return { 1., 0. };
+  }
+
+  /**
+   * @brief Create the transform used by CFitsIO to store a type which is not natively supported by Fits.
+   * @details
+   * This is the identity for natively supported types, and a pure offset for `char` and unsigned integers.
+   */
+  template <typename T>
+  static Scaling forType();
+
+  /**
+   * @brief Check whether the transform is the identity.
+   */
+  bool isIdentity() const;
+
+  /**
+   * @brief Check whether the transform from `TRaw` to `T` boils down to flipping the sign bit.
+   * @details
+   * This is true for unsigned integers stored as signed integers of the same size (and conversely),
+   * with the offset set by CFitsIO.
+   */
+  template <typename TRaw, typename T>
+  bool isSignBitFlip() const;
+
+  /**
+   * @brief Apply the transform to a single stored value.
+   */
+  template <typename TRaw, typename T>
+  T apply(TRaw raw) const;
+
+  /**
+   * @brief The scale factor.
+   */
+  double scale;
+
+  /**
+   * @brief The offset.
+   */
+  double offset;
+};
+
+/**
+ * @brief Check whether two transforms are equal.
+ */
+bool operator==(const Scaling& lhs, const Scaling& rhs);
+
+/**
+ * @brief Check whether two transforms are different.
+ */
+bool operator!=(const Scaling& lhs, const Scaling& rhs);
+
+/**
+ * @ingroup data_classes
+ * @brief Apply a scaling to a contiguous sequence of stored values.
+ * @param raw The stored values
+ * @param count The number of values
+ * @param scaling The transform
+ * @param out The physical values
+ * @details
+ * The loop is specialized before being entered (sign-bit flip, pure cast, or affine transform),
+ * such that its body is branch-free and can be vectorized by the compiler.
+ * This is how the element-wise loops of the library are optimized, e.g. conversions, bit packing and binning:
+ * rather than intrinsics, which would be bound to an instruction set,
+ * they are written as branch-free loops over contiguous arrays, which compilers vectorize for the target.
+ * `raw` and `out` may point to the same address if `TRaw` and `T` have the same size.
+ */
+template <typename TRaw, typename T>
+void scaleTo(const TRaw* raw, long count, const Scaling& scaling, T* out);
+
+/**
+ * @ingroup data_classes
+ * @brief Decode a contiguous sequence of big-endian stored values and apply a scaling.
+ * @param bigEndian The stored values, as encoded in the Fits file
+ * @param count The number of values
+ * @param scaling The transform
+ * @param out The physical values
+ * @details
+ * Byte swapping and scaling are fused into a single pass over the data,
+ * with the same specializations as scaleTo().
+ */
+template <typename TRaw, typename T>
+void decodeScaledTo(const unsigned char* bigEndian, long count, const Scaling& scaling, T* out);
+
+/**
+ * @ingroup data_classes
+ * @brief Encode a contiguous sequence of physical values into big-endian stored values.
+ * @param values The physical values
+ * @param count The number of values
+ * @param bigEndian The stored values, as encoded in the Fits file
+ * @details
+ * This is the inverse of decodeScaledTo() for the scaling `Scaling::forType<T>()`,
+ * i.e. unsigned integers are stored as signed integers with an unsigned offset, which boils down to flipping the sign bit.
+ */
+template <typename T>
+void encodeScaledTo(const T* values, long count, unsigned char* bigEndian);
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITSDATA_SCALING_IMPL
+#include "EleFitsData/impl/Scaling.hpp"
+#undef _ELEFITSDATA_SCALING_IMPL
+/// @endcond
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSDATA_VLACOLUMN_H
+#define _ELEFITSDATA_VLACOLUMN_H
+
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_data_classes
+ * @brief Variable-length array column, i.e. column with a `P` or `Q` TFORM.
+ * @details
+ * Instead of a vector of vectors, the values of all the rows are stored contiguously,
+ * and the rows are delimited by an array of offsets, like in Apache Arrow list arrays:
+ * the values of row `i` are `values()[offsets()[i]]` to `values()[offsets()[i + 1] - 1]`.
+ * Here is an example of a 3-row column:
+ * <table>
+ * <tr><th>Row<th>Values
+ * <tr style="text-align:center"><td>0<td>00, 01
+ * <tr style="text-align:center"><td>1<td>
+ * <tr style="text-align:center"><td>2<td>20, 21, 22
+ * </table>
+ * \code
+ * long offsets[] = { 0, 2, 2, 5 };
+ * int values[] = { 00, 01, 20, 21, 22 };
+ * \endcode
+ *
+ * This layout matches the heap of the binary table when it is written sequentially,
+ * such that the whole column is read or written in a single heap access.
+ * String columns are not supported.
+ * @see BintableColumns::readVla()
+ * @see BintableColumns::writeVla()
+ */
+template <typename T>
+class VlaColumn {
+
+public:
+  /**
+   * @brief The value type.
+   */
+  using Value = T;
+
+  /**
+   * @brief Create an empty column.
+   */
+  explicit VlaColumn(std::string name = "", std::string unit = "");
+
+  /**
+   * @brief Create a column from offsets and values.
+   * @details
+   * The offsets must start with 0, be non-decreasing and end with the number of values.
+   */
+  VlaColumn(std::string name, std::string unit, std::vector<long> offsets, std::vector<T> values);
+
+  /**
+   * @brief Get the column name.
+   */
+  const std::string& name() const;
+
+  /**
+   * @brief Get the column unit.
+   */
+  const std::string& unit() const;
+
+  /**
+   * @brief Change the column name.
+   */
+  void rename(const std::string& name);
+
+  /**
+   * @brief Get the number of rows.
+   */
+  long rowCount() const;
+
+  /**
+   * @brief Get the total number of values.
+   */
+  long elementCount() const;
+
+  /**
+   * @brief Get the number of values of a given row.
+   */
+  long size(long row) const;
+
+  /**
+   * @brief Get a pointer to the first value of a given row.
+   */
+  const T* data(long row) const;
+
+  /**
+   * @copydoc data()
+   */
+  T* data(long row);
+
+  /**
+   * @brief Get the offsets, of size `rowCount() + 1`.
+   */
+  const std::vector<long>& offsets() const;
+
+  /**
+   * @brief Get the values of all the rows.
+   */
+  const std::vector<T>& values() const;
+
+  /**
+   * @brief Reserve memory for a given number of rows and values.
+   */
+  void reserve(long rowCount, long elementCount);
+
+  /**
+   * @brief Append a row.
+   */
+  void append(const T* data, long count);
+
+  /**
+   * @brief Append a row.
+   */
+  void append(const std::vector<T>& row);
+
+private:
+  /**
+   * @brief The column name.
+   */
+  std::string m_name;
+
+  /**
+   * @brief The column unit.
+   */
+  std::string m_unit;
+
+  /**
+   * @brief The row offsets.
+   */
+  std::vector<long> m_offsets;
+
+  /**
+   * @brief The values.
+   */
+  std::vector<T> m_values;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITSDATA_VLACOLUMN_IMPL
+#include "EleFitsData/impl/VlaColumn.hpp"
+#undef _ELEFITSDATA_VLACOLUMN_IMPL
+/// @endcond
+
+#endif
@@ -0,0 +1,224 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITSDATA_BINNING_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFitsData/Binning.h"
+  #include "EleFitsData/Conversion.h"
+  #include "EleFitsData/FitsError.h"
+
+  #include <algorithm> // copy, fill, min, max, nth_element
+  #include <cmath> // round
+  #include <limits>
+  #include <type_traits>
+
+namespace Euclid {
+namespace Fits {
+
+template <typename T, long n>
+Binner<T, n>::Binner(const Position<n>& shape, const Position<n>& block, BinningMode mode) :
+    m_shape(shape), m_block(block), m_mode(mode), m_raster(binnedShape(shape, block)), m_planeSize(1), m_sums(),
+    m_values(), m_counts() {
+  for (long d = 0; d < n - 1; ++d) {
+    m_planeSize *= m_raster.shape()[d];
+  }
+  m_counts.resize(m_planeSize);
+  switch (m_mode) {
+    case BinningMode::Sum:
+    case BinningMode::Mean:
+      m_sums.resize(m_planeSize);
+      break;
+    case BinningMode::Min:
+    case BinningMode::Max:
+      m_values.resize(m_planeSize);
+      break;
+    case BinningMode::Median:
+      m_values.resize(m_planeSize * shapeSize(block));
+      break;
+  }
+}
+
+template <typename T, long n>
+long Binner<T, n>::slabCount() const {
+  return m_raster.shape()[n - 1];
+}
+
+template <typename T, long n>
+Region<n> Binner<T, n>::slab(long index) const {
+  Region<n> region { Position<n>::zero(), m_shape - 1 };
+  region.front[n - 1] = index * m_block[n - 1];
+  region.back[n - 1] = std::min(region.front[n - 1] + m_block[n - 1], m_shape[n - 1]) - 1;
+  return region;
+}
+
+template <typename T, long n>
+void Binner<T, n>::reduce(long index, const T* data) {
+
+  /* Reset */
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+  std::fill(m_sums.begin(), m_sums.end(), Accumulator(0));
+  if (m_mode == BinningMode::Min) {
+    std::fill(m_values.begin(), m_values.end(), std::numeric_limits<T>::max());
+  } else if (m_mode == BinningMode::Max) {
+    std::fill(m_values.begin(), m_values.end(), std::numeric_limits<T>::lowest());
+  }
+
+  /* Reduce each line into the output line of its block */
+  const auto slabShape = slab(index).shape();
+  const long width = m_shape[0];
+  const long lineCount = shapeSize(slabShape) / width;
+  for (long l = 0; l < lineCount; ++l) {
+    long out = 0;
+    long rest = l;
+    long stride = m_raster.shape()[0];
+    for (long d = 1; d < n - 1; ++d) {
+      out += rest % slabShape[d] / m_block[d] * stride;
+      rest /= slabShape[d];
+      stride *= m_raster.shape()[d];
+    }
+    reduceLine(data + l * width, out);
+  }
+
+  finalize(index);
+}
+
+template <typename T, long n>
+const VecRaster<T, n>& Binner<T, n>::raster() const {
+  return m_raster;
+}
+
+template <typename T, long n>
+VecRaster<T, n>& Binner<T, n>::raster() {
+  return m_raster;
+}
+
+template <typename T, long n>
+Position<n> Binner<T, n>::binnedShape(const Position<n>& shape, const Position<n>& block) {
+  Position<n> binned = shape;
+  for (long d = 0; d < n; ++d) {
+    if (block[d] <= 0) {
+      throw FitsError("Binning block shape must be positive");
+    }
+    binned[d] = (shape[d] + block[d] - 1) / block[d];
+  }
+  return binned;
+}
+
+template <typename T, long n>
+void Binner<T, n>::reduceLine(const T* in, long out) {
+  const long k = m_block[0];
+  const long width = m_shape[0];
+  const long fullCount = width / k;
+  const long tailBegin = fullCount * k;
+  long* counts = m_counts.data() + out;
+  switch (m_mode) {
+    case BinningMode::Sum:
+    case BinningMode::Mean: {
+      Accumulator* sums = m_sums.data() + out;
+      for (long j = 0; j < k; ++j) {
+        for (long o = 0; o < fullCount; ++o) {
+          sums[o] += in[o * k + j];
+        }
+      }
+      for (long x = tailBegin; x < width; ++x) {
+        sums[fullCount] += in[x];
+      }
+      break;
+    }
+    case BinningMode::Min: {
+      T* values = m_values.data() + out;
+      for (long j = 0; j < k; ++j) {
+        for (long o = 0; o < fullCount; ++o) {
+          values[o] = std::min(values[o], in[o * k + j]);
+        }
+      }
+      for (long x = tailBegin; x < width; ++x) {
+        values[fullCount] = std::min(values[fullCount], in[x]);
+      }
+      break;
+    }
+    case BinningMode::Max: {
+      T* values = m_values.data() + out;
+      for (long j = 0; j < k; ++j) {
+        for (long o = 0; o < fullCount; ++o) {
+          values[o] = std::max(values[o], in[o * k + j]);
+        }
+      }
+      for (long x = tailBegin; x < width; ++x) {
+        values[fullCount] = std::max(values[fullCount], in[x]);
+      }
+      break;
+    }
+    case BinningMode::Median: {
+      const long blockSize = shapeSize(m_block);
+      T* values = m_values.data() + out * blockSize;
+      for (long o = 0; o < fullCount; ++o) {
+        std::copy(in + o * k, in + o * k + k, values + o * blockSize + counts[o]);
+      }
+      std::copy(in + tailBegin, in + width, values + fullCount * blockSize + counts[fullCount]);
+      break;
+    }
+  }
+  for (long o = 0; o < fullCount; ++o) {
+    counts[o] += k;
+  }
+  if (tailBegin < width) {
+    counts[fullCount] += width - tailBegin;
+  }
+}
+
+template <typename T, long n>
+void Binner<T, n>::finalize(long index) {
+  T* out = m_raster.data() + index * m_planeSize;
+  switch (m_mode) {
+    case BinningMode::Sum:
+      convertTo(m_sums.data(), m_planeSize, out, OverflowPolicy::Saturate);
+      break;
+    case BinningMode::Mean:
+      for (long i = 0; i < m_planeSize; ++i) {
+        m_sums[i] /= m_counts[i];
+      }
+      if (std::is_integral<T>::value) {
+        for (long i = 0; i < m_planeSize; ++i) {
+          m_sums[i] = std::round(m_sums[i]);
+        }
+      }
+      convertTo(m_sums.data(), m_planeSize, out, OverflowPolicy::Saturate);
+      break;
+    case BinningMode::Min:
+    case BinningMode::Max:
+      std::copy(m_values.begin(), m_values.end(), out);
+      break;
+    case BinningMode::Median: {
+      const long blockSize = shapeSize(m_block);
+      for (long i = 0; i < m_planeSize; ++i) {
+        T* values = m_values.data() + i * blockSize;
+        T* median = values + (m_counts[i] - 1) / 2;
+        std::nth_element(values, median, values + m_counts[i]);
+        out[i] = *median;
+      }
+      break;
+    }
+  }
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
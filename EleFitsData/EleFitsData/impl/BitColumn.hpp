@@ -0,0 +1,87 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITSDATA_BITCOLUMN_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFitsData/BitColumn.h"
+
+namespace Euclid {
+namespace Fits {
+
+template <typename T>
+void packBits(const T* values, long count, unsigned char* bytes) {
+  const long fullCount = count / 8;
+  for (long b = 0; b < fullCount; ++b) {
+    const T* in = values + b * 8;
+    std::uint64_t word = 0; // One value per byte, first value in the least significant byte
+    for (int j = 0; j < 8; ++j) {
+      word |= std::uint64_t(in[j] != 0) << (j * 8);
+    }
+    // Gather the 8 bits in the most significant byte, first value as the most significant bit
+    bytes[b] = static_cast<unsigned char>((word * 0x8040201008040201ULL) >> 56);
+  }
+  if (count % 8 != 0) {
+    unsigned char last = 0;
+    for (long i = fullCount * 8; i < count; ++i) {
+      last |= static_cast<unsigned char>((values[i] != 0) << (7 - i % 8));
+    }
+    bytes[fullCount] = last;
+  }
+}
+
+template <typename T>
+void unpackBits(const unsigned char* bytes, long count, T* values) {
+  for (long i = 0; i < count; ++i) {
+    values[i] = static_cast<T>((bytes[i / 8] >> (7 - i % 8)) & 1);
+  }
+}
+
+template <typename T>
+BitColumn::BitColumn(const ColumnInfo<bool>& info, long rowCount, const T* values) : BitColumn(info, rowCount) {
+  packFrom(values);
+}
+
+template <typename T>
+void BitColumn::unpackTo(T* values) const {
+  const long byteCount = info().repeatCount;
+  if (m_bitCount == byteCount * 8) { // No padding
+    unpackBits(data(), rowCount() * m_bitCount, values);
+    return;
+  }
+  for (long row = 0; row < rowCount(); ++row) {
+    unpackBits(data() + row * byteCount, m_bitCount, values + row * m_bitCount);
+  }
+}
+
+template <typename T>
+void BitColumn::packFrom(const T* values) {
+  const long byteCount = info().repeatCount;
+  if (m_bitCount == byteCount * 8) { // No padding
+    packBits(values, rowCount() * m_bitCount, data());
+    return;
+  }
+  for (long row = 0; row < rowCount(); ++row) {
+    packBits(values + row * m_bitCount, m_bitCount, data() + row * byteCount);
+  }
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
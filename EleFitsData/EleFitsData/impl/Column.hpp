@@ -152,38 +152,38 @@ const T* PtrColumn<T>::dataImpl() const {
 
 // VecColumn
 
-template <typename T>
-VecColumn<T>::VecColumn() : Column<T>({ "", "", 1 }), m_vec() {}
+template <typename T, typename TAllocator>
+VecColumn<T, TAllocator>::VecColumn() : Column<T>({ "", "", 1 }), m_vec() {}
 
-template <typename T>
-VecColumn<T>::VecColumn(ColumnInfo<std::decay_t<T>> info, std::vector<T> vec) :
-    Column<T>(info), m_vec(vec) {}
+template <typename T, typename TAllocator>
+VecColumn<T, TAllocator>::VecColumn(ColumnInfo<std::decay_t<T>> info, Container vec) :
+    Column<T>(info), m_vec(std::move(vec)) {}
 
-template <typename T>
-VecColumn<T>::VecColumn(ColumnInfo<std::decay_t<T>> info, long rowCount) :
+template <typename T, typename TAllocator>
+VecColumn<T, TAllocator>::VecColumn(ColumnInfo<std::decay_t<T>> info, long rowCount) :
     Column<T>(info), m_vec(info.repeatCount * rowCount) {}
 
 template <>
 VecColumn<std::string>::VecColumn(ColumnInfo<std::string> info, long rowCount);
 
-template <typename T>
-const std::vector<T>& VecColumn<T>::vector() const {
+template <typename T, typename TAllocator>
+const typename VecColumn<T, TAllocator>::Container& VecColumn<T, TAllocator>::vector() const {
   return m_vec;
 }
 
-template <typename T>
-std::vector<std::decay_t<T>>& VecColumn<T>::moveTo(std::vector<std::decay_t<T>>& destination) {
+template <typename T, typename TAllocator>
+typename VecColumn<T, TAllocator>::Container& VecColumn<T, TAllocator>::moveTo(Container& destination) {
   destination = std::move(m_vec);
   return destination;
 }
 
-template <typename T>
-long VecColumn<T>::elementCountImpl() const {
+template <typename T, typename TAllocator>
+long VecColumn<T, TAllocator>::elementCountImpl() const {
   return m_vec.size();
 }
 
-template <typename T>
-const T* VecColumn<T>::dataImpl() const {
+template <typename T, typename TAllocator>
+const T* VecColumn<T, TAllocator>::dataImpl() const {
   return m_vec.data();
 }
 
@@ -0,0 +1,92 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITSDATA_COLUMNARENA_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFitsData/ColumnArena.h"
+  #include "EleFitsData/FitsError.h"
+
+  #include <utility> // move
+
+namespace Euclid {
+namespace Fits {
+
+// ColumnArena
+
+template <typename T>
+std::size_t ColumnArena::footprint(const ColumnInfo<T>& info, long rowCount) {
+  const std::size_t bytes = sizeof(T) * info.repeatCount * rowCount;
+  return (bytes + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+PtrColumn<T> ColumnArena::carve(const ColumnInfo<T>& info, long rowCount) {
+  static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be stored in an arena");
+  const auto bytes = footprint(info, rowCount);
+  if (m_size + bytes > m_buffer.size()) {
+    throw FitsError("Cannot carve column " + info.name + ": arena capacity exceeded");
+  }
+  auto* data = reinterpret_cast<T*>(m_buffer.data() + m_size);
+  m_size += bytes;
+  return PtrColumn<T>(info, info.repeatCount * rowCount, data);
+}
+
+// ArenaTable
+
+template <typename... Ts>
+ArenaTable<Ts...>::ArenaTable(ColumnArena arena, long rowCount, const ColumnInfo<Ts>&... infos) :
+    m_arena(prepare(std::move(arena), rowCount, infos...)), m_rowCount(rowCount),
+    m_columns { m_arena.carve(infos, rowCount)... } {}
+
+template <typename... Ts>
+long ArenaTable<Ts...>::rowCount() const {
+  return m_rowCount;
+}
+
+template <typename... Ts>
+const std::tuple<PtrColumn<Ts>...>& ArenaTable<Ts...>::columns() const {
+  return m_columns;
+}
+
+template <typename... Ts>
+std::tuple<PtrColumn<Ts>...>& ArenaTable<Ts...>::columns() {
+  return m_columns;
+}
+
+template <typename... Ts>
+ColumnArena ArenaTable<Ts...>::release() {
+  m_rowCount = 0;
+  return std::move(m_arena);
+}
+
+template <typename... Ts>
+ColumnArena ArenaTable<Ts...>::prepare(ColumnArena arena, long rowCount, const ColumnInfo<Ts>&... infos) {
+  std::size_t capacity = 0;
+  for (auto bytes : { std::size_t(0), ColumnArena::footprint(infos, rowCount)... }) {
+    capacity += bytes;
+  }
+  arena.clear();
+  arena.reserve(capacity);
+  return arena;
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
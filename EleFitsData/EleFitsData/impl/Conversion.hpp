@@ -0,0 +1,231 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITSDATA_CONVERSION_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFitsData/Conversion.h"
+
+  #include <cmath> // abs, ldexp
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Check whether a type is an `std::complex`.
+ */
+template <typename T>
+struct IsComplex : std::false_type {};
+
+/**
+ * @brief `std::complex` specialization.
+ */
+template <typename T>
+struct IsComplex<std::complex<T>> : std::true_type {};
+
+/**
+ * @brief Check whether a value is negative without warning for unsigned types.
+ */
+template <typename T>
+constexpr bool isNegative(T value, std::true_type) {
+  return value < T(0);
+}
+
+/**
+ * @brief Unsigned case.
+ */
+template <typename T>
+constexpr bool isNegative(T, std::false_type) {
+  return false;
+}
+
+/**
+ * @brief Check whether a value is negative.
+ */
+template <typename T>
+constexpr bool isNegative(T value) {
+  return isNegative(value, std::is_signed<T>());
+}
+
+/**
+ * @brief Conversion which cannot overflow, or which is not checked (e.g. for complex values).
+ */
+template <typename TFrom, typename TTo>
+struct CastConverter {
+
+  /** @brief Whether values may not fit in the destination type. */
+  static constexpr bool mayOverflow = false;
+
+  /** @brief Whether casting a value which does not fit is defined behavior. */
+  static constexpr bool isCastDefined = true;
+
+  /** @brief Check whether a value fits in the destination type. */
+  static bool isValid(TFrom) {
+    return true;
+  }
+
+  /** @brief Saturate a value which does not fit in the destination type. */
+  static TTo saturate(TFrom value) {
+    return static_cast<TTo>(value);
+  }
+};
+
+/**
+ * @brief Conversion between integers.
+ * @details
+ * A value fits if it survives the round trip and keeps its sign.
+ */
+template <typename TFrom, typename TTo>
+struct IntegerConverter {
+
+  /** @brief Whether values may not fit in the destination type. */
+  static constexpr bool mayOverflow =
+      std::numeric_limits<TFrom>::digits > std::numeric_limits<TTo>::digits ||
+      (std::is_signed<TFrom>::value && not std::is_signed<TTo>::value);
+
+  /** @brief Whether casting a value which does not fit is defined behavior (modular or implementation-defined). */
+  static constexpr bool isCastDefined = true;
+
+  /** @brief Check whether a value fits in the destination type. */
+  static bool isValid(TFrom value) {
+    const auto cast = static_cast<TTo>(value);
+    return static_cast<TFrom>(cast) == value && isNegative(value) == isNegative(cast);
+  }
+
+  /** @brief Saturate a value which does not fit in the destination type. */
+  static TTo saturate(TFrom value) {
+    return isNegative(value) ? std::numeric_limits<TTo>::lowest() : std::numeric_limits<TTo>::max();
+  }
+};
+
+/**
+ * @brief Conversion from floating point to integer.
+ * @details
+ * A value fits if its truncation fits; NaNs do not fit.
+ */
+template <typename TFrom, typename TTo>
+struct FloatToIntegerConverter {
+
+  /** @brief Whether values may not fit in the destination type. */
+  static constexpr bool mayOverflow = true;
+
+  /** @brief Whether casting a value which does not fit is defined behavior (it is not, e.g. for NaNs). */
+  static constexpr bool isCastDefined = false;
+
+  /** @brief Check whether a value fits in the destination type. */
+  static bool isValid(TFrom value) {
+    static const TFrom upper = std::ldexp(TFrom(1), std::numeric_limits<TTo>::digits); // Excluded
+    static const TFrom lower = std::is_signed<TTo>::value ? -upper : TFrom(-1); // Included if signed
+    const bool aboveLower = std::is_signed<TTo>::value ? value >= lower : value > lower;
+    return aboveLower && value < upper;
+  }
+
+  /** @brief Saturate a value which does not fit in the destination type. */
+  static TTo saturate(TFrom value) {
+    return value < 0 ? std::numeric_limits<TTo>::lowest() : (value > 0 ? std::numeric_limits<TTo>::max() : TTo(0));
+  }
+};
+
+/**
+ * @brief Conversion between floating points.
+ * @details
+ * Infinite values and NaNs are propagated.
+ */
+template <typename TFrom, typename TTo>
+struct FloatConverter {
+
+  /** @brief Whether values may not fit in the destination type. */
+  static constexpr bool mayOverflow = std::numeric_limits<TFrom>::max_exponent > std::numeric_limits<TTo>::max_exponent;
+
+  /** @brief Whether casting a value which does not fit is defined behavior, i.e. yields an infinity. */
+  static constexpr bool isCastDefined = std::numeric_limits<TTo>::is_iec559;
+
+  /** @brief Check whether a value fits in the destination type. */
+  static bool isValid(TFrom value) {
+    const auto magnitude = std::abs(value);
+    return not(magnitude > std::numeric_limits<TTo>::max()) || magnitude == std::numeric_limits<TFrom>::infinity();
+  }
+
+  /** @brief Saturate a value which does not fit in the destination type. */
+  static TTo saturate(TFrom value) {
+    return value < 0 ? std::numeric_limits<TTo>::lowest() : std::numeric_limits<TTo>::max();
+  }
+};
+
+/**
+ * @brief Select the converter according to the types.
+ */
+template <typename TFrom, typename TTo>
+using Converter = std::conditional_t<
+    std::is_integral<TFrom>::value && std::is_integral<TTo>::value,
+    IntegerConverter<TFrom, TTo>,
+    std::conditional_t<
+        std::is_floating_point<TFrom>::value && std::is_integral<TTo>::value,
+        FloatToIntegerConverter<TFrom, TTo>,
+        std::conditional_t<
+            std::is_floating_point<TFrom>::value && std::is_floating_point<TTo>::value,
+            FloatConverter<TFrom, TTo>,
+            CastConverter<TFrom, TTo>>>>;
+
+template <typename T>
+T* scratch(long size) {
+  thread_local std::vector<T> buffer;
+  if (static_cast<long>(buffer.size()) < size) {
+    buffer.resize(size);
+  }
+  return buffer.data();
+}
+
+} // namespace Internal
+/// @endcond
+
+template <typename TFrom, typename TTo>
+struct IsConvertible :
+    std::integral_constant<
+        bool,
+        (std::is_arithmetic<TFrom>::value && std::is_arithmetic<TTo>::value) ||
+            (Internal::IsComplex<TFrom>::value && Internal::IsComplex<TTo>::value)> {};
+
+template <typename TFrom, typename TTo>
+void convertTo(const TFrom* in, long count, TTo* out, OverflowPolicy policy) {
+  using TConverter = Internal::Converter<TFrom, TTo>;
+  if (not TConverter::mayOverflow || (policy == OverflowPolicy::Unchecked && TConverter::isCastDefined)) {
+    for (long i = 0; i < count; ++i) {
+      out[i] = static_cast<TTo>(in[i]);
+    }
+    return;
+  }
+  long overflowCount = 0;
+  for (long i = 0; i < count; ++i) {
+    const auto value = in[i];
+    const bool valid = TConverter::isValid(value);
+    overflowCount += not valid;
+    out[i] = valid ? static_cast<TTo>(value) : TConverter::saturate(value);
+  }
+  if (overflowCount > 0 && policy == OverflowPolicy::Throw) {
+    throw OverflowError(overflowCount);
+  }
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
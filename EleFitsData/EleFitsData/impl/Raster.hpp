@@ -275,25 +275,26 @@ const T* PtrRaster<T, n>::dataImpl() const {
 
 // VecRaster
 
-template <typename T, long n>
-VecRaster<T, n>::VecRaster(Position<n> rasterShape, std::vector<std::decay_t<T>> vec) :
+template <typename T, long n, typename TAllocator>
+VecRaster<T, n, TAllocator>::VecRaster(Position<n> rasterShape, Container vec) :
     Raster<T, n>(rasterShape), m_vec(vec) {}
 
-template <typename T, long n>
-VecRaster<T, n>::VecRaster(Position<n> rasterShape) : Raster<T, n>(rasterShape), m_vec(shapeSize(rasterShape)) {}
+template <typename T, long n, typename TAllocator>
+VecRaster<T, n, TAllocator>::VecRaster(Position<n> rasterShape) :
+    Raster<T, n>(rasterShape), m_vec(shapeSize(rasterShape)) {}
 
-template <typename T, long n>
-const T* VecRaster<T, n>::dataImpl() const {
+template <typename T, long n, typename TAllocator>
+const T* VecRaster<T, n, TAllocator>::dataImpl() const {
   return m_vec.data();
 }
 
-template <typename T, long n>
-const std::vector<std::decay_t<T>>& VecRaster<T, n>::vector() const {
+template <typename T, long n, typename TAllocator>
+const typename VecRaster<T, n, TAllocator>::Container& VecRaster<T, n, TAllocator>::vector() const {
   return m_vec;
 }
 
-template <typename T, long n>
-std::vector<std::decay_t<T>>& VecRaster<T, n>::moveTo(std::vector<std::decay_t<T>>& destination) {
+template <typename T, long n, typename TAllocator>
+typename VecRaster<T, n, TAllocator>::Container& VecRaster<T, n, TAllocator>::moveTo(Container& destination) {
   destination = std::move(m_vec);
   return destination;
 }
@@ -0,0 +1,245 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITSDATA_SCALING_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFitsData/Scaling.h"
+
+  #include <cstring> // memcpy
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief The unsigned integer type of given size in bytes.
+ */
+template <std::size_t size>
+struct UintOfSize;
+
+/**
+ * @brief 8-bit specialization.
+ */
+template <>
+struct UintOfSize<1> {
+  using Type = std::uint8_t;
+};
+
+/**
+ * @brief 16-bit specialization.
+ */
+template <>
+struct UintOfSize<2> {
+  using Type = std::uint16_t;
+};
+
+/**
+ * @brief 32-bit specialization.
+ */
+template <>
+struct UintOfSize<4> {
+  using Type = std::uint32_t;
+};
+
+/**
+ * @brief 64-bit specialization.
+ */
+template <>
+struct UintOfSize<8> {
+  using Type = std::uint64_t;
+};
+
+/**
+ * @brief Check whether `TRaw` and `T` are integers of the same size and opposite signedness.
+ */
+template <typename TRaw, typename T>
+struct IsSignBitFlippable :
+    std::integral_constant<
+        bool,
+        std::is_integral<TRaw>::value && std::is_integral<T>::value && sizeof(TRaw) == sizeof(T) &&
+            std::is_signed<TRaw>::value != std::is_signed<T>::value> {};
+
+/**
+ * @brief The offset which corresponds to flipping the sign bit of an integer of given size.
+ */
+template <typename T>
+constexpr double signBitOffset() {
+  return static_cast<double>(typename UintOfSize<sizeof(T)>::Type(1) << (sizeof(T) * 8 - 1));
+}
+
+/**
+ * @brief Load a big-endian value.
+ * @details
+ * The shift-or sequence is recognized as a byte swap by the compilers,
+ * and vectorized when used in a loop.
+ */
+template <typename TRaw>
+inline TRaw loadBigEndian(const unsigned char* bytes) {
+  using U = typename UintOfSize<sizeof(TRaw)>::Type;
+  U u = 0;
+  for (std::size_t i = 0; i < sizeof(TRaw); ++i) {
+    u = static_cast<U>((u << 8) | bytes[i]);
+  }
+  TRaw raw;
+  std::memcpy(&raw, &u, sizeof(TRaw));
+  return raw;
+}
+
+/**
+ * @brief Store a value as big-endian.
+ * @see loadBigEndian
+ */
+template <typename T>
+inline void storeBigEndian(typename UintOfSize<sizeof(T)>::Type u, unsigned char* bytes) {
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    bytes[i] = static_cast<unsigned char>(u >> ((sizeof(T) - 1 - i) * 8));
+  }
+}
+
+/**
+ * @brief Flip the sign bit of each loaded value.
+ */
+template <typename TRaw, typename T, typename TLoad>
+void flipSignBitTo(long count, T* out, TLoad&& load, std::true_type) {
+  using U = typename UintOfSize<sizeof(T)>::Type;
+  constexpr U signBit = U(1) << (sizeof(T) * 8 - 1);
+  for (long i = 0; i < count; ++i) {
+    out[i] = static_cast<T>(static_cast<U>(load(i)) ^ signBit);
+  }
+}
+
+/**
+ * @brief Non-integer case (never called).
+ */
+template <typename TRaw, typename T, typename TLoad>
+void flipSignBitTo(long, T*, TLoad&&, std::false_type) {}
+
+/**
+ * @brief Apply a scaling to loaded values.
+ * @details
+ * The specialization is selected once, outside the loops, so that each loop is branch-free.
+ */
+template <typename TRaw, typename T, typename TLoad>
+void transformTo(long count, const Scaling& scaling, T* out, TLoad&& load) {
+  if (scaling.isSignBitFlip<TRaw, T>()) {
+    flipSignBitTo<TRaw>(count, out, load, IsSignBitFlippable<TRaw, T>());
+    return;
+  }
+  if (scaling.isIdentity()) {
+    for (long i = 0; i < count; ++i) {
+      out[i] = static_cast<T>(load(i));
+    }
+    return;
+  }
+  const double scale = scaling.scale;
+  const double offset = scaling.offset;
+  for (long i = 0; i < count; ++i) {
+    out[i] = static_cast<T>(load(i) * scale + offset);
+  }
+}
+
+} // namespace Internal
+/// @endcond
+
+template <typename T>
+Scaling Scaling::forType() {
+  return identity();
+}
+
+/**
+ * @brief `char` specialization.
+ */
+template <>
+inline Scaling Scaling::forType<char>() {
+  return { 1., -128. };
+}
+
+/**
+ * @brief `std::uint16_t` specialization.
+ */
+template <>
+inline Scaling Scaling::forType<std::uint16_t>() {
+  return { 1., Internal::signBitOffset<std::uint16_t>() };
+}
+
+/**
+ * @brief `std::uint32_t` specialization.
+ */
+template <>
+inline Scaling Scaling::forType<std::uint32_t>() {
+  return { 1., Internal::signBitOffset<std::uint32_t>() };
+}
+
+/**
+ * @brief `std::uint64_t` specialization.
+ */
+template <>
+inline Scaling Scaling::forType<std::uint64_t>() {
+  return { 1., Internal::signBitOffset<std::uint64_t>() };
+}
+
+template <typename TRaw, typename T>
+bool Scaling::isSignBitFlip() const {
+  if (not Internal::IsSignBitFlippable<TRaw, T>::value || scale != 1.) {
+    return false;
+  }
+  const double expected = Internal::signBitOffset<TRaw>();
+  return std::is_signed<TRaw>::value ? offset == expected : offset == -expected;
+}
+
+template <typename TRaw, typename T>
+T Scaling::apply(TRaw raw) const {
+  T out;
+  Internal::transformTo<TRaw>(1, *this, &out, [&](long) {
+    return raw;
+  });
+  return out;
+}
+
+template <typename TRaw, typename T>
+void scaleTo(const TRaw* raw, long count, const Scaling& scaling, T* out) {
+  Internal::transformTo<TRaw>(count, scaling, out, [=](long i) {
+    return raw[i];
+  });
+}
+
+template <typename TRaw, typename T>
+void decodeScaledTo(const unsigned char* bigEndian, long count, const Scaling& scaling, T* out) {
+  Internal::transformTo<TRaw>(count, scaling, out, [=](long i) {
+    return Internal::loadBigEndian<TRaw>(bigEndian + i * sizeof(TRaw));
+  });
+}
+
+template <typename T>
+void encodeScaledTo(const T* values, long count, unsigned char* bigEndian) {
+  using U = typename Internal::UintOfSize<sizeof(T)>::Type;
+  const U signBit = Scaling::forType<T>().isIdentity() ? U(0) : static_cast<U>(U(1) << (sizeof(T) * 8 - 1));
+  for (long i = 0; i < count; ++i) {
+    U u;
+    std::memcpy(&u, values + i, sizeof(T));
+    Internal::storeBigEndian<T>(static_cast<U>(u ^ signBit), bigEndian + i * sizeof(T));
+  }
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITSDATA_VLACOLUMN_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFitsData/FitsError.h"
+  #include "EleFitsData/VlaColumn.h"
+
+  #include <algorithm> // is_sorted
+
+namespace Euclid {
+namespace Fits {
+
+template <typename T>
+VlaColumn<T>::VlaColumn(std::string name, std::string unit) :
+    m_name(std::move(name)), m_unit(std::move(unit)), m_offsets(1, 0), m_values() {}
+
+template <typename T>
+VlaColumn<T>::VlaColumn(std::string name, std::string unit, std::vector<long> offsets, std::vector<T> values) :
+    m_name(std::move(name)), m_unit(std::move(unit)), m_offsets(std::move(offsets)), m_values(std::move(values)) {
+  if (m_offsets.empty() || m_offsets.front() != 0 || m_offsets.back() != static_cast<long>(m_values.size()) ||
+      not std::is_sorted(m_offsets.begin(), m_offsets.end())) {
+    throw FitsError("Invalid offsets of variable-length array column: " + m_name);
+  }
+}
+
+template <typename T>
+const std::string& VlaColumn<T>::name() const {
+  return m_name;
+}
+
+template <typename T>
+const std::string& VlaColumn<T>::unit() const {
+  return m_unit;
+}
+
+template <typename T>
+void VlaColumn<T>::rename(const std::string& name) {
+  m_name = name;
+}
+
+template <typename T>
+long VlaColumn<T>::rowCount() const {
+  return m_offsets.size() - 1;
+}
+
+template <typename T>
+long VlaColumn<T>::elementCount() const {
+  return m_values.size();
+}
+
+template <typename T>
+long VlaColumn<T>::size(long row) const {
+  return m_offsets[row + 1] - m_offsets[row];
+}
+
+template <typename T>
+const T* VlaColumn<T>::data(long row) const {
+  return m_values.data() + m_offsets[row];
+}
+
+template <typename T>
+T* VlaColumn<T>::data(long row) {
+  return m_values.data() + m_offsets[row];
+}
+
+template <typename T>
+const std::vector<long>& VlaColumn<T>::offsets() const {
+  return m_offsets;
+}
+
+template <typename T>
+const std::vector<T>& VlaColumn<T>::values() const {
+  return m_values;
+}
+
+template <typename T>
+void VlaColumn<T>::reserve(long rowCount, long elementCount) {
+  m_offsets.reserve(rowCount + 1);
+  m_values.reserve(elementCount);
+}
+
+template <typename T>
+void VlaColumn<T>::append(const T* data, long count) {
+  m_values.insert(m_values.end(), data, data + count);
+  m_offsets.push_back(m_values.size());
+}
+
+template <typename T>
+void VlaColumn<T>::append(const std::vector<T>& row) {
+  append(row.data(), row.size());
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -0,0 +1,75 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/Allocator.h"
+
+#include <cstdlib> // posix_memalign, free
+#include <sys/mman.h> // mmap, munmap, madvise
+
+namespace Euclid {
+namespace Fits {
+namespace Internal {
+
+void* allocateAligned(std::size_t size, std::size_t alignment) {
+  if (alignment < sizeof(void*)) {
+    alignment = sizeof(void*);
+  }
+  void* ptr = nullptr;
+  if (posix_memalign(&ptr, alignment, size ? size : 1) != 0) {
+    return nullptr;
+  }
+  return ptr;
+}
+
+void deallocateAligned(void* ptr) {
+  std::free(ptr);
+}
+
+void* allocateHugePages(std::size_t size) {
+  if (size < hugePageSize) {
+    return allocateAligned(size, cacheLineSize);
+  }
+  const auto rounded = (size + hugePageSize - 1) / hugePageSize * hugePageSize;
+  void* ptr = allocateAligned(rounded, hugePageSize);
+#ifdef MADV_HUGEPAGE
+  if (ptr) {
+    madvise(ptr, rounded, MADV_HUGEPAGE); // Advisory: regular pages are used on failure
+  }
+#endif
+  return ptr;
+}
+
+void deallocateHugePages(void* ptr, std::size_t) {
+  deallocateAligned(ptr);
+}
+
+void* allocateUntouched(std::size_t size) {
+  void* ptr = mmap(nullptr, size ? size : 1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+void deallocateUntouched(void* ptr, std::size_t size) {
+  if (ptr) {
+    munmap(ptr, size ? size : 1);
+  }
+}
+
+} // namespace Internal
+} // namespace Fits
+} // namespace Euclid
@@ -0,0 +1,54 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/BitColumn.h"
+
+namespace Euclid {
+namespace Fits {
+
+BitColumn::BitColumn(const ColumnInfo<bool>& info, long rowCount) :
+    VecColumn<unsigned char>({ info.name, info.unit, (info.repeatCount + 7) / 8 }, rowCount),
+    m_bitCount(info.repeatCount) {}
+
+ColumnInfo<bool> BitColumn::bitInfo() const {
+  return { info().name, info().unit, m_bitCount };
+}
+
+long BitColumn::bitCount() const {
+  return m_bitCount;
+}
+
+bool BitColumn::bit(long row, long index) const {
+  return ((*this)(row, index / 8) >> (7 - index % 8)) & 1;
+}
+
+void BitColumn::setBit(long row, long index, bool value) {
+  auto& byte = (*this)(row, index / 8);
+  const auto mask = static_cast<unsigned char>(1 << (7 - index % 8));
+  byte = static_cast<unsigned char>(value ? (byte | mask) : (byte & ~mask));
+}
+
+std::vector<unsigned char> BitColumn::unpack() const {
+  std::vector<unsigned char> values(rowCount() * m_bitCount);
+  unpackTo(values.data());
+  return values;
+}
+
+} // namespace Fits
+} // namespace Euclid
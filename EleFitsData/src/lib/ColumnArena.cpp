@@ -0,0 +1,51 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/ColumnArena.h"
+
+namespace Euclid {
+namespace Fits {
+
+constexpr std::size_t ColumnArena::alignment;
+
+ColumnArena::ColumnArena(std::size_t capacity) : m_buffer(capacity), m_size(0) {}
+
+std::size_t ColumnArena::size() const {
+  return m_size;
+}
+
+std::size_t ColumnArena::capacity() const {
+  return m_buffer.size();
+}
+
+void ColumnArena::reserve(std::size_t capacity) {
+  if (capacity > m_buffer.size()) {
+    // Reallocate without copying, which is useless as the views are invalidated
+    decltype(m_buffer) buffer(capacity);
+    m_buffer.swap(buffer);
+    m_size = 0;
+  }
+}
+
+void ColumnArena::clear() {
+  m_size = 0;
+}
+
+} // namespace Fits
+} // namespace Euclid
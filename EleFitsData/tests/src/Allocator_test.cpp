@@ -0,0 +1,118 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/Allocator.h"
+#include "EleFitsData/Column.h"
+#include "EleFitsData/Raster.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstdint> // uintptr_t
+#include <vector>
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief Check whether a pointer is aligned.
+ */
+bool isAligned(const void* ptr, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+/**
+ * @brief Fill a raster with given allocator, and check the values.
+ */
+template <typename TAllocator>
+void checkRasterWithAllocator() {
+  VecRaster<float, 2, TAllocator> raster({ 37, 11 });
+  for (long i = 0; i < raster.size(); ++i) {
+    raster.data()[i] = float(i);
+  }
+  const auto copy = raster;
+  for (long i = 0; i < copy.size(); ++i) {
+    BOOST_TEST(copy.data()[i] == float(i));
+  }
+  typename VecRaster<float, 2, TAllocator>::Container destination;
+  raster.moveTo(destination);
+  BOOST_TEST(destination.size() == 37 * 11);
+  BOOST_TEST(destination.back() == float(37 * 11 - 1));
+}
+
+/**
+ * @brief Fill a column with given allocator, and check the values.
+ */
+template <typename TAllocator>
+void checkColumnWithAllocator() {
+  VecColumn<std::int32_t, TAllocator> column({ "COL", "", 3 }, 10);
+  BOOST_TEST(column.elementCount() == 30);
+  for (long i = 0; i < column.elementCount(); ++i) {
+    column.data()[i] = std::int32_t(i);
+  }
+  BOOST_TEST(column.vector().back() == 29);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Allocator_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(aligned_allocator_aligns_buffers_test) {
+  std::vector<char, AlignedAllocator<char>> small(3);
+  BOOST_TEST(isAligned(small.data(), cacheLineSize));
+  std::vector<double, AlignedAllocator<double, 4096>> page(1000);
+  BOOST_TEST(isAligned(page.data(), 4096));
+}
+
+BOOST_AUTO_TEST_CASE(huge_page_allocator_aligns_large_buffers_test) {
+  std::vector<char, HugePageAllocator<char>> small(100);
+  BOOST_TEST(isAligned(small.data(), cacheLineSize));
+  std::vector<char, HugePageAllocator<char>> large(hugePageSize + 1);
+  BOOST_TEST(isAligned(large.data(), hugePageSize));
+  large.back() = 1;
+  BOOST_TEST(large.back() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(first_touch_allocator_provides_zeros_test) {
+  std::vector<std::int64_t, FirstTouchAllocator<std::int64_t>> values(1 << 20);
+  BOOST_TEST(values.front() == 0);
+  BOOST_TEST(values[values.size() / 2] == 0);
+  BOOST_TEST(values.back() == 0);
+  std::vector<std::int64_t, FirstTouchAllocator<std::int64_t>> initialized(10, 42);
+  BOOST_TEST(initialized.back() == 42);
+}
+
+BOOST_AUTO_TEST_CASE(rasters_accept_allocators_test) {
+  checkRasterWithAllocator<std::allocator<float>>();
+  checkRasterWithAllocator<AlignedAllocator<float>>();
+  checkRasterWithAllocator<HugePageAllocator<float>>();
+  checkRasterWithAllocator<FirstTouchAllocator<float>>();
+  VecRaster<float, 2, AlignedAllocator<float>> raster({ 5, 3 });
+  BOOST_TEST(isAligned(raster.data(), cacheLineSize));
+}
+
+BOOST_AUTO_TEST_CASE(columns_accept_allocators_test) {
+  checkColumnWithAllocator<std::allocator<std::int32_t>>();
+  checkColumnWithAllocator<AlignedAllocator<std::int32_t>>();
+  checkColumnWithAllocator<HugePageAllocator<std::int32_t>>();
+  checkColumnWithAllocator<FirstTouchAllocator<std::int32_t>>();
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
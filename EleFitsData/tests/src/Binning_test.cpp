@@ -0,0 +1,163 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/Binning.h"
+#include "EleFitsData/TestRaster.h"
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief Reduce each block pixel by pixel.
+ */
+template <long n>
+VecRaster<double, n> binNaively(const VecRaster<double, n>& raster, const Position<n>& block, BinningMode mode) {
+  auto shape = raster.shape();
+  for (long d = 0; d < n; ++d) {
+    shape[d] = (shape[d] + block[d] - 1) / block[d];
+  }
+  VecRaster<double, n> binned(shape);
+  for (const auto& p : Region<n>::fromShape(Position<n>::zero(), shape)) {
+    Region<n> region { p, p };
+    for (long d = 0; d < n; ++d) {
+      region.front[d] = p[d] * block[d];
+      region.back[d] = std::min(region.front[d] + block[d], raster.shape()[d]) - 1;
+    }
+    std::vector<double> values;
+    for (const auto& q : region) {
+      values.push_back(raster[q]);
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (auto v : values) {
+      sum += v;
+    }
+    switch (mode) {
+      case BinningMode::Sum:
+        binned[p] = sum;
+        break;
+      case BinningMode::Mean:
+        binned[p] = sum / values.size();
+        break;
+      case BinningMode::Min:
+        binned[p] = values.front();
+        break;
+      case BinningMode::Max:
+        binned[p] = values.back();
+        break;
+      case BinningMode::Median:
+        binned[p] = values[(values.size() - 1) / 2];
+        break;
+    }
+  }
+  return binned;
+}
+
+/**
+ * @brief Reduce slab by slab with a `Binner`.
+ */
+template <long n>
+VecRaster<double, n> binBySlabs(const VecRaster<double, n>& raster, const Position<n>& block, BinningMode mode) {
+  Binner<double, n> binner(raster.shape(), block, mode);
+  for (long i = 0; i < binner.slabCount(); ++i) {
+    const auto slab = binner.slab(i);
+    const long offset = raster.index(slab.front);
+    binner.reduce(i, raster.data() + offset);
+  }
+  return binner.raster();
+}
+
+/**
+ * @brief Check all the modes.
+ */
+template <long n>
+void checkAllModes(const Position<n>& shape, const Position<n>& block) {
+  Test::RandomRaster<double, n> raster(shape, -1000., 1000.); // Sums must not overflow
+  for (auto mode : { BinningMode::Sum, BinningMode::Mean, BinningMode::Min, BinningMode::Max, BinningMode::Median }) {
+    const auto expected = binNaively(raster, block, mode);
+    const auto binned = binBySlabs(raster, block, mode);
+    BOOST_TEST(binned.shape() == expected.shape());
+    for (long i = 0; i < binned.size(); ++i) {
+      BOOST_TEST(binned.data()[i] == expected.data()[i], boost::test_tools::tolerance(1e-9));
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Binning_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(complete_blocks_are_reduced_test) {
+  checkAllModes<2>({ 12, 8 }, { 4, 2 });
+}
+
+BOOST_AUTO_TEST_CASE(incomplete_blocks_are_reduced_test) {
+  checkAllModes<2>({ 13, 7 }, { 4, 3 });
+}
+
+BOOST_AUTO_TEST_CASE(cube_blocks_are_reduced_test) {
+  checkAllModes<3>({ 7, 5, 6 }, { 2, 3, 4 });
+}
+
+BOOST_AUTO_TEST_CASE(mean_of_constant_is_constant_test) {
+  VecRaster<float, 2> raster({ 16, 16 });
+  std::fill(raster.data(), raster.data() + raster.size(), 3.F);
+  Binner<float> binner(raster.shape(), { 8, 8 }, BinningMode::Mean);
+  BOOST_TEST(binner.slabCount() == 2);
+  binner.reduce(0, raster.data());
+  binner.reduce(1, raster.data() + 8 * 16);
+  for (long i = 0; i < binner.raster().size(); ++i) {
+    BOOST_TEST(binner.raster().data()[i] == 3.F);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(integer_sum_is_saturated_test) {
+  VecRaster<unsigned char, 2> raster({ 16, 8 });
+  std::fill(raster.data(), raster.data() + raster.size(), 255);
+  Binner<unsigned char> binner(raster.shape(), { 8, 8 }, BinningMode::Sum); // Sum is 16320
+  binner.reduce(0, raster.data());
+  BOOST_TEST(binner.raster().size() == 2);
+  BOOST_TEST(int(binner.raster().data()[0]) == 255);
+  BOOST_TEST(int(binner.raster().data()[1]) == 255);
+}
+
+BOOST_AUTO_TEST_CASE(integer_mean_is_rounded_test) {
+  VecRaster<int, 2> raster({ 4, 1 });
+  const std::vector<int> values { 1, 2, -1, -2 };
+  std::copy(values.begin(), values.end(), raster.data());
+  Binner<int> binner(raster.shape(), { 2, 1 }, BinningMode::Mean);
+  binner.reduce(0, raster.data());
+  BOOST_TEST(binner.raster().data()[0] == 2); // 1.5
+  BOOST_TEST(binner.raster().data()[1] == -2); // -1.5
+}
+
+BOOST_AUTO_TEST_CASE(nonpositive_block_throws_test) {
+  const Position<2> shape { 16, 16 };
+  const Position<2> block { 0, 8 };
+  BOOST_CHECK_THROW(Binner<float>(shape, block, BinningMode::Mean), FitsError);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/BitColumn.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(BitColumn_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(bits_are_packed_most_significant_first_test) {
+  const std::vector<unsigned char> values { 1, 0, 0, 0, 0, 0, 0, 2, 0, 1, 1 };
+  std::vector<unsigned char> bytes(2);
+  packBits(values.data(), values.size(), bytes.data());
+  BOOST_TEST(bytes[0] == 0x81);
+  BOOST_TEST(bytes[1] == 0x60); // Trailing bits are cleared
+  std::vector<unsigned char> unpacked(values.size());
+  unpackBits(bytes.data(), unpacked.size(), unpacked.data());
+  BOOST_TEST(unpacked[7] == 1); // Non-zero values are set bits
+  unpacked[7] = 2;
+  BOOST_TEST(unpacked == values);
+}
+
+BOOST_AUTO_TEST_CASE(packing_is_the_inverse_of_unpacking_test) {
+  const long count = 1000;
+  std::vector<unsigned char> bytes((count + 7) / 8);
+  for (std::size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<unsigned char>(i * 37);
+  }
+  bytes.back() &= 0xFF << (8 - count % 8);
+  bool values[count];
+  unpackBits(bytes.data(), count, values);
+  std::vector<unsigned char> packed(bytes.size());
+  packBits(values, count, packed.data());
+  BOOST_TEST(packed == bytes);
+}
+
+BOOST_AUTO_TEST_CASE(rows_are_padded_to_bytes_test) {
+  const long rowCount = 3;
+  BitColumn column({ "FLAGS", "", 12 }, rowCount);
+  BOOST_TEST(column.info().repeatCount == 2);
+  BOOST_TEST(column.bitInfo().repeatCount == 12);
+  BOOST_TEST(column.rowCount() == rowCount);
+  BOOST_TEST(column.elementCount() == 6);
+  column.setBit(1, 0, true);
+  column.setBit(1, 11, true);
+  BOOST_TEST(column(1, 0) == 0x80);
+  BOOST_TEST(column(1, 1) == 0x10);
+  BOOST_TEST(column.bit(1, 11));
+  BOOST_TEST(not column.bit(1, 10));
+  column.setBit(1, 11, false);
+  BOOST_TEST(column(1, 1) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(column_is_packed_and_unpacked_test) {
+  const long rowCount = 4;
+  const long bitCount = 5;
+  std::vector<unsigned char> values(rowCount * bitCount);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = i % 3 == 0;
+  }
+  BitColumn column({ "FLAGS", "", bitCount }, rowCount, values.data());
+  for (long row = 0; row < rowCount; ++row) {
+    for (long i = 0; i < bitCount; ++i) {
+      BOOST_TEST(column.bit(row, i) == bool(values[row * bitCount + i]));
+    }
+  }
+  BOOST_TEST(column.unpack() == values);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
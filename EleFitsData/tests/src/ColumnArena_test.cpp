@@ -0,0 +1,108 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/ColumnArena.h"
+
+#include <boost/test/unit_test.hpp>
+#include <complex>
+#include <cstdint> // int16_t, uintptr_t
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief Check whether a column starts on a cache line.
+ */
+template <typename T>
+bool isAligned(const Column<T>& column) {
+  return reinterpret_cast<std::uintptr_t>(column.data()) % ColumnArena::alignment == 0;
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ColumnArena_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(footprint_is_padded_to_cache_lines_test) {
+  const ColumnInfo<std::int16_t> scalar { "SCALAR", "", 1 };
+  BOOST_TEST(ColumnArena::footprint(scalar, 1) == 64);
+  BOOST_TEST(ColumnArena::footprint(scalar, 32) == 64);
+  BOOST_TEST(ColumnArena::footprint(scalar, 33) == 128);
+  const ColumnInfo<double> vector { "VECTOR", "", 3 };
+  BOOST_TEST(ColumnArena::footprint(vector, 10) == 256);
+}
+
+BOOST_AUTO_TEST_CASE(columns_are_carved_aligned_and_contiguous_test) {
+  ColumnArena arena(1024);
+  BOOST_TEST(arena.capacity() == 1024);
+  auto a = arena.carve(ColumnInfo<std::int16_t> { "A", "", 1 }, 5);
+  auto b = arena.carve(ColumnInfo<std::complex<float>> { "B", "", 2 }, 5);
+  BOOST_TEST(a.rowCount() == 5);
+  BOOST_TEST(b.rowCount() == 5);
+  BOOST_TEST(b.elementCount() == 10);
+  BOOST_TEST(isAligned(a));
+  BOOST_TEST(isAligned(b));
+  BOOST_TEST(reinterpret_cast<const char*>(b.data()) - reinterpret_cast<const char*>(a.data()) == 64);
+  BOOST_TEST(arena.size() == 64 + 128);
+  BOOST_CHECK_THROW(arena.carve(ColumnInfo<double> { "C", "", 1 }, 1000), FitsError);
+}
+
+BOOST_AUTO_TEST_CASE(cleared_arena_is_reused_test) {
+  ColumnArena arena;
+  arena.reserve(256);
+  const auto* first = arena.carve(ColumnInfo<float> { "A", "", 1 }, 64).data();
+  arena.clear();
+  BOOST_TEST(arena.size() == 0);
+  arena.reserve(128);
+  BOOST_TEST(arena.capacity() == 256);
+  BOOST_TEST(arena.carve(ColumnInfo<float> { "A", "", 1 }, 64).data() == first);
+}
+
+BOOST_AUTO_TEST_CASE(table_arena_is_released_and_reused_test) {
+  ColumnArena arena;
+  const float* data = nullptr;
+  for (long rowCount : { 100, 50, 100 }) {
+    ArenaTable<float, std::int32_t> table(
+        std::move(arena),
+        rowCount,
+        ColumnInfo<float> { "F", "", 1 },
+        ColumnInfo<std::int32_t> { "I", "", 2 });
+    BOOST_TEST(table.rowCount() == rowCount);
+    auto& f = std::get<0>(table.columns());
+    auto& i = std::get<1>(table.columns());
+    BOOST_TEST(f.rowCount() == rowCount);
+    BOOST_TEST(i.elementCount() == 2 * rowCount);
+    BOOST_TEST(isAligned(f));
+    BOOST_TEST(isAligned(i));
+    for (long r = 0; r < rowCount; ++r) {
+      f.data()[r] = float(r);
+    }
+    BOOST_TEST(f.data()[rowCount - 1] == float(rowCount - 1));
+    if (data) {
+      BOOST_TEST(f.data() == data); // No reallocation
+    }
+    data = f.data();
+    arena = table.release();
+  }
+  BOOST_TEST(arena.capacity() == 448 + 832);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
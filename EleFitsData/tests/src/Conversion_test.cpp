@@ -0,0 +1,163 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/Conversion.h"
+#include "EleFitsData/DataUtils.h"
+#include "EleFitsData/Raster.h" // ELEFITS_FOREACH_RASTER_TYPE
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Conversion_test)
+
+//-----------------------------------------------------------------------------
+
+struct ListHead {};
+
+#define LIST_RASTER_TYPE(type, name) , type
+
+using RasterTypes = std::tuple<ListHead ELEFITS_FOREACH_RASTER_TYPE(LIST_RASTER_TYPE)>;
+
+template <typename TFrom>
+struct SmallValueChecker {
+  void operator()(const ListHead&) const {}
+  template <typename TTo>
+  void operator()(const TTo&) const {
+    const std::vector<TFrom> in { 0, 1, 100 };
+    std::vector<TTo> out(in.size());
+    convertTo(in.data(), in.size(), out.data());
+    for (std::size_t i = 0; i < in.size(); ++i) {
+      BOOST_TEST(out[i] == static_cast<TTo>(in[i]));
+    }
+  }
+};
+
+template <typename TFrom>
+void checkSmallValuesAreConverted() {
+  seqForeach(RasterTypes(), SmallValueChecker<TFrom>());
+}
+
+#define SMALL_VALUES_ARE_CONVERTED_TEST(type, name) \
+  BOOST_AUTO_TEST_CASE(name##_small_values_are_converted_test) { \
+    checkSmallValuesAreConverted<type>(); \
+  }
+
+ELEFITS_FOREACH_RASTER_TYPE(SMALL_VALUES_ARE_CONVERTED_TEST)
+
+BOOST_AUTO_TEST_CASE(widening_is_exact_test) {
+  const std::vector<std::int16_t> in { -32768, -1, 0, 32767 };
+  std::vector<float> out(in.size());
+  convertTo(in.data(), in.size(), out.data());
+  BOOST_TEST(out[0] == -32768.f);
+  BOOST_TEST(out[3] == 32767.f);
+}
+
+BOOST_AUTO_TEST_CASE(integer_narrowing_policies_test) {
+  const std::vector<std::int32_t> in { -100000, -1, 0, 100000 };
+  std::vector<std::int16_t> out(in.size());
+  BOOST_CHECK_THROW(convertTo(in.data(), in.size(), out.data()), OverflowError);
+  BOOST_TEST(out[0] == -32768); // Saturated before throwing
+  convertTo(in.data(), in.size(), out.data(), OverflowPolicy::Saturate);
+  BOOST_TEST(out[0] == -32768);
+  BOOST_TEST(out[1] == -1);
+  BOOST_TEST(out[3] == 32767);
+  std::vector<std::uint16_t> unsignedOut(in.size());
+  convertTo(in.data(), in.size(), unsignedOut.data(), OverflowPolicy::Saturate);
+  BOOST_TEST(unsignedOut[0] == 0);
+  BOOST_TEST(unsignedOut[1] == 0);
+  BOOST_TEST(unsignedOut[3] == 65535);
+}
+
+BOOST_AUTO_TEST_CASE(sign_change_is_an_overflow_test) {
+  const std::vector<std::uint16_t> in { 0, 32767, 32768 };
+  std::vector<std::int16_t> out(in.size());
+  try {
+    convertTo(in.data(), in.size(), out.data());
+    BOOST_FAIL("No overflow detected");
+  } catch (const OverflowError& e) {
+    BOOST_TEST(e.count == 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(float_to_integer_truncation_test) {
+  const std::vector<double> in { -1.5, -0.5, 0.5, 254.9, 255.5, std::nan("") };
+  std::vector<unsigned char> out(in.size());
+  convertTo(in.data(), in.size(), out.data(), OverflowPolicy::Saturate);
+  BOOST_TEST(out[0] == 0);
+  BOOST_TEST(out[1] == 0);
+  BOOST_TEST(out[2] == 0);
+  BOOST_TEST(out[3] == 254);
+  BOOST_TEST(out[4] == 255);
+  BOOST_TEST(out[5] == 0);
+  BOOST_CHECK_THROW(convertTo(in.data(), in.size(), out.data()), OverflowError);
+}
+
+BOOST_AUTO_TEST_CASE(unchecked_float_to_integer_saturates_test) {
+  const std::vector<float> in { std::nanf(""), 1.e9f, -1.e9f, 1.5f };
+  std::vector<std::int16_t> out(in.size());
+  BOOST_CHECK_NO_THROW(convertTo(in.data(), in.size(), out.data(), OverflowPolicy::Unchecked));
+  BOOST_TEST(out[0] == 0);
+  BOOST_TEST(out[1] == 32767);
+  BOOST_TEST(out[2] == -32768);
+  BOOST_TEST(out[3] == 1);
+}
+
+BOOST_AUTO_TEST_CASE(int64_bounds_are_exact_test) {
+  const std::vector<double> in { -9223372036854775808., 9223372036854775808. };
+  std::vector<std::int64_t> out(in.size());
+  convertTo(in.data(), in.size(), out.data(), OverflowPolicy::Saturate);
+  BOOST_TEST(out[0] == std::numeric_limits<std::int64_t>::lowest());
+  BOOST_TEST(out[1] == std::numeric_limits<std::int64_t>::max());
+  BOOST_CHECK_NO_THROW(convertTo(in.data(), 1, out.data()));
+  BOOST_CHECK_THROW(convertTo(in.data() + 1, 1, out.data()), OverflowError);
+}
+
+BOOST_AUTO_TEST_CASE(double_to_float_overflow_test) {
+  const std::vector<double> in { 1.e300, -1.e300, std::numeric_limits<double>::infinity(), 1. };
+  std::vector<float> out(in.size());
+  convertTo(in.data(), in.size(), out.data(), OverflowPolicy::Saturate);
+  BOOST_TEST(out[0] == std::numeric_limits<float>::max());
+  BOOST_TEST(out[1] == std::numeric_limits<float>::lowest());
+  BOOST_TEST(out[2] == std::numeric_limits<float>::infinity());
+  BOOST_TEST(out[3] == 1.f);
+}
+
+BOOST_AUTO_TEST_CASE(complex_conversion_test) {
+  BOOST_TEST((IsConvertible<std::complex<double>, std::complex<float>>::value));
+  BOOST_TEST((not IsConvertible<std::complex<double>, double>::value));
+  BOOST_TEST((not IsConvertible<std::string, double>::value));
+  const std::vector<std::complex<float>> in { { 1.f, 2.f } };
+  std::vector<std::complex<double>> out(in.size());
+  convertTo(in.data(), in.size(), out.data());
+  BOOST_TEST(out[0].real() == 1.);
+  BOOST_TEST(out[0].imag() == 2.);
+}
+
+BOOST_AUTO_TEST_CASE(scratch_is_reused_test) {
+  auto* first = Internal::scratch<float>(100);
+  auto* second = Internal::scratch<float>(10);
+  BOOST_TEST(first == second);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
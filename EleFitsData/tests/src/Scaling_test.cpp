@@ -0,0 +1,121 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/Scaling.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Scaling_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(native_types_are_not_scaled_test) {
+  BOOST_TEST(Scaling::forType<unsigned char>().isIdentity());
+  BOOST_TEST(Scaling::forType<std::int16_t>().isIdentity());
+  BOOST_TEST(Scaling::forType<std::int32_t>().isIdentity());
+  BOOST_TEST(Scaling::forType<std::int64_t>().isIdentity());
+  BOOST_TEST(Scaling::forType<float>().isIdentity());
+  BOOST_TEST(Scaling::forType<double>().isIdentity());
+}
+
+BOOST_AUTO_TEST_CASE(unsigned_offsets_are_sign_bit_flips_test) {
+  BOOST_TEST(Scaling::forType<std::uint16_t>().offset == 32768.);
+  BOOST_TEST((Scaling::forType<char>().isSignBitFlip<unsigned char, char>()));
+  BOOST_TEST((Scaling::forType<std::uint16_t>().isSignBitFlip<std::int16_t, std::uint16_t>()));
+  BOOST_TEST((Scaling::forType<std::uint32_t>().isSignBitFlip<std::int32_t, std::uint32_t>()));
+  BOOST_TEST((Scaling::forType<std::uint64_t>().isSignBitFlip<std::int64_t, std::uint64_t>()));
+  BOOST_TEST((not Scaling::forType<std::uint16_t>().isSignBitFlip<std::int16_t, float>()));
+  BOOST_TEST((not Scaling({ 2., 32768. }).isSignBitFlip<std::int16_t, std::uint16_t>()));
+}
+
+BOOST_AUTO_TEST_CASE(sign_bit_flip_matches_affine_transform_test) {
+  const std::vector<std::int16_t> raw { -32768, -1, 0, 1, 32767 };
+  const std::vector<std::uint16_t> expected { 0, 32767, 32768, 32769, 65535 };
+  std::vector<std::uint16_t> output(raw.size());
+  scaleTo(raw.data(), raw.size(), Scaling::forType<std::uint16_t>(), output.data());
+  BOOST_TEST(output == expected);
+}
+
+BOOST_AUTO_TEST_CASE(uint64_offset_is_exact_test) {
+  const std::int64_t raw = 1;
+  const auto value = Scaling::forType<std::uint64_t>().apply<std::int64_t, std::uint64_t>(raw);
+  BOOST_TEST(value == (std::uint64_t(1) << 63) + 1);
+}
+
+BOOST_AUTO_TEST_CASE(affine_transform_is_applied_test) {
+  const std::vector<std::int32_t> raw { -2, 0, 3 };
+  const Scaling scaling { 0.5, 10. };
+  std::vector<double> output(raw.size());
+  scaleTo(raw.data(), raw.size(), scaling, output.data());
+  BOOST_TEST(output[0] == 9.);
+  BOOST_TEST(output[1] == 10.);
+  BOOST_TEST(output[2] == 11.5);
+}
+
+BOOST_AUTO_TEST_CASE(in_place_scaling_test) {
+  std::vector<std::int16_t> data { -32768, 0, 32767 };
+  auto* out = reinterpret_cast<std::uint16_t*>(data.data());
+  scaleTo(data.data(), data.size(), Scaling::forType<std::uint16_t>(), out);
+  BOOST_TEST(out[0] == 0);
+  BOOST_TEST(out[1] == 32768);
+  BOOST_TEST(out[2] == 65535);
+}
+
+BOOST_AUTO_TEST_CASE(big_endian_values_are_decoded_test) {
+  const std::vector<unsigned char> bytes { 0x80, 0x00, 0xFF, 0xFF, 0x00, 0x01 }; // -32768, -1, 1
+  std::vector<std::uint16_t> flipped(3);
+  decodeScaledTo<std::int16_t>(bytes.data(), 3, Scaling::forType<std::uint16_t>(), flipped.data());
+  BOOST_TEST(flipped[0] == 0);
+  BOOST_TEST(flipped[1] == 32767);
+  BOOST_TEST(flipped[2] == 32769);
+  std::vector<float> scaled(3);
+  decodeScaledTo<std::int16_t>(bytes.data(), 3, { 2., 1. }, scaled.data());
+  BOOST_TEST(scaled[0] == -65535.f);
+  BOOST_TEST(scaled[1] == -1.f);
+  BOOST_TEST(scaled[2] == 3.f);
+  std::vector<std::int16_t> identity(3);
+  decodeScaledTo<std::int16_t>(bytes.data(), 3, Scaling::identity(), identity.data());
+  BOOST_TEST(identity[0] == -32768);
+  BOOST_TEST(identity[1] == -1);
+  BOOST_TEST(identity[2] == 1);
+}
+
+BOOST_AUTO_TEST_CASE(encoding_is_the_inverse_of_decoding_test) {
+  const std::vector<std::uint16_t> values { 0, 32767, 32769 };
+  std::vector<unsigned char> bytes(values.size() * sizeof(std::uint16_t));
+  encodeScaledTo(values.data(), values.size(), bytes.data());
+  const std::vector<unsigned char> expected { 0x80, 0x00, 0xFF, 0xFF, 0x00, 0x01 };
+  BOOST_TEST(bytes == expected);
+  const std::vector<double> doubles { -1.5, 0., 3.25e100 };
+  std::vector<unsigned char> doubleBytes(doubles.size() * sizeof(double));
+  encodeScaledTo(doubles.data(), doubles.size(), doubleBytes.data());
+  std::vector<double> decoded(doubles.size());
+  decodeScaledTo<double>(doubleBytes.data(), decoded.size(), Scaling::identity(), decoded.data());
+  BOOST_TEST(decoded == doubles);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
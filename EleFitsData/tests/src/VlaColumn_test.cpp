@@ -0,0 +1,70 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/FitsError.h"
+#include "EleFitsData/VlaColumn.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(VlaColumn_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(empty_column_has_no_rows_test) {
+  VlaColumn<float> column("SPECTRUM", "Jy");
+  BOOST_TEST(column.name() == "SPECTRUM");
+  BOOST_TEST(column.unit() == "Jy");
+  BOOST_TEST(column.rowCount() == 0);
+  BOOST_TEST(column.elementCount() == 0);
+  BOOST_TEST(column.offsets().size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(appended_rows_are_contiguous_test) {
+  VlaColumn<int> column;
+  column.append({ 0, 1 });
+  column.append({});
+  column.append({ 20, 21, 22 });
+  const std::vector<long> offsets { 0, 2, 2, 5 };
+  const std::vector<int> values { 0, 1, 20, 21, 22 };
+  BOOST_TEST(column.rowCount() == 3);
+  BOOST_TEST(column.elementCount() == 5);
+  BOOST_TEST(column.offsets() == offsets);
+  BOOST_TEST(column.values() == values);
+  BOOST_TEST(column.size(1) == 0);
+  BOOST_TEST(column.size(2) == 3);
+  BOOST_TEST(column.data(2)[1] == 21);
+  column.data(2)[1] = 42;
+  BOOST_TEST(column.values()[3] == 42);
+}
+
+BOOST_AUTO_TEST_CASE(offsets_are_checked_test) {
+  BOOST_CHECK_NO_THROW(VlaColumn<int>("OK", "", { 0, 1, 1, 3 }, { 1, 2, 3 }));
+  BOOST_CHECK_THROW(VlaColumn<int>("EMPTY", "", {}, {}), FitsError);
+  BOOST_CHECK_THROW(VlaColumn<int>("FRONT", "", { 1, 3 }, { 1, 2, 3 }), FitsError);
+  BOOST_CHECK_THROW(VlaColumn<int>("BACK", "", { 0, 2 }, { 1, 2, 3 }), FitsError);
+  BOOST_CHECK_THROW(VlaColumn<int>("ORDER", "", { 0, 2, 1, 3 }, { 1, 2, 3 }), FitsError);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
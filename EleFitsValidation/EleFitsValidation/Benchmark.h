@@ -20,15 +20,20 @@
 #ifndef _ELEFITS_VALIDATION_BENCHMARK_H
 #define _ELEFITS_VALIDATION_BENCHMARK_H
 
+#include "EleFits/Header.h"
 #include "EleFitsData/Column.h"
 #include "EleFitsData/DataUtils.h"
 #include "EleFitsData/Raster.h"
+#include "EleFitsData/RecordVec.h"
 #include "EleFitsValidation/Chronometer.h"
 #include "ElementsKernel/Logging.h"
 
 #include <memory>
+#include <string>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace Euclid {
 namespace Fits {
@@ -60,11 +65,33 @@ using BColumns = std::tuple<
  */
 constexpr std::size_t columnCount = std::tuple_size<BColumns>::value;
 
+/**
+ * @brief The record types used for benchmarking.
+ */
+using BRecords = std::tuple<RecordVec<bool>, RecordVec<std::int64_t>, RecordVec<double>, RecordVec<std::string>>;
+
+/**
+ * @brief Generate records of mixed types.
+ * @param count The total number of records
+ * @param stringLength The length of the string values, which are long strings if greater than 68
+ */
+BRecords generateRecords(long count, long stringLength = 100);
+
+/**
+ * @brief Get the keywords of records.
+ */
+std::vector<std::string> recordKeywords(const BRecords& records);
+
 /**
  * @brief The chronometer used for benchmarking.
  */
 using BChronometer = Chronometer<std::chrono::milliseconds>;
 
+/**
+ * @brief The chronometer used for benchmarking header operations, which are much shorter than data operations.
+ */
+using BHeaderChronometer = Chronometer<std::chrono::microseconds>;
+
 /**
  * @brief The exception which is thrown when a test case is not implemented.
  */
@@ -142,6 +169,18 @@ public:
    */
   const BChronometer& readBintables(long first, long count);
 
+  /**
+   * @brief Run the header test cases in new header-only extensions.
+   * @param count The number of HDUs, i.e. the number of times each test case is run
+   * @param records The records
+   * @return The name and chronometer of each test case, in the order of execution
+   * @details
+   * In each HDU, the test cases are run in sequence, each of them starting from the state left by the previous one:
+   * the records are written in each `RecordMode`, parsed in various ways, removed, and written again.
+   * Test cases which are not implemented are skipped.
+   */
+  std::vector<std::pair<std::string, BHeaderChronometer>> benchmarkHeaders(long count, const BRecords& records);
+
   /**
    * @brief Write the given raster in a new image extension.
    * @details
@@ -176,6 +215,71 @@ public:
     throw TestCaseNotImplemented("Read binary table");
   }
 
+  /**
+   * @brief Append a header-only extension, to which the next header test cases apply.
+   * @details
+   * Unlike data test cases, header test cases are timed by `benchmarkHeaders()`.
+   */
+  virtual void initHeader() {
+    throw TestCaseNotImplemented("Init header");
+  }
+
+  /**
+   * @brief Write records with given mode.
+   * @copydetails initHeader
+   */
+  virtual void writeRecords(const BRecords&, RecordMode) {
+    throw TestCaseNotImplemented("Write records");
+  }
+
+  /**
+   * @brief Parse all the records.
+   * @copydetails initHeader
+   */
+  virtual void parseAllRecords() {
+    throw TestCaseNotImplemented("Parse all records");
+  }
+
+  /**
+   * @brief Parse the given records.
+   * @copydetails initHeader
+   */
+  virtual void parseRecords(const BRecords&) {
+    throw TestCaseNotImplemented("Parse records");
+  }
+
+  /**
+   * @brief Parse the given records if they exist, or return fallbacks.
+   * @copydetails initHeader
+   */
+  virtual void parseRecordsOr(const BRecords&) {
+    throw TestCaseNotImplemented("Parse records or fallbacks");
+  }
+
+  /**
+   * @brief Read all the keywords and values as strings.
+   * @copydetails initHeader
+   */
+  virtual void readKeywordsValues() {
+    throw TestCaseNotImplemented("Read keywords and values");
+  }
+
+  /**
+   * @brief Check whether the given keywords exist.
+   * @copydetails initHeader
+   */
+  virtual void hasKeywords(const std::vector<std::string>&) {
+    throw TestCaseNotImplemented("Has keywords");
+  }
+
+  /**
+   * @brief Remove the given records.
+   * @copydetails initHeader
+   */
+  virtual void removeRecords(const std::vector<std::string>&) {
+    throw TestCaseNotImplemented("Remove records");
+  }
+
 protected:
   /** @brief The file name. */
   std::string m_filename;
@@ -0,0 +1,158 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_VALIDATION_BENCHMARKSUITE_H
+#define _ELEFITS_VALIDATION_BENCHMARKSUITE_H
+
+#include "EleFitsValidation/Chronometer.h"
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+namespace Test {
+
+/**
+ * @brief The chronometer used for latency measurements.
+ */
+using LatencyChronometer = Chronometer<std::chrono::microseconds>;
+
+/**
+ * @brief The parameters of a benchmark case, e.g. `{ { "rows", 1000 }, { "chunk", 16 } }`.
+ */
+using BenchmarkParameters = std::vector<std::pair<std::string, long>>;
+
+/**
+ * @brief The measurements of a benchmark case.
+ */
+struct BenchmarkResult {
+
+  /**
+   * @brief The case name, e.g. `image.region.read`.
+   */
+  std::string name;
+
+  /**
+   * @brief The case parameters.
+   */
+  BenchmarkParameters parameters;
+
+  /**
+   * @brief The number of bytes moved per iteration.
+   */
+  long byteCount;
+
+  /**
+   * @brief The latencies of the iterations, in microseconds.
+   */
+  std::vector<double> latencies;
+
+  /**
+   * @brief Get a quantile of the latencies, e.g. 0.5 for the median, by linear interpolation.
+   */
+  double quantile(double q) const;
+
+  /**
+   * @brief Get the mean latency, in microseconds.
+   */
+  double mean() const;
+
+  /**
+   * @brief Get the throughput based on the mean latency, in MB/s.
+   */
+  double throughput() const;
+};
+
+/**
+ * @brief A suite of parameterized benchmark cases, which are timed iteration-wise and reported as JSON.
+ * @details
+ * Each case is a function which performs one iteration and returns the number of bytes it moved.
+ * Setup should be done outside of the function, such that only the I/O is timed.
+ * Some warm-up iterations are run before the timed ones.
+ *
+ * Example usage:
+ * \code
+ * BenchmarkSuite suite(10);
+ * suite.run("image.read", { { "pixels", raster.size() } }, [&]() {
+ *   return hdu.raster().read<float>().size() * sizeof(float);
+ * });
+ * suite.writeJson("/tmp/benchmark.json");
+ * \endcode
+ */
+class BenchmarkSuite {
+
+public:
+  /**
+   * @brief The function which performs an iteration and returns the number of bytes moved.
+   */
+  using Iteration = std::function<long()>;
+
+  /**
+   * @brief Constructor.
+   * @param iterationCount The number of timed iterations per case
+   * @param warmupCount The number of untimed iterations per case
+   */
+  explicit BenchmarkSuite(long iterationCount = 10, long warmupCount = 1);
+
+  /**
+   * @brief Run a case and store its result.
+   */
+  const BenchmarkResult& run(const std::string& name, const BenchmarkParameters& parameters, const Iteration& iteration);
+
+  /**
+   * @brief Get the results of the cases which were run.
+   */
+  const std::vector<BenchmarkResult>& results() const;
+
+  /**
+   * @brief Write the results as JSON.
+   */
+  void writeJson(std::ostream& out) const;
+
+  /**
+   * @brief Write the results as JSON in a file.
+   */
+  void writeJson(const std::string& filename) const;
+
+private:
+  /**
+   * @brief The number of timed iterations.
+   */
+  long m_iterationCount;
+
+  /**
+   * @brief The number of warm-up iterations.
+   */
+  long m_warmupCount;
+
+  /**
+   * @brief The results.
+   */
+  std::vector<BenchmarkResult> m_results;
+};
+
+} // namespace Test
+} // namespace Fits
+} // namespace Euclid
+
+#endif
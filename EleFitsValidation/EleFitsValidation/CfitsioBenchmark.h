@@ -85,6 +85,48 @@ public:
    */
   virtual BColumns readBintable(long index) override;
 
+  /**
+   * @copybrief Benchmark::initHeader
+   */
+  virtual void initHeader() override;
+
+  /**
+   * @copybrief Benchmark::writeRecords
+   */
+  virtual void writeRecords(const BRecords& records, RecordMode mode) override;
+
+  /**
+   * @copybrief Benchmark::parseAllRecords
+   * @details
+   * Cards are read one-by-one and parsed according to their value type.
+   */
+  virtual void parseAllRecords() override;
+
+  /**
+   * @copybrief Benchmark::parseRecords
+   */
+  virtual void parseRecords(const BRecords& records) override;
+
+  /**
+   * @copybrief Benchmark::parseRecordsOr
+   */
+  virtual void parseRecordsOr(const BRecords& records) override;
+
+  /**
+   * @copybrief Benchmark::readKeywordsValues
+   */
+  virtual void readKeywordsValues() override;
+
+  /**
+   * @copybrief Benchmark::hasKeywords
+   */
+  virtual void hasKeywords(const std::vector<std::string>& keywords) override;
+
+  /**
+   * @copybrief Benchmark::removeRecords
+   */
+  virtual void removeRecords(const std::vector<std::string>& keywords) override;
+
 private:
   /**
    * @brief Get or compute the row chunk size.
@@ -129,6 +171,49 @@ private:
   template <std::size_t i>
   void readColumn(BColumns& columns, long firstRow, long rowCount);
 
+  /**
+   * @brief Check whether a keyword exists.
+   */
+  bool hasKeyword(const std::string& keyword);
+
+  /**
+   * @brief Throw if a keyword exists or not, according to the record mode.
+   * @return True if the record should be deleted before being written
+   */
+  bool checkKeyword(const std::string& keyword, RecordMode mode);
+
+  /**
+   * @brief Write a numeric record.
+   */
+  template <typename T>
+  void writeRecord(const Record<T>& record, RecordMode mode);
+
+  /**
+   * @brief Write a Boolean record.
+   */
+  void writeRecord(const Record<bool>& record, RecordMode mode);
+
+  /**
+   * @brief Write a string record, which may be a long string.
+   */
+  void writeRecord(const Record<std::string>& record, RecordMode mode);
+
+  /**
+   * @brief Parse a numeric record, and optionally return the fallback value if it does not exist.
+   */
+  template <typename T>
+  T parseRecord(const Record<T>& fallback, bool useFallback);
+
+  /**
+   * @brief Parse a Boolean record.
+   */
+  bool parseRecord(const Record<bool>& fallback, bool useFallback);
+
+  /**
+   * @brief Parse a string record, which may be a long string.
+   */
+  std::string parseRecord(const Record<std::string>& fallback, bool useFallback);
+
 private:
   /** @brief The Fits file. */
   fitsfile* m_fptr;
@@ -70,6 +70,46 @@ public:
    */
   virtual BColumns readBintable(long index) override;
 
+  /**
+   * @copybrief Benchmark::initHeader
+   */
+  virtual void initHeader() override;
+
+  /**
+   * @copybrief Benchmark::writeRecords
+   */
+  virtual void writeRecords(const BRecords& records, RecordMode mode) override;
+
+  /**
+   * @copybrief Benchmark::parseAllRecords
+   */
+  virtual void parseAllRecords() override;
+
+  /**
+   * @copybrief Benchmark::parseRecords
+   */
+  virtual void parseRecords(const BRecords& records) override;
+
+  /**
+   * @copybrief Benchmark::parseRecordsOr
+   */
+  virtual void parseRecordsOr(const BRecords& records) override;
+
+  /**
+   * @copybrief Benchmark::readKeywordsValues
+   */
+  virtual void readKeywordsValues() override;
+
+  /**
+   * @copybrief Benchmark::hasKeywords
+   */
+  virtual void hasKeywords(const std::vector<std::string>& keywords) override;
+
+  /**
+   * @copybrief Benchmark::removeRecords
+   */
+  virtual void removeRecords(const std::vector<std::string>& keywords) override;
+
 protected:
   /**
    * @brief The type and index of the i-th column.
@@ -77,11 +117,22 @@ protected:
   template <long i>
   Indexed<typename std::tuple_element<i, BColumns>::type::Value> colIndexed() const;
 
+  /**
+   * @brief Write records with given mode.
+   */
+  template <RecordMode Mode>
+  void writeRecordsWithMode(const BRecords& records);
+
 protected:
   /**
    * @brief The MEF file handler.
    */
   MefFile m_f;
+
+  /**
+   * @brief The header of the last header-only extension.
+   */
+  const Header* m_header;
 };
 
 /**
@@ -87,6 +87,40 @@ void CfitsioBenchmark::readColumn(BColumns& columns, long firstRow, long rowCoun
   mayThrow("Cannot read column");
 }
 
+template <typename T>
+void CfitsioBenchmark::writeRecord(const Record<T>& record, RecordMode mode) {
+  T value = record.value;
+  std::string comment = record.rawComment();
+  switch (mode) {
+    case RecordMode::CreateUnique:
+      checkKeyword(record.keyword, mode);
+      fits_write_key(m_fptr, Cfitsio::TypeCode<T>::forRecord(), record.keyword.c_str(), &value, &comment[0], &m_status);
+      break;
+    case RecordMode::CreateNew:
+      fits_write_key(m_fptr, Cfitsio::TypeCode<T>::forRecord(), record.keyword.c_str(), &value, &comment[0], &m_status);
+      break;
+    case RecordMode::CreateOrUpdate:
+      fits_update_key(m_fptr, Cfitsio::TypeCode<T>::forRecord(), record.keyword.c_str(), &value, &comment[0], &m_status);
+      break;
+    case RecordMode::UpdateExisting:
+      fits_modify_key(m_fptr, Cfitsio::TypeCode<T>::forRecord(), record.keyword.c_str(), &value, &comment[0], &m_status);
+      break;
+  }
+  mayThrow("Cannot write record: " + record.keyword);
+}
+
+template <typename T>
+T CfitsioBenchmark::parseRecord(const Record<T>& fallback, bool useFallback) {
+  T value;
+  fits_read_key(m_fptr, Cfitsio::TypeCode<T>::forRecord(), fallback.keyword.c_str(), &value, nullptr, &m_status);
+  if (useFallback && m_status == KEY_NO_EXIST) {
+    m_status = 0;
+    return fallback.value;
+  }
+  mayThrow("Cannot parse record: " + fallback.keyword);
+  return value;
+}
+
 } // namespace Test
 } // namespace Fits
 } // namespace Euclid
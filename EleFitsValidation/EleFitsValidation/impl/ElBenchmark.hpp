@@ -30,6 +30,13 @@ Indexed<typename std::tuple_element<i, BColumns>::type::Value> ElColwiseBenchmar
   return Indexed<typename std::tuple_element<i, BColumns>::type::Value>(i);
 }
 
+template <RecordMode Mode>
+void ElColwiseBenchmark::writeRecordsWithMode(const BRecords& records) {
+  seqForeach(records, [&](const auto& vec) {
+    m_header->writeSeq<Mode>(vec);
+  });
+}
+
 } // namespace Test
 } // namespace Fits
 } // namespace Euclid
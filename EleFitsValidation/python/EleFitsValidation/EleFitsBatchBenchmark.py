@@ -43,6 +43,8 @@ def makeCommand(testCase, output, results, log_level):
         # int(float(value)) allows value to be an integer in scientific notation
     if testCase['HDU type'] == 'Binary table':
         cmd += f' --tables {int(float(testCase["HDU count"]))} --rows {int(float(testCase["Value count / HDU"]))//10}'
+    if testCase['HDU type'] == 'Header':
+        cmd += f' --headers {int(float(testCase["HDU count"]))} --cards {int(float(testCase["Value count / HDU"]))}'
     return cmd
 
 
@@ -80,6 +82,8 @@ def mainMethod(args):
                 valueCount = int(testCase["Value count / HDU"])
                 if hduType == 'Image':
                     shape = f'{scientificNotation(valueCount)} pixels'
+                elif hduType == 'Header':
+                    shape = f'{valueCount} cards'
                 else:
                     shape = f'10 columns x {scientificNotation(valueCount/10)} rows'
                 testName = f'{testCase["Mode"]} {hduType}\n({testCase["HDU count"]} HDUs x {shape})'
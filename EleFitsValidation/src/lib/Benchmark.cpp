@@ -19,10 +19,45 @@
 
 #include "EleFitsValidation/Benchmark.h"
 
+#include <functional>
+
 namespace Euclid {
 namespace Fits {
 namespace Test {
 
+BRecords generateRecords(long count, long stringLength) {
+  BRecords records;
+  const std::string value(stringLength, 'v');
+  for (long i = 0; i < count; ++i) {
+    auto index = std::to_string(i);
+    index = std::string(7 - index.size(), '0') + index; // Keywords have 8 characters at most
+    switch (i % 4) {
+      case 0:
+        std::get<0>(records).vector.emplace_back("B" + index, i % 3 == 0, "", "Boolean");
+        break;
+      case 1:
+        std::get<1>(records).vector.emplace_back("I" + index, i, "count", "Integer");
+        break;
+      case 2:
+        std::get<2>(records).vector.emplace_back("R" + index, i * 3.14, "m", "Real");
+        break;
+      default:
+        std::get<3>(records).vector.emplace_back("S" + index, value, "", "String");
+    }
+  }
+  return records;
+}
+
+std::vector<std::string> recordKeywords(const BRecords& records) {
+  std::vector<std::string> keywords;
+  seqForeach(records, [&](const auto& vec) {
+    for (const auto& r : vec) {
+      keywords.push_back(r.keyword);
+    }
+  });
+  return keywords;
+}
+
 Benchmark::Benchmark(const std::string& filename) :
     m_filename(filename), m_chrono(), m_logger(Elements::Logging::getLogger("Benchmark")) {}
 
@@ -86,6 +121,84 @@ const BChronometer& Benchmark::readBintables(long first, long count) {
   return m_chrono;
 }
 
+std::vector<std::pair<std::string, BHeaderChronometer>> Benchmark::benchmarkHeaders(long count, const BRecords& records) {
+  const auto keywords = recordKeywords(records);
+  const std::vector<std::pair<std::string, std::function<void()>>> cases {
+      { "Write CreateNew",
+        [&]() {
+          writeRecords(records, RecordMode::CreateNew);
+        } },
+      { "Write CreateOrUpdate",
+        [&]() {
+          writeRecords(records, RecordMode::CreateOrUpdate);
+        } },
+      { "Write UpdateExisting",
+        [&]() {
+          writeRecords(records, RecordMode::UpdateExisting);
+        } },
+      { "Parse all",
+        [&]() {
+          parseAllRecords();
+        } },
+      { "Parse sequence",
+        [&]() {
+          parseRecords(records);
+        } },
+      { "Parse struct or fallbacks",
+        [&]() {
+          parseRecordsOr(records);
+        } },
+      { "Read keywords and values",
+        [&]() {
+          readKeywordsValues();
+        } },
+      { "Has",
+        [&]() {
+          hasKeywords(keywords);
+        } },
+      { "Remove",
+        [&]() {
+          removeRecords(keywords);
+        } },
+      { "Write CreateUnique",
+        [&]() {
+          writeRecords(records, RecordMode::CreateUnique);
+        } }
+  };
+  std::vector<std::pair<std::string, BHeaderChronometer>> chronos;
+  std::vector<bool> implemented(cases.size(), true);
+  for (const auto& c : cases) {
+    chronos.emplace_back(c.first, BHeaderChronometer());
+  }
+  open();
+  for (long i = 0; i < count; ++i) {
+    initHeader();
+    for (std::size_t c = 0; c < cases.size(); ++c) {
+      if (not implemented[c]) {
+        continue;
+      }
+      auto& chrono = chronos[c].second;
+      try {
+        chrono.start();
+        cases[c].second();
+        const auto inc = chrono.stop();
+        m_logger.debug() << i + 1 << "/" << count << ": " << cases[c].first << ": " << inc.count() << "us";
+      } catch (const TestCaseNotImplemented& e) {
+        m_logger.warn() << e.what();
+        implemented[c] = false;
+      }
+    }
+  }
+  close();
+  std::vector<std::pair<std::string, BHeaderChronometer>> res;
+  for (std::size_t c = 0; c < cases.size(); ++c) {
+    if (implemented[c]) {
+      res.push_back(std::move(chronos[c]));
+    }
+  }
+  return res;
+}
+
 void BenchmarkFactory::registerBenchmarkMaker(const std::string& key, BenchmarkMaker factory) {
   if (m_register.find(key) != m_register.end()) {
     throw std::runtime_error(std::string("Benchmark already registered: ") + key);
@@ -0,0 +1,107 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsValidation/BenchmarkSuite.h"
+
+#include <algorithm> // sort
+#include <fstream>
+#include <numeric> // accumulate
+
+namespace Euclid {
+namespace Fits {
+namespace Test {
+
+double BenchmarkResult::quantile(double q) const {
+  if (latencies.empty()) {
+    return 0;
+  }
+  auto sorted = latencies;
+  std::sort(sorted.begin(), sorted.end());
+  const double position = q * (sorted.size() - 1);
+  const std::size_t below = position;
+  const std::size_t above = std::min(below + 1, sorted.size() - 1);
+  return sorted[below] + (position - below) * (sorted[above] - sorted[below]);
+}
+
+double BenchmarkResult::mean() const {
+  if (latencies.empty()) {
+    return 0;
+  }
+  return std::accumulate(latencies.begin(), latencies.end(), 0.) / latencies.size();
+}
+
+double BenchmarkResult::throughput() const {
+  const auto m = mean();
+  return m > 0 ? byteCount / m : 0; // B/us = MB/s
+}
+
+BenchmarkSuite::BenchmarkSuite(long iterationCount, long warmupCount) :
+    m_iterationCount(iterationCount), m_warmupCount(warmupCount), m_results() {}
+
+const BenchmarkResult&
+BenchmarkSuite::run(const std::string& name, const BenchmarkParameters& parameters, const Iteration& iteration) {
+  for (long i = 0; i < m_warmupCount; ++i) {
+    iteration();
+  }
+  LatencyChronometer chrono;
+  long byteCount = 0;
+  for (long i = 0; i < m_iterationCount; ++i) {
+    chrono.start();
+    byteCount = iteration();
+    chrono.stop();
+  }
+  m_results.push_back({ name, parameters, byteCount, chrono.increments() });
+  return m_results.back();
+}
+
+const std::vector<BenchmarkResult>& BenchmarkSuite::results() const {
+  return m_results;
+}
+
+void BenchmarkSuite::writeJson(std::ostream& out) const {
+  out << "{\n  \"iterations\": " << m_iterationCount << ",\n  \"warmup\": " << m_warmupCount
+      << ",\n  \"results\": [";
+  for (std::size_t r = 0; r < m_results.size(); ++r) {
+    const auto& result = m_results[r];
+    out << (r == 0 ? "\n" : ",\n") << "    {\n      \"case\": \"" << result.name << "\",\n      \"parameters\": {";
+    for (std::size_t p = 0; p < result.parameters.size(); ++p) {
+      out << (p == 0 ? " " : ", ") << "\"" << result.parameters[p].first << "\": " << result.parameters[p].second;
+    }
+    out << " },\n      \"bytes\": " << result.byteCount;
+    out << ",\n      \"throughput_mbps\": " << result.throughput();
+    out << ",\n      \"latency_us\": { \"min\": " << result.quantile(0) << ", \"p50\": " << result.quantile(.5)
+        << ", \"p90\": " << result.quantile(.9) << ", \"p99\": " << result.quantile(.99)
+        << ", \"max\": " << result.quantile(1) << ", \"mean\": " << result.mean() << " }";
+    out << ",\n      \"samples_us\": [";
+    for (std::size_t i = 0; i < result.latencies.size(); ++i) {
+      out << (i == 0 ? "" : ", ") << result.latencies[i];
+    }
+    out << "]\n    }";
+  }
+  out << "\n  ]\n}\n";
+}
+
+void BenchmarkSuite::writeJson(const std::string& filename) const {
+  std::ofstream out(filename);
+  writeJson(out);
+}
+
+} // namespace Test
+} // namespace Fits
+} // namespace Euclid
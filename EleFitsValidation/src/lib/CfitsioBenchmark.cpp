@@ -19,6 +19,9 @@
 
 #include "EleFitsValidation/CfitsioBenchmark.h"
 
+#include <cstdlib> // strtod, strtoll
+#include <map>
+
 namespace Euclid {
 namespace Fits {
 namespace Test {
@@ -176,6 +179,164 @@ BColumns CfitsioBenchmark::readBintable(long index) {
   return columns;
 }
 
+void CfitsioBenchmark::initHeader() {
+  fits_create_img(m_fptr, BYTE_IMG, 0, nullptr, &m_status);
+  mayThrow("Cannot create header-only HDU");
+}
+
+void CfitsioBenchmark::writeRecords(const BRecords& records, RecordMode mode) {
+  seqForeach(records, [&](const auto& vec) {
+    for (const auto& r : vec) {
+      writeRecord(r, mode);
+    }
+  });
+}
+
+void CfitsioBenchmark::parseAllRecords() {
+  int count = 0;
+  fits_get_hdrspace(m_fptr, &count, nullptr, &m_status);
+  char keyword[FLEN_KEYWORD];
+  char value[FLEN_VALUE];
+  char comment[FLEN_COMMENT];
+  char type = 0;
+  std::vector<bool> logicals;
+  std::vector<long long> integers;
+  std::vector<double> reals;
+  std::vector<std::string> strings;
+  for (int i = 1; i <= count; ++i) {
+    fits_read_keyn(m_fptr, i, keyword, value, comment, &m_status);
+    if (value[0] == '\0') { // E.g. COMMENT
+      continue;
+    }
+    fits_get_keytype(value, &type, &m_status);
+    switch (type) {
+      case 'L':
+        logicals.push_back(value[0] == 'T');
+        break;
+      case 'I':
+        integers.push_back(std::strtoll(value, nullptr, 10));
+        break;
+      case 'F':
+        reals.push_back(std::strtod(value, nullptr));
+        break;
+      default:
+        strings.emplace_back(value);
+    }
+  }
+  mayThrow("Cannot parse all records");
+}
+
+void CfitsioBenchmark::parseRecords(const BRecords& records) {
+  seqForeach(records, [&](const auto& vec) {
+    for (const auto& r : vec) {
+      parseRecord(r, false);
+    }
+  });
+}
+
+void CfitsioBenchmark::parseRecordsOr(const BRecords& records) {
+  seqForeach(records, [&](const auto& vec) {
+    for (const auto& r : vec) {
+      parseRecord(r, true);
+    }
+  });
+}
+
+void CfitsioBenchmark::readKeywordsValues() {
+  int count = 0;
+  fits_get_hdrspace(m_fptr, &count, nullptr, &m_status);
+  char keyword[FLEN_KEYWORD];
+  char value[FLEN_VALUE];
+  std::map<std::string, std::string> keywordsValues;
+  for (int i = 1; i <= count; ++i) {
+    fits_read_keyn(m_fptr, i, keyword, value, nullptr, &m_status);
+    keywordsValues[keyword] = value;
+  }
+  mayThrow("Cannot read keywords and values");
+}
+
+void CfitsioBenchmark::hasKeywords(const std::vector<std::string>& keywords) {
+  for (const auto& k : keywords) {
+    hasKeyword(k);
+  }
+}
+
+void CfitsioBenchmark::removeRecords(const std::vector<std::string>& keywords) {
+  for (const auto& k : keywords) {
+    fits_delete_key(m_fptr, k.c_str(), &m_status);
+    mayThrow("Cannot remove record: " + k);
+  }
+}
+
+bool CfitsioBenchmark::hasKeyword(const std::string& keyword) {
+  char card[FLEN_CARD];
+  fits_read_card(m_fptr, keyword.c_str(), card, &m_status);
+  if (m_status == KEY_NO_EXIST) {
+    m_status = 0;
+    return false;
+  }
+  mayThrow("Cannot check keyword: " + keyword);
+  return true;
+}
+
+bool CfitsioBenchmark::checkKeyword(const std::string& keyword, RecordMode mode) {
+  if (mode == RecordMode::CreateNew) {
+    return false;
+  }
+  const bool exists = hasKeyword(keyword);
+  if (exists && mode == RecordMode::CreateUnique) {
+    throw KeywordExistsError(keyword);
+  }
+  if (not exists && mode == RecordMode::UpdateExisting) {
+    throw KeywordNotFoundError(keyword);
+  }
+  return exists;
+}
+
+void CfitsioBenchmark::writeRecord(const Record<bool>& record, RecordMode mode) {
+  int value = record.value; // TLOGICAL is for int
+  std::string comment = record.rawComment();
+  checkKeyword(record.keyword, mode);
+  if (mode == RecordMode::CreateNew || mode == RecordMode::CreateUnique) {
+    fits_write_key(m_fptr, TLOGICAL, record.keyword.c_str(), &value, &comment[0], &m_status);
+  } else {
+    fits_update_key(m_fptr, TLOGICAL, record.keyword.c_str(), &value, &comment[0], &m_status);
+  }
+  mayThrow("Cannot write Boolean record: " + record.keyword);
+}
+
+void CfitsioBenchmark::writeRecord(const Record<std::string>& record, RecordMode mode) {
+  if (checkKeyword(record.keyword, mode)) { // Long strings cannot be updated
+    fits_delete_key(m_fptr, record.keyword.c_str(), &m_status);
+  }
+  fits_write_key_longstr(m_fptr, record.keyword.c_str(), record.value.c_str(), record.rawComment().c_str(), &m_status);
+  mayThrow("Cannot write string record: " + record.keyword);
+}
+
+bool CfitsioBenchmark::parseRecord(const Record<bool>& fallback, bool useFallback) {
+  int value = 0; // TLOGICAL is for int
+  fits_read_key(m_fptr, TLOGICAL, fallback.keyword.c_str(), &value, nullptr, &m_status);
+  if (useFallback && m_status == KEY_NO_EXIST) {
+    m_status = 0;
+    return fallback.value;
+  }
+  mayThrow("Cannot parse Boolean record: " + fallback.keyword);
+  return value;
+}
+
+std::string CfitsioBenchmark::parseRecord(const Record<std::string>& fallback, bool useFallback) {
+  char* value = nullptr;
+  fits_read_key_longstr(m_fptr, fallback.keyword.c_str(), &value, nullptr, &m_status);
+  if (useFallback && m_status == KEY_NO_EXIST) {
+    m_status = 0;
+    return fallback.value;
+  }
+  mayThrow("Cannot parse string record: " + fallback.keyword);
+  std::string res(value);
+  fits_free_memory(value, &m_status);
+  return res;
+}
+
 long CfitsioBenchmark::computeRowChunkSize(long rowCount) {
   if (m_rowChunkSize == -1) {
     m_logger.debug() << "Row chunk size: " << rowCount;
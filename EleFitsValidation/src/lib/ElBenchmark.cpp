@@ -24,7 +24,7 @@ namespace Fits {
 namespace Test {
 
 ElColwiseBenchmark::ElColwiseBenchmark(const std::string& filename) :
-    Benchmark(filename), m_f(filename, FileMode::Overwrite) {
+    Benchmark(filename), m_f(filename, FileMode::Overwrite), m_header(nullptr) {
   m_logger.info() << "EleFits benchmark (column-wise, filename: " << filename << ")";
 }
 
@@ -81,6 +81,60 @@ BColumns ElColwiseBenchmark::readBintable(long index) {
   return columns;
 }
 
+void ElColwiseBenchmark::initHeader() {
+  m_header = &m_f.initRecordExt("").header();
+}
+
+void ElColwiseBenchmark::writeRecords(const BRecords& records, RecordMode mode) {
+  switch (mode) {
+    case RecordMode::CreateOrUpdate:
+      return writeRecordsWithMode<RecordMode::CreateOrUpdate>(records);
+    case RecordMode::CreateUnique:
+      return writeRecordsWithMode<RecordMode::CreateUnique>(records);
+    case RecordMode::CreateNew:
+      return writeRecordsWithMode<RecordMode::CreateNew>(records);
+    case RecordMode::UpdateExisting:
+      return writeRecordsWithMode<RecordMode::UpdateExisting>(records);
+  }
+}
+
+void ElColwiseBenchmark::parseAllRecords() {
+  m_header->parseAll();
+}
+
+void ElColwiseBenchmark::parseRecords(const BRecords& records) {
+  seqForeach(records, [&](const auto& vec) {
+    using Value = typename std::decay_t<decltype(vec.vector)>::value_type::Value;
+    std::vector<std::string> keywords;
+    for (const auto& r : vec) {
+      keywords.push_back(r.keyword);
+    }
+    m_header->parseSeq<Value>(keywords);
+  });
+}
+
+void ElColwiseBenchmark::parseRecordsOr(const BRecords& records) {
+  seqForeach(records, [&](const auto& vec) {
+    m_header->parseStructOr<std::decay_t<decltype(vec.vector)>>(vec.vector);
+  });
+}
+
+void ElColwiseBenchmark::readKeywordsValues() {
+  m_header->readKeywordsValues();
+}
+
+void ElColwiseBenchmark::hasKeywords(const std::vector<std::string>& keywords) {
+  for (const auto& k : keywords) {
+    m_header->has(k);
+  }
+}
+
+void ElColwiseBenchmark::removeRecords(const std::vector<std::string>& keywords) {
+  for (const auto& k : keywords) {
+    m_header->remove(k);
+  }
+}
+
 ElBenchmark::ElBenchmark(const std::string& filename) : ElColwiseBenchmark(filename) {
   m_logger.info() << "EleFits benchmark (buffered, filename: " << filename << ")";
 }
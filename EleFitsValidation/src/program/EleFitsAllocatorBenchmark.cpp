@@ -0,0 +1,204 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/SifFile.h"
+#include "EleFitsData/Allocator.h"
+#include "EleFitsData/TestRaster.h"
+#include "EleFitsUtils/ProgramOptions.h"
+#include "EleFitsValidation/Benchmark.h"
+#include "EleFitsValidation/CsvAppender.h"
+#include "ElementsKernel/ProgramHeaders.h"
+
+#include <algorithm> // max, min
+#include <boost/program_options.hpp>
+#include <map>
+#include <random>
+#include <string>
+#include <sys/resource.h> // getrusage
+#include <thread>
+#include <vector>
+
+using boost::program_options::value;
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief Get the number of minor page faults of the process so far.
+ */
+long minorFaultCount() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_minflt;
+}
+
+/**
+ * @brief The result of the gather workload, which prevents the loop from being optimized out.
+ */
+volatile double gatherSink = 0;
+
+/**
+ * @brief The benchmark parameters.
+ */
+struct Setup {
+
+  /**
+   * @brief The image width and height.
+   */
+  long side;
+
+  /**
+   * @brief The number of threads of the fill workload.
+   */
+  long threadCount;
+
+  /**
+   * @brief The number of random accesses of the gather workload.
+   */
+  long gatherCount;
+
+  /**
+   * @brief The Fits file of the read workload.
+   */
+  std::string filename;
+};
+
+/**
+ * @brief Run the workloads with a given allocator, and write a row per workload.
+ * @details
+ * - "Fill": allocate a raster and fill it in parallel, which is bound by page faults;
+ * - "Gather": sum random pixels of the raster, which is bound by TLB misses;
+ * - "Read": read the image from the file into a new raster.
+ */
+template <typename TAllocator>
+void runWorkloads(const std::string& name, const Setup& setup, Test::CsvAppender& writer) {
+
+  Test::BChronometer chrono;
+  const double megabytes = double(setup.side) * setup.side * sizeof(float) / 1024 / 1024;
+
+  /* Fill */
+  long faults = minorFaultCount();
+  chrono.reset();
+  chrono.start();
+  VecRaster<float, 2, TAllocator> raster({ setup.side, setup.side });
+  std::vector<std::thread> threads;
+  const long chunkSize = (raster.size() + setup.threadCount - 1) / setup.threadCount;
+  for (long t = 0; t < setup.threadCount; ++t) {
+    threads.emplace_back([&raster, t, chunkSize]() {
+      const long end = std::min(raster.size(), (t + 1) * chunkSize);
+      for (long i = t * chunkSize; i < end; ++i) {
+        raster.data()[i] = float(i);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  chrono.stop();
+  double elapsed = std::max(1L, long(chrono.elapsed().count()));
+  writer.writeRow(name, "Fill", setup.side, elapsed, megabytes * 1000 / elapsed, minorFaultCount() - faults);
+
+  /* Gather */
+  std::mt19937_64 generator(42);
+  std::uniform_int_distribution<long> distribution(0, raster.size() - 1);
+  std::vector<long> indices(setup.gatherCount);
+  for (auto& i : indices) {
+    i = distribution(generator);
+  }
+  faults = minorFaultCount();
+  chrono.reset();
+  chrono.start();
+  double sum = 0;
+  for (auto i : indices) {
+    sum += raster.data()[i];
+  }
+  chrono.stop();
+  gatherSink = sum;
+  elapsed = std::max(1L, long(chrono.elapsed().count()));
+  writer.writeRow(
+      name,
+      "Gather",
+      setup.side,
+      elapsed,
+      double(setup.gatherCount) * sizeof(float) / 1024 / 1024 * 1000 / elapsed,
+      minorFaultCount() - faults);
+
+  /* Read */
+  SifFile f(setup.filename, FileMode::Read);
+  faults = minorFaultCount();
+  chrono.reset();
+  chrono.start();
+  const auto image = f.raster().read<float, 2, TAllocator>();
+  chrono.stop();
+  elapsed = std::max(1L, long(chrono.elapsed().count()));
+  writer.writeRow(name, "Read", setup.side, elapsed, megabytes * 1000 / elapsed, minorFaultCount() - faults);
+}
+
+class EleFitsAllocatorBenchmark : public Elements::Program {
+
+public:
+  std::pair<OptionsDescription, PositionalOptionsDescription> defineProgramArguments() override {
+    ProgramOptions options;
+    options.named("side", value<long>()->default_value(8192), "Image width and height");
+    options.named("threads", value<long>()->default_value(0), "Number of threads (0 for hardware threads)");
+    options.named("gathers", value<long>()->default_value(1 << 24), "Number of random pixel accesses");
+    options.named("output", value<std::string>()->default_value("/tmp/test.fits"), "Output Fits file");
+    options.named("res", value<std::string>()->default_value("/tmp/allocator.csv"), "Output result file");
+    return options.asPair();
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, VariableValue>& args) override {
+
+    Elements::Logging logger = Elements::Logging::getLogger("EleFitsAllocatorBenchmark");
+
+    Setup setup;
+    setup.side = args["side"].as<long>();
+    setup.threadCount = args["threads"].as<long>();
+    if (setup.threadCount <= 0) {
+      setup.threadCount = std::max(1L, long(std::thread::hardware_concurrency()));
+    }
+    setup.gatherCount = args["gathers"].as<long>();
+    setup.filename = args["output"].as<std::string>();
+    const auto results = args["res"].as<std::string>();
+
+    logger.info() << "Writing an image of " << setup.side << " x " << setup.side << " pixels...";
+    {
+      Test::RandomRaster<float, 2> raster({ setup.side, setup.side });
+      SifFile f(setup.filename, FileMode::Overwrite);
+      f.writeRaster(raster);
+    }
+
+    Test::CsvAppender
+        writer(results, { "Allocator", "Workload", "Side", "Elapsed (ms)", "Throughput (MB/s)", "Minor page faults" });
+
+    logger.info("Running with the standard allocator...");
+    runWorkloads<std::allocator<float>>("Standard", setup, writer);
+    logger.info("Running with the aligned allocator...");
+    runWorkloads<AlignedAllocator<float>>("Aligned", setup, writer);
+    logger.info("Running with the huge page allocator...");
+    runWorkloads<HugePageAllocator<float>>("Huge pages", setup, writer);
+    logger.info("Running with the first-touch allocator...");
+    runWorkloads<FirstTouchAllocator<float>>("First touch", setup, writer);
+
+    logger.info() << "Results written to " << results;
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(EleFitsAllocatorBenchmark)
@@ -27,6 +27,7 @@
 #include "ElementsKernel/ProgramHeaders.h"
 
 #include <boost/filesystem.hpp>
+#include <algorithm> // transform
 #include <boost/program_options.hpp>
 #include <chrono>
 #include <map>
@@ -66,6 +67,8 @@ public:
     options.named("pixels", value<int>()->default_value(1), "Number of pixels");
     options.named("tables", value<int>()->default_value(0), "Number of binary table extensions");
     options.named("rows", value<int>()->default_value(1), "Number of rows");
+    options.named("headers", value<int>()->default_value(0), "Number of header-only extensions");
+    options.named("cards", value<int>()->default_value(1), "Number of records per header");
     options.named("output", value<std::string>()->default_value("/tmp/test.fits"), "Output Fits file");
     options.named("res", value<std::string>()->default_value("/tmp/benchmark.csv"), "Output result file");
     return options.asPair();
@@ -80,6 +83,8 @@ public:
     const auto pixelCount = args["pixels"].as<int>();
     const auto tableCount = args["tables"].as<int>();
     const auto rowCount = args["rows"].as<int>();
+    const auto headerCount = args["headers"].as<int>();
+    const auto cardCount = args["cards"].as<int>();
     const auto filename = args["output"].as<std::string>();
     const auto results = args["res"].as<std::string>();
 
@@ -225,9 +230,41 @@ public:
         logger.warn() << e.what();
       }
 
+    } else if (headerCount) {
+
+      logger.info("Generating records...");
+
+      const auto records = Test::generateRecords(cardCount);
+
+      logger.info("Running header test cases...");
+
+      for (const auto& c : benchmark->benchmarkHeaders(headerCount, records)) {
+        const auto& chrono = c.second;
+        std::vector<double> samples(chrono.increments().size());
+        std::transform(chrono.increments().begin(), chrono.increments().end(), samples.begin(), [](double us) {
+          return us / 1000.;
+        });
+        logger.info() << c.first << ": " << chrono.mean() / cardCount << "us per card";
+        writer.writeRow(
+            "TODO",
+            testSetup,
+            c.first,
+            "Header",
+            headerCount,
+            cardCount,
+            headerCount * cardCount,
+            boost::filesystem::file_size(filename),
+            chrono.elapsed().count() / 1000.,
+            chrono.min() / 1000.,
+            chrono.max() / 1000.,
+            chrono.mean() / 1000.,
+            chrono.stdev() / 1000.,
+            join(samples));
+      }
+
     } else {
       throw Test::TestCaseNotImplemented(
-          "There should be either a positive number of image HDUs or a positive number of binary table HDUs");
+          "There should be a positive number of image HDUs, binary table HDUs or header-only HDUs");
     }
 
     logger.info("Done.");
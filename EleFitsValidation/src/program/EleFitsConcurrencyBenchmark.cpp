@@ -0,0 +1,142 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/MefFile.h"
+#include "EleFitsData/TestRaster.h"
+#include "EleFitsUtils/ProgramOptions.h"
+#include "EleFitsValidation/Benchmark.h"
+#include "EleFitsValidation/CsvAppender.h"
+#include "ElementsKernel/ProgramHeaders.h"
+
+#include <algorithm> // max
+#include <boost/program_options.hpp>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using boost::program_options::value;
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief Read all the image extensions with a given number of threads, each thread reading every n-th extension.
+ */
+void readConcurrently(MefFile& f, long threadCount, long iterationCount) {
+  std::vector<std::thread> threads;
+  for (long t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&f, t, threadCount, iterationCount]() {
+      for (long k = 0; k < iterationCount; ++k) {
+        for (long i = 1 + t; i < f.hduCount(); i += threadCount) {
+          f.access<ImageHdu>(i).raster().read<float, 2>();
+        }
+      }
+      f.releaseThreadHandle();
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+class EleFitsConcurrencyBenchmark : public Elements::Program {
+
+public:
+  std::pair<OptionsDescription, PositionalOptionsDescription> defineProgramArguments() override {
+    ProgramOptions options;
+    options.named("hdus", value<long>()->default_value(16), "Number of image extensions");
+    options.named("side", value<long>()->default_value(1024), "Image width and height");
+    options.named("threads", value<long>()->default_value(0), "Maximum number of threads (0 for hardware threads)");
+    options.named("iterations", value<long>()->default_value(4), "Number of reads of each extension");
+    options.named("output", value<std::string>()->default_value("/tmp/test.fits"), "Output Fits file");
+    options.named("res", value<std::string>()->default_value("/tmp/concurrency.csv"), "Output result file");
+    return options.asPair();
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, VariableValue>& args) override {
+
+    Elements::Logging logger = Elements::Logging::getLogger("EleFitsConcurrencyBenchmark");
+
+    const auto hduCount = args["hdus"].as<long>();
+    const auto side = args["side"].as<long>();
+    auto maxThreadCount = args["threads"].as<long>();
+    if (maxThreadCount <= 0) {
+      maxThreadCount = std::max(1L, long(std::thread::hardware_concurrency()));
+    }
+    const auto iterationCount = args["iterations"].as<long>();
+    const auto filename = args["output"].as<std::string>();
+    const auto results = args["res"].as<std::string>();
+
+    logger.info() << "Writing " << hduCount << " images of " << side << " x " << side << " pixels...";
+    {
+      Test::RandomRaster<float, 2> raster({ side, side });
+      MefFile f(filename, FileMode::Overwrite);
+      for (long i = 0; i < hduCount; ++i) {
+        f.assignImageExt("", raster);
+      }
+    }
+    const double megabytes = double(hduCount) * side * side * sizeof(float) * iterationCount / 1024 / 1024;
+
+    Test::CsvAppender writer(
+        results,
+        { "Mode", "Threads", "HDU count", "Side", "Iterations", "Elapsed (ms)", "Throughput (MB/s)", "Speedup" });
+    Test::BChronometer chrono;
+
+    logger.info("Reading with a single handle...");
+    {
+      MefFile f(filename, FileMode::Read);
+      chrono.reset();
+      chrono.start();
+      for (long k = 0; k < iterationCount; ++k) {
+        for (long i = 1; i < f.hduCount(); ++i) {
+          f.access<ImageHdu>(i).raster().read<float, 2>();
+        }
+      }
+      chrono.stop();
+    }
+    const double reference = std::max(1L, long(chrono.elapsed().count()));
+    writer.writeRow("Single handle", 1, hduCount, side, iterationCount, reference, megabytes * 1000 / reference, 1.);
+
+    for (long threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2) {
+      logger.info() << "Reading with " << threadCount << " thread(s)...";
+      MefFile f(filename, FileMode::Read);
+      f.enableConcurrentReads();
+      chrono.reset();
+      chrono.start();
+      readConcurrently(f, threadCount, iterationCount);
+      chrono.stop();
+      const double elapsed = std::max(1L, long(chrono.elapsed().count()));
+      writer.writeRow(
+          "Handle pool",
+          threadCount,
+          hduCount,
+          side,
+          iterationCount,
+          elapsed,
+          megabytes * 1000 / elapsed,
+          reference / elapsed);
+    }
+
+    logger.info() << "Results written to " << results;
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(EleFitsConcurrencyBenchmark)
@@ -0,0 +1,131 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/BintableHdu.h"
+#include "EleFits/MefFile.h"
+#include "EleFitsData/TestColumn.h"
+#include "EleFitsValidation/Benchmark.h"
+#include "EleFitsValidation/CsvAppender.h"
+#include "EleFitsUtils/ProgramOptions.h"
+#include "ElementsKernel/ProgramHeaders.h"
+
+#include <algorithm>
+#include <boost/program_options.hpp>
+#include <map>
+#include <random>
+#include <string>
+
+using boost::program_options::value;
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief Generate row indices in random order.
+ * @param rowCount The number of rows of the table
+ * @param count The number of indices
+ * @param clustering The probability for an index to be close to the previous one
+ */
+std::vector<long> generateRows(long rowCount, long count, double clustering, std::mt19937& generator) {
+  std::uniform_int_distribution<long> anywhere(0, rowCount - 1);
+  std::uniform_int_distribution<long> nearby(1, 4);
+  std::bernoulli_distribution clustered(clustering);
+  std::vector<long> rows(count);
+  for (long i = 0; i < count; ++i) {
+    rows[i] = (i > 0 && clustered(generator)) ? std::min(rows[i - 1] + nearby(generator), rowCount - 1) :
+                                                 anywhere(generator);
+  }
+  std::shuffle(rows.begin(), rows.end(), generator); // E.g. cross-match order
+  return rows;
+}
+
+class EleFitsGatherBenchmark : public Elements::Program {
+
+public:
+  std::pair<OptionsDescription, PositionalOptionsDescription> defineProgramArguments() override {
+    ProgramOptions options;
+    options.named("rows", value<long>()->default_value(1000000), "Number of rows of the table");
+    options.named("gap", value<long>()->default_value(64), "Maximum gap of the coalesced runs");
+    options.named("output", value<std::string>()->default_value("/tmp/test.fits"), "Output Fits file");
+    options.named("res", value<std::string>()->default_value("/tmp/gather.csv"), "Output result file");
+    return options.asPair();
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, VariableValue>& args) override {
+
+    Elements::Logging logger = Elements::Logging::getLogger("EleFitsGatherBenchmark");
+
+    const auto rowCount = args["rows"].as<long>();
+    const auto maxGap = args["gap"].as<long>();
+    const auto filename = args["output"].as<std::string>();
+    const auto results = args["res"].as<std::string>();
+
+    logger.info("Writing binary table...");
+
+    Test::RandomScalarColumn<std::int64_t> ids(rowCount);
+    ids.rename("ID");
+    Test::RandomScalarColumn<double> ras(rowCount);
+    ras.rename("RA");
+    Test::RandomScalarColumn<float> mags(rowCount);
+    mags.rename("MAG");
+    MefFile f(filename, FileMode::Overwrite);
+    const auto& columns = f.assignBintableExt("CATALOG", ids, ras, mags).columns();
+
+    Test::CsvAppender writer(
+        results,
+        { "Strategy",
+          "Row count",
+          "Selectivity",
+          "Clustering",
+          "Gathered row count",
+          "Max gap",
+          "Elapsed (ms)" });
+    std::mt19937 generator;
+    Test::BChronometer chrono;
+
+    for (double selectivity : { 0.0001, 0.001, 0.01, 0.1 }) {
+      for (double clustering : { 0., 0.5, 0.9 }) {
+
+        const auto rows = generateRows(rowCount, std::max(1L, long(selectivity * rowCount)), clustering, generator);
+        logger.info() << "Gathering " << rows.size() << " rows with clustering " << clustering << "...";
+
+        chrono.reset();
+        chrono.start();
+        for (auto row : rows) {
+          columns.readSegmentSeq({ row, row }, Indexed<std::int64_t>(0), Indexed<double>(1), Indexed<float>(2));
+        }
+        chrono.stop();
+        writer.writeRow("Row-wise", rowCount, selectivity, clustering, rows.size(), 0, chrono.elapsed().count());
+
+        for (long gap : { 0L, maxGap }) {
+          chrono.reset();
+          chrono.start();
+          columns.readGatheredSeq(rows, gap, Indexed<std::int64_t>(0), Indexed<double>(1), Indexed<float>(2));
+          chrono.stop();
+          writer.writeRow("Gather", rowCount, selectivity, clustering, rows.size(), gap, chrono.elapsed().count());
+        }
+      }
+    }
+
+    logger.info("Done.");
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(EleFitsGatherBenchmark)
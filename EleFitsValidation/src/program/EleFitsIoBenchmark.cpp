@@ -0,0 +1,240 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+
+#include "EleFits/MefFile.h"
+#include "EleFitsData/TestColumn.h"
+#include "EleFitsData/TestRaster.h"
+#include "EleFitsUtils/ProgramOptions.h"
+#include "EleFitsValidation/BenchmarkSuite.h"
+#include "ElementsKernel/ProgramHeaders.h"
+
+#include <algorithm>
+#include <boost/program_options.hpp>
+#include <cmath> // sqrt
+#include <map>
+#include <string>
+
+using boost::program_options::value;
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief Benchmark image reads and writes, whole or by region, and checksums.
+ * @param pixelCount The approximate number of pixels of the square image
+ */
+void benchmarkImages(MefFile& f, Test::BenchmarkSuite& suite, long pixelCount) {
+  const long side = std::max(2L, long(std::sqrt(pixelCount)));
+  const Test::BenchmarkParameters parameters { { "pixels", side * side } };
+  const long byteCount = side * side * sizeof(float);
+  Test::RandomRaster<float, 2> raster({ side, side });
+  const auto& hdu = f.assignImageExt("IMAGE", raster);
+  const auto& du = hdu.raster();
+
+  suite.run("image.write", parameters, [&]() {
+    du.write(raster);
+    return byteCount;
+  });
+  suite.run("image.read", parameters, [&]() {
+    return du.read<float, 2>().size() * long(sizeof(float));
+  });
+
+  const auto region = Region<2>::fromShape({ side / 4, side / 4 }, { side / 2, side / 2 });
+  VecRaster<float, 2> patch(region.shape());
+  const long patchByteCount = patch.size() * sizeof(float);
+  suite.run("image.region.read", parameters, [&]() {
+    du.readRegionTo<float, 2, 2>(region, patch);
+    return patchByteCount;
+  });
+  suite.run("image.region.write", parameters, [&]() {
+    du.writeRegion<float, 2, 2>(region.front, patch);
+    return patchByteCount;
+  });
+
+  suite.run("checksum.update", parameters, [&]() {
+    hdu.updateChecksums();
+    return byteCount;
+  });
+  suite.run("checksum.verify", parameters, [&]() {
+    hdu.verifyChecksums();
+    return byteCount;
+  });
+}
+
+/**
+ * @brief Benchmark column reads and writes, whole, by segment, and chunk-wise.
+ */
+void benchmarkColumns(MefFile& f, Test::BenchmarkSuite& suite, long rowCount) {
+  const Test::BenchmarkParameters parameters { { "rows", rowCount } };
+  Test::RandomScalarColumn<double> scalars(rowCount);
+  scalars.rename("SCALAR");
+  Test::RandomVectorColumn<float> vectors(8, rowCount);
+  vectors.rename("VECTOR");
+  Test::RandomScalarColumn<std::string> strings(rowCount);
+  strings.rename("STRING");
+  const auto& du = f.assignBintableExt("TABLE", scalars, vectors, strings).columns();
+  const long byteCount = rowCount * sizeof(double);
+
+  suite.run("column.scalar.write", parameters, [&]() {
+    du.write(scalars);
+    return byteCount;
+  });
+  suite.run("column.scalar.read", parameters, [&]() {
+    return du.read<double>("SCALAR").elementCount() * long(sizeof(double));
+  });
+  suite.run("column.vector.write", parameters, [&]() {
+    du.write(vectors);
+    return vectors.elementCount() * long(sizeof(float));
+  });
+  suite.run("column.vector.read", parameters, [&]() {
+    return du.read<float>("VECTOR").elementCount() * long(sizeof(float));
+  });
+  const long stringByteCount = strings.elementCount() * strings.info().repeatCount;
+  suite.run("column.string.write", parameters, [&]() {
+    du.write(strings);
+    return stringByteCount;
+  });
+  suite.run("column.string.read", parameters, [&]() {
+    du.read<std::string>("STRING");
+    return stringByteCount;
+  });
+
+  const Segment segment { rowCount / 4, rowCount / 4 + rowCount / 2 - 1 };
+  suite.run("column.segment.read", { { "rows", rowCount }, { "segment", segment.size() } }, [&]() {
+    return du.readSegment<double>(segment, "SCALAR").elementCount() * long(sizeof(double));
+  });
+
+  VecColumn<double> scalarBuffer(scalars.info(), rowCount);
+  VecColumn<float> vectorBuffer(vectors.info(), rowCount);
+  VecColumn<std::string> stringBuffer(strings.info(), rowCount);
+  const long rowByteCount = sizeof(double) + 8 * sizeof(float) + strings.info().repeatCount;
+  for (long chunkRowCount : { 16L, 256L, 4096L, du.readBufferRowCount() }) {
+    suite.run("column.seq.chunked.read", { { "rows", rowCount }, { "chunk", chunkRowCount } }, [&]() {
+      for (long front = 0; front < rowCount; front += chunkRowCount) {
+        const Segment rows { front, std::min(front + chunkRowCount, rowCount) - 1 };
+        du.readSegmentSeqTo({ rows, front }, scalarBuffer, vectorBuffer, stringBuffer);
+      }
+      return rowCount * rowByteCount;
+    });
+  }
+}
+
+/**
+ * @brief Benchmark header writes and parsing.
+ */
+void benchmarkHeader(MefFile& f, Test::BenchmarkSuite& suite, long cardCount) {
+  const Test::BenchmarkParameters parameters { { "cards", cardCount } };
+  const auto& header = f.initRecordExt("HEADER").header();
+  RecordVec<long> records(cardCount);
+  std::vector<std::string> keywords(cardCount);
+  for (long i = 0; i < cardCount; ++i) {
+    keywords[i] = "K" + std::to_string(i);
+    records.vector[i] = { keywords[i], i, "", "" };
+  }
+  const long byteCount = cardCount * 80;
+
+  suite.run("header.write", parameters, [&]() {
+    header.writeSeq(records);
+    return byteCount;
+  });
+  suite.run("header.parse", parameters, [&]() {
+    header.parseSeq<long>(keywords);
+    return byteCount;
+  });
+  suite.run("header.parse.all", parameters, [&]() {
+    header.parseAll();
+    return byteCount;
+  });
+}
+
+/**
+ * @brief Benchmark HDU navigation by index and by name.
+ */
+void benchmarkNavigation(MefFile& f, Test::BenchmarkSuite& suite, long hduCount) {
+  const Test::BenchmarkParameters parameters { { "hdus", hduCount } };
+  const long first = f.hduCount();
+  std::vector<std::string> names(hduCount);
+  for (long i = 0; i < hduCount; ++i) {
+    names[i] = "HDU_" + std::to_string(i);
+    f.initRecordExt(names[i]);
+  }
+
+  suite.run("hdu.access.index", parameters, [&]() {
+    for (long i = 0; i < hduCount; ++i) {
+      f.access<>(first + i);
+    }
+    return 0L;
+  });
+  suite.run("hdu.access.name", parameters, [&]() {
+    for (const auto& n : names) {
+      f.access<>(n);
+    }
+    return 0L;
+  });
+}
+
+class EleFitsIoBenchmark : public Elements::Program {
+
+public:
+  std::pair<OptionsDescription, PositionalOptionsDescription> defineProgramArguments() override {
+    ProgramOptions options;
+    options.named("min", value<long>()->default_value(1000), "Minimum number of pixels or rows");
+    options.named("max", value<long>()->default_value(1000000), "Maximum number of pixels or rows");
+    options.named("cards", value<long>()->default_value(1000), "Maximum number of header cards");
+    options.named("hdus", value<long>()->default_value(100), "Maximum number of HDUs");
+    options.named("iterations", value<long>()->default_value(10), "Number of timed iterations per case");
+    options.named("output", value<std::string>()->default_value("/tmp/test.fits"), "Output Fits file");
+    options.named("res", value<std::string>()->default_value("/tmp/io.json"), "Output result file");
+    return options.asPair();
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, VariableValue>& args) override {
+
+    Elements::Logging logger = Elements::Logging::getLogger("EleFitsIoBenchmark");
+
+    const auto minSize = args["min"].as<long>();
+    const auto maxSize = args["max"].as<long>();
+    const auto maxCardCount = args["cards"].as<long>();
+    const auto maxHduCount = args["hdus"].as<long>();
+    const auto filename = args["output"].as<std::string>();
+    const auto results = args["res"].as<std::string>();
+
+    Test::BenchmarkSuite suite(args["iterations"].as<long>());
+
+    for (long size = minSize; size <= maxSize; size *= 10) {
+      logger.info() << "Size: " << size;
+      MefFile f(filename, FileMode::Overwrite);
+      logger.info("  Images...");
+      benchmarkImages(f, suite, size);
+      logger.info("  Columns...");
+      benchmarkColumns(f, suite, size);
+      logger.info("  Header...");
+      benchmarkHeader(f, suite, std::min(size, maxCardCount));
+      logger.info("  Navigation...");
+      benchmarkNavigation(f, suite, std::min(size, maxHduCount));
+    }
+
+    suite.writeJson(results);
+    logger.info() << "Results written to " << results;
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(EleFitsIoBenchmark)
@@ -0,0 +1,267 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/MefFile.h"
+#include "EleFitsData/TestColumn.h"
+#include "EleFitsData/TestRaster.h"
+#include "EleFitsUtils/ProgramOptions.h"
+#include "EleFitsValidation/CsvAppender.h"
+#include "EleFitsValidation/Chronometer.h"
+#include "ElementsKernel/ProgramHeaders.h"
+
+#include <boost/program_options.hpp>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <unistd.h> // sysconf
+
+using boost::program_options::value;
+
+using namespace Euclid::Fits;
+
+/**
+ * @brief The chronometer of the navigation benchmark.
+ */
+using NavigationChronometer = Test::Chronometer<std::chrono::microseconds>;
+
+/**
+ * @brief Get the name of the i-th HDU.
+ */
+std::string hduName(long i) {
+  return "HDU_" + std::to_string(i);
+}
+
+/**
+ * @brief Generate a MEF file with small HDUs, alternatively images and binary tables.
+ * @details
+ * The Primary is named like the extensions.
+ */
+void generateFile(const std::string& filename, long hduCount) {
+  Test::RandomRaster<float, 2> raster({ 2, 2 });
+  Test::RandomScalarColumn<float> column(2);
+  column.rename("X");
+  MefFile f(filename, FileMode::Overwrite);
+  f.primary().header().write("EXTNAME", hduName(0));
+  for (long i = 1; i < hduCount; ++i) {
+    if (i % 2) {
+      f.assignImageExt(hduName(i), raster);
+    } else {
+      f.assignBintableExt(hduName(i), column);
+    }
+  }
+}
+
+/**
+ * @brief Get the resident set size of the process, in bytes.
+ */
+long readResidentSize() {
+  long pageCount = 0;
+  long residentCount = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> pageCount >> residentCount;
+  return residentCount * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief Run the navigation cases on a given file and write the results.
+ */
+class NavigationBenchmark {
+
+public:
+  NavigationBenchmark(const std::string& filename, long hduCount, long iterationCount, Test::CsvAppender& writer) :
+      m_filename(filename), m_hduCount(hduCount), m_iterationCount(iterationCount), m_writer(writer) {}
+
+  /**
+   * @brief Time the opening of the file, which counts the HDUs.
+   */
+  void runOpen() {
+    NavigationChronometer chrono;
+    for (long i = 0; i < m_iterationCount; ++i) {
+      chrono.start();
+      MefFile f(m_filename, FileMode::Read);
+      chrono.stop();
+    }
+    write("Open", "", chrono);
+  }
+
+  /**
+   * @brief Time an operation on a newly opened file, where no HDU handle was created yet.
+   */
+  template <typename TFunc>
+  void run(const std::string& name, const std::string& target, TFunc&& func) {
+    NavigationChronometer chrono;
+    for (long i = 0; i < m_iterationCount; ++i) {
+      MefFile f(m_filename, FileMode::Read);
+      chrono.start();
+      func(f);
+      chrono.stop();
+    }
+    write(name, target, chrono);
+  }
+
+  /**
+   * @brief Time the creation of all the HDU handles, and measure their memory footprint.
+   * @details
+   * The footprint of `MefFile::m_hdus` is estimated as the vector of pointers plus the handles themselves,
+   * and is compared to the increase of the resident set size.
+   */
+  void runHandles() {
+    NavigationChronometer chrono;
+    long rssDelta = 0;
+    for (long i = 0; i < m_iterationCount; ++i) {
+      MefFile f(m_filename, FileMode::Read);
+      const auto rss = readResidentSize();
+      chrono.start();
+      for (long j = 0; j < m_hduCount; ++j) {
+        f.access<>(j);
+      }
+      chrono.stop();
+      rssDelta = readResidentSize() - rss;
+    }
+    const long imageCount = (m_hduCount + 1) / 2; // Including the Primary
+    const long bintableCount = m_hduCount - imageCount;
+    const long handleSize = m_hduCount * sizeof(std::unique_ptr<Hdu>) + imageCount * sizeof(ImageHdu) +
+        bintableCount * sizeof(BintableHdu);
+    write("Access all by index", "", chrono, handleSize, rssDelta);
+  }
+
+private:
+  /**
+   * @brief Write a row of results.
+   */
+  void write(
+      const std::string& name,
+      const std::string& target,
+      const NavigationChronometer& chrono,
+      long handleSize = 0,
+      long rssDelta = 0) {
+    m_writer.writeRow(
+        name,
+        m_hduCount,
+        target,
+        m_iterationCount,
+        chrono.mean(),
+        chrono.min(),
+        chrono.max(),
+        handleSize,
+        rssDelta);
+  }
+
+  std::string m_filename;
+  long m_hduCount;
+  long m_iterationCount;
+  Test::CsvAppender& m_writer;
+};
+
+class EleFitsNavigationBenchmark : public Elements::Program {
+
+public:
+  std::pair<OptionsDescription, PositionalOptionsDescription> defineProgramArguments() override {
+    ProgramOptions options;
+    options.named("min", value<long>()->default_value(10), "Minimum number of HDUs");
+    options.named("max", value<long>()->default_value(10000), "Maximum number of HDUs");
+    options.named("iterations", value<long>()->default_value(5), "Number of timed iterations per case");
+    options.named("output", value<std::string>()->default_value("/tmp/test.fits"), "Output Fits file");
+    options.named("res", value<std::string>()->default_value("/tmp/navigation.csv"), "Output result file");
+    return options.asPair();
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, VariableValue>& args) override {
+
+    Elements::Logging logger = Elements::Logging::getLogger("EleFitsNavigationBenchmark");
+
+    const auto minCount = args["min"].as<long>();
+    const auto maxCount = args["max"].as<long>();
+    const auto iterationCount = args["iterations"].as<long>();
+    const auto filename = args["output"].as<std::string>();
+    const auto results = args["res"].as<std::string>();
+
+    Test::CsvAppender writer(
+        results,
+        { "Case",
+          "HDU count",
+          "Target",
+          "Iterations",
+          "Mean (us)",
+          "Min (us)",
+          "Max (us)",
+          "Handle size (B)",
+          "RSS increase (B)" });
+
+    for (long hduCount = minCount; hduCount <= maxCount; hduCount *= 10) {
+
+      logger.info() << "Generating " << hduCount << " HDUs...";
+      NavigationChronometer chrono;
+      chrono.start();
+      generateFile(filename, hduCount);
+      chrono.stop();
+      writer.writeRow("Generate", hduCount, "", 1, chrono.mean(), chrono.min(), chrono.max(), 0, 0);
+
+      logger.info("  Navigating...");
+      NavigationBenchmark benchmark(filename, hduCount, iterationCount, writer);
+      benchmark.runOpen();
+      benchmark.run("Count", "", [](MefFile& f) {
+        f.hduCount();
+      });
+      benchmark.run("Read names", "", [](MefFile& f) {
+        f.readHduNames();
+      });
+      const std::vector<std::pair<std::string, long>> targets {
+          { "First", 0 },
+          { "Middle", hduCount / 2 },
+          { "Last", hduCount - 1 } };
+      for (const auto& t : targets) {
+        const auto name = hduName(t.second);
+        benchmark.run("Access by index", t.first, [&](MefFile& f) {
+          f.access<>(t.second);
+        });
+        benchmark.run("Access by name", t.first, [&](MefFile& f) {
+          f.access<>(name);
+        });
+        benchmark.run("Access first by name", t.first, [&](MefFile& f) {
+          f.accessFirst<>(name);
+        });
+      }
+      benchmark.run("Select all", "", [](MefFile& f) {
+        for (const auto& hdu : f.select<>()) {
+          hdu.readName();
+        }
+      });
+      benchmark.run("Select image extensions", "", [](MefFile& f) {
+        for (const auto& hdu : f.select<ImageHdu>(HduCategory::Ext)) {
+          hdu.readName();
+        }
+      });
+      benchmark.run("Select binary tables", "", [](MefFile& f) {
+        for (const auto& hdu : f.select<BintableHdu>()) {
+          hdu.readName();
+        }
+      });
+      benchmark.runHandles();
+    }
+
+    logger.info() << "Results written to " << results;
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(EleFitsNavigationBenchmark)
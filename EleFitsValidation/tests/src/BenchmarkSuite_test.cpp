@@ -0,0 +1,77 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsValidation/BenchmarkSuite.h"
+
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(BenchmarkSuite_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(iterations_are_counted_and_timed_test) {
+  Test::BenchmarkSuite suite(5, 2);
+  long callCount = 0;
+  const auto& result = suite.run("dummy", { { "size", 42 } }, [&]() {
+    ++callCount;
+    return 42L;
+  });
+  BOOST_TEST(callCount == 7);
+  BOOST_TEST(result.name == "dummy");
+  BOOST_TEST(result.byteCount == 42);
+  BOOST_TEST(result.latencies.size() == 5);
+  BOOST_TEST(suite.results().size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(quantiles_are_interpolated_test) {
+  Test::BenchmarkResult result { "dummy", {}, 100, { 4, 1, 3, 2, 5 } };
+  BOOST_TEST(result.quantile(0) == 1);
+  BOOST_TEST(result.quantile(.5) == 3);
+  BOOST_TEST(result.quantile(.875) == 4.5);
+  BOOST_TEST(result.quantile(1) == 5);
+  BOOST_TEST(result.mean() == 3);
+  BOOST_TEST(result.throughput() == 100. / 3);
+}
+
+BOOST_AUTO_TEST_CASE(json_contains_results_test) {
+  Test::BenchmarkSuite suite(3, 0);
+  suite.run("first", { { "rows", 10 }, { "chunk", 2 } }, []() {
+    return 1L;
+  });
+  suite.run("second", {}, []() {
+    return 2L;
+  });
+  std::ostringstream out;
+  suite.writeJson(out);
+  const auto json = out.str();
+  BOOST_TEST(json.find("\"iterations\": 3") != std::string::npos);
+  BOOST_TEST(json.find("\"case\": \"first\"") != std::string::npos);
+  BOOST_TEST(json.find("\"rows\": 10, \"chunk\": 2") != std::string::npos);
+  BOOST_TEST(json.find("\"case\": \"second\"") != std::string::npos);
+  BOOST_TEST(json.find("\"p99\"") != std::string::npos);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
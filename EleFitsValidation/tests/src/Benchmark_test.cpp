@@ -31,6 +31,17 @@ struct ParamBenchmark : Test::Benchmark {
   double m_d;
 };
 
+struct WriteOnlyBenchmark : Test::Benchmark {
+  WriteOnlyBenchmark() : Test::Benchmark("file.fits"), m_writeCount(0) {}
+  void open() {};
+  void close() {};
+  void initHeader() {};
+  void writeRecords(const Test::BRecords&, RecordMode) {
+    ++m_writeCount;
+  }
+  long m_writeCount;
+};
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE(Benchmark_test)
@@ -54,6 +65,34 @@ BOOST_AUTO_TEST_CASE(factory_test) {
   BOOST_TEST(pb1->m_d == 0.);
 }
 
+BOOST_AUTO_TEST_CASE(records_are_generated_test) {
+  const auto records = Test::generateRecords(10, 80);
+  BOOST_TEST(std::get<0>(records).vector.size() == 3);
+  BOOST_TEST(std::get<1>(records).vector.size() == 3);
+  BOOST_TEST(std::get<2>(records).vector.size() == 2);
+  BOOST_TEST(std::get<3>(records).vector.size() == 2);
+  BOOST_TEST(std::get<3>(records).vector[0].value.length() == 80);
+  const auto keywords = Test::recordKeywords(records);
+  BOOST_TEST(keywords.size() == 10);
+  for (const auto& k : keywords) {
+    BOOST_TEST(k.length() == 8);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(unimplemented_header_cases_are_skipped_test) {
+  WriteOnlyBenchmark benchmark;
+  const auto records = Test::generateRecords(4);
+  const auto chronos = benchmark.benchmarkHeaders(3, records);
+  BOOST_TEST(chronos.size() == 4); // Write in each mode
+  for (const auto& c : chronos) {
+    BOOST_TEST(c.first.substr(0, 6) == "Write ");
+    BOOST_TEST(c.second.count() == 3);
+  }
+  BOOST_TEST(benchmark.m_writeCount == 12);
+  ParamBenchmark unimplemented("file.fits", 0, 0.);
+  BOOST_CHECK_THROW(unimplemented.benchmarkHeaders(1, records), Test::TestCaseNotImplemented);
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()